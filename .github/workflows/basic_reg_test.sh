@@ -15,6 +15,7 @@ python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/config
 python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/configuration_chain_use_setb --debug --show_thread_logs
 python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/configuration_chain_use_set_reset --debug --show_thread_logs
 python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/multi_region_configuration_chain --debug --show_thread_logs
+python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/multi_region_balanced_configuration_chain --debug --show_thread_logs
 python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/fast_configuration_chain --debug --show_thread_logs
 python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/fast_configuration_chain_use_set --debug --show_thread_logs
 python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/smart_fast_configuration_chain --debug --show_thread_logs
@@ -108,3 +109,59 @@ python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/tile_organization/til
 echo -e "Testing global port definition from tiles";
 python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/global_tile_ports/global_tile_clock --debug --show_thread_logs
 python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/global_tile_ports/global_tile_reset --debug --show_thread_logs
+
+echo -e "Testing read-only commands executed concurrently";
+python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/concurrent_commands/serial --debug --show_thread_logs
+python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/concurrent_commands/concurrent --debug --show_thread_logs
+# The outputs should be the same as the ones of the commands executed one by one
+serial_task_dir=openfpga_flow/tasks/basic_tests/concurrent_commands/serial/latest
+concurrent_task_dir=openfpga_flow/tasks/basic_tests/concurrent_commands/concurrent/latest
+for run_dir in ${serial_task_dir}/*/*/*/; do
+  concurrent_run_dir=${concurrent_task_dir}/${run_dir#${serial_task_dir}/}
+  cmp ${run_dir}/fabric_bitstream.txt ${concurrent_run_dir}/fabric_bitstream.txt
+  diff -I "Date:" ${run_dir}/fabric_bitstream.xml ${concurrent_run_dir}/fabric_bitstream.xml
+  diff -r -I "Date:" ${run_dir}/SRC ${concurrent_run_dir}/SRC
+  diff -r -I "Date:" ${run_dir}/SDC ${concurrent_run_dir}/SDC
+  diff -r -I "Date:" ${run_dir}/SDC_analysis ${concurrent_run_dir}/SDC_analysis
+  # Each command succeeds in the profile, and the commands executed concurrently
+  # include the timed sections of their own threads
+  python3 - ${concurrent_run_dir}/profile.json <<'EOF'
+import json
+import sys
+with open(sys.argv[1]) as fp:
+    profile = json.load(fp)
+assert profile["status"] == 0
+assert len(profile["children"]) > 0
+for cmd in profile["children"]:
+    assert cmd["status"] == 0, cmd["name"]
+    if cmd["name"].startswith(("write_fabric_bitstream", "write_pnr_sdc", "write_analysis_sdc")):
+        assert len(cmd["children"]) > 0, cmd["name"]
+EOF
+done
+
+echo -e "Testing server mode which implements several designs on the same fabric";
+python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/server_mode --debug --show_thread_logs
+openfpga_exec=$(pwd)/openfpga/openfpga
+server_run_dirs=(openfpga_flow/tasks/basic_tests/server_mode/latest/*/*/*/)
+server_dir=$(cd ${server_run_dirs[0]} && pwd)
+# The setup script of the server builds the fabric with the first design
+sed -n '1,/^build_fabric /p' ${server_dir}/*_run.openfpga > ${server_dir}/server_setup.openfpga
+(cd ${server_dir} && exec ${openfpga_exec} --file server_setup.openfpga --server openfpga.sock > openfpga_server.log 2>&1) &
+server_pid=$!
+for run_dir in "${server_run_dirs[@]}"; do
+  run_dir=$(cd ${run_dir} && pwd)
+  top=$(basename ${run_dir}/*_run.openfpga _run.openfpga)
+  # Each request implements a design on the fabric without building it,
+  # using the files of its own run directory
+  grep -v -E "^(read_openfpga_arch|build_fabric|exit)( |$)" ${run_dir}/${top}_run.openfpga \
+    | sed -e "s| ${top}| ${run_dir}/${top}|g" \
+          -e "s| \./| ${run_dir}/|g" \
+          -e "s| fabric_bitstream.txt| ${run_dir}/server_fabric_bitstream.txt|" \
+    > ${run_dir}/server_request.openfpga
+  python3 openfpga_flow/scripts/run_openfpga_server_request.py ${server_dir}/openfpga.sock ${run_dir}/server_request.openfpga --server_pid ${server_pid}
+  # The bitstream should be the same as the one built in script mode
+  cmp ${run_dir}/fabric_bitstream.txt ${run_dir}/server_fabric_bitstream.txt
+done
+echo "exit" > ${server_dir}/server_exit.openfpga
+python3 openfpga_flow/scripts/run_openfpga_server_request.py ${server_dir}/openfpga.sock ${server_dir}/server_exit.openfpga --server_pid ${server_pid}
+wait ${server_pid}
@@ -19,3 +19,66 @@ python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/generate_bitstream
 
 echo -e "Testing loading architecture bitstream from an external file";
 python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/load_external_architecture_bitstream --debug --show_thread_logs
+
+echo -e "Testing updating the bitstream incrementally after re-routing";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/incremental_bitstream --debug --show_thread_logs
+# The updated bitstream should be the same as the one built from scratch
+for run_dir in openfpga_flow/tasks/fpga_bitstream/incremental_bitstream/latest/*/*/*/; do
+  cmp ${run_dir}/incremental_fabric_bitstream.txt ${run_dir}/full_fabric_bitstream.txt
+  diff -I "Date:" ${run_dir}/incremental_fabric_independent_bitstream.xml ${run_dir}/full_fabric_independent_bitstream.xml
+done
+
+echo -e "Testing reading a block of architecture bitstream through an index";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/read_bitstream_block --debug --show_thread_logs
+for run_dir in openfpga_flow/tasks/fpga_bitstream/read_bitstream_block/latest/*/*/*/; do
+  cmp ${run_dir}/fabric_bitstream.txt ${run_dir}/reloaded_fabric_bitstream.txt
+done
+
+echo -e "Testing writing the frames of the fabric bitstream which are changed by a new routing";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/differential_bitstream --debug --show_thread_logs
+for run_dir in openfpga_flow/tasks/fpga_bitstream/differential_bitstream/latest/*/*/*/; do
+  # Nothing is changed when the reference is the bitstream itself
+  test -z "$(cat ${run_dir}/unchanged_fabric_bitstream.txt)"
+  # The changed frames are the same as in the bitstream of the new routing
+  test -z "$(grep -vxF -f ${run_dir}/rerouted_fabric_bitstream.txt ${run_dir}/diff_fabric_bitstream.txt)"
+done
+
+echo -e "Testing reporting the configuration time of the fabric bitstream";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/report_config_time --debug --show_thread_logs
+# The reported clock cycles should be the same as the ones applied by the testbenches
+for run_dir in openfpga_flow/tasks/fpga_bitstream/report_config_time/latest/*/*/*/; do
+  for config in "config_time.rpt SRC" "fast_config_time.rpt SRC_fast"; do
+    set -- ${config}
+    report_cycles=$(grep "Number of configuration clock cycles (including 1 reset cycle)" ${run_dir}/$1 | awk '{print $NF}')
+    testbench_cycles=$(grep -h "Number of clock cycles in configuration phase" ${run_dir}/$2/*_autocheck_top_tb.v | awk '{print $(NF-1)}')
+    test -n "${report_cycles}"
+    test "${report_cycles}" = "${testbench_cycles}"
+  done
+done
+
+echo -e "Testing querying the bitstream database";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/query_bitstream --debug --show_thread_logs
+for run_dir in openfpga_flow/tasks/fpga_bitstream/query_bitstream/latest/*/*/*/; do
+  # Each query of blocks should find configuration bits
+  test -z "$(grep "^Found 0 configuration bits" ${run_dir}/openfpgashell.log)"
+  # The owner of a fabric bit should be the same as in the fabric bitstream file
+  for fabric_bit in 0 1 10; do
+    owner=$(grep "^Fabric bit ${fabric_bit}: " ${run_dir}/openfpgashell.log \
+            | sed -E 's/^Fabric bit ([0-9]+): configuration bit [0-9]+ at (.*)\[([0-9]+)\] with value ([01])$/<bit id="\1" value="\4" path="\2.mem_out[\3]"/')
+    test -n "${owner}"
+    grep -qF "${owner}" ${run_dir}/fabric_bitstream.xml
+  done
+done
+
+echo -e "Testing the options of writing the fabric bitstream in XML format";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/write_xml_fabric_bitstream/configuration_chain --debug --show_thread_logs
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/write_xml_fabric_bitstream/memory_bank --debug --show_thread_logs
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/write_xml_fabric_bitstream/configuration_frame --debug --show_thread_logs
+# The default output should keep the original format line by line,
+# and the other options should write the same bits
+for run_dir in openfpga_flow/tasks/fpga_bitstream/write_xml_fabric_bitstream/*/latest/*/*/*/; do
+  python3 openfpga_flow/scripts/check_xml_fabric_bitstream.py ${run_dir}/fabric_bitstream.xml \
+    ${run_dir}/fabric_bitstream_by_block.xml \
+    ${run_dir}/fabric_bitstream.xml.gz \
+    ${run_dir}/fabric_bitstream_by_block.xml.gz
+done
@@ -111,6 +111,15 @@ echo -e "Testing through channels in tileable routing";
 python3 openfpga_flow/scripts/run_fpga_task.py fpga_verilog/thru_channel/thru_narrow_tile --debug --show_thread_logs
 python3 openfpga_flow/scripts/run_fpga_task.py fpga_verilog/thru_channel/thru_wide_tile --debug --show_thread_logs
 
+echo -e "Testing Verilog generation of single modules on a lazy fabric";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_verilog/lazy_fabric --debug --show_thread_logs
+# The modules built on demand should be the same as the ones of the full fabric
+for run_dir in openfpga_flow/tasks/fpga_verilog/lazy_fabric/latest/*/*/*/; do
+  for module in grid_clb sb_1__1_ cbx_1__1_; do
+    diff -I "Date:" ${run_dir}/SRC_lazy/${module}.v ${run_dir}/SRC_full/${module}.v
+  done
+done
+
 # Verify MCNC big20 benchmark suite with ModelSim 
 # Please make sure you have ModelSim installed in the environment
 # Otherwise, it will fail
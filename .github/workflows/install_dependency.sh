@@ -32,6 +32,7 @@ sudo apt-get install texinfo
 sudo apt-get install time
 sudo apt-get install valgrind
 sudo apt-get install zip
+sudo apt-get install zlib1g-dev
 sudo apt-get install qt5-default
 sudo apt-get install clang-format-7
 # Add all the supported compilers
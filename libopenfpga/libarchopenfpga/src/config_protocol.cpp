@@ -10,7 +10,7 @@
  * Constructors
  ***********************************************************************/
 ConfigProtocol::ConfigProtocol() {
-  return;
+  balance_regions_ = false;
 }
 
 /************************************************************************
@@ -32,6 +32,10 @@ int ConfigProtocol::num_regions() const {
   return num_regions_;
 }
 
+bool ConfigProtocol::balance_regions() const {
+  return balance_regions_;
+}
+
 /************************************************************************
  * Public Mutators
  ***********************************************************************/
@@ -50,3 +54,7 @@ void ConfigProtocol::set_memory_model(const CircuitModelId& memory_model) {
 void ConfigProtocol::set_num_regions(const int& num_regions) {
   num_regions_ = num_regions;
 }
+
+void ConfigProtocol::set_balance_regions(const bool& balance_regions) {
+  balance_regions_ = balance_regions;
+}
@@ -16,11 +16,13 @@ class ConfigProtocol {
     std::string memory_model_name() const;
     CircuitModelId memory_model() const;
     int num_regions() const;
+    bool balance_regions() const;
   public: /* Public Mutators */
     void set_type(const e_config_protocol_type& type);
     void set_memory_model_name(const std::string& memory_model_name);
     void set_memory_model(const CircuitModelId& memory_model);
     void set_num_regions(const int& num_regions);
+    void set_balance_regions(const bool& balance_regions);
   private: /* Internal data */
     /* The type of configuration protocol. 
      * In other words, it is about how to organize and access each configurable memory 
@@ -33,6 +35,11 @@ class ConfigProtocol {
 
     /* Number of configurable regions */
     int num_regions_;
+
+    /* Split the configurable children among regions by their configuration bits
+     * instead of their number 
+     */
+    bool balance_regions_;
 };
 
 #endif
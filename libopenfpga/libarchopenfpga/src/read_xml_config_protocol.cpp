@@ -65,6 +65,9 @@ void read_xml_config_organization(pugi::xml_node& xml_config_orgz,
                    "Invalid 'num_region=%d' definition. At least 1 region should be defined!\n",
                    config_protocol.num_regions());
   }
+
+  /* Parse how the configurable children are split among regions */
+  config_protocol.set_balance_regions(get_attribute(xml_config_orgz, "balance_regions", loc_data, pugiutil::ReqOpt::OPTIONAL).as_bool(false));
 }
 
 /********************************************************************
@@ -234,6 +234,68 @@ void BitstreamManager::add_child_block(const ConfigBlockId& parent_block, const
   parent_block_ids_[child_block] = parent_block;
 }
 
+void BitstreamManager::add_child_blocks_from(const ConfigBlockId& parent_block,
+                                             const BitstreamManager& src_manager,
+                                             const ConfigBlockId& src_root_block) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(parent_block));
+  VTR_ASSERT(true == src_manager.valid_block_id(src_root_block));
+  /* The root block should carry no bits, otherwise they will be lost */
+  VTR_ASSERT(0 == src_manager.block_bit_lengths_[src_root_block]);
+
+  /* Blocks in the source are renumbered by skipping the root block */
+  size_t block_offset = num_blocks_;
+  auto map_block = [&](const ConfigBlockId& src_block) {
+    VTR_ASSERT_SAFE(src_block != src_root_block);
+    if (size_t(src_block) < size_t(src_root_block)) {
+      return ConfigBlockId(block_offset + size_t(src_block));
+    }
+    return ConfigBlockId(block_offset + size_t(src_block) - 1);
+  };
+
+  size_t bit_offset = num_bits_;
+  for (const ConfigBlockId& src_block : src_manager.blocks()) {
+    if (src_block == src_root_block) {
+      continue;
+    }
+    ConfigBlockId block = create_block();
+    VTR_ASSERT_SAFE(block == map_block(src_block));
+    block_names_[block] = src_manager.block_names_[src_block];
+    if (0 < src_manager.block_bit_lengths_[src_block]) {
+      block_bit_id_lsbs_[block] = bit_offset + src_manager.block_bit_id_lsbs_[src_block];
+    }
+    block_bit_lengths_[block] = src_manager.block_bit_lengths_[src_block];
+    block_path_ids_[block] = src_manager.block_path_ids_[src_block];
+    block_input_net_ids_[block] = src_manager.block_input_net_ids_[src_block];
+    block_output_net_ids_[block] = src_manager.block_output_net_ids_[src_block];
+
+    /* The source manager should contain a single tree */
+    ConfigBlockId src_parent = src_manager.parent_block_ids_[src_block];
+    VTR_ASSERT(true == src_manager.valid_block_id(src_parent));
+    if (src_parent == src_root_block) {
+      /* Children of the parent block are registered later in the source order */
+      parent_block_ids_[block] = parent_block;
+    } else {
+      parent_block_ids_[block] = map_block(src_parent);
+    }
+
+    child_block_ids_[block].reserve(src_manager.child_block_ids_[src_block].size());
+    for (const ConfigBlockId& src_child : src_manager.child_block_ids_[src_block]) {
+      child_block_ids_[block].push_back(map_block(src_child));
+    }
+  }
+
+  for (const ConfigBlockId& src_child : src_manager.child_block_ids_[src_root_block]) {
+    child_block_ids_[parent_block].push_back(map_block(src_child));
+  }
+
+  for (const ConfigBitId& src_bit : src_manager.bits()) {
+    bit_values_.push_back(src_manager.bit_values_[src_bit]);
+    bit_parent_blocks_.push_back(map_block(src_manager.bit_parent_blocks_[src_bit]));
+  }
+  num_bits_ += src_manager.num_bits_;
+}
+
 void BitstreamManager::add_block_bits(const ConfigBlockId& block,
                                       const std::vector<bool>& block_bitstream) {
   /* Ensure the input ids are valid */
@@ -247,6 +309,55 @@ void BitstreamManager::add_block_bits(const ConfigBlockId& block,
   }
 }
 
+void BitstreamManager::set_block_bits(const ConfigBlockId& block,
+                                      const std::vector<bool>& block_bitstream) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block));
+  VTR_ASSERT(block_bitstream.size() == (size_t)block_bit_lengths_[block]);
+
+  size_t lsb = block_bit_id_lsbs_[block];
+  for (size_t ibit = 0; ibit < block_bitstream.size(); ++ibit) {
+    if (true == block_bitstream[ibit]) {
+      bit_values_[ConfigBitId(lsb + ibit)] = '1';
+    } else {
+      bit_values_[ConfigBitId(lsb + ibit)] = '0';
+    }
+  }
+}
+
+size_t BitstreamManager::overwrite_blocks_from(const ConfigBlockId& block,
+                                               const BitstreamManager& src_manager,
+                                               const ConfigBlockId& src_block) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block));
+  VTR_ASSERT(true == src_manager.valid_block_id(src_block));
+  /* The two block trees should have the same hierarchy */
+  VTR_ASSERT(block_names_[block] == src_manager.block_names_[src_block]);
+  VTR_ASSERT(block_bit_lengths_[block] == src_manager.block_bit_lengths_[src_block]);
+  VTR_ASSERT(child_block_ids_[block].size() == src_manager.child_block_ids_[src_block].size());
+
+  size_t num_changed_bits = 0;
+  for (size_t ibit = 0; ibit < (size_t)block_bit_lengths_[block]; ++ibit) {
+    ConfigBitId bit = ConfigBitId(block_bit_id_lsbs_[block] + ibit);
+    ConfigBitId src_bit = ConfigBitId(src_manager.block_bit_id_lsbs_[src_block] + ibit);
+    if (bit_values_[bit] != src_manager.bit_values_[src_bit]) {
+      bit_values_[bit] = src_manager.bit_values_[src_bit];
+      num_changed_bits++;
+    }
+  }
+  block_path_ids_[block] = src_manager.block_path_ids_[src_block];
+  block_input_net_ids_[block] = src_manager.block_input_net_ids_[src_block];
+  block_output_net_ids_[block] = src_manager.block_output_net_ids_[src_block];
+
+  for (size_t ichild = 0; ichild < child_block_ids_[block].size(); ++ichild) {
+    num_changed_bits += overwrite_blocks_from(child_block_ids_[block][ichild],
+                                              src_manager,
+                                              src_manager.child_block_ids_[src_block][ichild]);
+  }
+
+  return num_changed_bits;
+}
+
 void BitstreamManager::add_path_id_to_block(const ConfigBlockId& block, const int& path_id) {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block));
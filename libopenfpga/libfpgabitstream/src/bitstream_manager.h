@@ -173,10 +173,32 @@ class BitstreamManager {
     /* Set a block as a child block of another */
     void add_child_block(const ConfigBlockId& parent_block, const ConfigBlockId& child_block);
 
+    /* Append all the blocks and bits of another bitstream manager,
+     * whose root block is replaced by the given parent block.
+     * Block and bit ids are assigned in the same order as in the source,
+     * so the result is the same as building the blocks here directly
+     */
+    void add_child_blocks_from(const ConfigBlockId& parent_block,
+                               const BitstreamManager& src_manager,
+                               const ConfigBlockId& src_root_block);
+
     /* Add a bitstream to a block */
     void add_block_bits(const ConfigBlockId& block,
                         const std::vector<bool>& block_bitstream);
 
+    /* Overwrite the bitstream of a block, which must have the same size as the existing one */
+    void set_block_bits(const ConfigBlockId& block,
+                        const std::vector<bool>& block_bitstream);
+
+    /* Overwrite the bits, path ids and net ids of a block and all its child blocks
+     * with those of a block tree of another bitstream manager,
+     * which must have the same hierarchy and the same number of bits per block.
+     * Return the number of bits whose values are changed
+     */
+    size_t overwrite_blocks_from(const ConfigBlockId& block,
+                                 const BitstreamManager& src_manager,
+                                 const ConfigBlockId& src_block);
+
     /* Add a path id to a block */
     void add_path_id_to_block(const ConfigBlockId& block, const int& path_id);
  
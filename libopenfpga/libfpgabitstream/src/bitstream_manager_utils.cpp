@@ -10,6 +10,9 @@
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_thread_pool.h"
+
 #include "bitstream_manager_utils.h"
 
 /* begin namespace openfpga */
@@ -71,5 +74,108 @@ size_t find_bitstream_manager_config_bit_index_in_parent_block(const BitstreamMa
   return curr_index;
 }
 
+/********************************************************************
+ * Find a block by its hierarchy path, e.g., fpga_top.grid_clb_1__1_,
+ * where the first name is a top-level block
+ * Return an invalid id if the block is not found
+ *******************************************************************/
+ConfigBlockId find_bitstream_manager_block_by_path(const BitstreamManager& bitstream_manager,
+                                                   const std::string& block_path) {
+  ConfigBlockId curr_block = ConfigBlockId::INVALID();
+  size_t name_begin = 0;
+  while (name_begin <= block_path.size()) {
+    size_t name_end = block_path.find('.', name_begin);
+    if (std::string::npos == name_end) {
+      name_end = block_path.size();
+    }
+    std::string block_name = block_path.substr(name_begin, name_end - name_begin);
+
+    if (ConfigBlockId::INVALID() == curr_block) {
+      for (const ConfigBlockId& top_block : find_bitstream_manager_top_blocks(bitstream_manager)) {
+        if (block_name == bitstream_manager.block_name(top_block)) {
+          curr_block = top_block;
+          break;
+        }
+      }
+    } else {
+      curr_block = bitstream_manager.find_child_block(curr_block, block_name);
+    }
+    if (false == bitstream_manager.valid_block_id(curr_block)) {
+      return ConfigBlockId::INVALID();
+    }
+    name_begin = name_end + 1;
+  }
+
+  return curr_block;
+}
+
+/********************************************************************
+ * Check if two block trees, which may come from different bitstream managers,
+ * have the same hierarchy, i.e., the same block names, 
+ * the same number of bits in each block and the same child blocks
+ *******************************************************************/
+bool bitstream_manager_block_trees_match(const BitstreamManager& bitstream_manager,
+                                         const ConfigBlockId& block,
+                                         const BitstreamManager& other_bitstream_manager,
+                                         const ConfigBlockId& other_block) {
+  if ( (bitstream_manager.block_name(block) != other_bitstream_manager.block_name(other_block))
+    || (bitstream_manager.block_bits(block).size() != other_bitstream_manager.block_bits(other_block).size()) ) {
+    return false;
+  }
+
+  std::vector<ConfigBlockId> child_blocks = bitstream_manager.block_children(block);
+  std::vector<ConfigBlockId> other_child_blocks = other_bitstream_manager.block_children(other_block);
+  if (child_blocks.size() != other_child_blocks.size()) {
+    return false;
+  }
+  for (size_t ichild = 0; ichild < child_blocks.size(); ++ichild) {
+    if (false == bitstream_manager_block_trees_match(bitstream_manager, child_blocks[ichild],
+                                                     other_bitstream_manager, other_child_blocks[ichild])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/********************************************************************
+ * Build a number of independent child blocks under a parent block,
+ * e.g., one for each tile of a FPGA fabric.
+ * Each task adds its blocks (and their bits) under the parent block
+ * passed to the builder function.
+ *
+ * When the thread pool has multiple threads, each task is built in a private 
+ * bitstream manager, which is then appended to the bitstream manager 
+ * in the order of task index.
+ * As a result, block and bit ids are the same as a single-thread run.
+ *
+ * Note: the builder function must be thread-safe, i.e., it should only
+ * read shared data structures 
+ *******************************************************************/
+void build_bitstream_manager_child_blocks(BitstreamManager& bitstream_manager,
+                                          const ConfigBlockId& parent_block,
+                                          const size_t& num_tasks,
+                                          const ThreadPool& thread_pool,
+                                          const BitstreamBlockBuilder& build_task) {
+  if (1 >= thread_pool.num_threads()) {
+    for (size_t itask = 0; itask < num_tasks; ++itask) {
+      build_task(bitstream_manager, parent_block, itask);
+    }
+    return;
+  }
+
+  std::vector<BitstreamManager> task_managers(num_tasks);
+  thread_pool.parallel_for(num_tasks, [&](const size_t& itask) {
+    BitstreamManager& task_manager = task_managers[itask];
+    ConfigBlockId task_root = task_manager.add_block(bitstream_manager.block_name(parent_block));
+    build_task(task_manager, task_root, itask);
+  });
+
+  for (size_t itask = 0; itask < num_tasks; ++itask) {
+    bitstream_manager.add_child_blocks_from(parent_block, task_managers[itask], ConfigBlockId(0));
+    /* Release memory as soon as possible */
+    task_managers[itask] = BitstreamManager();
+  }
+}
 
 } /* end namespace openfpga */
@@ -4,8 +4,11 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <functional>
+#include <string>
 #include <vector>
 #include "bitstream_manager.h"
+#include "openfpga_thread_pool.h"
 
 /********************************************************************
  * Function declaration
@@ -22,6 +25,22 @@ std::vector<ConfigBlockId> find_bitstream_manager_top_blocks(const BitstreamMana
 size_t find_bitstream_manager_config_bit_index_in_parent_block(const BitstreamManager& bitstream_manager,
                                                                const ConfigBitId& bit_id);
 
+ConfigBlockId find_bitstream_manager_block_by_path(const BitstreamManager& bitstream_manager,
+                                                   const std::string& block_path);
+
+bool bitstream_manager_block_trees_match(const BitstreamManager& bitstream_manager,
+                                         const ConfigBlockId& block,
+                                         const BitstreamManager& other_bitstream_manager,
+                                         const ConfigBlockId& other_block);
+
+typedef std::function<void(BitstreamManager&, const ConfigBlockId&, const size_t&)> BitstreamBlockBuilder;
+
+void build_bitstream_manager_child_blocks(BitstreamManager& bitstream_manager,
+                                          const ConfigBlockId& parent_block,
+                                          const size_t& num_tasks,
+                                          const ThreadPool& thread_pool,
+                                          const BitstreamBlockBuilder& build_task);
+
 } /* end namespace openfpga */
 
 #endif
@@ -2,20 +2,37 @@
  * This file includes the top-level function of this library
  * which reads an XML of a fabric key to the associated
  * data structures
+ *
+ * The XML file is mapped to memory and scanned tag by tag,
+ * so that the bitstream blocks and bits are built without
+ * loading the whole XML tree, which can be huge for large fabrics.
+ * An index of the byte offsets of bitstream blocks can be written
+ * to a binary sidecar file, through which a block can be read
+ * by its hierarchy path without scanning the whole XML file.
+ * The index records the size and modification time of the XML file
+ * and a hash of each block, so that an outdated index is rejected.
  *******************************************************************/
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <string>
+#include <utility>
+#include <vector>
 
-/* Headers from pugi XML library */
-#include "pugixml.hpp"
-#include "pugixml_util.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 /* Headers from vtr util library */
 #include "vtr_assert.h"
+#include "vtr_log.h"
 #include "vtr_time.h"
 
 /* Headers from libarchfpga */
 #include "arch_error.h"
-#include "read_xml_util.h"
 
 #include "openfpga_reserved_words.h"
 
@@ -24,117 +41,524 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Magic string and version at the head of an index file */
+constexpr const char* ARCH_BITSTREAM_INDEX_MAGIC = "OFBITIDX";
+constexpr uint64_t ARCH_BITSTREAM_INDEX_VERSION = 2;
+
+/* Number of uint64 in the header (after the magic string) and in a record of an index file */
+constexpr size_t ARCH_BITSTREAM_INDEX_HEADER_SIZE = 5;
+constexpr size_t ARCH_BITSTREAM_INDEX_RECORD_SIZE = 5;
+
+/* Separator between block names in a hierarchy path */
+constexpr const char* ARCH_BITSTREAM_PATH_SEPARATOR = ".";
+
 /********************************************************************
- * Parse XML codes of a <bitstream_block> to an object of BitstreamManager
- * This function goes recursively until we reach the leaf node
+ * A read-only memory mapping of a file, which is unmapped when destroyed
  *******************************************************************/
-static 
-void rec_read_xml_bitstream_block(pugi::xml_node& xml_bitstream_block,
-                                  const pugiutil::loc_data& loc_data,
-                                  BitstreamManager& bitstream_manager,
-                                  const ConfigBlockId& parent_block) {
-
-  /* Find the name of this bitstream block */
-  const std::string& block_name = get_attribute(xml_bitstream_block, "name", loc_data).as_string();
-
-  /* Create the bitstream block */
-  ConfigBlockId curr_block = bitstream_manager.add_block(block_name);
-
-  /* Add it to parent block */
-  bitstream_manager.add_child_block(parent_block, curr_block);
-
-  /* Parse input nets if defined */
-  pugi::xml_node xml_input_nets = get_single_child(xml_bitstream_block, "input_nets", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_input_nets) {
-    std::vector<std::string> input_nets;
-    size_t num_input_nets = count_children(xml_input_nets, "path", loc_data, pugiutil::ReqOpt::OPTIONAL);
-    input_nets.resize(num_input_nets);
-
-    /* Find the child paths/nets */
-    for (pugi::xml_node xml_input_net : xml_input_nets.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_input_net.name() != std::string("path")) {
-        bad_tag(xml_input_net, loc_data, xml_input_nets, {"path"});
-      }
-      const int& id = get_attribute(xml_input_net, "id", loc_data).as_int();
-      const std::string& net_name = get_attribute(xml_input_net, "net_name", loc_data).as_string();
-      VTR_ASSERT((size_t)id < input_nets.size());
-      input_nets[id] = net_name; 
-    } 
-
-    std::string input_nets_str;
-    bool need_splitter = false;
-    for (const std::string& input_net : input_nets) {
-      if (true == need_splitter) {
-        input_nets_str += std::string(" ");
-      }
-      input_nets_str += input_net;
-      need_splitter = true;
-    }
-    bitstream_manager.add_input_net_id_to_block(curr_block, input_nets_str); 
+class MappedFile {
+  public: /* Constructor and destructor */
+    MappedFile(const char* fname) {
+      data_ = nullptr;
+      size_ = 0;
+
+      int fd = open(fname, O_RDONLY);
+      if (-1 == fd) {
+        archfpga_throw(fname, 0, "Fail to open file!\n");
+      }
+      struct stat file_stat;
+      if (-1 == fstat(fd, &file_stat)) {
+        close(fd);
+        archfpga_throw(fname, 0, "Fail to get the size of file!\n");
+      }
+      size_ = file_stat.st_size;
+      mtime_sec_ = file_stat.st_mtim.tv_sec;
+      mtime_nsec_ = file_stat.st_mtim.tv_nsec;
+      /* An empty file cannot be mapped */
+      if (0 < size_) {
+        void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED == addr) {
+          close(fd);
+          archfpga_throw(fname, 0, "Fail to map file to memory!\n");
+        }
+        data_ = static_cast<const char*>(addr);
+        /* The file is accessed in sequence except when an index is used */
+        madvise(addr, size_, MADV_SEQUENTIAL);
+      }
+      close(fd);
+    }
+    ~MappedFile() {
+      if (nullptr != data_) {
+        munmap(const_cast<char*>(data_), size_);
+      }
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+  public: /* Public accessors */
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    /* Modification time of the file, in seconds and nanoseconds */
+    uint64_t mtime_sec() const { return mtime_sec_; }
+    uint64_t mtime_nsec() const { return mtime_nsec_; }
+  private: /* Internal data */
+    const char* data_;
+    size_t size_;
+    uint64_t mtime_sec_;
+    uint64_t mtime_nsec_;
+};
+
+/********************************************************************
+ * 64-bit FNV-1a hash of a range of bytes, which is used to check
+ * that a block indexed in a file is not changed
+ *******************************************************************/
+static
+uint64_t hash_arch_bitstream_bytes(const char* begin, const char* end) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char* c = begin; c < end; ++c) {
+    hash ^= static_cast<unsigned char>(*c);
+    hash *= 1099511628211ULL;
   }
+  return hash;
+}
+
+/********************************************************************
+ * Types of XML tags found by the scanner
+ *******************************************************************/
+enum e_xml_tag_type {
+  XML_TAG_START, /* <name ...> */
+  XML_TAG_END,   /* </name> */
+  XML_TAG_EMPTY  /* <name .../> */
+};
+
+/********************************************************************
+ * An XML tag found by the scanner
+ *******************************************************************/
+struct t_xml_tag {
+  e_xml_tag_type type;
+  std::string name;
+  std::vector<std::pair<std::string, std::string>> attributes;
+  size_t begin; /* Offset of the '<' of the tag in the file */
+  size_t end;   /* Offset next to the '>' of the tag in the file */
+};
 
-  /* Parse output nets if defined */
-  pugi::xml_node xml_output_nets = get_single_child(xml_bitstream_block, "output_nets", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_output_nets) {
-    std::vector<std::string> output_nets;
-    size_t num_output_nets = count_children(xml_output_nets, "path", loc_data, pugiutil::ReqOpt::OPTIONAL);
-    output_nets.resize(num_output_nets);
-
-    /* Find the child paths/nets */
-    for (pugi::xml_node xml_output_net : xml_output_nets.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_output_net.name() != std::string("path")) {
-        bad_tag(xml_output_net, loc_data, xml_output_nets, {"path"});
-      }
-      const int& id = get_attribute(xml_output_net, "id", loc_data).as_int();
-      const std::string& net_name = get_attribute(xml_output_net, "net_name", loc_data).as_string();
-      VTR_ASSERT((size_t)id < output_nets.size());
-      output_nets[id] = net_name; 
-    } 
-
-    std::string output_nets_str;
-    bool need_splitter = false;
-    for (const std::string& output_net : output_nets) {
-      if (true == need_splitter) {
-        output_nets_str += std::string(" ");
-      }
-      output_nets_str += output_net;
-      need_splitter = true;
-    }
-    bitstream_manager.add_output_net_id_to_block(curr_block, output_nets_str); 
+/********************************************************************
+ * Decode the predefined and numeric character references
+ * in an attribute value
+ *******************************************************************/
+static
+std::string decode_xml_entities(const char* begin, const char* end) {
+  std::string decoded;
+  decoded.reserve(end - begin);
+  for (const char* c = begin; c < end; ++c) {
+    if ('&' != *c) {
+      decoded.push_back(*c);
+      continue;
+    }
+    const char* semicolon = std::find(c, end, ';');
+    std::string entity(c + 1, semicolon);
+    if (std::string("lt") == entity) {
+      decoded.push_back('<');
+    } else if (std::string("gt") == entity) {
+      decoded.push_back('>');
+    } else if (std::string("amp") == entity) {
+      decoded.push_back('&');
+    } else if (std::string("quot") == entity) {
+      decoded.push_back('"');
+    } else if (std::string("apos") == entity) {
+      decoded.push_back('\'');
+    } else if ( (1 < entity.size()) && ('#' == entity[0]) ) {
+      if ('x' == entity[1]) {
+        decoded.push_back((char)std::strtol(entity.c_str() + 2, nullptr, 16));
+      } else {
+        decoded.push_back((char)std::strtol(entity.c_str() + 1, nullptr, 10));
+      }
+    } else {
+      /* Not a reference, keep as it is */
+      decoded.push_back(*c);
+      continue;
+    }
+    c = semicolon;
   }
+  return decoded;
+}
 
-  /* Parse configuration bits */
-  pugi::xml_node xml_bitstream = get_single_child(xml_bitstream_block, "bitstream", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_bitstream) {
-    /* Parse path_id: -2 is an invalid value defined in the bitstream manager internally */
-    const int& path_id = get_attribute(xml_bitstream, "path_id", loc_data, pugiutil::ReqOpt::OPTIONAL).as_int(-2);
-    if (-2 < path_id) {
-      bitstream_manager.add_path_id_to_block(curr_block, path_id); 
+/********************************************************************
+ * A scanner which finds the XML tags in a range of a file in sequence.
+ * Text between tags, comments, declarations and processing instructions
+ * are skipped.
+ * The scanner checks that the start and end tags are balanced
+ *******************************************************************/
+class XmlTagScanner {
+  public: /* Constructor */
+    XmlTagScanner(const char* fname,
+                  const char* data,
+                  const size_t& begin,
+                  const size_t& end) {
+      fname_ = fname;
+      data_ = data;
+      pos_ = begin;
+      end_ = end;
     }
+  public: /* Public accessors */
+    const char* fname() const { return fname_; }
+    /* Number of start tags which are not yet closed */
+    size_t depth() const { return open_tags_.size(); }
+    /* Line number of an offset in the file, which is only counted
+     * when reporting errors, so that the part of file before the range
+     * is not accessed otherwise
+     */
+    int line(const size_t& offset) const {
+      return 1 + std::count(data_, data_ + offset, '\n');
+    }
+  public: /* Public mutators */
+    /* Find the next tag. Return false if there is no more tag in the range */
+    bool next_tag(t_xml_tag& tag) {
+      while (true) {
+        const char* lt = static_cast<const char*>(std::memchr(data_ + pos_, '<', end_ - pos_));
+        if (nullptr == lt) {
+          pos_ = end_;
+          if (false == open_tags_.empty()) {
+            archfpga_throw(fname_, line(pos_),
+                           "Missing end tag for XML node '%s'!\n",
+                           open_tags_.back().c_str());
+          }
+          return false;
+        }
+        pos_ = lt - data_;
+
+        /* Skip comments, declarations and processing instructions */
+        if (0 == compare_at(pos_, "<!--")) {
+          skip_to(pos_ + 4, "-->");
+          continue;
+        }
+        if ( (0 == compare_at(pos_, "<?"))
+          || (0 == compare_at(pos_, "<!")) ) {
+          skip_to(pos_ + 2, ">");
+          continue;
+        }
+        break;
+      }
 
-    /* Find the child paths/nets */
-    std::vector<bool> block_bits;
-    for (pugi::xml_node xml_bit : xml_bitstream.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_bit.name() != std::string("bit")) {
-        bad_tag(xml_bit, loc_data, xml_bitstream, {"bit"});
+      tag.begin = pos_;
+      tag.attributes.clear();
+
+      size_t cur = pos_ + 1;
+      tag.type = XML_TAG_START;
+      if ( (cur < end_) && ('/' == data_[cur]) ) {
+        tag.type = XML_TAG_END;
+        ++cur;
+      }
+
+      /* Tag name */
+      size_t name_begin = cur;
+      while ( (cur < end_) && (false == is_space(data_[cur]))
+           && ('>' != data_[cur]) && ('/' != data_[cur]) ) {
+        ++cur;
+      }
+      tag.name.assign(data_ + name_begin, cur - name_begin);
+      if (true == tag.name.empty()) {
+        archfpga_throw(fname_, line(tag.begin), "Invalid XML tag!\n");
       }
-      const int& bit_value = get_attribute(xml_bit, "value", loc_data).as_int();
+
+      /* Attributes */
+      while (true) {
+        while ( (cur < end_) && (true == is_space(data_[cur])) ) {
+          ++cur;
+        }
+        if (cur >= end_) {
+          archfpga_throw(fname_, line(tag.begin), "Unterminated XML node '%s'!\n", tag.name.c_str());
+        }
+        if ('>' == data_[cur]) {
+          ++cur;
+          break;
+        }
+        if ( ('/' == data_[cur]) && (cur + 1 < end_) && ('>' == data_[cur + 1]) ) {
+          if (XML_TAG_END == tag.type) {
+            archfpga_throw(fname_, line(tag.begin), "Invalid end tag of XML node '%s'!\n", tag.name.c_str());
+          }
+          tag.type = XML_TAG_EMPTY;
+          cur += 2;
+          break;
+        }
+
+        size_t attr_name_begin = cur;
+        while ( (cur < end_) && ('=' != data_[cur])
+             && (false == is_space(data_[cur])) && ('>' != data_[cur]) ) {
+          ++cur;
+        }
+        size_t attr_name_end = cur;
+        while ( (cur < end_) && (true == is_space(data_[cur])) ) {
+          ++cur;
+        }
+        if ( (cur >= end_) || ('=' != data_[cur]) ) {
+          archfpga_throw(fname_, line(tag.begin), "Invalid attribute in XML node '%s'!\n", tag.name.c_str());
+        }
+        ++cur;
+        while ( (cur < end_) && (true == is_space(data_[cur])) ) {
+          ++cur;
+        }
+        if ( (cur >= end_) || ( ('"' != data_[cur]) && ('\'' != data_[cur]) ) ) {
+          archfpga_throw(fname_, line(tag.begin), "Attribute value should be quoted in XML node '%s'!\n", tag.name.c_str());
+        }
+        char quote = data_[cur];
+        size_t value_begin = ++cur;
+        const char* value_end = static_cast<const char*>(std::memchr(data_ + cur, quote, end_ - cur));
+        if (nullptr == value_end) {
+          archfpga_throw(fname_, line(tag.begin), "Unterminated attribute value in XML node '%s'!\n", tag.name.c_str());
+        }
+        cur = value_end - data_ + 1;
+
+        std::string value;
+        if (nullptr == std::memchr(data_ + value_begin, '&', value_end - (data_ + value_begin))) {
+          value.assign(data_ + value_begin, value_end);
+        } else {
+          value = decode_xml_entities(data_ + value_begin, value_end);
+        }
+        tag.attributes.emplace_back(std::string(data_ + attr_name_begin, attr_name_end - attr_name_begin), value);
+      }
+      pos_ = cur;
+      tag.end = cur;
+
+      /* Check the balance of tags */
+      if (XML_TAG_START == tag.type) {
+        open_tags_.push_back(tag.name);
+      } else if (XML_TAG_END == tag.type) {
+        if ( (true == open_tags_.empty())
+          || (open_tags_.back() != tag.name) ) {
+          archfpga_throw(fname_, line(tag.begin), "Unexpected end tag of XML node '%s'!\n", tag.name.c_str());
+        }
+        open_tags_.pop_back();
+      }
+
+      return true;
+    }
+  private: /* Internal helpers */
+    static bool is_space(const char& c) {
+      return (' ' == c) || ('\t' == c) || ('\n' == c) || ('\r' == c);
+    }
+    int compare_at(const size_t& pos, const char* str) const {
+      size_t len = std::strlen(str);
+      if (pos + len > end_) {
+        return 1;
+      }
+      return std::strncmp(data_ + pos, str, len);
+    }
+    /* Move the position next to the given string */
+    void skip_to(const size_t& from, const char* str) {
+      const char* found = std::search(data_ + from, data_ + end_, str, str + std::strlen(str));
+      if (data_ + end_ == found) {
+        archfpga_throw(fname_, line(pos_), "Unterminated XML comment or declaration!\n");
+      }
+      pos_ = found - data_ + std::strlen(str);
+    }
+  private: /* Internal data */
+    const char* fname_;
+    const char* data_;
+    size_t pos_;
+    size_t end_;
+    std::vector<std::string> open_tags_;
+};
+
+/********************************************************************
+ * Find the value of an attribute of a tag
+ * Error out if a mandatory attribute is not found
+ *******************************************************************/
+static
+const std::string* find_xml_tag_attribute(const XmlTagScanner& scanner,
+                                          const t_xml_tag& tag,
+                                          const char* attribute_name,
+                                          const bool& required) {
+  for (const std::pair<std::string, std::string>& attribute : tag.attributes) {
+    if (attribute.first == attribute_name) {
+      return &attribute.second;
+    }
+  }
+  if (true == required) {
+    archfpga_throw(scanner.fname(), scanner.line(tag.begin),
+                   "Expected attribute '%s' in XML node '%s'!\n",
+                   attribute_name, tag.name.c_str());
+  }
+  return nullptr;
+}
+
+/********************************************************************
+ * Join the names of nets with spaces, as stored in the bitstream manager
+ *******************************************************************/
+static
+std::string join_bitstream_block_net_names(const std::vector<std::string>& nets) {
+  std::string nets_str;
+  bool need_splitter = false;
+  for (const std::string& net : nets) {
+    if (true == need_splitter) {
+      nets_str += std::string(" ");
+    }
+    nets_str += net;
+    need_splitter = true;
+  }
+  return nets_str;
+}
+
+/********************************************************************
+ * Parse the XML codes of <bitstream_block> found by a scanner
+ * to an object of BitstreamManager
+ * The first <bitstream_block> is the top block of the bitstream manager,
+ * which should be the top-level module of FPGA fabric if required.
+ * Configuration bits are added in the sequence of the XML file.
+ *******************************************************************/
+static
+void read_xml_bitstream_blocks(XmlTagScanner& scanner,
+                               BitstreamManager& bitstream_manager,
+                               const bool& check_top_block) {
+  /* Blocks which are not yet closed */
+  std::vector<ConfigBlockId> block_stack;
+
+  /* The node under a <bitstream_block> which is being parsed */
+  enum e_block_node {
+    BLOCK_NODE_NONE,
+    BLOCK_NODE_INPUT_NETS,
+    BLOCK_NODE_OUTPUT_NETS,
+    BLOCK_NODE_BITSTREAM
+  };
+  e_block_node curr_node = BLOCK_NODE_NONE;
+  size_t curr_node_depth = 0;
+  std::vector<std::string> nets;
+  std::vector<bool> block_bits;
+  bool found_top_block = false;
+
+  t_xml_tag tag;
+  while (true == scanner.next_tag(tag)) {
+    if (XML_TAG_END == tag.type) {
+      if (std::string("bitstream_block") == tag.name) {
+        block_stack.pop_back();
+        if (true == block_stack.empty()) {
+          break;
+        }
+      } else if ( (BLOCK_NODE_NONE != curr_node) && (curr_node_depth == scanner.depth()) ) {
+        if (BLOCK_NODE_INPUT_NETS == curr_node) {
+          bitstream_manager.add_input_net_id_to_block(block_stack.back(), join_bitstream_block_net_names(nets));
+        } else if (BLOCK_NODE_OUTPUT_NETS == curr_node) {
+          bitstream_manager.add_output_net_id_to_block(block_stack.back(), join_bitstream_block_net_names(nets));
+        } else {
+          VTR_ASSERT(BLOCK_NODE_BITSTREAM == curr_node);
+          bitstream_manager.add_block_bits(block_stack.back(), block_bits);
+        }
+        curr_node = BLOCK_NODE_NONE;
+      }
+      continue;
+    }
+
+    /* Parse the children of <input_nets> and <output_nets> */
+    if ( (BLOCK_NODE_INPUT_NETS == curr_node) || (BLOCK_NODE_OUTPUT_NETS == curr_node) ) {
+      if (std::string("path") != tag.name) {
+        archfpga_throw(scanner.fname(), scanner.line(tag.begin),
+                       "Unexpected XML node '%s' (expected 'path')!\n",
+                       tag.name.c_str());
+      }
+      const std::string& id_str = *find_xml_tag_attribute(scanner, tag, "id", true);
+      const std::string& net_name = *find_xml_tag_attribute(scanner, tag, "net_name", true);
+      char* id_end = nullptr;
+      const long id = std::strtol(id_str.c_str(), &id_end, 10);
+      if ( (true == id_str.empty()) || ('\0' != *id_end) || (0 > id) ) {
+        archfpga_throw(scanner.fname(), scanner.line(tag.begin),
+                       "Invalid id '%s' of XML node 'path' (expected a non-negative integer)!\n",
+                       id_str.c_str());
+      }
+      if ((size_t)id >= nets.size()) {
+        nets.resize(id + 1);
+      }
+      nets[id] = net_name;
+      continue;
+    }
+
+    /* Parse the children of <bitstream> */
+    if (BLOCK_NODE_BITSTREAM == curr_node) {
+      if (std::string("bit") != tag.name) {
+        archfpga_throw(scanner.fname(), scanner.line(tag.begin),
+                       "Unexpected XML node '%s' (expected 'bit')!\n",
+                       tag.name.c_str());
+      }
+      const int bit_value = std::atoi(find_xml_tag_attribute(scanner, tag, "value", true)->c_str());
       block_bits.push_back(1 == bit_value);
+      continue;
+    }
+
+    if (std::string("bitstream_block") == tag.name) {
+      /* Find the name of this bitstream block */
+      const std::string& block_name = *find_xml_tag_attribute(scanner, tag, "name", true);
+
+      if ( (false == found_top_block)
+        && (true == check_top_block)
+        && (block_name != std::string(FPGA_TOP_MODULE_NAME)) ) {
+        archfpga_throw(scanner.fname(), scanner.line(tag.begin),
+                       "Top-level block must be named as '%s'!\n",
+                       FPGA_TOP_MODULE_NAME);
+      }
+
+      /* Create the bitstream block and add it to parent block */
+      ConfigBlockId curr_block = bitstream_manager.add_block(block_name);
+      if (false == block_stack.empty()) {
+        bitstream_manager.add_child_block(block_stack.back(), curr_block);
+      }
+      found_top_block = true;
+
+      if (XML_TAG_START == tag.type) {
+        block_stack.push_back(curr_block);
+      } else if (true == block_stack.empty()) {
+        /* An empty top block */
+        break;
+      }
+      continue;
+    }
+
+    if (true == block_stack.empty()) {
+      archfpga_throw(scanner.fname(), scanner.line(tag.begin),
+                     "Unexpected XML node '%s' (expected 'bitstream_block')!\n",
+                     tag.name.c_str());
+    }
+
+    /* Only <bitstream_block> can be the child of the top block */
+    if ( (true == check_top_block) && (1 == block_stack.size()) ) {
+      archfpga_throw(scanner.fname(), scanner.line(tag.begin),
+                     "Unexpected XML node '%s' (expected 'bitstream_block')!\n",
+                     tag.name.c_str());
+    }
+
+    if ( (std::string("input_nets") == tag.name)
+      || (std::string("output_nets") == tag.name) ) {
+      nets.clear();
+      curr_node = (std::string("input_nets") == tag.name) ? BLOCK_NODE_INPUT_NETS : BLOCK_NODE_OUTPUT_NETS;
+    } else if (std::string("bitstream") == tag.name) {
+      /* Parse path_id: -2 is an invalid value defined in the bitstream manager internally */
+      const std::string* path_id = find_xml_tag_attribute(scanner, tag, "path_id", false);
+      if ( (nullptr != path_id) && (-2 < std::atoi(path_id->c_str())) ) {
+        bitstream_manager.add_path_id_to_block(block_stack.back(), std::atoi(path_id->c_str()));
+      }
+      block_bits.clear();
+      curr_node = BLOCK_NODE_BITSTREAM;
+    } else {
+      /* Other nodes, e.g., <hierarchy>, are not stored in the bitstream manager */
+      continue;
+    }
+
+    /* Nodes without children are finished here */
+    curr_node_depth = scanner.depth();
+    if (XML_TAG_EMPTY == tag.type) {
+      if (BLOCK_NODE_INPUT_NETS == curr_node) {
+        bitstream_manager.add_input_net_id_to_block(block_stack.back(), std::string());
+      } else if (BLOCK_NODE_OUTPUT_NETS == curr_node) {
+        bitstream_manager.add_output_net_id_to_block(block_stack.back(), std::string());
+      } else {
+        bitstream_manager.add_block_bits(block_stack.back(), block_bits);
+      }
+      curr_node = BLOCK_NODE_NONE;
+    } else {
+      /* The depth when the node is closed */
+      curr_node_depth--;
     }
-    /* Link the bit to parent block */
-    bitstream_manager.add_block_bits(curr_block, block_bits);
   }
-  
-  /* Go recursively: find all the child blocks and parse */
-  for (pugi::xml_node xml_child : xml_bitstream_block.children()) {
-    /* We only care child bitstream blocks here */
-    if (xml_child.name() == std::string("bitstream_block")) {
-      rec_read_xml_bitstream_block(xml_child, loc_data, bitstream_manager, curr_block);
-    }
-  } 
+
+  if (false == found_top_block) {
+    archfpga_throw(scanner.fname(), 0, "Expected XML node 'bitstream_block'!\n");
+  }
 }
 
 /********************************************************************
@@ -146,51 +570,221 @@ BitstreamManager read_xml_architecture_bitstream(const char* fname) {
 
   BitstreamManager bitstream_manager;
 
-  /* Parse the file */
-  pugi::xml_document doc;
-  pugiutil::loc_data loc_data;
+  MappedFile xml_file(fname);
+  XmlTagScanner scanner(fname, xml_file.data(), 0, xml_file.size());
+  read_xml_bitstream_blocks(scanner, bitstream_manager, true);
 
-  try {
-    loc_data = pugiutil::load_xml(doc, fname);
+  return bitstream_manager;
+}
 
-    /* Count the child <bitstream_block> */
+/********************************************************************
+ * Write an index of the bitstream blocks in an XML file to a binary file.
+ * The index includes the hierarchy path, e.g., fpga_top.grid_clb_1_1,
+ * and the range of byte offsets in the XML file of each block.
+ *
+ * The index file is organized as follows, in native byte order:
+ *   - Header: magic string (8 bytes), version, size of the XML file,
+ *             modification time of the XML file in seconds and nanoseconds
+ *             and the number of blocks (uint64 each)
+ *   - Records: one per block, sorted by the hierarchy path
+ *              offset and length of the path in the string pool,
+ *              first and last byte offsets of the block 
+ *              and the hash of the bytes of the block (uint64 each)
+ *   - String pool: the hierarchy paths
+ * Since records have the same size, a block can be found by a binary search
+ * on the index file, without loading it.
+ *
+ * Return 0 if successful
+ * Return 1 if fail when creating files
+ *******************************************************************/
+int write_xml_architecture_bitstream_index(const char* fname,
+                                           const char* index_fname) {
+  std::string timer_message = std::string("Write index of architecture bitstream file '") + std::string(fname) + std::string("' to '") + std::string(index_fname) + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  struct t_block_record {
+    std::string path;
+    uint64_t begin;
+    uint64_t end;
+  };
+  std::vector<t_block_record> records;
+
+  {
+    MappedFile xml_file(fname);
+    XmlTagScanner scanner(fname, xml_file.data(), 0, xml_file.size());
+
+    /* Records of blocks which are not yet closed */
+    std::vector<size_t> block_stack;
+    t_xml_tag tag;
+    while (true == scanner.next_tag(tag)) {
+      if (std::string("bitstream_block") != tag.name) {
+        continue;
+      }
+      if (XML_TAG_END == tag.type) {
+        records[block_stack.back()].end = tag.end;
+        block_stack.pop_back();
+        continue;
+      }
+      t_block_record record;
+      if (false == block_stack.empty()) {
+        record.path = records[block_stack.back()].path + std::string(ARCH_BITSTREAM_PATH_SEPARATOR);
+      }
+      record.path += *find_xml_tag_attribute(scanner, tag, "name", true);
+      record.begin = tag.begin;
+      record.end = tag.end;
+      records.push_back(record);
+      if (XML_TAG_START == tag.type) {
+        block_stack.push_back(records.size() - 1);
+      }
+    }
 
-    pugi::xml_node xml_root = get_single_child(doc, "bitstream_block", loc_data);
+    /* Sort the records by path for binary search */
+    std::sort(records.begin(), records.end(),
+              [](const t_block_record& a, const t_block_record& b) { return a.path < b.path; });
 
-    /* Find the name of the top block*/
-    const std::string& top_block_name = get_attribute(xml_root, "name", loc_data).as_string();
-    
-    if (top_block_name != std::string(FPGA_TOP_MODULE_NAME)) {
-      archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_root),
-                     "Top-level block must be named as '%s'!\n",
-                     FPGA_TOP_MODULE_NAME);
+    std::fstream fp;
+    fp.open(index_fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+    if (false == fp.is_open()) {
+      VTR_LOG_ERROR("Fail to create index file '%s'!\n", index_fname);
+      return 1;
     }
 
-    /* Create the top-level block */
-    ConfigBlockId top_block = bitstream_manager.add_block(top_block_name);
+    auto write_uint64 = [&](const uint64_t& value) {
+      fp.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    fp.write(ARCH_BITSTREAM_INDEX_MAGIC, std::strlen(ARCH_BITSTREAM_INDEX_MAGIC));
+    write_uint64(ARCH_BITSTREAM_INDEX_VERSION);
+    write_uint64(xml_file.size());
+    write_uint64(xml_file.mtime_sec());
+    write_uint64(xml_file.mtime_nsec());
+    write_uint64(records.size());
+
+    uint64_t path_offset = 0;
+    for (const t_block_record& record : records) {
+      write_uint64(path_offset);
+      write_uint64(record.path.size());
+      write_uint64(record.begin);
+      write_uint64(record.end);
+      write_uint64(hash_arch_bitstream_bytes(xml_file.data() + record.begin, xml_file.data() + record.end));
+      path_offset += record.path.size();
+    }
+    for (const t_block_record& record : records) {
+      fp.write(record.path.c_str(), record.path.size());
+    }
 
-    size_t num_blks = count_children(xml_root, "bitstream_block", loc_data, pugiutil::ReqOpt::OPTIONAL);
+    fp.close();
+  }
 
-    /* Reserve bitstream blocks in the data base */
-    bitstream_manager.reserve_blocks(num_blks);
+  VTR_LOG("Indexed %lu bitstream blocks\n", records.size());
 
-    /* Iterate over the children under this node,
-     * each child should be named after circuit_model
-     */
-    for (pugi::xml_node xml_blk : xml_root.children()) {
-      /* Error out if the XML child has an invalid name! */
-      if (xml_blk.name() != std::string("bitstream_block")) {
-        bad_tag(xml_blk, loc_data, xml_root, {"bitstream_block"});
-      }
-      rec_read_xml_bitstream_block(xml_blk, loc_data, bitstream_manager, top_block);
-    } 
-  } catch (pugiutil::XmlError& e) {
-    archfpga_throw(fname, e.line(),
-                   "%s", e.what());
+  return 0;
+}
+
+/********************************************************************
+ * Read a bitstream block, including its child blocks, from an XML file
+ * to an object of BitstreamManager, where the block is the top block.
+ * The block is found by its hierarchy path, e.g., fpga_top.grid_clb_1_1,
+ * in the index file created by write_xml_architecture_bitstream_index(),
+ * and only the part of the XML file describing the block is parsed
+ *******************************************************************/
+BitstreamManager read_xml_architecture_bitstream_block(const char* fname,
+                                                       const char* index_fname,
+                                                       const std::string& block_path) {
+  std::string timer_message = std::string("Read block '") + block_path + std::string("' from Architecture Bitstream file");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  MappedFile xml_file(fname);
+  MappedFile index_file(index_fname);
+
+  const size_t magic_size = std::strlen(ARCH_BITSTREAM_INDEX_MAGIC);
+  const size_t header_size = magic_size + ARCH_BITSTREAM_INDEX_HEADER_SIZE * sizeof(uint64_t);
+  const size_t record_size = ARCH_BITSTREAM_INDEX_RECORD_SIZE * sizeof(uint64_t);
+
+  auto read_uint64 = [&](const size_t& offset) {
+    uint64_t value;
+    std::memcpy(&value, index_file.data() + offset, sizeof(value));
+    return value;
+  };
+  auto read_header = [&](const size_t& ifield) {
+    return read_uint64(magic_size + ifield * sizeof(uint64_t));
+  };
+  auto read_record = [&](const size_t& irecord, const size_t& ifield) {
+    return read_uint64(header_size + irecord * record_size + ifield * sizeof(uint64_t));
+  };
+
+  /* Validate the index file */
+  if ( (index_file.size() < header_size)
+    || (0 != std::strncmp(index_file.data(), ARCH_BITSTREAM_INDEX_MAGIC, magic_size))
+    || (ARCH_BITSTREAM_INDEX_VERSION != read_header(0)) ) {
+    archfpga_throw(index_fname, 0, "Invalid index file of architecture bitstream!\n");
+  }
+  if ( (xml_file.size() != read_header(1))
+    || (xml_file.mtime_sec() != read_header(2))
+    || (xml_file.mtime_nsec() != read_header(3)) ) {
+    archfpga_throw(index_fname, 0,
+                   "Index file is outdated for architecture bitstream file '%s'! Please create the index again.\n",
+                   fname);
+  }
+  const uint64_t num_records = read_header(4);
+  if (num_records > (index_file.size() - header_size) / record_size) {
+    archfpga_throw(index_fname, 0, "Invalid index file of architecture bitstream!\n");
+  }
+  const size_t pool_offset = header_size + num_records * record_size;
+  const size_t pool_size = index_file.size() - pool_offset;
+
+  /* Find the path of a record in the string pool */
+  auto read_record_path = [&](const size_t& irecord) {
+    uint64_t path_offset = read_record(irecord, 0);
+    uint64_t path_length = read_record(irecord, 1);
+    if ( (path_offset > pool_size)
+      || (path_length > pool_size - path_offset) ) {
+      archfpga_throw(index_fname, 0, "Invalid index file of architecture bitstream!\n");
+    }
+    return std::string(index_file.data() + pool_offset + path_offset, path_length);
+  };
+
+  /* Binary search on the records sorted by path */
+  size_t lo = 0;
+  size_t hi = num_records;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (read_record_path(mid) < block_path) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  if ( (lo == num_records)
+    || (block_path != read_record_path(lo)) ) {
+    archfpga_throw(index_fname, 0,
+                   "Bitstream block '%s' is not found!\n",
+                   block_path.c_str());
   }
 
-  return bitstream_manager; 
+  uint64_t block_begin = read_record(lo, 2);
+  uint64_t block_end = read_record(lo, 3);
+  if ( (block_begin >= block_end) || (block_end > xml_file.size()) ) {
+    archfpga_throw(index_fname, 0,
+                   "Invalid range of bitstream block '%s' in index file!\n",
+                   block_path.c_str());
+  }
+  /* The content of the block should be the same as when it was indexed */
+  if (read_record(lo, 4) != hash_arch_bitstream_bytes(xml_file.data() + block_begin, xml_file.data() + block_end)) {
+    archfpga_throw(index_fname, 0,
+                   "Index file is outdated for bitstream block '%s' in architecture bitstream file '%s'! Please create the index again.\n",
+                   block_path.c_str(), fname);
+  }
+
+  /* Only the block is accessed */
+  madvise(const_cast<char*>(xml_file.data()), xml_file.size(), MADV_RANDOM);
+
+  BitstreamManager bitstream_manager;
+  XmlTagScanner scanner(fname, xml_file.data(), block_begin, block_end);
+  read_xml_bitstream_blocks(scanner, bitstream_manager, false);
+
+  return bitstream_manager;
 }
 
 } /* end namespace openfpga */
-
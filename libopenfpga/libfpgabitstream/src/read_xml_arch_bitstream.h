@@ -4,8 +4,7 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
-#include "pugixml_util.hpp"
-#include "pugixml.hpp"
+#include <string>
 #include "bitstream_manager.h"
 
 /********************************************************************
@@ -16,6 +15,13 @@ namespace openfpga {
 
 BitstreamManager read_xml_architecture_bitstream(const char* fname);
 
+int write_xml_architecture_bitstream_index(const char* fname,
+                                           const char* index_fname);
+
+BitstreamManager read_xml_architecture_bitstream_block(const char* fname,
+                                                       const char* index_fname,
+                                                       const std::string& block_path);
+
 } /* end namespace openfpga */
 
 #endif
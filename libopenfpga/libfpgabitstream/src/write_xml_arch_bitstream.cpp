@@ -30,14 +30,11 @@ static
 void write_bitstream_xml_file_head(std::fstream& fp) {
   valid_file_stream(fp);
  
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
-
   fp << "<!--" << std::endl;
   fp << "\t- Architecture independent bitstream" << std::endl;
   fp << "\t- Author: Xifan TANG" << std::endl;
   fp << "\t- Organization: University of Utah" << std::endl;
-  fp << "\t- Date: " << std::ctime(&end_time) ;
+  fp << "\t- Date: " << get_current_date_string() ;
   fp << "-->" << std::endl;
   fp << std::endl;
 }
@@ -0,0 +1,284 @@
+/*********************************************************************
+ * This file includes functions to measure the runtime and memory usage
+ * of commands executed by the shell and output them to a report
+ ********************************************************************/
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_rusage.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "command_profile.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/* Profilers which are not finished, protected by a mutex
+ * as they are constructed, finished and fed in different threads
+ */
+static std::mutex f_profilers_mutex;
+static std::vector<CommandProfiler*> f_active_profilers;
+
+/* The profiler which is running in the current thread, if any */
+static thread_local CommandProfiler* f_thread_profiler = nullptr;
+
+/*********************************************************************
+ * Callback for vtr::ScopedActionTimer, which records the finished section
+ * to the profiler running in the same thread. A section finished in 
+ * a thread without profiler, e.g., a worker of a thread pool, is
+ * recorded only when there is a single profiler running, as
+ * it can not be attributed to any profiler otherwise
+ ********************************************************************/
+static
+void record_scoped_timer(const std::string& action,
+                         float elapsed_sec,
+                         float max_rss_mib,
+                         float delta_max_rss_mib) {
+  t_timer_record record;
+  std::chrono::time_point<std::chrono::steady_clock> end = std::chrono::steady_clock::now();
+  record.start = end - std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(elapsed_sec));
+  record.span.name = action;
+  record.span.wall_time = elapsed_sec;
+  record.span.max_rss = max_rss_mib;
+  record.span.delta_max_rss = delta_max_rss_mib;
+
+  std::lock_guard<std::mutex> lock(f_profilers_mutex);
+  CommandProfiler* profiler = f_thread_profiler;
+  if ( (nullptr == profiler) && (1 == f_active_profilers.size()) ) {
+    profiler = f_active_profilers.front();
+  }
+  if (nullptr != profiler) {
+    profiler->add_timer_record(record);
+  }
+}
+
+/*********************************************************************
+ * Build the hierarchy of sections from the records in the order of
+ * their finish time. A section is a child of another section
+ * if it starts after the other section and finishes before it.
+ * Return the sections at the highest level
+ ********************************************************************/
+static
+std::vector<t_profile_span> build_profile_span_hierarchy(const std::vector<t_timer_record>& records) {
+  /* Sections whose parent is not found yet */
+  std::vector<const t_timer_record*> pending_records;
+  std::vector<t_profile_span> pending_spans;
+
+  for (const t_timer_record& record : records) {
+    t_profile_span span = record.span;
+
+    /* All the pending sections which start after the current one are its children */
+    size_t first_child = pending_records.size();
+    while ( (0 < first_child)
+         && (pending_records[first_child - 1]->start >= record.start) ) {
+      --first_child;
+    }
+    span.children.assign(pending_spans.begin() + first_child, pending_spans.end());
+    pending_records.resize(first_child);
+    pending_spans.resize(first_child);
+
+    pending_records.push_back(&record);
+    pending_spans.push_back(span);
+  }
+
+  return pending_spans;
+}
+
+/*********************************************************************
+ * Public constructors
+ ********************************************************************/
+CommandProfiler::CommandProfiler(const std::string& name) {
+  /* Register the callback only once */
+  static std::once_flag observer_flag;
+  std::call_once(observer_flag, []() { vtr::set_scoped_timer_observer(record_scoped_timer); });
+
+  name_ = name;
+  wall_start_ = std::chrono::steady_clock::now();
+  cpu_start_ = std::clock();
+  initial_max_rss_ = vtr::get_max_rss();
+  initial_bytes_written_ = get_process_bytes_written();
+  finished_ = false;
+
+  std::lock_guard<std::mutex> lock(f_profilers_mutex);
+  f_active_profilers.push_back(this);
+  parent_profiler_ = f_thread_profiler;
+  f_thread_profiler = this;
+}
+
+CommandProfiler::~CommandProfiler() {
+  if (false == finished_) {
+    unregister_profiler();
+  }
+}
+
+/*********************************************************************
+ * Public mutators
+ ********************************************************************/
+/* Finish the measurement and return the results */
+t_profile_span CommandProfiler::finish() {
+  VTR_ASSERT(false == finished_);
+
+  t_profile_span span;
+  span.name = name_;
+  span.wall_time = std::chrono::duration<float>(std::chrono::steady_clock::now() - wall_start_).count();
+  span.cpu_time = (float)(std::clock() - cpu_start_) / (float)CLOCKS_PER_SEC;
+  span.max_rss = get_process_max_rss_mib();
+  span.delta_max_rss = (float)(vtr::get_max_rss() - initial_max_rss_) / (1024. * 1024.);
+  span.bytes_written = get_process_bytes_written() - initial_bytes_written_;
+
+  /* No more section can be added after this point */
+  unregister_profiler();
+  finished_ = true;
+
+  span.children = build_profile_span_hierarchy(timer_records_);
+  timer_records_.clear();
+
+  return span;
+}
+
+/* Add a finished section, which is called under the lock of the profilers */
+void CommandProfiler::add_timer_record(const t_timer_record& record) {
+  /* Drop the sections which start before the profiler */
+  if (record.start < wall_start_) {
+    return;
+  }
+  timer_records_.push_back(record);
+}
+
+/*********************************************************************
+ * Internal functions
+ ********************************************************************/
+void CommandProfiler::unregister_profiler() {
+  std::lock_guard<std::mutex> lock(f_profilers_mutex);
+  auto it = std::find(f_active_profilers.begin(), f_active_profilers.end(), this);
+  VTR_ASSERT(it != f_active_profilers.end());
+  f_active_profilers.erase(it);
+  /* A profiler is finished in the thread where it is created */
+  VTR_ASSERT(this == f_thread_profiler);
+  f_thread_profiler = parent_profiler_;
+}
+
+/*********************************************************************
+ * Get the number of bytes written by the process
+ * This relies on the I/O statistics of Linux, and is 0 on other platforms
+ ********************************************************************/
+size_t get_process_bytes_written() {
+  std::ifstream fp("/proc/self/io");
+  std::string key;
+  size_t value;
+  while (fp >> key >> value) {
+    if (std::string("wchar:") == key) {
+      return value;
+    }
+  }
+  return 0;
+}
+
+/*********************************************************************
+ * Get the peak memory resident set size of the process in MiB
+ ********************************************************************/
+float get_process_max_rss_mib() {
+  return (float)vtr::get_max_rss() / (1024. * 1024.);
+}
+
+/*********************************************************************
+ * Escape a string to be a JSON string
+ ********************************************************************/
+static
+std::string escape_json_string(const std::string& str) {
+  std::string escaped;
+  for (const char& c : str) {
+    if ( ('"' == c) || ('\\' == c) ) {
+      escaped.push_back('\\');
+      escaped.push_back(c);
+    } else if ('\t' == c) {
+      escaped += "\\t";
+    } else if ('\n' == c) {
+      escaped += "\\n";
+    } else if (0x20 > (unsigned char)c) {
+      /* Other control characters are not expected in command lines */
+      escaped.push_back(' ');
+    } else {
+      escaped.push_back(c);
+    }
+  }
+  return escaped;
+}
+
+/*********************************************************************
+ * Recursively output a span and its children to a JSON file
+ ********************************************************************/
+static
+void rec_write_profile_span_to_json_file(std::fstream& fp,
+                                         const t_profile_span& span,
+                                         const size_t& depth) {
+  std::string indent(2 * depth, ' ');
+
+  fp << indent << "{\n";
+  fp << indent << "  \"name\": \"" << escape_json_string(span.name) << "\",\n";
+  fp << indent << "  \"wall_time\": " << span.wall_time << ",\n";
+  fp << indent << "  \"cpu_time\": " << span.cpu_time << ",\n";
+  fp << indent << "  \"max_rss\": " << span.max_rss << ",\n";
+  fp << indent << "  \"delta_max_rss\": " << span.delta_max_rss << ",\n";
+  fp << indent << "  \"bytes_written\": " << span.bytes_written << ",\n";
+  fp << indent << "  \"status\": " << span.status << ",\n";
+  fp << indent << "  \"children\": [";
+  for (size_t ichild = 0; ichild < span.children.size(); ++ichild) {
+    fp << (0 == ichild ? "\n" : ",\n");
+    rec_write_profile_span_to_json_file(fp, span.children[ichild], depth + 2);
+  }
+  if (false == span.children.empty()) {
+    fp << "\n" << indent << "  ";
+  }
+  fp << "]\n";
+  fp << indent << "}";
+}
+
+/*********************************************************************
+ * Write the profile of a shell session to a JSON file, e.g.,
+ * {
+ *   "name": "OpenFPGA",
+ *   "wall_time": <float>,
+ *   ...
+ *   "children": [
+ *     {
+ *       "name": "<command_line>",
+ *       ...
+ *       "children": [<sections measured inside the command>]
+ *     }
+ *   ]
+ * }
+ * Time is in seconds while memory is in MiB
+ *
+ * Return 0 if successful
+ * Return 1 if fail when creating files
+ ********************************************************************/
+int write_profile_to_json_file(const t_profile_span& root_span,
+                               const std::string& fname) {
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  if (false == valid_file_stream(fp)) {
+    VTR_LOG_ERROR("Fail to create profile file '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  fp << std::fixed << std::setprecision(6);
+  rec_write_profile_span_to_json_file(fp, root_span, 0);
+  fp << "\n";
+
+  fp.close();
+
+  VTR_LOG("Write profile to '%s'\n", fname.c_str());
+
+  return 0;
+}
+
+} /* End namespace openfpga */
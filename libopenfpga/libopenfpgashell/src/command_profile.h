@@ -0,0 +1,97 @@
+#ifndef COMMAND_PROFILE_H
+#define COMMAND_PROFILE_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <chrono>
+#include <ctime>
+#include <string>
+#include <vector>
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/*********************************************************************
+ * Runtime and memory usage of an action, which can be
+ * - a command executed by the shell
+ * - a section of a command measured by a vtr::ScopedActionTimer,
+ *   which is a child of the command or of another section
+ * Note that CPU time and bytes written are only available for commands,
+ * and they are measured on the whole process
+ ********************************************************************/
+struct t_profile_span {
+  std::string name;
+  float wall_time = 0.;      /* Elapsed time in seconds */
+  float cpu_time = 0.;       /* CPU time of the process in seconds */
+  float max_rss = 0.;        /* Peak memory resident set size in MiB */
+  float delta_max_rss = 0.;  /* Change of peak memory resident set size in MiB */
+  size_t bytes_written = 0;  /* Number of bytes written by the process */
+  int status = 0;            /* Exit code of a command */
+  std::vector<t_profile_span> children;
+};
+
+/*********************************************************************
+ * A section measured by a vtr::ScopedActionTimer, which is finished
+ ********************************************************************/
+struct t_timer_record {
+  std::chrono::time_point<std::chrono::steady_clock> start;
+  t_profile_span span;
+};
+
+/*********************************************************************
+ * Measure an action, typically a command, from the construction of the
+ * object until finish() is called, which should be in the same thread.
+ * The sections measured by vtr::ScopedActionTimer are collected 
+ * as the children of the action when they finish:
+ * - in the thread of the profiler
+ * - in other threads, e.g., the workers of a thread pool, only when 
+ *   this is the only profiler running. Otherwise, the sections cannot
+ *   be attributed to a profiler and are dropped
+ * Profilers running concurrently in different threads, e.g., for 
+ * concurrent commands, therefore never collect the sections of each other
+ *
+ * An example of how to use
+ * -----------------------
+ *   CommandProfiler profiler("my_command");
+ *   // Do the work
+ *   t_profile_span span = profiler.finish();
+ ********************************************************************/
+class CommandProfiler {
+  public: /* Constructor */
+    CommandProfiler(const std::string& name);
+    ~CommandProfiler();
+    /* A profiler is registered by its address, and is not copyable */
+    CommandProfiler(const CommandProfiler&) = delete;
+    CommandProfiler& operator=(const CommandProfiler&) = delete;
+  public: /* Public mutators */
+    /* Stop the measurement and return the results. Can be called only once */
+    t_profile_span finish();
+    /* Add a finished section to the profiler */
+    void add_timer_record(const t_timer_record& record);
+  private: /* Internal functions */
+    void unregister_profiler();
+  private: /* Internal data */
+    std::string name_;
+    std::chrono::time_point<std::chrono::steady_clock> wall_start_;
+    std::clock_t cpu_start_;
+    size_t initial_max_rss_;
+    size_t initial_bytes_written_;
+
+    /* Sections collected so far, in the order of their finish time */
+    std::vector<t_timer_record> timer_records_;
+    /* The profiler which was running in the same thread before this one */
+    CommandProfiler* parent_profiler_;
+    bool finished_;
+};
+
+size_t get_process_bytes_written();
+
+float get_process_max_rss_mib();
+
+int write_profile_to_json_file(const t_profile_span& root_span,
+                               const std::string& fname);
+
+} /* End namespace openfpga */
+
+#endif
@@ -2,9 +2,12 @@
 #define SHELL_H
 
 #include <string>
+#include <istream>
 #include <map>
 #include <vector>
 #include <functional>
+#include <memory>
+#include <chrono>
 #include <ctime>
 
 #include "vtr_vector.h"
@@ -12,6 +15,8 @@
 #include "command.h"
 #include "command_context.h"
 #include "command_exit_codes.h"
+#include "command_profile.h"
+#include "openfpga_thread_pool.h"
 #include "shell_fwd.h"
 
 /* Begin namespace openfpga */
@@ -136,14 +141,30 @@ class Shell {
     void set_command_dependency(const ShellCommandId& cmd_id,
                                 const std::vector<ShellCommandId>& cmd_dependency);
     ShellCommandClassId add_command_class(const char* name);
+    /* Output the runtime and memory usage of the executed commands to a JSON file when the shell exits */
+    void set_profile_file(const std::string& fname);
+    /* Set the function to clear the data exchange <T> before each request in server mode
+     * The given commands, whose results are cleared by the function, are marked as not executed,
+     * so that the commands depending on them cannot be executed before they are executed again
+     */
+    void set_server_request_reset_function(std::function<void(T&)> reset_func,
+                                           const std::vector<std::string>& reset_cmd_names);
   public: /* Public validators */
     bool valid_command_id(const ShellCommandId& cmd_id) const;
     bool valid_command_class_id(const ShellCommandClassId& cmd_class_id) const;
   public: /* Public executors */
     /* Start the interactive mode, where users will type-in command by command */
     void run_interactive_mode(T& context, const bool& quiet_mode = false);
-    /* Start the script mode, where users provide a file which includes all the commands to run */
-    void run_script_mode(const char* script_file_name, T& context);
+    /* Start the script mode, where users provide a file which includes all the commands to run
+     * When more than 1 thread is allowed, consecutive commands which only read the data exchange <T>
+     * are executed concurrently 
+     */
+    void run_script_mode(const char* script_file_name, T& context, const size_t& num_threads = 1);
+    /* Start the server mode, where clients send commands to run through a UNIX socket
+     * The setup script (can be nullptr) is executed before serving, and its results are kept for all the requests
+     * The function only returns when the server fails to start
+     */
+    void run_server_mode(const char* socket_path, const char* setup_script_file_name, T& context, const size_t& num_threads = 1);
     /* Print all the commands by their classes. This is actually the help desk */
     void print_commands() const;
     /* Quit the shell */
@@ -153,6 +174,40 @@ class Shell {
      * The common_context is the data structure to exchange data between commands
      */
     int execute_command(const char* cmd_line, T& common_context);
+
+    /* Parse the command lines from a script, skipping comments and joining continued lines */
+    std::vector<std::string> parse_script_lines(std::istream& fp) const;
+
+    /* Execute command lines in order until a fatal error occurs */
+    int execute_command_lines(const std::vector<std::string>& cmd_lines,
+                              T& common_context,
+                              const size_t& num_threads);
+
+    /* Execute a group of commands concurrently, the commands must only read the common_context */
+    int execute_concurrent_commands(const std::vector<std::string>& cmd_lines,
+                                    T& common_context,
+                                    const size_t& num_threads);
+
+    /* Find the end of a group of commands starting from a command line,
+     * which can be executed concurrently
+     */
+    size_t find_concurrent_command_group_end(const std::vector<std::string>& cmd_lines,
+                                             const size_t& group_begin) const;
+
+    /* Check if all the prequistics of a command have been met */
+    bool check_command_dependency(const ShellCommandId& cmd_id) const;
+
+    /* Parse the options of a command, the tokens are the user's input to launch a command */
+    bool parse_command_tokens(const std::vector<std::string>& tokens, const ShellCommandId& cmd_id);
+
+    /* Execute a command whose options have been parsed */
+    int execute_parsed_command(const ShellCommandId& cmd_id, T& common_context);
+
+    /* Record the runtime and memory usage of an executed command */
+    void add_command_profile(const t_profile_span& cmd_profile);
+
+    /* Build the profile of the whole flow, whose children are the profiles of executed commands */
+    t_profile_span build_flow_profile() const;
   private: /* Internal data */ 
     /* Name of the shell, this will appear in the interactive mode */
     std::string name_;
@@ -215,6 +270,26 @@ class Shell {
 
     /* Timer */
     std::clock_t time_start_;
+    std::chrono::time_point<std::chrono::steady_clock> wall_time_start_;
+
+    /* Runtime and memory usage of each executed command, in the order of execution
+     * In server mode, only the commands of the setup script and of the current request are kept
+     */
+    std::vector<t_profile_span> command_profiles_;
+
+    /* File to output the profile of commands, empty if not required */
+    std::string profile_file_;
+
+    /* Function to clear the data exchange <T> before each request in server mode */
+    std::function<void(T&)> server_request_reset_function_;
+    /* Commands whose results are cleared by the function above */
+    std::vector<ShellCommandId> server_request_reset_commands_;
+
+    /* Threads to execute commands concurrently, created at the first use,
+     * where the parallel loops of each command run in its own thread.
+     * The pool is shared by the copies of the shell, as threads are not copyable
+     */
+    std::shared_ptr<ThreadPool> concurrent_command_thread_pool_;
 };
 
 } /* End namespace openfpga */
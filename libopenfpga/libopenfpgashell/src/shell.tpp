@@ -2,7 +2,16 @@
  * Member functions for class Shell
  ********************************************************************/
 #include <fstream>
+#include <sstream>
 #include <algorithm>
+#include <cstring>
+#include <cerrno>
+
+/* Headers for UNIX sockets */
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
@@ -29,6 +38,7 @@ template<class T>
 Shell<T>::Shell(const char* name) {
   name_ = std::string(name);
   time_start_ = 0;
+  wall_time_start_ = std::chrono::steady_clock::now();
 }
 
 /************************************************************************
@@ -236,6 +246,23 @@ ShellCommandClassId Shell<T>::add_command_class(const char* name) {
   return cmd_class;
 } 
 
+template<class T>
+void Shell<T>::set_profile_file(const std::string& fname) {
+  profile_file_ = fname;
+}
+
+template<class T>
+void Shell<T>::set_server_request_reset_function(std::function<void(T&)> reset_func,
+                                                 const std::vector<std::string>& reset_cmd_names) {
+  server_request_reset_function_ = reset_func;
+  server_request_reset_commands_.clear();
+  for (const std::string& cmd_name : reset_cmd_names) {
+    ShellCommandId cmd_id = command(cmd_name);
+    VTR_ASSERT(true == valid_command_id(cmd_id));
+    server_request_reset_commands_.push_back(cmd_id);
+  }
+}
+
 /************************************************************************
  * Public executors
  ***********************************************************************/
@@ -244,6 +271,7 @@ void Shell<T>::run_interactive_mode(T& context, const bool& quiet_mode) {
   if (false == quiet_mode) {
     /* Reset timer since it does not come from another mode */
     time_start_ = std::clock();
+    wall_time_start_ = std::chrono::steady_clock::now();
 
     VTR_LOG("Start interactive mode of %s...\n",
             name().c_str());
@@ -262,7 +290,12 @@ void Shell<T>::run_interactive_mode(T& context, const bool& quiet_mode) {
      * Add to history 
      */
     if (strlen(cmd_line) > 0) {
-      execute_command((const char*)cmd_line, context);
+      std::string profile_name(cmd_line);
+      CommandProfiler profiler(profile_name);
+      int status = execute_command((const char*)cmd_line, context);
+      t_profile_span cmd_profile = profiler.finish();
+      cmd_profile.status = status;
+      add_command_profile(cmd_profile);
       add_history(cmd_line);
     }
 
@@ -272,9 +305,10 @@ void Shell<T>::run_interactive_mode(T& context, const bool& quiet_mode) {
 }
 
 template <class T>
-void Shell<T>::run_script_mode(const char* script_file_name, T& context) {
+void Shell<T>::run_script_mode(const char* script_file_name, T& context, const size_t& num_threads) {
 
   time_start_ = std::clock();
+  wall_time_start_ = std::chrono::steady_clock::now();
 
   VTR_LOG("Reading script file %s...\n", script_file_name);
 
@@ -283,8 +317,6 @@ void Shell<T>::run_script_mode(const char* script_file_name, T& context) {
     VTR_LOG("%s\n", title().c_str());
   } 
 
-  std::string line;
-
   /* Create an input file stream */
   std::ifstream fp(script_file_name);
 
@@ -295,78 +327,216 @@ void Shell<T>::run_script_mode(const char* script_file_name, T& context) {
     return; 
   }
 
-  /* Consider that each line may not end due to the continued line charactor 
-   * Use cmd_line to conjunct multiple lines 
-   */
-  std::string cmd_line;
+  /* All the command lines of the script, which are executed after the script is read */
+  std::vector<std::string> cmd_lines = parse_script_lines(fp);
+  fp.close();
 
-  /* Read line by line */
-  while (getline(fp, line)) {
-    /* Skip empty line */
-    if (true == line.empty()) {
-      continue;
+  /* Check the execution status of the commands, if fatal error happened, we should abort immediately */
+  if (CMD_EXEC_FATAL_ERROR == execute_command_lines(cmd_lines, context, num_threads)) {
+    VTR_LOG("Fatal error occurred!\nAbort and enter interactive mode\n");
+  }
+
+  /* Return to interactive mode, stay tuned */
+  run_interactive_mode(context, true); 
+}
+
+/************************************************************************
+ * Start the server mode, where command lines are sent by clients
+ * through a UNIX socket. Each connection is a request, which includes 
+ * all the data sent by the client until it shuts down the writing.
+ * The data is parsed in the same way as a script file.
+ *
+ * The setup script is executed once before listening to the socket,
+ * which is supposed to prepare the data that is shared by all the requests.
+ * Before each request
+ * - the status of commands is restored to the one after the setup script,
+ *   so that the dependency of commands is checked within the request
+ * - the reset function is called to clear the data of the previous request
+ *
+ * The server replies the exit code of each executed command,
+ * one command per line, followed by the number of errors in the request.
+ * The command 'exit' in a request stops the server 
+ * after the commands before it are executed
+ *
+ * An example of a client
+ *   nc -U -N <socket_path> < <script_file>
+ ***********************************************************************/
+template <class T>
+void Shell<T>::run_server_mode(const char* socket_path, const char* setup_script_file_name, T& context, const size_t& num_threads) {
+
+  time_start_ = std::clock();
+  wall_time_start_ = std::chrono::steady_clock::now();
+
+  VTR_LOG("Start server mode of %s...\n",
+          name().c_str());
+
+  /* Print the title of the shell */
+  if (!title().empty()) {
+    VTR_LOG("%s\n", title().c_str());
+  } 
+
+  if (nullptr != setup_script_file_name) {
+    VTR_LOG("Reading setup script file %s...\n", setup_script_file_name);
+
+    std::ifstream fp(setup_script_file_name);
+    if (!fp.is_open()) {
+      VTR_LOG_ERROR("Fail to open the setup script file: %s! Please check its location\n",
+                    setup_script_file_name);
+      return; 
     }
+    std::vector<std::string> setup_cmd_lines = parse_script_lines(fp);
+    fp.close();
 
-    /* If the line that starts with '#', it is commented, we can skip */ 
-    if ('#' == line.front()) {
-      continue;
+    if (CMD_EXEC_FATAL_ERROR == execute_command_lines(setup_cmd_lines, context, num_threads)) {
+      VTR_LOG_ERROR("Fatal error occurred in the setup script!\nAbort server mode\n");
+      return;
     }
-    /* Try to split the line with '#', the string before '#' is the read command we want */
-    std::string cmd_part = line;
-    std::size_t cmd_end_pos = line.find_first_of('#');
-    /* If the full line has '#', we need the part before it */
-    if (cmd_end_pos != std::string::npos) {
-      cmd_part = line.substr(0, cmd_end_pos);
+  }
+
+  /* Status of commands after the setup, which is restored before each request */
+  vtr::vector<ShellCommandId, int> setup_command_status = command_status_;
+
+  struct sockaddr_un server_addr;
+  if (sizeof(server_addr.sun_path) <= strlen(socket_path)) {
+    VTR_LOG_ERROR("Socket path '%s' is too long!\n",
+                  socket_path);
+    return;
+  }
+  memset(&server_addr, 0, sizeof(server_addr));
+  server_addr.sun_family = AF_UNIX;
+  strncpy(server_addr.sun_path, socket_path, sizeof(server_addr.sun_path) - 1);
+
+  /* Remove the socket left by a previous server. Other types of files are never removed */
+  struct stat socket_stat;
+  if ( (0 == stat(socket_path, &socket_stat))
+    && (S_ISSOCK(socket_stat.st_mode)) ) {
+    unlink(socket_path);
+  }
+
+  int server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (0 > server_fd) {
+    VTR_LOG_ERROR("Fail to create a socket: %s!\n",
+                  strerror(errno));
+    return;
+  }
+
+  if ( (0 != bind(server_fd, (struct sockaddr*)&server_addr, sizeof(server_addr)))
+    || (0 != listen(server_fd, SOMAXCONN)) ) {
+    VTR_LOG_ERROR("Fail to listen to socket '%s': %s!\n",
+                  socket_path, strerror(errno));
+    close(server_fd);
+    return;
+  }
+
+  VTR_LOG("\nListening to socket '%s'...\n", socket_path);
+
+  size_t num_requests = 0;
+  bool stop_server = false;
+  while (false == stop_server) {
+    int client_fd = accept(server_fd, nullptr, nullptr);
+    if (0 > client_fd) {
+      if (EINTR == errno) {
+        continue;
+      }
+      VTR_LOG_ERROR("Fail to accept a connection from socket '%s': %s!\n",
+                    socket_path, strerror(errno));
+      break;
     }
 
-    /* Remove the space at the end of the line
-     * So that we can check easily if there is a continued line in the end  
-     */
-    StringToken cmd_part_tokenizer(cmd_part);
-    cmd_part_tokenizer.rtrim(std::string(" "));
-    cmd_part = cmd_part_tokenizer.data();
+    /* Receive the request until the client shuts down the writing */
+    std::string request;
+    char buffer[4096];
+    ssize_t num_bytes_read;
+    while ( (0 < (num_bytes_read = read(client_fd, buffer, sizeof(buffer))))
+         || ( (0 > num_bytes_read) && (EINTR == errno) ) ) {
+      if (0 < num_bytes_read) {
+        request.append(buffer, num_bytes_read);
+      }
+    }
 
-    /* If the line ends with '\', this is a continued line, parse the next until it ends */
-    if ('\\' == cmd_part.back()) {
-      /* Pop up the last charactor and conjunct to cmd_line */
-      cmd_part.pop_back();
- 
-      if (!cmd_part.empty()) {
-        cmd_line += cmd_part; 
+    std::istringstream request_stream(request);
+    std::vector<std::string> cmd_lines = parse_script_lines(request_stream);
+
+    /* Only the commands before 'exit' are executed */
+    for (size_t iline = 0; iline < cmd_lines.size(); ++iline) {
+      openfpga::StringToken tokenizer(cmd_lines[iline]);  
+      std::vector<std::string> tokens = tokenizer.split(" ");
+      if ( (false == tokens.empty())
+        && (std::string("exit") == tokens[0]) ) {
+        cmd_lines.resize(iline);
+        stop_server = true;
+        break;
       }
-      /* Not finished yet. Parse the next line */
-      continue;
-    } else {
-      /* End of this line, if cmd_line is empty, 
-       * there is no previous lines, cache the part we have
-       * and then execute the command 
-       */
-      cmd_line += cmd_part;
     }
 
-    /* Remove the space at the beginning of the line */
-    StringToken cmd_line_tokenizer(cmd_line);
-    cmd_line_tokenizer.ltrim(std::string(" "));
-    cmd_line = cmd_line_tokenizer.data();
+    num_requests++;
+    VTR_LOG("\nStart request #%lu with %lu commands\n",
+            num_requests, cmd_lines.size());
 
-    /* Process the command only when the full command line in ended */
-    if (!cmd_line.empty()) {
-      VTR_LOG("\nCommand line to execute: %s\n", cmd_line.c_str());
-      int status = execute_command(cmd_line.c_str(), context);
-      /* Empty the line ready to start a new line */
-      cmd_line.clear();
+    command_status_ = setup_command_status;
+    if (nullptr != server_request_reset_function_) {
+      server_request_reset_function_(context);
+      /* The results of these commands are cleared, and they should be executed again */
+      for (const ShellCommandId& cmd_id : server_request_reset_commands_) {
+        command_status_[cmd_id] = CMD_EXEC_NONE;
+      }
+    }
+
+    size_t first_cmd_profile = command_profiles_.size();
+    int request_status = execute_command_lines(cmd_lines, context, num_threads);
 
-      /* Check the execution status of the command, if fatal error happened, we should abort immediately */
-      if (CMD_EXEC_FATAL_ERROR == status) {
-        VTR_LOG("Fatal error occurred!\nAbort and enter interactive mode\n");
+    /* Reply the exit code of each executed command */
+    std::string reply;
+    size_t num_err = 0;
+    for (size_t iprofile = first_cmd_profile; iprofile < command_profiles_.size(); ++iprofile) {
+      reply += std::to_string(command_profiles_[iprofile].status) + std::string("\t") + command_profiles_[iprofile].name + std::string("\n");
+      if (CMD_EXEC_SUCCESS != command_profiles_[iprofile].status) {
+        num_err++;
+      }
+    }
+    /* Errors may occur before a command is executed, e.g., unmet dependency */
+    if ( (0 == num_err)
+      && (CMD_EXEC_SUCCESS != request_status) ) {
+      num_err++;
+    }
+    reply += std::string("Finish request with ") + std::to_string(num_err) + std::string(" errors\n");
+
+    VTR_LOG("\nFinish request #%lu with %lu errors\n",
+            num_requests, num_err);
+
+    size_t num_bytes_sent = 0;
+    while (num_bytes_sent < reply.size()) {
+      ssize_t curr_num_bytes_sent = send(client_fd, reply.c_str() + num_bytes_sent, reply.size() - num_bytes_sent, MSG_NOSIGNAL);
+      if (0 > curr_num_bytes_sent) {
+        if (EINTR == errno) {
+          continue;
+        }
+        VTR_LOG_WARN("Fail to reply request #%lu: %s!\n",
+                     num_requests, strerror(errno));
         break;
       }
+      num_bytes_sent += curr_num_bytes_sent;
+    }
+
+    close(client_fd);
+
+    /* The profiles of a request are only kept until the request is replied,
+     * so that the memory of a long-running server does not grow with the number of requests.
+     * The profile file, if required, is updated with the last request, except the one
+     * stopping the server, whose profile is written when the shell exits
+     */
+    if (false == stop_server) {
+      if (false == profile_file_.empty()) {
+        write_profile_to_json_file(build_flow_profile(), profile_file_);
+      }
+      command_profiles_.resize(first_cmd_profile);
     }
   }
-  fp.close();
 
-  /* Return to interactive mode, stay tuned */
-  run_interactive_mode(context, true); 
+  close(server_fd);
+  unlink(socket_path);
+
+  exit();
 }
 
 template <class T>
@@ -425,8 +595,14 @@ void Shell<T>::exit() const {
   VTR_LOG("\nFinish execution with %d errors\n",
             num_err);
 
-  VTR_LOG("\nThe entire OpenFPGA flow took %g seconds\n",
-          (double)(std::clock() - time_start_) / (double)CLOCKS_PER_SEC);
+  t_profile_span flow_profile = build_flow_profile();
+
+  VTR_LOG("\nThe entire OpenFPGA flow took %g seconds (CPU time %g seconds, max_rss %.1f MiB)\n",
+          flow_profile.wall_time, flow_profile.cpu_time, flow_profile.max_rss);
+
+  if (false == profile_file_.empty()) {
+    write_profile_to_json_file(flow_profile, profile_file_);
+  }
 
   VTR_LOG("\nThank you for using %s!\n",
           name().c_str());
@@ -453,15 +629,8 @@ int Shell<T>::execute_command(const char* cmd_line,
   }
 
   /* Check the dependency graph to see if all the prequistics have been met */
-  for (const ShellCommandId& dep_cmd : command_dependencies_[cmd_id]) {
-    if ( (CMD_EXEC_NONE == command_status_[dep_cmd])
-      || (CMD_EXEC_FATAL_ERROR == command_status_[dep_cmd]) ) {
-      VTR_LOG("Command '%s' is required to be executed before command '%s'!\n",
-              commands_[dep_cmd].name().c_str(), commands_[cmd_id].name().c_str());
-      /* Echo the command help desk */
-      print_command_options(commands_[cmd_id]);
-      return CMD_EXEC_FATAL_ERROR;
-    } 
+  if (false == check_command_dependency(cmd_id)) {
+    return CMD_EXEC_FATAL_ERROR;
   }
 
   /* Find the command! Parse the options 
@@ -487,6 +656,165 @@ int Shell<T>::execute_command(const char* cmd_line,
     return command_status_[cmd_id];
   }
  
+  if (false == parse_command_tokens(tokens, cmd_id)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return execute_parsed_command(cmd_id, common_context);
+}
+
+/************************************************************************
+ * Execute a group of commands concurrently
+ * The commands are parsed one by one in order, so that the log is the same
+ * as sequential execution, and then executed by a number of threads.
+ * Only the commands which are declared to be read-only on the common context
+ * are allowed here, see find_concurrent_command_group_end()
+ * The commands run on the threads of a pool owned by the shell, 
+ * and the parallel loops inside each command run in the thread of the command
+ * Return the most severe status among the commands
+ ***********************************************************************/
+template <class T>
+int Shell<T>::execute_concurrent_commands(const std::vector<std::string>& cmd_lines,
+                                          T& common_context,
+                                          const size_t& num_threads) {
+  std::vector<ShellCommandId> cmd_ids;
+  for (const std::string& cmd_line : cmd_lines) {
+    VTR_LOG("\nCommand line to execute: %s\n", cmd_line.c_str());
+
+    openfpga::StringToken tokenizer(cmd_line);  
+    std::vector<std::string> tokens = tokenizer.split(" ");
+
+    ShellCommandId cmd_id = command(tokens[0]);
+    VTR_ASSERT(true == valid_command_id(cmd_id));
+
+    if (false == check_command_dependency(cmd_id)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+
+    if (false == parse_command_tokens(tokens, cmd_id)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+
+    cmd_ids.push_back(cmd_id);
+  }
+
+  VTR_LOG("\nExecute %lu commands concurrently with %lu threads\n",
+          cmd_ids.size(), std::min(num_threads, cmd_ids.size()));
+
+  std::vector<int> cmd_status(cmd_ids.size(), CMD_EXEC_NONE);
+  std::vector<t_profile_span> cmd_profiles(cmd_ids.size());
+  if (nullptr == concurrent_command_thread_pool_) {
+    concurrent_command_thread_pool_ = std::make_shared<ThreadPool>(num_threads);
+  }
+  concurrent_command_thread_pool_->set_num_threads(num_threads);
+  concurrent_command_thread_pool_->parallel_for(cmd_ids.size(),
+                                                [&](const size_t& icmd) {
+    CommandProfiler profiler(cmd_lines[icmd]);
+    cmd_status[icmd] = execute_parsed_command(cmd_ids[icmd], common_context);
+    cmd_profiles[icmd] = profiler.finish();
+    cmd_profiles[icmd].status = cmd_status[icmd];
+  });
+
+  /* Record the profiles in the order of the script */
+  for (const t_profile_span& cmd_profile : cmd_profiles) {
+    add_command_profile(cmd_profile);
+  }
+
+  int status = CMD_EXEC_SUCCESS;
+  for (const int& curr_status : cmd_status) {
+    if (CMD_EXEC_FATAL_ERROR == curr_status) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if (CMD_EXEC_MINOR_ERROR == curr_status) {
+      status = CMD_EXEC_MINOR_ERROR;
+    }
+  }
+
+  return status;
+}
+
+/************************************************************************
+ * Find the end of a group of consecutive commands starting from 
+ * the command line group_begin, which can be executed concurrently
+ * The dependency between the commands in the script is modeled as
+ * a graph where
+ * - a command modifying the common context depends on all the commands before it
+ *   and all the commands after it depend on it
+ * - a command only reading the common context, i.e., registered by 
+ *   set_command_const_execute_function(), depends on the commands 
+ *   required by set_command_dependency() 
+ * Therefore, a group consists of consecutive read-only commands
+ * where no command depends on another command of the group.
+ * The same command can not appear twice in a group, as the parsing results
+ * are stored per command
+ * The group contains at least the command line group_begin
+ ***********************************************************************/
+template <class T>
+size_t Shell<T>::find_concurrent_command_group_end(const std::vector<std::string>& cmd_lines,
+                                                   const size_t& group_begin) const {
+  std::vector<ShellCommandId> group_cmd_ids;
+
+  size_t group_end = group_begin;
+  for (; group_end < cmd_lines.size(); ++group_end) {
+    openfpga::StringToken tokenizer(cmd_lines[group_end]);  
+    std::vector<std::string> tokens = tokenizer.split(" ");
+    ShellCommandId cmd_id = command(tokens[0]);
+
+    /* Invalid commands are reported by the sequential execution */
+    if (false == valid_command_id(cmd_id)) {
+      break;
+    }
+
+    /* Only read-only commands can be executed concurrently */
+    if ( (CONST_STANDARD != command_execute_function_types_[cmd_id])
+      && (CONST_SHORT != command_execute_function_types_[cmd_id]) ) {
+      break;
+    }
+
+    /* The command appears in the group or depends on a command of the group */
+    bool independent = true;
+    for (const ShellCommandId& group_cmd_id : group_cmd_ids) {
+      if ( (group_cmd_id == cmd_id)
+        || (command_dependencies_[cmd_id].end() != std::find(command_dependencies_[cmd_id].begin(), command_dependencies_[cmd_id].end(), group_cmd_id)) ) {
+        independent = false;
+        break;
+      }
+    }
+    if (false == independent) {
+      break;
+    }
+
+    group_cmd_ids.push_back(cmd_id);
+  }
+
+  /* A group contains at least one command */
+  return std::max(group_end, group_begin + 1);
+}
+
+/************************************************************************
+ * Check the dependency graph to see if all the prequistics of a command have been met 
+ ***********************************************************************/
+template <class T>
+bool Shell<T>::check_command_dependency(const ShellCommandId& cmd_id) const {
+  for (const ShellCommandId& dep_cmd : command_dependencies_[cmd_id]) {
+    if ( (CMD_EXEC_NONE == command_status_[dep_cmd])
+      || (CMD_EXEC_FATAL_ERROR == command_status_[dep_cmd]) ) {
+      VTR_LOG("Command '%s' is required to be executed before command '%s'!\n",
+              commands_[dep_cmd].name().c_str(), commands_[cmd_id].name().c_str());
+      /* Echo the command help desk */
+      print_command_options(commands_[cmd_id]);
+      return false;
+    } 
+  }
+  return true;
+}
+
+/************************************************************************
+ * Parse the options of a command and let user to confirm selected options
+ ***********************************************************************/
+template <class T>
+bool Shell<T>::parse_command_tokens(const std::vector<std::string>& tokens, 
+                                    const ShellCommandId& cmd_id) {
   /* Reset the command parse results to initial status 
    * Avoid conflict when calling the same command in the second time 
    */
@@ -494,12 +822,23 @@ int Shell<T>::execute_command(const char* cmd_line,
   if (false == parse_command(tokens, commands_[cmd_id], command_contexts_[cmd_id])) {
     /* Echo the command */
     print_command_options(commands_[cmd_id]);
-    return CMD_EXEC_FATAL_ERROR;
+    return false;
   }
  
   /* Parse succeed. Let user to confirm selected options */ 
   print_command_context(commands_[cmd_id], command_contexts_[cmd_id]);
 
+  return true;
+}
+
+/************************************************************************
+ * Execute a command whose options have been parsed 
+ * Note that this function may be called by multiple threads for different
+ * commands, it should only modify the data owned by the command
+ ***********************************************************************/
+template <class T>
+int Shell<T>::execute_parsed_command(const ShellCommandId& cmd_id,
+                                     T& common_context) {
   /* Execute the command depending on the type of function ! */ 
   switch (command_execute_function_types_[cmd_id]) {
   case CONST_STANDARD:
@@ -537,6 +876,161 @@ int Shell<T>::execute_command(const char* cmd_line,
   return command_status_[cmd_id];
 }
 
+/************************************************************************
+ * Parse the command lines from a stream of a script, where
+ * - empty lines and comments starting with '#' are skipped
+ * - a line ending with '\' is continued by the next line
+ ***********************************************************************/
+template <class T>
+std::vector<std::string> Shell<T>::parse_script_lines(std::istream& fp) const {
+  std::string line;
+
+  /* Consider that each line may not end due to the continued line charactor 
+   * Use cmd_line to conjunct multiple lines 
+   */
+  std::string cmd_line;
+
+  std::vector<std::string> cmd_lines;
+
+  /* Read line by line */
+  while (getline(fp, line)) {
+    /* Skip empty line */
+    if (true == line.empty()) {
+      continue;
+    }
+
+    /* If the line that starts with '#', it is commented, we can skip */ 
+    if ('#' == line.front()) {
+      continue;
+    }
+    /* Try to split the line with '#', the string before '#' is the read command we want */
+    std::string cmd_part = line;
+    std::size_t cmd_end_pos = line.find_first_of('#');
+    /* If the full line has '#', we need the part before it */
+    if (cmd_end_pos != std::string::npos) {
+      cmd_part = line.substr(0, cmd_end_pos);
+    }
+
+    /* Remove the space at the end of the line
+     * So that we can check easily if there is a continued line in the end  
+     */
+    StringToken cmd_part_tokenizer(cmd_part);
+    cmd_part_tokenizer.rtrim(std::string(" "));
+    cmd_part = cmd_part_tokenizer.data();
+
+    /* If the line ends with '\', this is a continued line, parse the next until it ends */
+    if ('\\' == cmd_part.back()) {
+      /* Pop up the last charactor and conjunct to cmd_line */
+      cmd_part.pop_back();
+ 
+      if (!cmd_part.empty()) {
+        cmd_line += cmd_part; 
+      }
+      /* Not finished yet. Parse the next line */
+      continue;
+    } else {
+      /* End of this line, if cmd_line is empty, 
+       * there is no previous lines, cache the part we have
+       * and then execute the command 
+       */
+      cmd_line += cmd_part;
+    }
+
+    /* Remove the space at the beginning of the line */
+    StringToken cmd_line_tokenizer(cmd_line);
+    cmd_line_tokenizer.ltrim(std::string(" "));
+    cmd_line = cmd_line_tokenizer.data();
+
+    /* Cache the command only when the full command line in ended */
+    if (!cmd_line.empty()) {
+      cmd_lines.push_back(cmd_line);
+      /* Empty the line ready to start a new line */
+      cmd_line.clear();
+    }
+  }
+
+  return cmd_lines;
+}
+
+/************************************************************************
+ * Execute the command lines in order.
+ * A group of commands can be executed concurrently when it is allowed 
+ * Return CMD_EXEC_FATAL_ERROR if the execution is aborted due to a fatal error
+ ***********************************************************************/
+template <class T>
+int Shell<T>::execute_command_lines(const std::vector<std::string>& cmd_lines,
+                                    T& common_context,
+                                    const size_t& num_threads) {
+  size_t group_begin = 0;
+  while (group_begin < cmd_lines.size()) {
+    size_t group_end = group_begin + 1;
+    if (1 < num_threads) {
+      group_end = find_concurrent_command_group_end(cmd_lines, group_begin);
+    }
+
+    int status = CMD_EXEC_SUCCESS;
+    if (1 == group_end - group_begin) {
+      VTR_LOG("\nCommand line to execute: %s\n", cmd_lines[group_begin].c_str());
+      CommandProfiler profiler(cmd_lines[group_begin]);
+      status = execute_command(cmd_lines[group_begin].c_str(), common_context);
+      t_profile_span cmd_profile = profiler.finish();
+      cmd_profile.status = status;
+      add_command_profile(cmd_profile);
+    } else {
+      status = execute_concurrent_commands(std::vector<std::string>(cmd_lines.begin() + group_begin, cmd_lines.begin() + group_end),
+                                           common_context, num_threads);
+    }
+
+    if (CMD_EXEC_FATAL_ERROR == status) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+
+    group_begin = group_end;
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/************************************************************************
+ * Record the runtime and memory usage of an executed command 
+ * and report it in the log
+ ***********************************************************************/
+template <class T>
+void Shell<T>::add_command_profile(const t_profile_span& cmd_profile) {
+  VTR_LOG("Command '%s' took %.2f seconds (CPU time %.2f seconds, max_rss %.1f MiB, delta_rss %+.1f MiB, %lu bytes written)\n",
+          cmd_profile.name.c_str(), cmd_profile.wall_time, cmd_profile.cpu_time,
+          cmd_profile.max_rss, cmd_profile.delta_max_rss, cmd_profile.bytes_written);
+  command_profiles_.push_back(cmd_profile);
+}
+
+/************************************************************************
+ * Build the profile of the whole flow from the start of the shell,
+ * whose children are the profiles of the executed commands.
+ * The status is an error if any command has errors,
+ * which is the same as the exit code of the shell
+ ***********************************************************************/
+template <class T>
+t_profile_span Shell<T>::build_flow_profile() const {
+  t_profile_span flow_profile;
+  flow_profile.name = name();
+  flow_profile.wall_time = std::chrono::duration<float>(std::chrono::steady_clock::now() - wall_time_start_).count();
+  flow_profile.cpu_time = (float)(std::clock() - time_start_) / (float)CLOCKS_PER_SEC;
+  flow_profile.max_rss = get_process_max_rss_mib();
+  flow_profile.status = 0;
+  for (const int& status : command_status_) {
+    if ( (status == CMD_EXEC_FATAL_ERROR)
+      || (status == CMD_EXEC_MINOR_ERROR) ) {
+      flow_profile.status = 1;
+      break;
+    }
+  }
+  flow_profile.children = command_profiles_;
+  for (const t_profile_span& cmd_profile : command_profiles_) {
+    flow_profile.bytes_written += cmd_profile.bytes_written;
+  }
+  return flow_profile;
+}
+
 /************************************************************************
  * Public invalidators/validators 
  ***********************************************************************/
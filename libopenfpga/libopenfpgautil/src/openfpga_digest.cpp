@@ -5,6 +5,9 @@
 #include <sys/stat.h>
 #include <vector>
 #include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <mutex>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
@@ -272,4 +275,19 @@ bool write_tab_to_file(std::fstream& fp,
   return true;
 }
 
+/******************************************************************** 
+ * Get the current date and time in the format of std::ctime(),
+ * which is used in the headers of output files 
+ * std::ctime() shares a static buffer, which is guarded here
+ * as files may be written by multiple threads
+ ********************************************************************/
+std::string get_current_date_string() {
+  auto end = std::chrono::system_clock::now(); 
+  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
+
+  static std::mutex ctime_mutex;
+  std::lock_guard<std::mutex> lock(ctime_mutex);
+  return std::string(std::ctime(&end_time));
+}
+
 } /* namespace openfpga ends */
@@ -5,6 +5,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <fstream>
+#include <string>
 
 /********************************************************************
  * Function declaration
@@ -31,6 +32,8 @@ bool write_space_to_file(std::fstream& fp,
 bool write_tab_to_file(std::fstream& fp,
                        const size_t& num_tab);
 
+std::string get_current_date_string();
+
 } /* namespace openfpga ends */
 
 #endif
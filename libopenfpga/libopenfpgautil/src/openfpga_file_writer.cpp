@@ -0,0 +1,172 @@
+/********************************************************************
+ * This file includes member functions for data structure FileWriter
+ *******************************************************************/
+#include <algorithm>
+
+#ifdef OPENFPGA_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_file_writer.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Size of the buffer to collect data before writing to the file */
+constexpr size_t FILE_WRITER_BUFFER_SIZE = 1 << 20;
+
+bool file_compression_supported(const e_file_compression& compression) {
+  switch (compression) {
+  case FILE_COMPRESSION_NONE:
+    return true;
+  case FILE_COMPRESSION_GZIP:
+#ifdef OPENFPGA_WITH_ZLIB
+    return true;
+#else
+    return false;
+#endif
+  default:
+    return false;
+  }
+}
+
+/************************************************************************
+ * Constructors
+ ***********************************************************************/
+FileWriter::FileWriter() {
+  buffer_.resize(FILE_WRITER_BUFFER_SIZE);
+  buffer_used_ = 0;
+  compression_ = FILE_COMPRESSION_NONE;
+  file_ = nullptr;
+  compressed_file_ = nullptr;
+  failed_ = false;
+}
+
+FileWriter::~FileWriter() {
+  close();
+}
+
+/************************************************************************
+ * Public accessors
+ ***********************************************************************/
+bool FileWriter::good() const {
+  return ( (nullptr != file_) || (nullptr != compressed_file_) ) && (false == failed_);
+}
+
+/************************************************************************
+ * Public mutators
+ ***********************************************************************/
+bool FileWriter::open(const std::string& fname, const e_file_compression& compression) {
+  close();
+  buffer_used_ = 0;
+
+  if (false == file_compression_supported(compression)) {
+    return false;
+  }
+
+  compression_ = compression;
+  failed_ = false;
+  if (FILE_COMPRESSION_NONE == compression_) {
+    file_ = std::fopen(fname.c_str(), "wb");
+    if (nullptr == file_) {
+      return false;
+    }
+    /* Data is already buffered by the writer */
+    std::setvbuf(file_, nullptr, _IONBF, 0);
+  } else {
+#ifdef OPENFPGA_WITH_ZLIB
+    VTR_ASSERT(FILE_COMPRESSION_GZIP == compression_);
+    gzFile gz_file = gzopen(fname.c_str(), "wb");
+    if (nullptr == gz_file) {
+      return false;
+    }
+    gzbuffer(gz_file, FILE_WRITER_BUFFER_SIZE);
+    compressed_file_ = gz_file;
+#endif
+  }
+
+  return true;
+}
+
+void FileWriter::write_number(size_t number) {
+  /* Digits are formatted from the lowest one */
+  char digits[24];
+  size_t num_digits = 0;
+  do {
+    digits[sizeof(digits) - 1 - num_digits] = char('0' + number % 10);
+    number /= 10;
+    ++num_digits;
+  } while (0 < number);
+  write(digits + sizeof(digits) - num_digits, num_digits);
+}
+
+bool FileWriter::close() {
+  if ( (nullptr == file_) && (nullptr == compressed_file_) ) {
+    return false == failed_;
+  }
+
+  flush_buffer();
+
+  if (nullptr != file_) {
+    if (0 != std::fclose(file_)) {
+      failed_ = true;
+    }
+    file_ = nullptr;
+  }
+#ifdef OPENFPGA_WITH_ZLIB
+  if (nullptr != compressed_file_) {
+    if (Z_OK != gzclose(static_cast<gzFile>(compressed_file_))) {
+      failed_ = true;
+    }
+    compressed_file_ = nullptr;
+  }
+#endif
+
+  return false == failed_;
+}
+
+/************************************************************************
+ * Internal functions
+ ***********************************************************************/
+void FileWriter::flush_buffer() {
+  write_to_file(buffer_.data(), buffer_used_);
+  buffer_used_ = 0;
+}
+
+void FileWriter::write_to_file(const char* data, const size_t& size) {
+  if ( (0 == size) || (true == failed_) ) {
+    return;
+  }
+
+  if (nullptr != file_) {
+    if (size != std::fwrite(data, 1, size, file_)) {
+      failed_ = true;
+    }
+    return;
+  }
+
+#ifdef OPENFPGA_WITH_ZLIB
+  if (nullptr != compressed_file_) {
+    /* The size of each write is limited by the interface of zlib */
+    size_t offset = 0;
+    while (offset < size) {
+      unsigned chunk_size = unsigned(std::min(size - offset, size_t(1) << 30));
+      if (int(chunk_size) != gzwrite(static_cast<gzFile>(compressed_file_), data + offset, chunk_size)) {
+        failed_ = true;
+        return;
+      }
+      offset += chunk_size;
+    }
+    return;
+  }
+#endif
+
+  /* No file is opened */
+  failed_ = true;
+}
+
+} /* namespace openfpga ends */
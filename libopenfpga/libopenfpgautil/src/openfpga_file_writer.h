@@ -0,0 +1,110 @@
+#ifndef OPENFPGA_FILE_WRITER_H
+#define OPENFPGA_FILE_WRITER_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/********************************************************************
+ * This file introduces a writer to output large files, e.g., bitstreams,
+ * which are written piece by piece.
+ * - Data is collected in a large buffer, and is written to the file
+ *   only when the buffer is full, instead of for each piece
+ * - Numbers are formatted without going through a stream
+ * - Data can be compressed on the fly, when the compression library
+ *   is available in the build
+ *******************************************************************/
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Compression of output files */
+enum e_file_compression {
+  FILE_COMPRESSION_NONE,
+  FILE_COMPRESSION_GZIP,
+  NUM_FILE_COMPRESSIONS
+};
+/* Strings correspond to each type of compression */
+constexpr std::array<const char*, NUM_FILE_COMPRESSIONS> FILE_COMPRESSION_STRING = {{"none", "gzip"}};
+
+/* Check if a compression is available in the build */
+bool file_compression_supported(const e_file_compression& compression);
+
+class FileWriter {
+  public: /* Public constructor */
+    FileWriter();
+    ~FileWriter();
+    /* A file is not copyable */
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+
+  public: /* Public accessors */
+    /* Check if the file is opened and all the data has been written so far */
+    bool good() const;
+
+  public: /* Public mutators */
+    /* Open a file to write, which is truncated if it exists
+     * Return false if the file cannot be opened
+     */
+    bool open(const std::string& fname, const e_file_compression& compression);
+
+    void write(const char* data, const size_t& size) {
+      if (buffer_.size() - buffer_used_ < size) {
+        flush_buffer();
+        /* Data larger than the buffer is written directly */
+        if (buffer_.size() < size) {
+          write_to_file(data, size);
+          return;
+        }
+      }
+      std::memcpy(buffer_.data() + buffer_used_, data, size);
+      buffer_used_ += size;
+    }
+
+    void write(const char& c) {
+      if (buffer_.size() == buffer_used_) {
+        flush_buffer();
+      }
+      buffer_[buffer_used_++] = c;
+    }
+
+    void write(const std::string& str) {
+      write(str.data(), str.size());
+    }
+
+    void write(const char* str) {
+      write(str, std::strlen(str));
+    }
+
+    /* Write an unsigned number in decimal */
+    void write_number(size_t number);
+
+    /* Write the remaining data and close the file
+     * Return false if any data failed to be written
+     */
+    bool close();
+
+  private: /* Internal functions */
+    void flush_buffer();
+    void write_to_file(const char* data, const size_t& size);
+
+  private: /* Internal data */
+    std::vector<char> buffer_;
+    size_t buffer_used_;
+
+    e_file_compression compression_;
+    std::FILE* file_;
+    /* Handler of a compressed file, whose type depends on the library */
+    void* compressed_file_;
+
+    bool failed_;
+};
+
+} /* namespace openfpga ends */
+
+#endif
@@ -0,0 +1,222 @@
+/********************************************************************
+ * This file includes member functions for data structure ThreadPool
+ *******************************************************************/
+#include <algorithm>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_thread_pool.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Mark the threads which are running the tasks of a loop,
+ * where nested loops are executed in the calling thread
+ */
+static thread_local bool in_parallel_loop = false;
+
+/************************************************************************
+ * Constructors
+ ***********************************************************************/
+ThreadPool::ThreadPool(const size_t& num_threads) {
+  num_threads_ = std::max(num_threads, size_t(1));
+  loop_generation_ = 0;
+  num_busy_workers_ = 0;
+  stop_ = false;
+  loop_func_ = nullptr;
+  loop_cancelled_ = false;
+  first_exception_ = nullptr;
+  start_workers();
+}
+
+ThreadPool::~ThreadPool() {
+  stop_workers();
+}
+
+/************************************************************************
+ * Public accessors
+ ***********************************************************************/
+size_t ThreadPool::num_threads() const {
+  return num_threads_;
+}
+
+/************************************************************************
+ * Public mutators
+ ***********************************************************************/
+void ThreadPool::set_num_threads(const size_t& num_threads) {
+  if (std::max(num_threads, size_t(1)) == num_threads_) {
+    return;
+  }
+  std::lock_guard<std::mutex> loop_lock(loop_mutex_);
+  stop_workers();
+  num_threads_ = std::max(num_threads, size_t(1));
+  start_workers();
+}
+
+/************************************************************************
+ * Internal functions
+ ***********************************************************************/
+bool ThreadPool::run_in_calling_thread(const size_t& num_tasks) const {
+  return (1 == num_threads_) || (1 >= num_tasks) || (true == in_parallel_loop);
+}
+
+void ThreadPool::run_tasks(const size_t& num_tasks,
+                           const std::function<void(const size_t&)>& func) const {
+  /* Another thread is running a loop: do not wait for it */
+  std::unique_lock<std::mutex> loop_lock(loop_mutex_, std::try_to_lock);
+  if (false == loop_lock.owns_lock()) {
+    for (size_t itask = 0; itask < num_tasks; ++itask) {
+      func(itask);
+    }
+    return;
+  }
+
+  /* Split the tasks evenly among the threads */
+  for (size_t ithread = 0; ithread < num_threads_; ++ithread) {
+    task_ranges_[ithread]->begin = num_tasks * ithread / num_threads_;
+    task_ranges_[ithread]->end = num_tasks * (ithread + 1) / num_threads_;
+  }
+  loop_func_ = &func;
+  loop_cancelled_ = false;
+  first_exception_ = nullptr;
+
+  /* Wake up the workers */
+  {
+    std::lock_guard<std::mutex> state_lock(state_mutex_);
+    num_busy_workers_ = workers_.size();
+    ++loop_generation_;
+  }
+  start_cv_.notify_all();
+
+  /* The calling thread is also a worker */
+  in_parallel_loop = true;
+  execute_tasks(0);
+  in_parallel_loop = false;
+
+  {
+    std::unique_lock<std::mutex> state_lock(state_mutex_);
+    finish_cv_.wait(state_lock, [&]() { return 0 == num_busy_workers_; });
+  }
+  loop_func_ = nullptr;
+
+  if (nullptr != first_exception_) {
+    std::exception_ptr exception = first_exception_;
+    first_exception_ = nullptr;
+    std::rethrow_exception(exception);
+  }
+}
+
+void ThreadPool::execute_tasks(const size_t& thread_id) const {
+  TaskRange& own_range = *task_ranges_[thread_id];
+  while (false == loop_cancelled_) {
+    /* Take the next task from the front of its own range */
+    size_t itask = 0;
+    bool found_task = false;
+    {
+      std::lock_guard<std::mutex> lock(own_range.mutex);
+      if (own_range.begin < own_range.end) {
+        itask = own_range.begin++;
+        found_task = true;
+      }
+    }
+
+    if (false == found_task) {
+      if (false == steal_tasks(thread_id)) {
+        return;
+      }
+      continue;
+    }
+
+    try {
+      (*loop_func_)(itask);
+    } catch (...) {
+      std::lock_guard<std::mutex> state_lock(state_mutex_);
+      if (nullptr == first_exception_) {
+        first_exception_ = std::current_exception();
+      }
+      /* Stop executing new tasks */
+      loop_cancelled_ = true;
+    }
+  }
+}
+
+bool ThreadPool::steal_tasks(const size_t& thread_id) const {
+  for (size_t offset = 1; offset < num_threads_; ++offset) {
+    TaskRange& victim_range = *task_ranges_[(thread_id + offset) % num_threads_];
+    size_t begin = 0;
+    size_t end = 0;
+    {
+      std::lock_guard<std::mutex> lock(victim_range.mutex);
+      if (victim_range.begin == victim_range.end) {
+        continue;
+      }
+      /* Take the back half, which the victim would execute last */
+      end = victim_range.end;
+      begin = victim_range.begin + (victim_range.end - victim_range.begin) / 2;
+      victim_range.end = begin;
+    }
+
+    TaskRange& own_range = *task_ranges_[thread_id];
+    std::lock_guard<std::mutex> lock(own_range.mutex);
+    own_range.begin = begin;
+    own_range.end = end;
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::worker_loop(const size_t& thread_id, const size_t& start_generation) const {
+  in_parallel_loop = true;
+  /* Loops started before the worker are not for it */
+  size_t finished_generation = start_generation;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> state_lock(state_mutex_);
+      start_cv_.wait(state_lock, [&]() { return (true == stop_) || (finished_generation != loop_generation_); });
+      if (true == stop_) {
+        return;
+      }
+      finished_generation = loop_generation_;
+    }
+
+    execute_tasks(thread_id);
+
+    std::lock_guard<std::mutex> state_lock(state_mutex_);
+    VTR_ASSERT(0 < num_busy_workers_);
+    --num_busy_workers_;
+    if (0 == num_busy_workers_) {
+      finish_cv_.notify_one();
+    }
+  }
+}
+
+void ThreadPool::start_workers() {
+  task_ranges_.clear();
+  for (size_t ithread = 0; ithread < num_threads_; ++ithread) {
+    task_ranges_.emplace_back(new TaskRange());
+    task_ranges_.back()->begin = 0;
+    task_ranges_.back()->end = 0;
+  }
+
+  stop_ = false;
+  /* The calling thread is the thread 0 */
+  for (size_t ithread = 1; ithread < num_threads_; ++ithread) {
+    workers_.emplace_back(&ThreadPool::worker_loop, this, ithread, loop_generation_);
+  }
+}
+
+void ThreadPool::stop_workers() {
+  {
+    std::lock_guard<std::mutex> state_lock(state_mutex_);
+    stop_ = true;
+  }
+  start_cv_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+} /* namespace openfpga ends */
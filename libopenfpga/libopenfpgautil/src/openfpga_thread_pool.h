@@ -0,0 +1,131 @@
+#ifndef OPENFPGA_THREAD_POOL_H
+#define OPENFPGA_THREAD_POOL_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/************************************************************************
+ * This file introduces a pool of threads which are shared by the
+ * parallel loops of OpenFPGA, so that each loop does not create and
+ * join its own threads
+ *
+ * General concept
+ * ---------------
+ * Tasks are identified by an index in the range of [0, num_tasks).
+ * When a loop starts, the range is split evenly among the calling thread
+ * and the worker threads. Each thread executes the tasks of its own range
+ * from the front. When a thread runs out of tasks, it steals the back half
+ * of the range of another thread, so that tasks with different runtime
+ * are balanced among the threads.
+ *
+ * Each task should only write to the data owned by its index,
+ * so that the results are identical whatever the number of threads is.
+ * parallel_map() follows this rule by storing the result of each task
+ * at its index.
+ *
+ * A loop runs in the calling thread, in the order of indices, when
+ * - the pool has only 1 thread
+ * - the loop is nested in a task of another loop
+ * - another thread is running a loop on the same pool,
+ *   e.g., commands are executed concurrently
+ ***********************************************************************/
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+class ThreadPool {
+  public: /* Public constructor */
+    /* The calling thread is counted as one of the threads */
+    explicit ThreadPool(const size_t& num_threads = 1);
+    ~ThreadPool();
+    /* Threads are not copyable */
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+  public: /* Public accessors */
+    size_t num_threads() const;
+
+    /* Run a function on each index of [0, num_tasks)
+     * The first exception thrown by a task is rethrown in the calling thread
+     * after all the threads have finished
+     */
+    template<typename Func>
+    void parallel_for(const size_t& num_tasks, const Func& func) const {
+      if (true == run_in_calling_thread(num_tasks)) {
+        for (size_t itask = 0; itask < num_tasks; ++itask) {
+          func(itask);
+        }
+        return;
+      }
+      run_tasks(num_tasks, std::function<void(const size_t&)>(std::cref(func)));
+    }
+
+    /* Run a function on each index of [0, num_tasks) and
+     * return the results in the order of indices
+     */
+    template<typename T, typename Func>
+    std::vector<T> parallel_map(const size_t& num_tasks, const Func& func) const {
+      /* Bits of std::vector<bool> are not independent objects */
+      static_assert(false == std::is_same<T, bool>::value, "Results of parallel tasks cannot be bool");
+      std::vector<T> results(num_tasks);
+      parallel_for(num_tasks, [&](const size_t& itask) {
+        results[itask] = func(itask);
+      });
+      return results;
+    }
+
+  public: /* Public mutators */
+    /* Resize the pool, which should not be called during a loop */
+    void set_num_threads(const size_t& num_threads);
+
+  private: /* Internal functions */
+    bool run_in_calling_thread(const size_t& num_tasks) const;
+    void run_tasks(const size_t& num_tasks, const std::function<void(const size_t&)>& func) const;
+    void execute_tasks(const size_t& thread_id) const;
+    bool steal_tasks(const size_t& thread_id) const;
+    void worker_loop(const size_t& thread_id, const size_t& start_generation) const;
+    void start_workers();
+    void stop_workers();
+
+  private: /* Internal data */
+    /* Range of tasks owned by a thread */
+    struct TaskRange {
+      std::mutex mutex;
+      size_t begin;
+      size_t end;
+    };
+
+    size_t num_threads_;
+    std::vector<std::thread> workers_;
+
+    /* Only one loop runs on the pool at a time */
+    mutable std::mutex loop_mutex_;
+
+    /* Synchronization between the calling thread and the workers */
+    mutable std::mutex state_mutex_;
+    mutable std::condition_variable start_cv_;
+    mutable std::condition_variable finish_cv_;
+    mutable size_t loop_generation_;
+    mutable size_t num_busy_workers_;
+    bool stop_;
+
+    /* Data of the running loop */
+    mutable const std::function<void(const size_t&)>* loop_func_;
+    mutable std::vector<std::unique_ptr<TaskRange>> task_ranges_;
+    mutable std::atomic<bool> loop_cancelled_;
+    mutable std::exception_ptr first_exception_;
+};
+
+} /* namespace openfpga ends */
+
+#endif
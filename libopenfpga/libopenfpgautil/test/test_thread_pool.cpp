@@ -0,0 +1,194 @@
+/********************************************************************
+ * Unit test functions to validate the correctness of the thread pool
+ * 1. results of parallel loops are in the order of indices,
+ *    whatever the number of threads is
+ * 2. nested loops and concurrent loops run in the calling thread
+ * 3. exceptions of tasks are rethrown in the calling thread
+ *******************************************************************/
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_thread_pool.h"
+
+/********************************************************************
+ * The results of a loop should be identical for any number of threads,
+ * including the tasks with very different runtime, which are stolen
+ * by other threads, and the loops with fewer tasks than threads
+ *******************************************************************/
+static
+void test_thread_pool_ordering() {
+  const std::vector<size_t> num_tasks_list = {0, 1, 3, 1000};
+
+  for (const size_t& num_threads : std::vector<size_t>({1, 2, 4, 8})) {
+    openfpga::ThreadPool thread_pool(num_threads);
+    VTR_ASSERT(num_threads == thread_pool.num_threads());
+
+    for (const size_t& num_tasks : num_tasks_list) {
+      /* Run the same pool several times to check that it can be reused */
+      for (size_t irun = 0; irun < 3; ++irun) {
+        std::vector<size_t> results = thread_pool.parallel_map<size_t>(num_tasks, [](const size_t& itask) {
+          size_t result = itask;
+          /* Make a few tasks much longer than the others */
+          size_t num_iterations = (0 == itask % 97) ? 100000 : 10;
+          for (size_t iter = 0; iter < num_iterations; ++iter) {
+            result = (result * 31 + iter) % 1000003;
+          }
+          return result;
+        });
+
+        VTR_ASSERT(num_tasks == results.size());
+        for (size_t itask = 0; itask < num_tasks; ++itask) {
+          size_t expected = itask;
+          size_t num_iterations = (0 == itask % 97) ? 100000 : 10;
+          for (size_t iter = 0; iter < num_iterations; ++iter) {
+            expected = (expected * 31 + iter) % 1000003;
+          }
+          VTR_ASSERT(expected == results[itask]);
+        }
+      }
+    }
+  }
+
+  /* Each task is executed exactly once */
+  openfpga::ThreadPool thread_pool(4);
+  std::vector<size_t> num_executions(1000, 0);
+  thread_pool.parallel_for(num_executions.size(), [&](const size_t& itask) {
+    num_executions[itask]++;
+  });
+  for (const size_t& num_execution : num_executions) {
+    VTR_ASSERT(1 == num_execution);
+  }
+
+  /* The pool can be resized between loops */
+  thread_pool.set_num_threads(2);
+  VTR_ASSERT(2 == thread_pool.num_threads());
+  std::vector<size_t> results = thread_pool.parallel_map<size_t>(100, [](const size_t& itask) {
+    return 2 * itask;
+  });
+  for (size_t itask = 0; itask < results.size(); ++itask) {
+    VTR_ASSERT(2 * itask == results[itask]);
+  }
+
+  VTR_LOG("Tested ordering of parallel loops.\n");
+}
+
+/********************************************************************
+ * A loop nested in a task runs in the thread of the task, in the order
+ * of indices, and a loop started while another thread is running a loop
+ * on the same pool runs in its calling thread
+ *******************************************************************/
+static
+void test_thread_pool_serial_fallback() {
+  openfpga::ThreadPool thread_pool(4);
+
+  /* Nested loops */
+  std::vector<std::vector<size_t>> nested_results(16);
+  std::vector<std::vector<std::thread::id>> nested_thread_ids(16);
+  std::vector<std::thread::id> outer_thread_ids(16);
+  thread_pool.parallel_for(nested_results.size(), [&](const size_t& itask) {
+    outer_thread_ids[itask] = std::this_thread::get_id();
+    nested_thread_ids[itask].resize(50);
+    thread_pool.parallel_for(50, [&](const size_t& jtask) {
+      nested_results[itask].push_back(jtask);
+      nested_thread_ids[itask][jtask] = std::this_thread::get_id();
+    });
+  });
+  for (size_t itask = 0; itask < nested_results.size(); ++itask) {
+    VTR_ASSERT(50 == nested_results[itask].size());
+    for (size_t jtask = 0; jtask < nested_results[itask].size(); ++jtask) {
+      VTR_ASSERT(jtask == nested_results[itask][jtask]);
+      VTR_ASSERT(outer_thread_ids[itask] == nested_thread_ids[itask][jtask]);
+    }
+  }
+
+  /* Concurrent loops from threads which do not belong to the pool */
+  std::vector<std::vector<size_t>> concurrent_results(4);
+  std::vector<std::thread> callers;
+  for (size_t icaller = 0; icaller < concurrent_results.size(); ++icaller) {
+    callers.push_back(std::thread([&, icaller]() {
+      concurrent_results[icaller] = thread_pool.parallel_map<size_t>(1000, [&](const size_t& itask) {
+        return icaller * 1000 + itask;
+      });
+    }));
+  }
+  for (std::thread& caller : callers) {
+    caller.join();
+  }
+  for (size_t icaller = 0; icaller < concurrent_results.size(); ++icaller) {
+    VTR_ASSERT(1000 == concurrent_results[icaller].size());
+    for (size_t itask = 0; itask < concurrent_results[icaller].size(); ++itask) {
+      VTR_ASSERT(icaller * 1000 + itask == concurrent_results[icaller][itask]);
+    }
+  }
+
+  VTR_LOG("Tested serial fallback of nested and concurrent loops.\n");
+}
+
+/********************************************************************
+ * An exception thrown by a task is rethrown by the loop,
+ * and the pool is still usable afterwards
+ *******************************************************************/
+static
+void test_thread_pool_exception() {
+  for (const size_t& num_threads : std::vector<size_t>({1, 4})) {
+    openfpga::ThreadPool thread_pool(num_threads);
+
+    bool caught = false;
+    try {
+      thread_pool.parallel_for(1000, [](const size_t& itask) {
+        if (500 == itask) {
+          throw std::runtime_error("task failed");
+        }
+      });
+    } catch (const std::runtime_error& e) {
+      caught = (std::string("task failed") == e.what());
+    }
+    VTR_ASSERT(true == caught);
+
+    /* Exception in a nested loop is rethrown through the outer loop */
+    caught = false;
+    try {
+      thread_pool.parallel_for(8, [&](const size_t& itask) {
+        thread_pool.parallel_for(8, [&](const size_t& jtask) {
+          if ((3 == itask) && (5 == jtask)) {
+            throw std::out_of_range("nested task failed");
+          }
+        });
+      });
+    } catch (const std::out_of_range&) {
+      caught = true;
+    }
+    VTR_ASSERT(true == caught);
+
+    /* The pool runs the next loops normally */
+    std::vector<size_t> results = thread_pool.parallel_map<size_t>(1000, [](const size_t& itask) {
+      return itask + 1;
+    });
+    for (size_t itask = 0; itask < results.size(); ++itask) {
+      VTR_ASSERT(itask + 1 == results[itask]);
+    }
+  }
+
+  VTR_LOG("Tested exceptions of parallel loops.\n");
+}
+
+int main(int argc, const char** argv) {
+  /* No argument is required */
+  VTR_ASSERT(1 == argc);
+  (void)argv;
+
+  test_thread_pool_ordering();
+  test_thread_pool_serial_fallback();
+  test_thread_pool_exception();
+
+  VTR_LOG("All the tests of thread pool passed.\n");
+
+  return 0;
+}
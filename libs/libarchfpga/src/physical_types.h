@@ -1045,6 +1045,10 @@ class t_pb_graph_node {
 
     int total_pb_pins; /* only valid for top-level */
 
+    /* Index of the logical block type whose pb_graph_head is the top-level node of this node,
+     * so that the top-level node of a pin is found without walking through its parents */
+    int logical_block_type_index;
+
     void* temp_scratch_pad;                                     /* temporary data, useful for keeping track of things when traversing data structure */
     t_cluster_placement_primitive* cluster_placement_primitive; /* pointer to indexing structure useful during packing stage */
 
@@ -5,7 +5,15 @@
 
 namespace vtr {
 
-int f_timer_depth = 0;
+//Depth of nested timers, which is tracked per thread so that
+//timers running concurrently in different threads do not interfere
+static thread_local int f_timer_depth = 0;
+
+static ScopedTimerObserver f_scoped_timer_observer;
+
+void set_scoped_timer_observer(ScopedTimerObserver observer) {
+    f_scoped_timer_observer = observer;
+}
 
 Timer::Timer()
     : start_(clock::now())
@@ -31,6 +39,9 @@ ScopedActionTimer::ScopedActionTimer(std::string action_str)
 
 ScopedActionTimer::~ScopedActionTimer() {
     --f_timer_depth;
+    if (f_scoped_timer_observer) {
+        f_scoped_timer_observer(action_, elapsed_sec(), max_rss_mib(), delta_max_rss_mib());
+    }
 }
 
 void ScopedActionTimer::quiet(bool value) {
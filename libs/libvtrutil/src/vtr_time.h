@@ -1,6 +1,7 @@
 #ifndef VTR_TIME_H
 #define VTR_TIME_H
 #include <chrono>
+#include <functional>
 #include <string>
 
 namespace vtr {
@@ -55,6 +56,14 @@ class ScopedActionTimer : public Timer {
     int depth_;
 };
 
+//Callback invoked when a ScopedActionTimer is destructed, e.g., by profilers.
+//It receives the action, the elapsed time (in seconds), the peak memory
+//resident set size and its change (in MiB)
+typedef std::function<void(const std::string&, float, float, float)> ScopedTimerObserver;
+
+//Set the callback for all the ScopedActionTimers. An empty callback disables it
+void set_scoped_timer_observer(ScopedTimerObserver observer);
+
 //Scoped elapsed time class which prints the time elapsed for
 //the specified action when it is destructed.
 //
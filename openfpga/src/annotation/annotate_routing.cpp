@@ -2,10 +2,16 @@
  * This file includes functions that are used to annotate routing results
  * from VPR to OpenFPGA
  *******************************************************************/
+#include <unordered_map>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_thread_pool.h"
+
 #include "annotate_routing.h"
 
 /* begin namespace openfpga */
@@ -58,10 +64,14 @@ void annotate_rr_node_nets(const DeviceContext& device_ctx,
  * It requires a candidate which provided by upstream functions
  * Try to validate a candidate by searching it from driving node list
  * If not validated, try to find a right one in the routing traces
+ *
+ * The position of each node in the routing traces, i.e., where the node
+ * appears for the first time, is given in trace_node_positions,
+ * so that the search only visits the driving nodes of the rr_node
  *******************************************************************/
 static 
 RRNodeId find_previous_node_from_routing_traces(const RRGraph& rr_graph,
-                                                t_trace* routing_trace_head,
+                                                const std::unordered_map<RRNodeId, size_t>& trace_node_positions,
                                                 const RRNodeId& prev_node_candidate,
                                                 const RRNodeId& cur_rr_node) {
   RRNodeId prev_node = prev_node_candidate;
@@ -69,19 +79,13 @@ RRNodeId find_previous_node_from_routing_traces(const RRGraph& rr_graph,
   /* For a valid prev_node, ensure prev node is one of the driving nodes for this rr_node! */
   if (prev_node) {
     /* Try to spot the previous node in the incoming node list of this rr_node */
-    bool valid_prev_node = false;
     for (const RREdgeId& in_edge : rr_graph.node_in_edges(cur_rr_node)) {
       if (prev_node == rr_graph.edge_src_node(in_edge)) {
-        valid_prev_node = true;
-        break;
+        /* Early exit if we already validate the node */
+        return prev_node;
       }
     }
 
-    /* Early exit if we already validate the node */
-    if (true == valid_prev_node) {
-      return prev_node;
-    }
-
     /* If we cannot find one, it could be possible that this rr_node branches 
      * from an earlier point in the routing tree
      *
@@ -91,54 +95,93 @@ RRNodeId find_previous_node_from_routing_traces(const RRGraph& rr_graph,
      *            |
      *            +-----+ rr_node
      *
-     * Our job now is to start from the head of the traces and find the prev_node 
-     * that drives this rr_node
+     * Our job now is to find the driving node of this rr_node 
+     * which appears first in the routing traces
      *
      * This search will find the first-fit and finish.
      * This is reasonable because if there is a second-fit, it should be a longer path
      * which should be considered in routing optimization
      */
-    if (false == valid_prev_node) {
-      t_trace* tptr = routing_trace_head;
-      while (tptr != nullptr) {
-        RRNodeId cand_prev_node = tptr->index;
-        bool is_good_cand = false;
-        for (const RREdgeId& in_edge : rr_graph.node_in_edges(cur_rr_node)) {
-          if (cand_prev_node == rr_graph.edge_src_node(in_edge)) {
-            is_good_cand = true;
-            break;
-          }
-        }
-  
-        if (true == is_good_cand) {
-          /* Update prev_node */
-          prev_node = cand_prev_node;
-          break;
-        }
-
-        /* Move on to the next */
-        tptr = tptr->next;
+    size_t first_position = trace_node_positions.size();
+    for (const RREdgeId& in_edge : rr_graph.node_in_edges(cur_rr_node)) {
+      RRNodeId cand_prev_node = rr_graph.edge_src_node(in_edge);
+      auto it = trace_node_positions.find(cand_prev_node);
+      if ( (it != trace_node_positions.end())
+        && (it->second < first_position) ) {
+        /* Update prev_node */
+        prev_node = cand_prev_node;
+        first_position = it->second;
       }
-    } 
+    }
   }
 
   return prev_node; 
 }
 
+/********************************************************************
+ * Find the previous node of each rr_node in the routing traces of a net
+ * Return the pairs of rr_node and its previous node in the order of traces
+ *******************************************************************/
+static 
+std::vector<std::pair<RRNodeId, RRNodeId>> find_net_rr_node_previous_nodes(const RRGraph& rr_graph,
+                                                                           t_trace* routing_trace_head) {
+  std::vector<std::pair<RRNodeId, RRNodeId>> prev_nodes;
+
+  /* Index the nodes by their first position in the routing traces */
+  std::unordered_map<RRNodeId, size_t> trace_node_positions;
+  for (t_trace* tptr = routing_trace_head; tptr != nullptr; tptr = tptr->next) {
+    trace_node_positions.insert(std::make_pair(RRNodeId(tptr->index), trace_node_positions.size()));
+  }
+
+  /* Cache Previous nodes */
+  RRNodeId prev_node = RRNodeId::INVALID();
+
+  t_trace* tptr = routing_trace_head;
+  while (tptr != nullptr) {
+    RRNodeId rr_node = tptr->index;
+
+    /* Find the right previous node */
+    prev_node = find_previous_node_from_routing_traces(rr_graph,
+                                                       trace_node_positions,
+                                                       prev_node,
+                                                       rr_node);
+
+    /* Only update mapped nodes */
+    if (prev_node) {
+      prev_nodes.push_back(std::make_pair(rr_node, prev_node));
+    }
+
+    /* Update prev_node */
+    prev_node = rr_node;
+
+    /* Move on to the next */
+    tptr = tptr->next;
+  }
+
+  return prev_nodes;
+}
+
 /********************************************************************
  * Create a mapping between each rr_node and its previous node
  * based on VPR routing results
  * - Unmapped rr_node will have an invalid id of previous rr_node
+ *
+ * The previous nodes of each net are found in parallel. 
+ * As a SOURCE or SINK node may be shared by several nets,
+ * the results are annotated in the order of nets, 
+ * which is the same whatever the number of threads is
  *******************************************************************/
 void annotate_rr_node_previous_nodes(const DeviceContext& device_ctx,
                                      const ClusteringContext& clustering_ctx,
                                      const RoutingContext& routing_ctx,
                                      VprRoutingAnnotation& vpr_routing_annotation,
+                                     const ThreadPool& thread_pool,
                                      const bool& verbose) {
   size_t counter = 0;
   VTR_LOG("Annotating previous nodes for rr_node...");
   VTR_LOGV(verbose, "\n");
-   
+
+  std::vector<ClusterNetId> routed_nets;
   for (auto net_id : clustering_ctx.clb_nlist.nets()) {
     /* Ignore nets that are not routed */
     if (true == clustering_ctx.clb_nlist.net_is_ignored(net_id)) {
@@ -148,31 +191,20 @@ void annotate_rr_node_previous_nodes(const DeviceContext& device_ctx,
     if (false == clustering_ctx.clb_nlist.net_sinks(net_id).size()) {
       continue;
     }
-    
-    /* Cache Previous nodes */
-    RRNodeId prev_node = RRNodeId::INVALID();
-
-    t_trace* tptr = routing_ctx.trace[net_id].head;
-    while (tptr != nullptr) {
-      RRNodeId rr_node = tptr->index;
-
-      /* Find the right previous node */
-      prev_node = find_previous_node_from_routing_traces(device_ctx.rr_graph,
-                                                         routing_ctx.trace[net_id].head,
-                                                         prev_node,
-                                                         rr_node);
-
-      /* Only update mapped nodes */
-      if (prev_node) {
-        vpr_routing_annotation.set_rr_node_prev_node(rr_node, prev_node);
-        counter++;
-      }
-
-      /* Update prev_node */
-      prev_node = rr_node;
+    routed_nets.push_back(net_id);
+  }
 
-      /* Move on to the next */
-      tptr = tptr->next;
+  std::vector<std::vector<std::pair<RRNodeId, RRNodeId>>> net_prev_nodes(routed_nets.size());
+  thread_pool.parallel_for(routed_nets.size(),
+                           [&](const size_t& inet) {
+                             net_prev_nodes[inet] = find_net_rr_node_previous_nodes(device_ctx.rr_graph,
+                                                                                    routing_ctx.trace[routed_nets[inet]].head);
+                           });
+
+  for (const std::vector<std::pair<RRNodeId, RRNodeId>>& prev_nodes : net_prev_nodes) {
+    for (const std::pair<RRNodeId, RRNodeId>& prev_node : prev_nodes) {
+      vpr_routing_annotation.set_rr_node_prev_node(prev_node.first, prev_node.second);
+      counter++;
     }
   }
 
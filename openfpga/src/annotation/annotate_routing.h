@@ -25,6 +25,7 @@ void annotate_rr_node_previous_nodes(const DeviceContext& device_ctx,
                                      const ClusteringContext& clustering_ctx,
                                      const RoutingContext& routing_ctx,
                                      VprRoutingAnnotation& vpr_routing_annotation,
+                                     const ThreadPool& thread_pool,
                                      const bool& verbose);
 
 } /* end namespace openfpga */
@@ -26,6 +26,10 @@ bool VprClusteringAnnotation::is_net_renamed(const ClusterBlockId& block_id, con
   return (net_names_.at(block_id).end() != net_names_.at(block_id).find(pin_index));
 }
 
+bool VprClusteringAnnotation::is_block_net_renamed(const ClusterBlockId& block_id) const {
+  return (net_names_.end() != net_names_.find(block_id));
+}
+
 ClusterNetId VprClusteringAnnotation::net(const ClusterBlockId& block_id, const int& pin_index) const {
   VTR_ASSERT(true == is_net_renamed(block_id, pin_index));
   return net_names_.at(block_id).at(pin_index);
@@ -32,6 +32,8 @@ class VprClusteringAnnotation {
      * In this case, return an invalid value does not mean that a net is not renamed
      */
     bool is_net_renamed(const ClusterBlockId& block_id, const int& pin_index) const;
+    /* Check if any pin of a block has been renamed, e.g., by the pin fix-up after routing */
+    bool is_block_net_renamed(const ClusterBlockId& block_id) const;
     ClusterNetId net(const ClusterBlockId& block_id, const int& pin_index) const;
     bool is_truth_table_adapted(t_pb* pb) const;
     AtomNetlist::TruthTable truth_table(t_pb* pb) const;
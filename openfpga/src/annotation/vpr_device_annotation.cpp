@@ -123,24 +123,14 @@ std::vector<size_t> VprDeviceAnnotation::pb_type_mode_bits(t_pb_type* pb_type) c
 }
 
 PbGraphNodeId VprDeviceAnnotation::pb_graph_node_unique_index(t_pb_graph_node* pb_graph_node) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, std::vector<t_pb_graph_node*>>::const_iterator it = pb_graph_node_unique_index_.find(pb_graph_node->pb_type);
-  if (it == pb_graph_node_unique_index_.end()) {
-    /* Invalid pb_type, return a null pointer */
-    return PbGraphNodeId::INVALID();
-  }
-
-  /* Try to find the pb_graph_node in the vector */
-  std::vector<t_pb_graph_node*>::const_iterator it_node = std::find(pb_graph_node_unique_index_.at(pb_graph_node->pb_type).begin(),
-                                                                    pb_graph_node_unique_index_.at(pb_graph_node->pb_type).end(),
-                                                                    pb_graph_node);
-  /* If it exists, return the index
+  /* If the pb_graph_node exists, return the index
    * Otherwise, return an invalid id
    */
-  if (it_node == pb_graph_node_unique_index_.at(pb_graph_node->pb_type).end()) {
+  std::unordered_map<const t_pb_graph_node*, PbGraphNodeId>::const_iterator it = pb_graph_node_unique_ids_.find(pb_graph_node);
+  if (it == pb_graph_node_unique_ids_.end()) {
     return PbGraphNodeId::INVALID();
   }
-  return PbGraphNodeId(it_node - pb_graph_node_unique_index_.at(pb_graph_node->pb_type).begin());
+  return it->second;
 }
 
 t_pb_graph_node* VprDeviceAnnotation::pb_graph_node(t_pb_type* pb_type, const PbGraphNodeId& unique_index) const {
@@ -163,11 +153,11 @@ t_pb_graph_node* VprDeviceAnnotation::pb_graph_node(t_pb_type* pb_type, const Pb
 
 t_pb_graph_node* VprDeviceAnnotation::physical_pb_graph_node(t_pb_graph_node* pb_graph_node) const {
   /* Ensure that the pb_graph_node is in the list */
-  std::map<t_pb_graph_node*, t_pb_graph_node*>::const_iterator it = physical_pb_graph_nodes_.find(pb_graph_node);
+  std::unordered_map<const t_pb_graph_node*, t_pb_graph_node*>::const_iterator it = physical_pb_graph_nodes_.find(pb_graph_node);
   if (it == physical_pb_graph_nodes_.end()) {
     return nullptr;
   }
-  return physical_pb_graph_nodes_.at(pb_graph_node);
+  return it->second;
 }
 
 float VprDeviceAnnotation::physical_pb_type_index_factor(t_pb_type* pb_type) const {
@@ -236,38 +226,40 @@ int VprDeviceAnnotation::physical_pb_pin_offset(t_port* operating_pb_port,
 }
 
 t_pb_graph_pin* VprDeviceAnnotation::physical_pb_graph_pin(const t_pb_graph_pin* pb_graph_pin) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<const t_pb_graph_pin*, t_pb_graph_pin*>::const_iterator it = physical_pb_graph_pins_.find(pb_graph_pin);
-  if (it == physical_pb_graph_pins_.end()) {
+  /* Ensure that the pb_graph_pin is in the list */
+  size_t type_index = pb_graph_pin->parent_node->logical_block_type_index;
+  if (type_index >= physical_pb_graph_pins_.size()) {
+    return nullptr;
+  }
+  const std::vector<t_pb_graph_pin*>& type_physical_pins = physical_pb_graph_pins_[type_index];
+  if ((size_t)pb_graph_pin->pin_count_in_cluster >= type_physical_pins.size()) {
     return nullptr;
   }
-  return physical_pb_graph_pins_.at(pb_graph_pin);
+  return type_physical_pins[pb_graph_pin->pin_count_in_cluster];
 }
 
 CircuitModelId VprDeviceAnnotation::rr_switch_circuit_model(const RRSwitchId& rr_switch) const {
   /* Ensure that the rr_switch is in the list */
-  std::map<RRSwitchId, CircuitModelId>::const_iterator it = rr_switch_circuit_models_.find(rr_switch);
-  if (it == rr_switch_circuit_models_.end()) {
+  if (size_t(rr_switch) >= rr_switch_circuit_models_.size()) {
     return CircuitModelId::INVALID();
   }
-  return rr_switch_circuit_models_.at(rr_switch);
+  return rr_switch_circuit_models_[rr_switch];
 }
 
 CircuitModelId VprDeviceAnnotation::rr_segment_circuit_model(const RRSegmentId& rr_segment) const {
-  /* Ensure that the rr_switch is in the list */
-  std::map<RRSegmentId, CircuitModelId>::const_iterator it = rr_segment_circuit_models_.find(rr_segment);
-  if (it == rr_segment_circuit_models_.end()) {
+  /* Ensure that the rr_segment is in the list */
+  if (size_t(rr_segment) >= rr_segment_circuit_models_.size()) {
     return CircuitModelId::INVALID();
   }
-  return rr_segment_circuit_models_.at(rr_segment);
+  return rr_segment_circuit_models_[rr_segment];
 }
 
 ArchDirectId VprDeviceAnnotation::direct_annotation(const size_t& direct) const {
-  /* Ensure that the rr_switch is in the list */
-  if (0 == direct_annotations_.count(direct)) {
+  /* Ensure that the direct is in the list */
+  if (direct >= direct_annotations_.size()) {
     return ArchDirectId::INVALID();
   }
-  return direct_annotations_.at(direct);
+  return direct_annotations_[direct];
 }
 
 LbRRGraph VprDeviceAnnotation::physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const {
@@ -384,13 +376,15 @@ void VprDeviceAnnotation::add_pb_type_mode_bits(t_pb_type* pb_type, const std::v
 }
 
 void VprDeviceAnnotation::add_pb_graph_node_unique_index(t_pb_graph_node* pb_graph_node) {
-  pb_graph_node_unique_index_[pb_graph_node->pb_type].push_back(pb_graph_node);
+  std::vector<t_pb_graph_node*>& pb_graph_nodes = pb_graph_node_unique_index_[pb_graph_node->pb_type];
+  pb_graph_node_unique_ids_[pb_graph_node] = PbGraphNodeId(pb_graph_nodes.size());
+  pb_graph_nodes.push_back(pb_graph_node);
 }
 
 void VprDeviceAnnotation::add_physical_pb_graph_node(t_pb_graph_node* operating_pb_graph_node, 
                                                      t_pb_graph_node* physical_pb_graph_node) {
   /* Warn any override attempt */
-  std::map<t_pb_graph_node*, t_pb_graph_node*>::const_iterator it = physical_pb_graph_nodes_.find(operating_pb_graph_node);
+  std::unordered_map<const t_pb_graph_node*, t_pb_graph_node*>::const_iterator it = physical_pb_graph_nodes_.find(operating_pb_graph_node);
   if (it != physical_pb_graph_nodes_.end()) {
     VTR_LOG_WARN("Override the annotation between operating pb_graph_node '%s[%d]' and it physical pb_graph_node '%s[%d]'!\n",
                  operating_pb_graph_node->pb_type->name, 
@@ -457,13 +451,30 @@ void VprDeviceAnnotation::add_physical_pb_pin_rotate_offset(t_port* operating_pb
 void VprDeviceAnnotation::add_physical_pb_graph_pin(const t_pb_graph_pin* operating_pb_graph_pin, 
                                                     t_pb_graph_pin* physical_pb_graph_pin) {
   /* Warn any override attempt */
-  std::map<const t_pb_graph_pin*, t_pb_graph_pin*>::const_iterator it = physical_pb_graph_pins_.find(operating_pb_graph_pin);
-  if (it != physical_pb_graph_pins_.end()) {
+  if (nullptr != this->physical_pb_graph_pin(operating_pb_graph_pin)) {
     VTR_LOG_WARN("Override the annotation between operating pb_graph_pin '%s' and it physical pb_graph_pin '%s'!\n",
                  operating_pb_graph_pin->port->name, physical_pb_graph_pin->port->name);
   }
 
-  physical_pb_graph_pins_[operating_pb_graph_pin] = physical_pb_graph_pin;
+  /* Create the table for the top-level pb_graph_node when it is seen for the first time */
+  size_t type_index = operating_pb_graph_pin->parent_node->logical_block_type_index;
+  if (type_index >= physical_pb_graph_pins_.size()) {
+    physical_pb_graph_pins_.resize(type_index + 1);
+  }
+  std::vector<t_pb_graph_pin*>& type_physical_pins = physical_pb_graph_pins_[type_index];
+  if (true == type_physical_pins.empty()) {
+    const t_pb_graph_node* pb_graph_head = operating_pb_graph_pin->parent_node;
+    while (nullptr != pb_graph_head->parent_pb_graph_node) {
+      pb_graph_head = pb_graph_head->parent_pb_graph_node;
+    }
+    type_physical_pins.resize(pb_graph_head->total_pb_pins, nullptr);
+  }
+
+  size_t pin_index = operating_pb_graph_pin->pin_count_in_cluster;
+  if (pin_index >= type_physical_pins.size()) {
+    type_physical_pins.resize(pin_index + 1, nullptr);
+  }
+  type_physical_pins[pin_index] = physical_pb_graph_pin;
 
   /* Update the accumulated offsets for the operating port 
    * Each time we pair two pins, we update the offset by the pin rotate offset
@@ -493,33 +504,40 @@ void VprDeviceAnnotation::add_physical_pb_graph_pin(const t_pb_graph_pin* operat
 
 void VprDeviceAnnotation::add_rr_switch_circuit_model(const RRSwitchId& rr_switch, const CircuitModelId& circuit_model) {
   /* Warn any override attempt */
-  std::map<RRSwitchId, CircuitModelId>::const_iterator it = rr_switch_circuit_models_.find(rr_switch);
-  if (it != rr_switch_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != rr_switch_circuit_model(rr_switch)) {
     VTR_LOG_WARN("Override the annotation between rr_switch '%ld' and its circuit_model '%ld'!\n",
                  size_t(rr_switch), size_t(circuit_model));
   }
 
+  if (size_t(rr_switch) >= rr_switch_circuit_models_.size()) {
+    rr_switch_circuit_models_.resize(size_t(rr_switch) + 1, CircuitModelId::INVALID());
+  }
   rr_switch_circuit_models_[rr_switch] = circuit_model;
 }
 
 void VprDeviceAnnotation::add_rr_segment_circuit_model(const RRSegmentId& rr_segment, const CircuitModelId& circuit_model) {
   /* Warn any override attempt */
-  std::map<RRSegmentId, CircuitModelId>::const_iterator it = rr_segment_circuit_models_.find(rr_segment);
-  if (it != rr_segment_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != rr_segment_circuit_model(rr_segment)) {
     VTR_LOG_WARN("Override the annotation between rr_segment '%ld' and its circuit_model '%ld'!\n",
                  size_t(rr_segment), size_t(circuit_model));
   }
 
+  if (size_t(rr_segment) >= rr_segment_circuit_models_.size()) {
+    rr_segment_circuit_models_.resize(size_t(rr_segment) + 1, CircuitModelId::INVALID());
+  }
   rr_segment_circuit_models_[rr_segment] = circuit_model;
 }
 
 void VprDeviceAnnotation::add_direct_annotation(const size_t& direct, const ArchDirectId& arch_direct_id) {
   /* Warn any override attempt */
-  if (0 < direct_annotations_.count(direct)) {
+  if (ArchDirectId::INVALID() != direct_annotation(direct)) {
     VTR_LOG_WARN("Override the annotation between direct '%ld' and its annotation '%ld'!\n",
                  size_t(direct), size_t(arch_direct_id));
   }
 
+  if (direct >= direct_annotations_.size()) {
+    direct_annotations_.resize(direct + 1, ArchDirectId::INVALID());
+  }
   direct_annotations_[direct] = arch_direct_id;
 }
 
@@ -5,9 +5,12 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 #include <map> 
+#include <unordered_map> 
+#include <vector> 
 
 /* Header from vtrutil library */
 #include "vtr_strong_id.h"
+#include "vtr_vector.h"
 
 /* Header from archfpga library */
 #include "physical_types.h"
@@ -176,24 +179,37 @@ class VprDeviceAnnotation {
      * The unique index if the index in the array of t_pb_graph_node*
      */ 
     std::map<t_pb_type*, std::vector<t_pb_graph_node*>> pb_graph_node_unique_index_;
+    /* Fast look-up of the unique index of a pb_graph_node */
+    std::unordered_map<const t_pb_graph_node*, PbGraphNodeId> pb_graph_node_unique_ids_;
 
     /* Pair a pb_graph_node to a physical pb_graph_node
      * Note:
      * - the pb_type of physical pb_graph_node must be a physical pb_type
      */
-    std::map<t_pb_graph_node*, t_pb_graph_node*> physical_pb_graph_nodes_;
+    std::unordered_map<const t_pb_graph_node*, t_pb_graph_node*> physical_pb_graph_nodes_;
 
-    /* Pair a pb_graph_pin to a physical pb_graph_pin */
-    std::map<const t_pb_graph_pin*, t_pb_graph_pin*> physical_pb_graph_pins_;
+    /* Pair a pb_graph_pin to a physical pb_graph_pin
+     * The pins are indexed by the logical block type of the top-level pb_graph_node 
+     * they belong to, i.e., logical_block_type_index of their parent node,
+     * and then by their unique index in the top-level pb_graph_node, i.e., pin_count_in_cluster
+     * Pins without a physical pb_graph_pin are paired to nullptr
+     */
+    std::vector<std::vector<t_pb_graph_pin*>> physical_pb_graph_pins_;
 
-    /* Pair a Routing Resource Switch (rr_switch) to a circuit model */
-    std::map<RRSwitchId, CircuitModelId> rr_switch_circuit_models_;
+    /* Pair a Routing Resource Switch (rr_switch) to a circuit model
+     * Switches without circuit model are paired to an invalid id
+     */
+    vtr::vector<RRSwitchId, CircuitModelId> rr_switch_circuit_models_;
 
-    /* Pair a Routing Segment (rr_segment) to a circuit model */
-    std::map<RRSegmentId, CircuitModelId> rr_segment_circuit_models_;
+    /* Pair a Routing Segment (rr_segment) to a circuit model
+     * Segments without circuit model are paired to an invalid id
+     */
+    vtr::vector<RRSegmentId, CircuitModelId> rr_segment_circuit_models_;
 
-    /* Pair a direct connection (direct) to a annotation which contains circuit model id */
-    std::map<size_t, ArchDirectId> direct_annotations_;
+    /* Pair a direct connection (direct) to a annotation which contains circuit model id
+     * Directs without annotation are paired to an invalid id
+     */
+    std::vector<ArchDirectId> direct_annotations_;
 
     /* Logical type routing resource graphs built from physical modes */
     std::map<t_pb_graph_node*, LbRRGraph> physical_lb_rr_graphs_;
@@ -1,6 +1,8 @@
 /********************************************************************
  * This file includes functions to build bitstream database
  *******************************************************************/
+#include <stdexcept>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_log.h"
@@ -10,15 +12,23 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_tokenizer.h"
+#include "openfpga_file_writer.h"
 
 /* Headers from fpgabitstream library */
 #include "read_xml_arch_bitstream.h"
 #include "write_xml_arch_bitstream.h"
+#include "bitstream_manager_utils.h"
 
+#include "openfpga_naming.h"
+#include "openfpga_build_fabric.h"
 #include "build_device_bitstream.h"
 #include "write_text_fabric_bitstream.h"
 #include "write_xml_fabric_bitstream.h"
+#include "report_fabric_bitstream_config_time.h"
 #include "build_fabric_bitstream.h"
+#include "query_bitstream.h"
+#include "openfpga_command_thread_pool.h"
 #include "openfpga_bitstream.h"
 
 /* Include global variables of VPR */
@@ -36,13 +46,100 @@ int fpga_bitstream(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_verbose = cmd.option("verbose");
   CommandOptionId opt_write_file = cmd.option("write_file");
   CommandOptionId opt_read_file = cmd.option("read_file");
+  CommandOptionId opt_write_index = cmd.option("write_index");
+  CommandOptionId opt_read_index = cmd.option("read_index");
+  CommandOptionId opt_block = cmd.option("block");
+  CommandOptionId opt_incremental = cmd.option("incremental");
+
+  /* A block is read from a file through its index */
+  if ( ( (true == cmd_context.option_enable(cmd, opt_block))
+      || (true == cmd_context.option_enable(cmd, opt_read_index)) )
+    && ( (false == cmd_context.option_enable(cmd, opt_block))
+      || (false == cmd_context.option_enable(cmd, opt_read_index))
+      || (false == cmd_context.option_enable(cmd, opt_read_file)) ) ) {
+    VTR_LOG_ERROR("Options '--%s' and '--%s' should be used together with '--%s'!\n",
+                  cmd.option_name(opt_block).c_str(),
+                  cmd.option_name(opt_read_index).c_str(),
+                  cmd.option_name(opt_read_file).c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* By default, the threads shared by all the commands are used,
+   * unless the number of threads is specified for this command
+   */
+  std::unique_ptr<ThreadPool> command_thread_pool;
+  const ThreadPool* thread_pool = find_command_thread_pool(openfpga_ctx, cmd, cmd_context, command_thread_pool);
+  if (nullptr == thread_pool) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Build the full fabric if the fabric is lazy */
+  if (CMD_EXEC_SUCCESS != build_fabric_module_on_demand(openfpga_ctx,
+                                                        generate_fpga_top_module_name(),
+                                                        cmd_context.option_enable(cmd, opt_verbose))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
 
-  if (true == cmd_context.option_enable(cmd, opt_read_file)) {
+  if (true == cmd_context.option_enable(cmd, opt_block)) {
+    /* Only the block is updated, which requires an existing bitstream */
+    std::string block_path = cmd_context.option_value(cmd, opt_block);
+    ConfigBlockId block = find_bitstream_manager_block_by_path(openfpga_ctx.bitstream_manager(), block_path);
+    if (false == openfpga_ctx.bitstream_manager().valid_block_id(block)) {
+      VTR_LOG_ERROR("Block '%s' is not found in the bitstream database! Please build the architecture bitstream first\n",
+                    block_path.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    BitstreamManager block_bitstream_manager = read_xml_architecture_bitstream_block(cmd_context.option_value(cmd, opt_read_file).c_str(),
+                                                                                     cmd_context.option_value(cmd, opt_read_index).c_str(),
+                                                                                     block_path);
+    std::vector<ConfigBlockId> read_block = find_bitstream_manager_top_blocks(block_bitstream_manager);
+    VTR_ASSERT(1 == read_block.size());
+    if (false == bitstream_manager_block_trees_match(openfpga_ctx.bitstream_manager(), block,
+                                                     block_bitstream_manager, read_block[0])) {
+      VTR_LOG_ERROR("Block '%s' read from file '%s' does not match the block in the bitstream database!\n",
+                    block_path.c_str(),
+                    cmd_context.option_value(cmd, opt_read_file).c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    size_t num_changed_bits = openfpga_ctx.mutable_bitstream_manager().overwrite_blocks_from(block, block_bitstream_manager, read_block[0]);
+    VTR_LOGV(cmd_context.option_enable(cmd, opt_verbose),
+             "Changed %lu configuration bits of block '%s'\n",
+             num_changed_bits, block_path.c_str());
+    /* The fabric bitstream refers to the same configuration bits, and only its data inputs are updated */
+    update_fabric_bitstream_bit_dins(openfpga_ctx.mutable_fabric_bitstream(),
+                                     openfpga_ctx.bitstream_manager());
+  } else if (true == cmd_context.option_enable(cmd, opt_read_file)) {
     openfpga_ctx.mutable_bitstream_manager() = read_xml_architecture_bitstream(cmd_context.option_value(cmd, opt_read_file).c_str());
+    openfpga_ctx.mutable_bitstream_query_index().clear();
+  } else if (true == cmd_context.option_enable(cmd, opt_incremental)) {
+    /* Only the bits changed by the new routing are updated, which requires an existing bitstream */
+    if (0 == openfpga_ctx.bitstream_manager().num_bits()) {
+      VTR_LOG_ERROR("No bitstream database to be updated! Please build the architecture bitstream without '--%s' first\n",
+                    cmd.option_name(opt_incremental).c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if (0 != update_device_bitstream(openfpga_ctx.mutable_bitstream_manager(),
+                                     g_vpr_ctx,
+                                     openfpga_ctx,
+                                     *thread_pool,
+                                     cmd_context.option_enable(cmd, opt_verbose))) {
+      /* The bitstream may be partially updated, and can not be used any more */
+      VTR_LOG_ERROR("The bitstream database does not match the fabric and is cleared! Please build the architecture bitstream without '--%s'\n",
+                    cmd.option_name(opt_incremental).c_str());
+      openfpga_ctx.mutable_bitstream_manager() = BitstreamManager();
+      openfpga_ctx.mutable_fabric_bitstream() = FabricBitstream();
+      openfpga_ctx.mutable_bitstream_query_index().clear();
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    /* The fabric bitstream refers to the same configuration bits, and only its data inputs are updated */
+    update_fabric_bitstream_bit_dins(openfpga_ctx.mutable_fabric_bitstream(),
+                                     openfpga_ctx.bitstream_manager());
   } else {
     openfpga_ctx.mutable_bitstream_manager() = build_device_bitstream(g_vpr_ctx,
                                                                       openfpga_ctx,
+                                                                      *thread_pool,
                                                                       cmd_context.option_enable(cmd, opt_verbose));
+    openfpga_ctx.mutable_bitstream_query_index().clear();
   }
 
   if (true == cmd_context.option_enable(cmd, opt_write_file)) {
@@ -53,6 +150,22 @@ int fpga_bitstream(OpenfpgaContext& openfpga_ctx,
 
     write_xml_architecture_bitstream(openfpga_ctx.bitstream_manager(),
                                      cmd_context.option_value(cmd, opt_write_file));
+
+    /* Index the blocks in the file, so that a block can be read without the whole file */
+    if (true == cmd_context.option_enable(cmd, opt_write_index)) {
+      std::string index_dir_path = find_path_dir_name(cmd_context.option_value(cmd, opt_write_index));
+      create_directory(index_dir_path);
+
+      if (0 != write_xml_architecture_bitstream_index(cmd_context.option_value(cmd, opt_write_file).c_str(),
+                                                      cmd_context.option_value(cmd, opt_write_index).c_str())) {
+        return CMD_EXEC_FATAL_ERROR;
+      }
+    }
+  } else if (true == cmd_context.option_enable(cmd, opt_write_index)) {
+    VTR_LOG_ERROR("Option '--%s' requires option '--%s'!\n",
+                  cmd.option_name(opt_write_index).c_str(),
+                  cmd.option_name(opt_write_file).c_str());
+    return CMD_EXEC_FATAL_ERROR;
   }
 
   /* TODO: should identify the error code from internal function execution */
@@ -67,11 +180,20 @@ int build_fabric_bitstream(OpenfpgaContext& openfpga_ctx,
 
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Build the full fabric if the fabric is lazy */
+  if (CMD_EXEC_SUCCESS != build_fabric_module_on_demand(openfpga_ctx,
+                                                        generate_fpga_top_module_name(),
+                                                        cmd_context.option_enable(cmd, opt_verbose))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Build fabric bitstream here */
   openfpga_ctx.mutable_fabric_bitstream() = build_fabric_dependent_bitstream(openfpga_ctx.bitstream_manager(),
                                                                              openfpga_ctx.module_graph(),
                                                                              openfpga_ctx.arch().config_protocol,
                                                                              cmd_context.option_enable(cmd, opt_verbose));
+  /* The fabric bits should be indexed again */
+  openfpga_ctx.mutable_bitstream_query_index().clear();
 
   /* TODO: should identify the error code from internal function execution */
   return CMD_EXEC_SUCCESS;
@@ -86,6 +208,9 @@ int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_verbose = cmd.option("verbose");
   CommandOptionId opt_file = cmd.option("file");
   CommandOptionId opt_file_format = cmd.option("format");
+  CommandOptionId opt_diff_from = cmd.option("diff_from");
+  CommandOptionId opt_group_by_block = cmd.option("group_by_block");
+  CommandOptionId opt_compress = cmd.option("compress");
 
   /* Write fabric bitstream if required */
   int status = CMD_EXEC_SUCCESS;
@@ -103,11 +228,59 @@ int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
     file_format = cmd_context.option_value(cmd, opt_file_format);
   }
 
-  if (std::string("xml") == file_format) {
+  /* Grouping and compression are only supported in xml */
+  if ( (std::string("xml") != file_format)
+    && (true == cmd_context.option_enable(cmd, opt_group_by_block))) {
+    VTR_LOG_ERROR("Option '--group_by_block' only supports the xml format!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  e_file_compression compression = FILE_COMPRESSION_NONE;
+  if (true == cmd_context.option_enable(cmd, opt_compress)) {
+    std::string compress_name = cmd_context.option_value(cmd, opt_compress);
+    compression = NUM_FILE_COMPRESSIONS;
+    for (size_t itype = 0; itype < NUM_FILE_COMPRESSIONS; ++itype) {
+      if (compress_name == std::string(FILE_COMPRESSION_STRING[itype])) {
+        compression = static_cast<e_file_compression>(itype);
+        break;
+      }
+    }
+    if (NUM_FILE_COMPRESSIONS == compression) {
+      VTR_LOG_ERROR("Invalid compression '%s' for option '--compress'! Expect [none|gzip]\n",
+                    compress_name.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if (false == file_compression_supported(compression)) {
+      VTR_LOG_ERROR("Compression '%s' is not available in this build!\n",
+                    compress_name.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if ( (std::string("xml") != file_format)
+      && (FILE_COMPRESSION_NONE != compression)) {
+      VTR_LOG_ERROR("Option '--compress' only supports the xml format!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  /* Differential bitstream is only supported in plain text */
+  if (true == cmd_context.option_enable(cmd, opt_diff_from)) {
+    if (std::string("plain_text") != file_format) {
+      VTR_LOG_ERROR("Option '--diff_from' only supports the plain_text format!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    status = write_fabric_bitstream_diff_to_text_file(openfpga_ctx.bitstream_manager(),
+                                                      openfpga_ctx.fabric_bitstream(),
+                                                      openfpga_ctx.arch().config_protocol,
+                                                      cmd_context.option_value(cmd, opt_diff_from),
+                                                      cmd_context.option_value(cmd, opt_file),
+                                                      cmd_context.option_enable(cmd, opt_verbose));
+  } else if (std::string("xml") == file_format) {
     status = write_fabric_bitstream_to_xml_file(openfpga_ctx.bitstream_manager(),
                                                 openfpga_ctx.fabric_bitstream(),
                                                 openfpga_ctx.arch().config_protocol,
                                                 cmd_context.option_value(cmd, opt_file),
+                                                cmd_context.option_enable(cmd, opt_group_by_block),
+                                                compression,
                                                 cmd_context.option_enable(cmd, opt_verbose));
   } else {
     /* By default, output in plain text format */
@@ -121,4 +294,131 @@ int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
   return status;
 } 
 
+/********************************************************************
+ * A wrapper function to call the report_fabric_bitstream_config_time() in FPGA bitstream
+ *******************************************************************/
+int report_bitstream_config_time(const OpenfpgaContext& openfpga_ctx,
+                                 const Command& cmd, const CommandContext& cmd_context) {
+
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_fast_config = cmd.option("fast_configuration");
+
+  std::string fname;
+  if (true == cmd_context.option_enable(cmd, opt_file)) {
+    fname = cmd_context.option_value(cmd, opt_file);
+    /* Create directories */
+    create_directory(find_path_dir_name(fname));
+  }
+
+  int status = report_fabric_bitstream_config_time(openfpga_ctx.bitstream_manager(),
+                                                   openfpga_ctx.fabric_bitstream(),
+                                                   openfpga_ctx.arch().config_protocol,
+                                                   openfpga_ctx.fabric_global_port_info(),
+                                                   openfpga_ctx.simulation_setting().programming_clock_frequency(),
+                                                   cmd_context.option_enable(cmd, opt_fast_config),
+                                                   fname,
+                                                   cmd_context.option_enable(cmd, opt_verbose));
+
+  if (0 != status) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * A wrapper function to query the bitstream database and the fabric bitstream
+ * The query index is built at the first query after the bitstream is built,
+ * and is reused by the following queries
+ *******************************************************************/
+int query_bitstream(OpenfpgaContext& openfpga_ctx,
+                    const Command& cmd, const CommandContext& cmd_context) {
+
+  CommandOptionId opt_block = cmd.option("block");
+  CommandOptionId opt_coordinate = cmd.option("coordinate");
+  CommandOptionId opt_fabric_bit = cmd.option("fabric_bit");
+
+  /* Exactly one kind of query is required */
+  size_t num_queries = 0;
+  for (const CommandOptionId& opt : {opt_block, opt_coordinate, opt_fabric_bit}) {
+    if (true == cmd_context.option_enable(cmd, opt)) {
+      num_queries++;
+    }
+  }
+  if (1 != num_queries) {
+    VTR_LOG_ERROR("Expect one of the options '--%s', '--%s' and '--%s'!\n",
+                  cmd.option_name(opt_block).c_str(),
+                  cmd.option_name(opt_coordinate).c_str(),
+                  cmd.option_name(opt_fabric_bit).c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Build the index on demand */
+  if (true == openfpga_ctx.bitstream_query_index().empty()) {
+    openfpga_ctx.mutable_bitstream_query_index().build(openfpga_ctx.bitstream_manager());
+  }
+  if ( (0 < openfpga_ctx.fabric_bitstream().num_bits())
+    && (false == openfpga_ctx.bitstream_query_index().fabric_bitstream_indexed()) ) {
+    openfpga_ctx.mutable_bitstream_query_index().build_fabric_bitstream_index(openfpga_ctx.bitstream_manager(),
+                                                                              openfpga_ctx.fabric_bitstream());
+  }
+  const BitstreamQueryIndex& query_index = openfpga_ctx.bitstream_query_index();
+
+  if (true == cmd_context.option_enable(cmd, opt_block)) {
+    report_bitstream_blocks(openfpga_ctx.bitstream_manager(), query_index,
+                            query_index.find_blocks_by_path_prefix(cmd_context.option_value(cmd, opt_block)));
+  } else if (true == cmd_context.option_enable(cmd, opt_coordinate)) {
+    /* Coordinate is in the format of <x>,<y> */
+    StringToken coord_tokenizer(cmd_context.option_value(cmd, opt_coordinate));
+    std::vector<std::string> coord_tokens = coord_tokenizer.split(',');
+    if ( (2 != coord_tokens.size())
+      || (std::string::npos != (coord_tokens[0] + coord_tokens[1]).find_first_not_of("0123456789"))
+      || (true == coord_tokens[0].empty()) || (true == coord_tokens[1].empty()) ) {
+      VTR_LOG_ERROR("Invalid coordinate '%s' which should be in the format of <x>,<y>!\n",
+                    cmd_context.option_value(cmd, opt_coordinate).c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    /* Digits only, but the numbers may still be too large */
+    size_t coord_x = 0;
+    size_t coord_y = 0;
+    try {
+      coord_x = std::stoul(coord_tokens[0]);
+      coord_y = std::stoul(coord_tokens[1]);
+    } catch (const std::out_of_range&) {
+      VTR_LOG_ERROR("Coordinate '%s' is out of range!\n",
+                    cmd_context.option_value(cmd, opt_coordinate).c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    vtr::Point<size_t> coord(coord_x, coord_y);
+    report_bitstream_blocks(openfpga_ctx.bitstream_manager(), query_index,
+                            query_index.find_blocks_by_coordinate(coord));
+  } else {
+    VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_fabric_bit));
+    if (false == query_index.fabric_bitstream_indexed()) {
+      VTR_LOG_ERROR("No fabric bitstream to query! Please call 'build_fabric_bitstream' first\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    long long fabric_bit = -1;
+    try {
+      fabric_bit = std::stoll(cmd_context.option_value(cmd, opt_fabric_bit));
+    } catch (const std::logic_error&) {
+      /* Invalid or out-of-range numbers are rejected below */
+      fabric_bit = -1;
+    }
+    if (0 > fabric_bit) {
+      VTR_LOG_ERROR("Invalid fabric bit '%s'!\n",
+                    cmd_context.option_value(cmd, opt_fabric_bit).c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if (0 != report_fabric_bit_owner(openfpga_ctx.bitstream_manager(),
+                                     openfpga_ctx.fabric_bitstream(),
+                                     query_index, size_t(fabric_bit))) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
 } /* end namespace openfpga */
@@ -24,6 +24,12 @@ int build_fabric_bitstream(OpenfpgaContext& openfpga_ctx,
 int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
                            const Command& cmd, const CommandContext& cmd_context);
 
+int report_bitstream_config_time(const OpenfpgaContext& openfpga_ctx,
+                                 const Command& cmd, const CommandContext& cmd_context);
+
+int query_bitstream(OpenfpgaContext& openfpga_ctx,
+                    const Command& cmd, const CommandContext& cmd_context);
+
 } /* end namespace openfpga */
 
 #endif
@@ -21,6 +21,11 @@ ShellCommandId add_openfpga_repack_command(openfpga::Shell<OpenfpgaContext>& she
                                            const ShellCommandClassId& cmd_class_id,
                                            const std::vector<ShellCommandId>& dependent_cmds) {
   Command shell_cmd("repack");
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads used to repack clustered blocks");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -50,10 +55,28 @@ ShellCommandId add_openfpga_build_arch_bitstream_command(openfpga::Shell<Openfpg
   CommandOptionId opt_write_file = shell_cmd.add_option("write_file", false, "file path to output the bitstream database");
   shell_cmd.set_option_require_value(opt_write_file, openfpga::OPT_STRING);
 
+  /* Add an option '--write_index' */
+  CommandOptionId opt_write_index = shell_cmd.add_option("write_index", false, "file path to output the index of blocks in the bitstream database file, which requires '--write_file'");
+  shell_cmd.set_option_require_value(opt_write_index, openfpga::OPT_STRING);
+
   /* Add an option '--read_file' */
   CommandOptionId opt_read_file = shell_cmd.add_option("read_file", false, "file path to read the bitstream database");
   shell_cmd.set_option_require_value(opt_read_file, openfpga::OPT_STRING);
 
+  /* Add an option '--read_index' */
+  CommandOptionId opt_read_index = shell_cmd.add_option("read_index", false, "file path to read the index of blocks in the bitstream database file, which is created by '--write_index'");
+  shell_cmd.set_option_require_value(opt_read_index, openfpga::OPT_STRING);
+
+  /* Add an option '--block' */
+  CommandOptionId opt_block = shell_cmd.add_option("block", false, "Only read the block of the given hierarchy path, e.g., fpga_top.grid_clb_1__1_, from the bitstream database file with its index, and overwrite the block in the existing bitstream database. Require '--read_file' and '--read_index'");
+  shell_cmd.set_option_require_value(opt_block, openfpga::OPT_STRING);
+
+  /* Add an option '--incremental' */
+  shell_cmd.add_option("incremental", false, "Update the routing bitstream of the existing bitstream database for new routing results");
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads used to build the bitstream database");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
 
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
@@ -114,13 +137,91 @@ ShellCommandId add_openfpga_write_fabric_bitstream_command(openfpga::Shell<Openf
   CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of fabric bitstream [plain_text|xml]. Default: plain_text");
   shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
 
+  /* Add an option '--diff_from'*/
+  CommandOptionId opt_diff_from = shell_cmd.add_option("diff_from", false, "file path to a previous fabric bitstream in plain text. Only the frames which are different from it will be outputted");
+  shell_cmd.set_option_require_value(opt_diff_from, openfpga::OPT_STRING);
+
+  /* Add an option '--group_by_block'*/
+  shell_cmd.add_option("group_by_block", false, "Output the hierarchy path once for the consecutive bits of each configurable block. Only applicable to xml format");
+
+  /* Add an option '--compress'*/
+  CommandOptionId opt_compress = shell_cmd.add_option("compress", false, "compress the fabric bitstream file on the fly [none|gzip]. Only applicable to xml format. Default: none");
+  shell_cmd.set_option_require_value(opt_compress, openfpga::OPT_STRING);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
   /* Add command 'fabric_bitstream' to the Shell */
   ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Write the fabric-dependent bitstream to a file");
   shell.set_command_class(shell_cmd_id, cmd_class_id);
-  shell.set_command_execute_function(shell_cmd_id, write_fabric_bitstream);
+  shell.set_command_const_execute_function(shell_cmd_id, write_fabric_bitstream);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: report_bitstream_config_time
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_report_bitstream_config_time_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                                 const ShellCommandClassId& cmd_class_id,
+                                                                 const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("report_bitstream_config_time");
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_file = shell_cmd.add_option("file", false, "file path to output the report. If not specified, the report is outputted to the log");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--fast_configuration' */
+  shell_cmd.add_option("fast_configuration", false, "Skip the configuration bits which can be set by programming reset/set signals, as the testbench does with fast configuration");
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command 'report_bitstream_config_time' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Report the number of clock cycles required to configure the fabric bitstream");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id, report_bitstream_config_time);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: query_bitstream
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_query_bitstream_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                    const ShellCommandClassId& cmd_class_id,
+                                                    const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("query_bitstream");
+
+  /* Add an option '--block' */
+  CommandOptionId opt_block = shell_cmd.add_option("block", false, "Report the bits of the blocks whose hierarchy paths start with the given prefix, e.g., fpga_top.grid_clb_1__1_");
+  shell_cmd.set_option_require_value(opt_block, openfpga::OPT_STRING);
+
+  /* Add an option '--coordinate' */
+  CommandOptionId opt_coordinate = shell_cmd.add_option("coordinate", false, "Report the bits of the grid and routing blocks at the given coordinate <x>,<y>");
+  shell_cmd.set_option_require_value(opt_coordinate, openfpga::OPT_STRING);
+
+  /* Add an option '--fabric_bit' */
+  CommandOptionId opt_fabric_bit = shell_cmd.add_option("fabric_bit", false, "Report the block which owns the fabric bit with the given index");
+  shell_cmd.set_option_require_value(opt_fabric_bit, openfpga::OPT_INT);
+
+  /* Add command 'query_bitstream' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Query the bits of blocks in the bitstream database and the owner of fabric bits");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, query_bitstream);
 
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
@@ -169,6 +270,22 @@ void add_openfpga_bitstream_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   std::vector<ShellCommandId> cmd_dependency_write_fabric_bitstream;
   cmd_dependency_write_fabric_bitstream.push_back(shell_cmd_build_fabric_bitstream_id);
   add_openfpga_write_fabric_bitstream_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_write_fabric_bitstream);
+
+  /******************************** 
+   * Command 'report_bitstream_config_time' 
+   */
+  /* The 'report_bitstream_config_time' command should NOT be executed before 'build_fabric_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_report_bitstream_config_time;
+  cmd_dependency_report_bitstream_config_time.push_back(shell_cmd_build_fabric_bitstream_id);
+  add_openfpga_report_bitstream_config_time_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_report_bitstream_config_time);
+
+  /******************************** 
+   * Command 'query_bitstream' 
+   */
+  /* The 'query_bitstream' command should NOT be executed before 'build_architecture_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_query_bitstream;
+  cmd_dependency_query_bitstream.push_back(shell_cmd_build_arch_bitstream_id);
+  add_openfpga_query_bitstream_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_query_bitstream);
 } 
 
 } /* end namespace openfpga */
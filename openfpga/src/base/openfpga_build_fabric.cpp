@@ -13,11 +13,13 @@
 
 #include "device_rr_gsb.h"
 #include "device_rr_gsb_utils.h"
+#include "openfpga_naming.h"
 #include "build_device_module.h"
 #include "fabric_hierarchy_writer.h"
 #include "fabric_key_writer.h"
 #include "build_fabric_io_location_map.h"
 #include "build_fabric_global_port_info.h"
+#include "openfpga_design_reset.h"
 #include "openfpga_build_fabric.h"
 
 /* Include global variables of VPR */
@@ -63,6 +65,41 @@ void compress_routing_hierarchy(OpenfpgaContext& openfpga_ctx,
           100. * ((float)find_device_rr_gsb_num_gsb_modules(openfpga_ctx.device_rr_gsb()) / (float)openfpga_ctx.device_rr_gsb().get_num_gsb_unique_module() - 1.));
 }
 
+/********************************************************************
+ * Build the full module graph for FPGA device as well as 
+ * the fabric information extracted from the module graph
+ *******************************************************************/
+static 
+int build_fabric_module_graph(OpenfpgaContext& openfpga_ctx,
+                              const bool& frame_view,
+                              const bool& compress_routing,
+                              const bool& duplicate_grid_pin,
+                              const FabricKey& fabric_key,
+                              const bool& generate_random_fabric_key,
+                              const bool& verbose) {
+  int status = build_device_module_graph(openfpga_ctx.mutable_module_graph(),
+                                         openfpga_ctx.mutable_decoder_lib(),
+                                         const_cast<const OpenfpgaContext&>(openfpga_ctx),
+                                         g_vpr_ctx.device(),
+                                         frame_view,
+                                         compress_routing,
+                                         duplicate_grid_pin,
+                                         fabric_key,
+                                         generate_random_fabric_key,
+                                         verbose);
+
+  /* Build I/O location map */
+  openfpga_ctx.mutable_io_location_map() = build_fabric_io_location_map(openfpga_ctx.module_graph(),
+                                                                        g_vpr_ctx.device().grid);
+
+  /* Build fabric global port information */
+  openfpga_ctx.mutable_fabric_global_port_info() = build_fabric_global_port_info(openfpga_ctx.module_graph(),
+                                                                                 openfpga_ctx.arch().tile_annotations,
+                                                                                 openfpga_ctx.arch().circuit_lib);
+
+  return status;
+}
+
 /********************************************************************
  * Build the module graph for FPGA device
  *******************************************************************/
@@ -75,7 +112,18 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_gen_random_fabric_key = cmd.option("generate_random_fabric_key");
   CommandOptionId opt_write_fabric_key = cmd.option("write_fabric_key");
   CommandOptionId opt_load_fabric_key = cmd.option("load_fabric_key");
+  CommandOptionId opt_lazy = cmd.option("lazy");
   CommandOptionId opt_verbose = cmd.option("verbose");
+
+  /* The options on the top-level module can not be applied to a lazy fabric */
+  if ( (true == cmd_context.option_enable(cmd, opt_lazy))
+    && ( (true == cmd_context.option_enable(cmd, opt_frame_view))
+      || (true == cmd_context.option_enable(cmd, opt_gen_random_fabric_key))
+      || (true == cmd_context.option_enable(cmd, opt_write_fabric_key))
+      || (true == cmd_context.option_enable(cmd, opt_load_fabric_key)) ) ) {
+    VTR_LOG_ERROR("Option '--lazy' cannot be used with '--frame_view', '--generate_random_fabric_key', '--write_fabric_key' or '--load_fabric_key'!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
   
   if (true == cmd_context.option_enable(cmd, opt_compress_routing)) {
     compress_routing_hierarchy(openfpga_ctx, cmd_context.option_enable(cmd, opt_verbose));
@@ -83,8 +131,23 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
     openfpga_ctx.mutable_flow_manager().set_compress_routing(true);
   }
 
+  /* Update flow manager so that modules can be built on demand with the same options */
+  openfpga_ctx.mutable_flow_manager().set_duplicate_grid_pin(cmd_context.option_enable(cmd, opt_duplicate_grid_pin));
+
+  /* Record the device which the fabric is built for, so that the device of another design can be checked */
+  openfpga_ctx.mutable_flow_manager().set_fabric_device_signature(build_fabric_device_signature(g_vpr_ctx.device(),
+                                                                                                openfpga_ctx.device_rr_gsb(),
+                                                                                                openfpga_ctx.flow_manager().compress_routing()));
+
   VTR_LOG("\n");
 
+  /* Defer the module building to the commands which require the modules */
+  if (true == cmd_context.option_enable(cmd, opt_lazy)) {
+    openfpga_ctx.mutable_flow_manager().set_lazy_fabric(true);
+    VTR_LOG("Fabric modules will be built on demand\n");
+    return CMD_EXEC_SUCCESS;
+  }
+
   /* Record the execution status in curr_status for each command 
    * and summarize them in the final status
    */
@@ -101,10 +164,7 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
 
   VTR_LOG("\n");
 
-  curr_status = build_device_module_graph(openfpga_ctx.mutable_module_graph(),
-                                          openfpga_ctx.mutable_decoder_lib(),
-                                          const_cast<const OpenfpgaContext&>(openfpga_ctx),
-                                          g_vpr_ctx.device(),
+  curr_status = build_fabric_module_graph(openfpga_ctx,
                                           cmd_context.option_enable(cmd, opt_frame_view),
                                           cmd_context.option_enable(cmd, opt_compress_routing),
                                           cmd_context.option_enable(cmd, opt_duplicate_grid_pin),
@@ -117,15 +177,6 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
     final_status = curr_status;
   }
 
-  /* Build I/O location map */
-  openfpga_ctx.mutable_io_location_map() = build_fabric_io_location_map(openfpga_ctx.module_graph(),
-                                                                        g_vpr_ctx.device().grid);
-
-  /* Build fabric global port information */
-  openfpga_ctx.mutable_fabric_global_port_info() = build_fabric_global_port_info(openfpga_ctx.module_graph(),
-                                                                                 openfpga_ctx.arch().tile_annotations,
-                                                                                 openfpga_ctx.arch().circuit_lib);
-
   /* Output fabric key if user requested */
   if (true == cmd_context.option_enable(cmd, opt_write_fabric_key)) {
     std::string fkey_fname = cmd_context.option_value(cmd, opt_write_fabric_key);
@@ -142,10 +193,74 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
   return final_status;
 } 
 
+/********************************************************************
+ * Ensure that a module and all its children are in the module graph
+ * This is required when the fabric is built with the option '--lazy'
+ * - For the top-level module, the full fabric is built
+ *   and the fabric will no longer be lazy
+ * - For other modules, only the modules required are built.
+ *   The module graph is rebuilt from scratch when the module 
+ *   is not in the modules built by a previous request
+ * Nothing is done when the fabric is fully built
+ *******************************************************************/
+int build_fabric_module_on_demand(OpenfpgaContext& openfpga_ctx,
+                                  const std::string& module_name,
+                                  const bool& verbose) {
+  if (false == openfpga_ctx.flow_manager().lazy_fabric()) {
+    return CMD_EXEC_SUCCESS;
+  }
+
+  const ModuleManager& module_manager = openfpga_ctx.module_graph();
+  if (true == module_manager.valid_module_id(module_manager.find_module(module_name))) {
+    return CMD_EXEC_SUCCESS;
+  }
+
+  /* Start from an empty module graph */
+  openfpga_ctx.mutable_module_graph() = ModuleManager();
+  openfpga_ctx.mutable_decoder_lib() = DecoderLibrary();
+
+  if (generate_fpga_top_module_name() == module_name) {
+    openfpga_ctx.mutable_flow_manager().set_lazy_fabric(false);
+    return build_fabric_module_graph(openfpga_ctx,
+                                     false,
+                                     openfpga_ctx.flow_manager().compress_routing(),
+                                     openfpga_ctx.flow_manager().duplicate_grid_pin(),
+                                     FabricKey(),
+                                     false,
+                                     verbose);
+  }
+
+  return build_device_submodule_graph(openfpga_ctx.mutable_module_graph(),
+                                      openfpga_ctx.mutable_decoder_lib(),
+                                      const_cast<const OpenfpgaContext&>(openfpga_ctx),
+                                      g_vpr_ctx.device(),
+                                      module_name,
+                                      openfpga_ctx.flow_manager().compress_routing(),
+                                      openfpga_ctx.flow_manager().duplicate_grid_pin(),
+                                      verbose);
+}
+
+/********************************************************************
+ * Check that the full fabric has been built, as required by the commands
+ * which cannot build the modules on demand, e.g., FPGA-SDC and 
+ * the testbench generator, whose execution does not modify the context
+ * Return an error if the fabric is lazy
+ *******************************************************************/
+int check_full_fabric_built(const OpenfpgaContext& openfpga_ctx,
+                            const Command& cmd) {
+  if (false == openfpga_ctx.flow_manager().lazy_fabric()) {
+    return CMD_EXEC_SUCCESS;
+  }
+
+  VTR_LOG_ERROR("Command '%s' requires the full fabric, which is not built as 'build_fabric' was called with option '--lazy'!\n\tPlease call 'build_fabric' without '--lazy', or a command which builds the full fabric on demand before, e.g., 'build_architecture_bitstream' or 'write_fabric_verilog' without '--module'.\n",
+                cmd.name().c_str());
+  return CMD_EXEC_FATAL_ERROR;
+}
+
 /********************************************************************
  * Build the module graph for FPGA device
  *******************************************************************/
-int write_fabric_hierarchy(const OpenfpgaContext& openfpga_ctx,
+int write_fabric_hierarchy(OpenfpgaContext& openfpga_ctx,
                            const Command& cmd, const CommandContext& cmd_context) { 
 
   CommandOptionId opt_verbose = cmd.option("verbose");
@@ -171,10 +286,25 @@ int write_fabric_hierarchy(const OpenfpgaContext& openfpga_ctx,
     }
   }
 
+  /* Default root is the top-level module */
+  std::string root_module_name = generate_fpga_top_module_name();
+  CommandOptionId opt_module = cmd.option("module");
+  if (true == cmd_context.option_enable(cmd, opt_module)) {
+    root_module_name = cmd_context.option_value(cmd, opt_module);
+  }
+
+  /* Build the modules if the fabric is lazy */
+  int status = build_fabric_module_on_demand(openfpga_ctx, root_module_name,
+                                             cmd_context.option_enable(cmd, opt_verbose));
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
+
   std::string hie_file_name = cmd_context.option_value(cmd, opt_file);
 
   /* Write hierarchy to a file */
   return write_fabric_hierarchy_to_text_file(openfpga_ctx.module_graph(),
+                                             root_module_name,
                                              hie_file_name,
                                              size_t(depth),
                                              cmd_context.option_enable(cmd, opt_verbose));
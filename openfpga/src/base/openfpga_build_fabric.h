@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <string>
 #include "command.h"
 #include "command_context.h"
 #include "openfpga_context.h"
@@ -18,7 +19,14 @@ namespace openfpga {
 int build_fabric(OpenfpgaContext& openfpga_ctx,
                  const Command& cmd, const CommandContext& cmd_context); 
 
-int write_fabric_hierarchy(const OpenfpgaContext& openfpga_ctx,
+int build_fabric_module_on_demand(OpenfpgaContext& openfpga_ctx,
+                                  const std::string& module_name,
+                                  const bool& verbose);
+
+int check_full_fabric_built(const OpenfpgaContext& openfpga_ctx,
+                            const Command& cmd);
+
+int write_fabric_hierarchy(OpenfpgaContext& openfpga_ctx,
                            const Command& cmd, const CommandContext& cmd_context); 
 
 } /* end namespace openfpga */
@@ -0,0 +1,48 @@
+/********************************************************************
+ * This file includes functions to select the threads used by a command
+ *******************************************************************/
+#include <cstdlib>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+#include "openfpga_command_thread_pool.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Find the thread pool to execute a command
+ * - By default, the thread pool of OpenFPGA context is used,
+ *   which is shared by all the commands
+ * - When the option '--threads' of the command is enabled,
+ *   a thread pool with the given number of threads is created
+ *   for this command only, and is owned by the caller
+ * Return nullptr if the number of threads is not valid
+ *******************************************************************/
+const ThreadPool* find_command_thread_pool(const OpenfpgaContext& openfpga_ctx,
+                                           const Command& cmd, const CommandContext& cmd_context,
+                                           std::unique_ptr<ThreadPool>& command_thread_pool) {
+  CommandOptionId opt_threads = cmd.option("threads");
+  if ( (CommandOptionId::INVALID() == opt_threads)
+    || (false == cmd_context.option_enable(cmd, opt_threads)) ) {
+    return &openfpga_ctx.thread_pool();
+  }
+
+  int num_threads = std::atoi(cmd_context.option_value(cmd, opt_threads).c_str());
+  /* Error out if we have a non-positive number of threads */
+  if (0 >= num_threads) {
+    VTR_LOG_ERROR("Invalid number of threads '%d' which should be a positive number!\n",
+                  num_threads);
+    return nullptr;
+  }
+
+  /* No need to create threads when the shared thread pool is the same */
+  if (size_t(num_threads) == openfpga_ctx.thread_pool().num_threads()) {
+    return &openfpga_ctx.thread_pool();
+  }
+  command_thread_pool.reset(new ThreadPool(size_t(num_threads)));
+  return command_thread_pool.get();
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,25 @@
+#ifndef OPENFPGA_COMMAND_THREAD_POOL_H
+#define OPENFPGA_COMMAND_THREAD_POOL_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <memory>
+#include "command.h"
+#include "command_context.h"
+#include "openfpga_context.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+const ThreadPool* find_command_thread_pool(const OpenfpgaContext& openfpga_ctx,
+                                           const Command& cmd, const CommandContext& cmd_context,
+                                           std::unique_ptr<ThreadPool>& command_thread_pool);
+
+} /* end namespace openfpga */
+
+#endif
@@ -17,9 +17,11 @@
 #include "openfpga_flow_manager.h"
 #include "bitstream_manager.h"
 #include "fabric_bitstream.h"
+#include "bitstream_query_index.h"
 #include "device_rr_gsb.h"
 #include "io_location_map.h"
 #include "fabric_global_port_info.h"
+#include "openfpga_thread_pool.h"
 
 /********************************************************************
  * This file includes the declaration of the date structure 
@@ -65,11 +67,13 @@ class OpenfpgaContext : public Context  {
     const openfpga::FlowManager& flow_manager() const { return flow_manager_; }
     const openfpga::BitstreamManager& bitstream_manager() const { return bitstream_manager_; }
     const openfpga::FabricBitstream& fabric_bitstream() const { return fabric_bitstream_; }
+    const openfpga::BitstreamQueryIndex& bitstream_query_index() const { return bitstream_query_index_; }
     const openfpga::IoLocationMap& io_location_map() const { return io_location_map_; }
     const openfpga::FabricGlobalPortInfo& fabric_global_port_info() const { return fabric_global_port_info_; }
     const std::unordered_map<AtomNetId, t_net_power>& net_activity() const { return net_activity_; }
     const openfpga::NetlistManager& verilog_netlists() const { return verilog_netlists_; }
     const openfpga::NetlistManager& spice_netlists() const { return spice_netlists_; }
+    const openfpga::ThreadPool& thread_pool() const { return thread_pool_; }
   public:  /* Public mutators */
     openfpga::Arch& mutable_arch() { return arch_; }
     openfpga::SimulationSetting& mutable_simulation_setting() { return sim_setting_; }
@@ -86,11 +90,13 @@ class OpenfpgaContext : public Context  {
     openfpga::FlowManager& mutable_flow_manager() { return flow_manager_; }
     openfpga::BitstreamManager& mutable_bitstream_manager() { return bitstream_manager_; }
     openfpga::FabricBitstream& mutable_fabric_bitstream() { return fabric_bitstream_; }
+    openfpga::BitstreamQueryIndex& mutable_bitstream_query_index() { return bitstream_query_index_; }
     openfpga::IoLocationMap& mutable_io_location_map() { return io_location_map_; }
     openfpga::FabricGlobalPortInfo& mutable_fabric_global_port_info() { return fabric_global_port_info_; }
     std::unordered_map<AtomNetId, t_net_power>& mutable_net_activity() { return net_activity_; }
     openfpga::NetlistManager& mutable_verilog_netlists() { return verilog_netlists_; }
     openfpga::NetlistManager& mutable_spice_netlists() { return spice_netlists_; }
+    openfpga::ThreadPool& mutable_thread_pool() { return thread_pool_; }
   private: /* Internal data */
     /* Data structure to store information from read_openfpga_arch library */
     openfpga::Arch arch_;
@@ -132,6 +138,9 @@ class OpenfpgaContext : public Context  {
     openfpga::BitstreamManager bitstream_manager_;
     openfpga::FabricBitstream fabric_bitstream_;
 
+    /* Index to query the bitstream database, which is built on demand */
+    openfpga::BitstreamQueryIndex bitstream_query_index_;
+
     /* Netlist database 
      * TODO: Each format should have an independent entry
      */
@@ -143,6 +152,9 @@ class OpenfpgaContext : public Context  {
  
     /* Flow status */
     openfpga::FlowManager flow_manager_;
+
+    /* Threads shared by the parallel loops of all the commands */
+    openfpga::ThreadPool thread_pool_;
 };
 
 #endif
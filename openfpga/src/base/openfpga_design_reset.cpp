@@ -0,0 +1,111 @@
+/********************************************************************
+ * This file includes functions to clear the data of OpenfpgaContext
+ * which depends on the user's design, so that another design can be
+ * implemented on the same fabric
+ *******************************************************************/
+#include <functional>
+
+/* Headers from vtrutil library */
+#include "vtr_time.h"
+#include "vtr_log.h"
+
+#include "openfpga_design_reset.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Clear the design-dependent data of OpenfpgaContext, including
+ * - the annotation to the netlist, clustering, placement and routing results
+ * - the annotation to the VPR architecture, which is built on the data
+ *   structures of VPR and is no longer valid once VPR is re-run
+ * - the net activities
+ * - the architecture bitstream and fabric bitstream
+ * - the netlists that have been written
+ *
+ * The fabric-level data, i.e., the OpenFPGA architecture, the simulation
+ * settings, the routing multiplexer and decoder libraries,
+ * the device-level RRGSBs and the module graph, are kept,
+ * so that they do not have to be rebuilt for the next design.
+ * Note that the RRGSBs and the multiplexer library will be
+ * refreshed by the command 'link_openfpga_arch'
+ *******************************************************************/
+void reset_openfpga_design_data(OpenfpgaContext& openfpga_ctx) {
+  vtr::ScopedStartFinishTimer timer("Clear design-dependent data of OpenFPGA");
+
+  openfpga_ctx.mutable_vpr_device_annotation() = VprDeviceAnnotation();
+  openfpga_ctx.mutable_vpr_netlist_annotation() = VprNetlistAnnotation();
+  openfpga_ctx.mutable_vpr_clustering_annotation() = VprClusteringAnnotation();
+  openfpga_ctx.mutable_vpr_placement_annotation() = VprPlacementAnnotation();
+  openfpga_ctx.mutable_vpr_routing_annotation() = VprRoutingAnnotation();
+
+  openfpga_ctx.mutable_net_activity().clear();
+
+  openfpga_ctx.mutable_bitstream_manager() = BitstreamManager();
+  openfpga_ctx.mutable_fabric_bitstream() = FabricBitstream();
+  openfpga_ctx.mutable_bitstream_query_index().clear();
+
+  openfpga_ctx.mutable_verilog_netlists() = NetlistManager();
+  openfpga_ctx.mutable_spice_netlists() = NetlistManager();
+}
+
+/********************************************************************
+ * Find the names of the commands whose results are cleared by
+ * reset_openfpga_design_data(), including the commands which run
+ * and link VPR, and the commands which build the bitstreams.
+ * These commands have to be executed again for another design
+ *******************************************************************/
+std::vector<std::string> find_openfpga_design_dependent_command_names() {
+  return std::vector<std::string>({"vpr",
+                                   "link_openfpga_arch",
+                                   "check_netlist_naming_conflict",
+                                   "pb_pin_fixup",
+                                   "lut_truth_table_fixup",
+                                   "repack",
+                                   "build_architecture_bitstream",
+                                   "build_fabric_bitstream"});
+}
+
+/********************************************************************
+ * Mix a value into a signature, in the same way as boost::hash_combine
+ *******************************************************************/
+static
+void combine_fabric_device_signature(size_t& signature,
+                                     const size_t& value) {
+  signature ^= value + 0x9e3779b9 + (signature << 6) + (signature >> 2);
+}
+
+/********************************************************************
+ * Build a signature of the device which the module graph is built for,
+ * i.e., the size of the grid, the type of each grid, the channel width
+ * and the unique routing modules when the routing hierarchy is compressed.
+ * The module graph is kept when another design is implemented in server mode,
+ * so the device of the new design is required to have the same signature
+ *
+ * Format: <width>x<height> grid, routing channel width <W>, layout #<hash>
+ *******************************************************************/
+std::string build_fabric_device_signature(const DeviceContext& device_ctx,
+                                          const DeviceRRGSB& device_rr_gsb,
+                                          const bool& compress_routing) {
+  size_t layout_hash = 0;
+  for (size_t ix = 0; ix < device_ctx.grid.width(); ++ix) {
+    for (size_t iy = 0; iy < device_ctx.grid.height(); ++iy) {
+      const t_grid_tile& grid_tile = device_ctx.grid[ix][iy];
+      combine_fabric_device_signature(layout_hash, std::hash<std::string>()(std::string(grid_tile.type->name)));
+      combine_fabric_device_signature(layout_hash, grid_tile.width_offset);
+      combine_fabric_device_signature(layout_hash, grid_tile.height_offset);
+    }
+  }
+
+  if (true == compress_routing) {
+    combine_fabric_device_signature(layout_hash, device_rr_gsb.get_num_sb_unique_module());
+    combine_fabric_device_signature(layout_hash, device_rr_gsb.get_num_cb_unique_module(CHANX));
+    combine_fabric_device_signature(layout_hash, device_rr_gsb.get_num_cb_unique_module(CHANY));
+  }
+
+  return std::to_string(device_ctx.grid.width()) + std::string("x") + std::to_string(device_ctx.grid.height())
+       + std::string(" grid, routing channel width ") + std::to_string(device_ctx.chan_width.max)
+       + std::string(", layout #") + std::to_string(layout_hash);
+}
+
+} /* end namespace openfpga */
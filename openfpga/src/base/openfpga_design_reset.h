@@ -0,0 +1,30 @@
+#ifndef OPENFPGA_DESIGN_RESET_H
+#define OPENFPGA_DESIGN_RESET_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include <vector>
+#include "vpr_context.h"
+#include "device_rr_gsb.h"
+#include "openfpga_context.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void reset_openfpga_design_data(OpenfpgaContext& openfpga_ctx);
+
+std::vector<std::string> find_openfpga_design_dependent_command_names();
+
+std::string build_fabric_device_signature(const DeviceContext& device_ctx,
+                                          const DeviceRRGSB& device_rr_gsb,
+                                          const bool& compress_routing);
+
+} /* end namespace openfpga */
+
+#endif
@@ -14,6 +14,8 @@ namespace openfpga {
 FlowManager::FlowManager() {
   /* Turn off compress_routing as default */
   compress_routing_ = false;
+  duplicate_grid_pin_ = false;
+  lazy_fabric_ = false;
 }
 
 /**************************************************
@@ -23,6 +25,18 @@ bool FlowManager::compress_routing() const {
   return compress_routing_;
 }
 
+bool FlowManager::duplicate_grid_pin() const {
+  return duplicate_grid_pin_;
+}
+
+bool FlowManager::lazy_fabric() const {
+  return lazy_fabric_;
+}
+
+std::string FlowManager::fabric_device_signature() const {
+  return fabric_device_signature_;
+}
+
 /******************************************************************************
  * Private Mutators
  ******************************************************************************/
@@ -30,5 +44,17 @@ void FlowManager::set_compress_routing(const bool& enabled) {
   compress_routing_ = enabled;
 }
 
+void FlowManager::set_duplicate_grid_pin(const bool& enabled) {
+  duplicate_grid_pin_ = enabled;
+}
+
+void FlowManager::set_lazy_fabric(const bool& enabled) {
+  lazy_fabric_ = enabled;
+}
+
+void FlowManager::set_fabric_device_signature(const std::string& signature) {
+  fabric_device_signature_ = signature;
+}
+
 
 } /* end namespace openfpga */
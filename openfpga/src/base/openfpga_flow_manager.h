@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <string>
+
 /* Begin namespace openfpga */
 namespace openfpga {
 
@@ -19,10 +21,21 @@ class FlowManager {
     FlowManager();
   public: /* Public accessors */
     bool compress_routing() const;
+    bool duplicate_grid_pin() const;
+    bool lazy_fabric() const;
+    std::string fabric_device_signature() const;
   public: /* Public mutators */
     void set_compress_routing(const bool& enabled);
+    void set_duplicate_grid_pin(const bool& enabled);
+    void set_lazy_fabric(const bool& enabled);
+    void set_fabric_device_signature(const std::string& signature);
   private: /* Internal Data */
     bool compress_routing_;
+    bool duplicate_grid_pin_;
+    /* The fabric modules are built on demand rather than by 'build_fabric' */
+    bool lazy_fabric_;
+    /* Signature of the device which the fabric is built for, empty if no fabric is built */
+    std::string fabric_device_signature_;
 };
 
 } /* End namespace openfpga*/
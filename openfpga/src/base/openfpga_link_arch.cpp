@@ -24,6 +24,8 @@
 #include "mux_library_builder.h"
 #include "build_tile_direct.h"
 #include "annotate_placement.h"
+#include "openfpga_command_thread_pool.h"
+#include "openfpga_design_reset.h"
 #include "openfpga_link_arch.h"
 
 /* Include global variables of VPR */
@@ -71,6 +73,15 @@ int link_arch(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_sort_edge = cmd.option("sort_gsb_chan_node_in_edges");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* By default, the threads shared by all the commands are used,
+   * unless the number of threads is specified for this command
+   */
+  std::unique_ptr<ThreadPool> command_thread_pool;
+  const ThreadPool* thread_pool = find_command_thread_pool(openfpga_ctx, cmd, cmd_context, command_thread_pool);
+  if (nullptr == thread_pool) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Annotate pb_type graphs
    * - physical pb_type
    * - mode selection bits for pb_type and pb interconnect
@@ -107,6 +118,7 @@ int link_arch(OpenfpgaContext& openfpga_ctx,
 
   annotate_rr_node_previous_nodes(g_vpr_ctx.device(), g_vpr_ctx.clustering(), g_vpr_ctx.routing(), 
                                   openfpga_ctx.mutable_vpr_routing_annotation(),
+                                  *thread_pool,
                                   cmd_context.option_enable(cmd, opt_verbose));
 
 
@@ -126,7 +138,30 @@ int link_arch(OpenfpgaContext& openfpga_ctx,
     sort_device_rr_gsb_chan_node_in_edges(g_vpr_ctx.device().rr_graph,
                                           openfpga_ctx.mutable_device_rr_gsb(),
                                           cmd_context.option_enable(cmd, opt_verbose));
-  } 
+  }
+
+  /* When the fabric has been built with a compressed routing hierarchy,
+   * e.g., the architecture is linked again for another design in server mode,
+   * the unique GSBs should be identified again to be consistent with the module graph
+   */
+  if (true == openfpga_ctx.flow_manager().compress_routing()) {
+    openfpga_ctx.mutable_device_rr_gsb().build_unique_module(g_vpr_ctx.device().rr_graph);
+  }
+
+  /* The module graph, which is kept when the architecture is linked again, 
+   * is valid only when the device of VPR is the same as the device the fabric is built for
+   */
+  if (false == openfpga_ctx.flow_manager().fabric_device_signature().empty()) {
+    std::string device_signature = build_fabric_device_signature(g_vpr_ctx.device(),
+                                                                 openfpga_ctx.device_rr_gsb(),
+                                                                 openfpga_ctx.flow_manager().compress_routing());
+    if (device_signature != openfpga_ctx.flow_manager().fabric_device_signature()) {
+      VTR_LOG_ERROR("The device of VPR (%s) differs from the device the fabric is built for (%s)!\n\tPlease use the same architecture and fixed device layout and routing channel width for all the designs.\n",
+                    device_signature.c_str(),
+                    openfpga_ctx.flow_manager().fabric_device_signature().c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
 
   /* Build multiplexer library */
   openfpga_ctx.mutable_mux_lib() = build_device_mux_library(g_vpr_ctx.device(),
@@ -108,8 +108,16 @@ void update_cluster_pin_with_post_routing_results(const DeviceContext& device_ct
       continue;
     }
 
+    /* The pin may have been fixed up for a previous routing of the same clustering results,
+     * e.g., when the design is re-routed, and the fix-up should be made again
+     */
+    ClusterNetId curr_net_id = cluster_net_id;
+    if (true == vpr_clustering_annotation.is_net_renamed(blk_id, j)) {
+      curr_net_id = vpr_clustering_annotation.net(blk_id, j);
+    }
+
     /* If matched, we finish here */
-    if (routing_net_id == cluster_net_id) {
+    if (routing_net_id == curr_net_id) {
       continue;
     }
 
@@ -122,8 +130,8 @@ void update_cluster_pin_with_post_routing_results(const DeviceContext& device_ct
     }
 
     std::string cluster_net_name("unmapped");
-    if (ClusterNetId::INVALID() != cluster_net_id) {
-      cluster_net_name = clustering_ctx.clb_nlist.net_name(cluster_net_id);
+    if (ClusterNetId::INVALID() != curr_net_id) {
+      cluster_net_name = clustering_ctx.clb_nlist.net_name(curr_net_id);
     }
 
     VTR_LOGV(verbose,
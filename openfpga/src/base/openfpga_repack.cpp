@@ -10,6 +10,7 @@
 
 #include "build_physical_truth_table.h"
 #include "repack.h"
+#include "openfpga_command_thread_pool.h"
 #include "openfpga_repack.h"
 
 /* Include global variables of VPR */
@@ -26,12 +27,24 @@ int repack(OpenfpgaContext& openfpga_ctx,
 
   CommandOptionId opt_verbose = cmd.option("verbose");
 
-  pack_physical_pbs(g_vpr_ctx.device(),
-                    g_vpr_ctx.atom(),
-                    g_vpr_ctx.clustering(),
-                    openfpga_ctx.mutable_vpr_device_annotation(),
-                    openfpga_ctx.mutable_vpr_clustering_annotation(),
-                    cmd_context.option_enable(cmd, opt_verbose));
+  /* Clustered blocks are repacked by the threads shared by commands,
+   * unless the number of threads is specified for this command
+   */
+  std::unique_ptr<ThreadPool> command_thread_pool;
+  const ThreadPool* thread_pool = find_command_thread_pool(openfpga_ctx, cmd, cmd_context, command_thread_pool);
+  if (nullptr == thread_pool) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  if (0 != pack_physical_pbs(g_vpr_ctx.device(),
+                             g_vpr_ctx.atom(),
+                             g_vpr_ctx.clustering(),
+                             openfpga_ctx.mutable_vpr_device_annotation(),
+                             openfpga_ctx.mutable_vpr_clustering_annotation(),
+                             *thread_pool,
+                             cmd_context.option_enable(cmd, opt_verbose))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
 
   build_physical_lut_truth_tables(openfpga_ctx.mutable_vpr_clustering_annotation(),
                                   g_vpr_ctx.atom(),
@@ -17,6 +17,8 @@
 #include "analysis_sdc_writer.h"
 #include "configuration_chain_sdc_writer.h"
 #include "configure_port_sdc_writer.h"
+#include "openfpga_command_thread_pool.h"
+#include "openfpga_build_fabric.h"
 #include "openfpga_sdc.h"
 
 /* Include global variables of VPR */
@@ -46,6 +48,20 @@ int write_pnr_sdc(const OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_constrain_switch_block_outputs = cmd.option("constrain_switch_block_outputs");
   CommandOptionId opt_constrain_zero_delay_paths = cmd.option("constrain_zero_delay_paths");
 
+  /* The modules of a lazy fabric cannot be built by this command */
+  if (CMD_EXEC_SUCCESS != check_full_fabric_built(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* By default, the threads shared by all the commands are used,
+   * unless the number of threads is specified for this command
+   */
+  std::unique_ptr<ThreadPool> command_thread_pool;
+  const ThreadPool* thread_pool = find_command_thread_pool(openfpga_ctx, cmd, cmd_context, command_thread_pool);
+  if (nullptr == thread_pool) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* This is an intermediate data structure which is designed to modularize the FPGA-SDC
    * Keep it independent from any other outside data structures
    */
@@ -92,7 +108,8 @@ int write_pnr_sdc(const OpenfpgaContext& openfpga_ctx,
                   openfpga_ctx.mux_lib(),
                   openfpga_ctx.arch().circuit_lib,
                   openfpga_ctx.fabric_global_port_info(),
-                  openfpga_ctx.flow_manager().compress_routing());
+                  openfpga_ctx.flow_manager().compress_routing(),
+                  *thread_pool);
   }
 
   /* TODO: should identify the error code from internal function execution */
@@ -120,6 +137,11 @@ int write_configuration_chain_sdc(const OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_min_delay = cmd.option("min_delay");
   CommandOptionId opt_max_delay = cmd.option("max_delay");
 
+  /* The modules of a lazy fabric cannot be built by this command */
+  if (CMD_EXEC_SUCCESS != check_full_fabric_built(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   std::string sdc_dir_path = format_dir_path(cmd_context.option_value(cmd, opt_output_dir));
 
   float time_unit = string_to_time_unit(cmd_context.option_value(cmd, opt_time_unit));
@@ -146,6 +168,11 @@ int write_sdc_disable_timing_configure_ports(const OpenfpgaContext& openfpga_ctx
   CommandOptionId opt_flatten_names = cmd.option("flatten_names");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* The modules of a lazy fabric cannot be built by this command */
+  if (CMD_EXEC_SUCCESS != check_full_fabric_built(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   std::string sdc_dir_path = format_dir_path(cmd_context.option_value(cmd, opt_output_dir));
 
   /* Write the SDC for configuration chain */
@@ -172,6 +199,11 @@ int write_analysis_sdc(const OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_flatten_names = cmd.option("flatten_names");
   CommandOptionId opt_time_unit = cmd.option("time_unit");
 
+  /* The modules of a lazy fabric cannot be built by this command */
+  if (CMD_EXEC_SUCCESS != check_full_fabric_built(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* This is an intermediate data structure which is designed to modularize the FPGA-SDC
    * Keep it independent from any other outside data structures
    */
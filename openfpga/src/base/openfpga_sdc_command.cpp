@@ -66,6 +66,10 @@ ShellCommandId add_openfpga_write_pnr_sdc_command(openfpga::Shell<OpenfpgaContex
   /* Add an option '--constrain_zero_delay_paths' */
   shell_cmd.add_option("constrain_zero_delay_paths", false, "Constrain zero-delay paths in FPGA fabric");
 
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads used to write the SDC files of routing blocks");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -131,6 +131,10 @@ ShellCommandId add_openfpga_link_arch_command(openfpga::Shell<OpenfpgaContext>&
   /* Add an option '--sort_gsb_chan_node_in_edges'*/
   shell_cmd.add_option("sort_gsb_chan_node_in_edges", false, "Sort all the incoming edges for each routing track output node in General Switch Blocks (GSBs)");
 
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads used to annotate the routing results");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
   
@@ -287,6 +291,9 @@ ShellCommandId add_openfpga_build_fabric_command(openfpga::Shell<OpenfpgaContext
   /* Add an option '--generate_random_fabric_key' */
   shell_cmd.add_option("generate_random_fabric_key", false, "Create a random fabric key which will shuffle the memory address for encryption purpose");
 
+  /* Add an option '--lazy' */
+  shell_cmd.add_option("lazy", false, "Build the modules on demand when they are required by other commands");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -322,13 +329,17 @@ ShellCommandId add_openfpga_write_fabric_hierarchy_command(openfpga::Shell<Openf
   CommandOptionId opt_depth = shell_cmd.add_option("depth", false, "Specify the depth of hierarchy to which the writer should stop");
   shell_cmd.set_option_require_value(opt_depth, openfpga::OPT_INT);
 
+  /* Add an option '--module' */
+  CommandOptionId opt_module = shell_cmd.add_option("module", false, "Specify the module to be the root of the hierarchy. By default, it is the top-level module");
+  shell_cmd.set_option_require_value(opt_module, openfpga::OPT_STRING);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
   /* Add command 'write_fabric_hierarchy' to the Shell */
   ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Write the hierarchy of FPGA fabric graph to a plain-text file");
   shell.set_command_class(shell_cmd_id, cmd_class_id);
-  shell.set_command_const_execute_function(shell_cmd_id, write_fabric_hierarchy);
+  shell.set_command_execute_function(shell_cmd_id, write_fabric_hierarchy);
 
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
@@ -8,7 +8,10 @@
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
 
+#include "openfpga_naming.h"
 #include "spice_api.h"
+#include "openfpga_build_fabric.h"
+#include "openfpga_command_thread_pool.h"
 #include "openfpga_spice.h"
 
 /* Include global variables of VPR */
@@ -27,6 +30,22 @@ int write_fabric_spice(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_explicit_port_mapping = cmd.option("explicit_port_mapping");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* By default, the threads shared by all the commands are used,
+   * unless the number of threads is specified for this command
+   */
+  std::unique_ptr<ThreadPool> command_thread_pool;
+  const ThreadPool* thread_pool = find_command_thread_pool(openfpga_ctx, cmd, cmd_context, command_thread_pool);
+  if (nullptr == thread_pool) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Build the full fabric if the fabric is lazy */
+  if (CMD_EXEC_SUCCESS != build_fabric_module_on_demand(openfpga_ctx,
+                                                        generate_fpga_top_module_name(),
+                                                        cmd_context.option_enable(cmd, opt_verbose))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* This is an intermediate data structure which is designed to modularize the FPGA-SPICE
    * Keep it independent from any other outside data structures
    */
@@ -44,7 +63,8 @@ int write_fabric_spice(OpenfpgaContext& openfpga_ctx,
                              g_vpr_ctx.device(),
                              openfpga_ctx.vpr_device_annotation(),
                              openfpga_ctx.device_rr_gsb(),
-                             options);
+                             options,
+                             *thread_pool);
 
   return status;
 } 
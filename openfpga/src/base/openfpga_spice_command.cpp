@@ -38,6 +38,10 @@ ShellCommandId add_openfpga_write_fabric_spice_command(openfpga::Shell<OpenfpgaC
   /* Add an option '--explicit_port_mapping' */
   shell_cmd.add_option("explicit_port_mapping", false, "Use explicit port mapping in Verilog netlists");
 
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads used to write the SPICE netlists of routing blocks");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -8,7 +8,9 @@
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
 
+#include "openfpga_naming.h"
 #include "verilog_api.h"
+#include "openfpga_build_fabric.h"
 #include "openfpga_verilog.h"
 
 /* Include global variables of VPR */
@@ -27,6 +29,7 @@ int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_explicit_port_mapping = cmd.option("explicit_port_mapping");
   CommandOptionId opt_include_timing = cmd.option("include_timing");
   CommandOptionId opt_print_user_defined_template = cmd.option("print_user_defined_template");
+  CommandOptionId opt_module = cmd.option("module");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
   /* This is an intermediate data structure which is designed to modularize the FPGA-Verilog
@@ -39,6 +42,35 @@ int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
   options.set_print_user_defined_template(cmd_context.option_enable(cmd, opt_print_user_defined_template));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_compress_routing(openfpga_ctx.flow_manager().compress_routing());
+
+  /* Output a single module and its children only */
+  if (true == cmd_context.option_enable(cmd, opt_module)) {
+    std::string module_name = cmd_context.option_value(cmd, opt_module);
+
+    /* Build the modules if the fabric is lazy */
+    if (CMD_EXEC_SUCCESS != build_fabric_module_on_demand(openfpga_ctx, module_name,
+                                                          cmd_context.option_enable(cmd, opt_verbose))) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+
+    if (0 != fpga_fabric_verilog_module(openfpga_ctx.mutable_module_graph(),
+                                        openfpga_ctx.mutable_verilog_netlists(),
+                                        openfpga_ctx.arch().circuit_lib,
+                                        openfpga_ctx.mux_lib(),
+                                        openfpga_ctx.decoder_lib(),
+                                        module_name,
+                                        options)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+
+    return CMD_EXEC_SUCCESS;
+  }
+
+  /* The full fabric is required */
+  if (CMD_EXEC_SUCCESS != build_fabric_module_on_demand(openfpga_ctx, generate_fpga_top_module_name(),
+                                                        cmd_context.option_enable(cmd, opt_verbose))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
   
   fpga_fabric_verilog(openfpga_ctx.mutable_module_graph(),
                       openfpga_ctx.mutable_verilog_netlists(),
@@ -57,7 +89,7 @@ int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
 /********************************************************************
  * A wrapper function to call the Verilog testbench generator of FPGA-Verilog 
  *******************************************************************/
-int write_verilog_testbench(OpenfpgaContext& openfpga_ctx,
+int write_verilog_testbench(const OpenfpgaContext& openfpga_ctx,
                             const Command& cmd, const CommandContext& cmd_context) {
 
   CommandOptionId opt_output_dir = cmd.option("file");
@@ -73,6 +105,11 @@ int write_verilog_testbench(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_support_icarus_simulator = cmd.option("support_icarus_simulator");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* The modules of a lazy fabric cannot be built by this command */
+  if (CMD_EXEC_SUCCESS != check_full_fabric_built(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* This is an intermediate data structure which is designed to modularize the FPGA-Verilog
    * Keep it independent from any other outside data structures
    */
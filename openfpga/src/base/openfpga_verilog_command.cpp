@@ -36,6 +36,10 @@ ShellCommandId add_openfpga_write_fabric_verilog_command(openfpga::Shell<Openfpg
   /* Add an option '--print_user_defined_template' */
   shell_cmd.add_option("print_user_defined_template", false, "Generate a template Verilog files for user-defined circuit models");
 
+  /* Add an option '--module' */
+  CommandOptionId module_opt = shell_cmd.add_option("module", false, "Output only the Verilog netlists required by the given module");
+  shell_cmd.set_option_require_value(module_opt, openfpga::OPT_STRING);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -105,7 +109,7 @@ ShellCommandId add_openfpga_write_verilog_testbench_command(openfpga::Shell<Open
   /* Add command to the Shell */
   ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "generate Verilog testbenches for full FPGA fabric");
   shell.set_command_class(shell_cmd_id, cmd_class_id);
-  shell.set_command_execute_function(shell_cmd_id, write_verilog_testbench);
+  shell.set_command_const_execute_function(shell_cmd_id, write_verilog_testbench);
 
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
@@ -26,26 +26,13 @@
 namespace openfpga {
 
 /********************************************************************
- * The main function to be called for building module graphs 
- * for a FPGA fabric
+ * Build the primitive modules, which are the corner stones of 
+ * all the other modules of a FPGA fabric
  *******************************************************************/
-int build_device_module_graph(ModuleManager& module_manager,
-                              DecoderLibrary& decoder_lib,
-                              const OpenfpgaContext& openfpga_ctx,
-                              const DeviceContext& vpr_device_ctx,
-                              const bool& frame_view,
-                              const bool& compress_routing,
-                              const bool& duplicate_grid_pin,
-                              const FabricKey& fabric_key,
-                              const bool& generate_random_fabric_key,
-                              const bool& verbose) {
-  vtr::ScopedStartFinishTimer timer("Build fabric module graph");
-
-  int status = CMD_EXEC_SUCCESS;
-
-  CircuitModelId sram_model = openfpga_ctx.arch().config_protocol.memory_model();  
-  VTR_ASSERT(true == openfpga_ctx.arch().circuit_lib.valid_model_id(sram_model));
-
+static 
+void build_device_primitive_modules(ModuleManager& module_manager,
+                                    DecoderLibrary& decoder_lib,
+                                    const OpenfpgaContext& openfpga_ctx) {
   /* Add constant generator modules: VDD and GND */
   build_constant_generator_modules(module_manager);
 
@@ -77,17 +64,19 @@ int build_device_module_graph(ModuleManager& module_manager,
                        openfpga_ctx.mux_lib(), 
                        openfpga_ctx.arch().circuit_lib,
                        openfpga_ctx.arch().config_protocol.type());
+}
 
-  /* Build grid and programmable block modules */
-  build_grid_modules(module_manager,
-                     decoder_lib,
-                     vpr_device_ctx,
-                     openfpga_ctx.vpr_device_annotation(),
-                     openfpga_ctx.arch().circuit_lib,
-                     openfpga_ctx.mux_lib(),
-                     openfpga_ctx.arch().config_protocol.type(),
-                     sram_model, duplicate_grid_pin, verbose);
-
+/********************************************************************
+ * Build the routing modules, i.e., Switch Blocks and Connection Blocks
+ *******************************************************************/
+static 
+void build_device_routing_modules(ModuleManager& module_manager,
+                                  DecoderLibrary& decoder_lib,
+                                  const OpenfpgaContext& openfpga_ctx,
+                                  const DeviceContext& vpr_device_ctx,
+                                  const CircuitModelId& sram_model,
+                                  const bool& compress_routing,
+                                  const bool& verbose) {
   if (true == compress_routing) {
     build_unique_routing_modules(module_manager,
                                  decoder_lib,
@@ -108,6 +97,46 @@ int build_device_module_graph(ModuleManager& module_manager,
                                   openfpga_ctx.arch().config_protocol.type(),
                                   sram_model, verbose);
   }
+}
+
+/********************************************************************
+ * The main function to be called for building module graphs 
+ * for a FPGA fabric
+ *******************************************************************/
+int build_device_module_graph(ModuleManager& module_manager,
+                              DecoderLibrary& decoder_lib,
+                              const OpenfpgaContext& openfpga_ctx,
+                              const DeviceContext& vpr_device_ctx,
+                              const bool& frame_view,
+                              const bool& compress_routing,
+                              const bool& duplicate_grid_pin,
+                              const FabricKey& fabric_key,
+                              const bool& generate_random_fabric_key,
+                              const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Build fabric module graph");
+
+  int status = CMD_EXEC_SUCCESS;
+
+  CircuitModelId sram_model = openfpga_ctx.arch().config_protocol.memory_model();  
+  VTR_ASSERT(true == openfpga_ctx.arch().circuit_lib.valid_model_id(sram_model));
+
+  /* Build primitive modules */
+  build_device_primitive_modules(module_manager, decoder_lib, openfpga_ctx);
+
+  /* Build grid and programmable block modules */
+  build_grid_modules(module_manager,
+                     decoder_lib,
+                     vpr_device_ctx,
+                     openfpga_ctx.vpr_device_annotation(),
+                     openfpga_ctx.arch().circuit_lib,
+                     openfpga_ctx.mux_lib(),
+                     openfpga_ctx.arch().config_protocol.type(),
+                     sram_model, duplicate_grid_pin, verbose);
+
+  /* Build routing modules */
+  build_device_routing_modules(module_manager, decoder_lib,
+                               openfpga_ctx, vpr_device_ctx,
+                               sram_model, compress_routing, verbose);
 
   /* Build FPGA fabric top-level module */
   status = build_top_module(module_manager,
@@ -140,4 +169,86 @@ int build_device_module_graph(ModuleManager& module_manager,
   return status;
 }
 
+/********************************************************************
+ * Build only the modules which are required by a given module,
+ * i.e., the module itself and all its children in the hierarchy.
+ * This is an on-demand alternative to build_device_module_graph(),
+ * which is much faster on large fabrics when only a primitive, grid
+ * or routing module is of interest.
+ *
+ * The primitive modules are always built, as they are the leaves 
+ * of the other modules. Then the builder of the requested module 
+ * is resolved from its name:
+ *  - a physical tile of a grid type, on a border side for I/O tiles,
+ *    or a programmable block of a logical tile
+ *  - a Switch Block or a Connection Block at a GSB coordinate
+ * and only this module and its children are built.
+ * The top-level module requires all the modules of the fabric
+ * and cannot be built by this function.
+ *
+ * Note that the ports of primitive modules are renamed at the end,
+ * so the module manager must be empty when calling this function.
+ *******************************************************************/
+int build_device_submodule_graph(ModuleManager& module_manager,
+                                 DecoderLibrary& decoder_lib,
+                                 const OpenfpgaContext& openfpga_ctx,
+                                 const DeviceContext& vpr_device_ctx,
+                                 const std::string& module_name,
+                                 const bool& compress_routing,
+                                 const bool& duplicate_grid_pin,
+                                 const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Build fabric module graph for module '" + module_name + "'");
+
+  VTR_ASSERT(0 == module_manager.num_modules());
+
+  CircuitModelId sram_model = openfpga_ctx.arch().config_protocol.memory_model();  
+  VTR_ASSERT(true == openfpga_ctx.arch().circuit_lib.valid_model_id(sram_model));
+
+  /* Build primitive modules */
+  build_device_primitive_modules(module_manager, decoder_lib, openfpga_ctx);
+
+  ModuleId module = module_manager.find_module(module_name);
+
+  /* Build the grid module and its programmable blocks */
+  if (false == module_manager.valid_module_id(module)) {
+    module = build_grid_module_by_name(module_manager,
+                                       decoder_lib,
+                                       vpr_device_ctx,
+                                       openfpga_ctx.vpr_device_annotation(),
+                                       openfpga_ctx.arch().circuit_lib,
+                                       openfpga_ctx.mux_lib(),
+                                       openfpga_ctx.arch().config_protocol.type(),
+                                       sram_model, module_name, 
+                                       duplicate_grid_pin, verbose);
+  }
+
+  /* Build the routing module */
+  if (false == module_manager.valid_module_id(module)) {
+    module = build_routing_module_by_name(module_manager,
+                                          decoder_lib,
+                                          vpr_device_ctx,
+                                          openfpga_ctx.vpr_device_annotation(),
+                                          openfpga_ctx.device_rr_gsb(),
+                                          openfpga_ctx.arch().circuit_lib,
+                                          openfpga_ctx.arch().config_protocol.type(),
+                                          sram_model, compress_routing,
+                                          module_name, verbose);
+  }
+
+  if (false == module_manager.valid_module_id(module)) {
+    VTR_LOG_ERROR("Unable to build module '%s' on demand! Only primitive, grid and routing modules are supported.\n",
+                  module_name.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  VTR_LOGV(verbose,
+           "Built %lu modules for module '%s'\n",
+           module_manager.num_modules(), module_name.c_str());
+
+  /* Rename the ports of primitive modules, same as the full builder */
+  rename_primitive_module_port_names(module_manager, openfpga_ctx.arch().circuit_lib);
+
+  return CMD_EXEC_SUCCESS;
+}
+
 } /* end namespace openfpga */
@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <string>
 #include "vpr_context.h"
 #include "openfpga_context.h"
 #include "fabric_key.h"
@@ -26,6 +27,15 @@ int build_device_module_graph(ModuleManager& module_manager,
                               const bool& generate_random_fabric_key,
                               const bool& verbose);
 
+int build_device_submodule_graph(ModuleManager& module_manager,
+                                 DecoderLibrary& decoder_lib,
+                                 const OpenfpgaContext& openfpga_ctx,
+                                 const DeviceContext& vpr_device_ctx,
+                                 const std::string& module_name,
+                                 const bool& compress_routing,
+                                 const bool& duplicate_grid_pin,
+                                 const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
@@ -992,6 +992,8 @@ void build_physical_tile_module(ModuleManager& module_manager,
 
   ModuleId grid_module = module_manager.add_module(grid_module_name); 
   VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
+  /* Label module usage */
+  module_manager.set_module_usage(grid_module, ModuleManager::MODULE_GRID);
 
   /* Now each physical tile may have a number of logical blocks
    * OpenFPGA only considers the physical implementation of the tiles.
@@ -1207,4 +1209,122 @@ void build_grid_modules(ModuleManager& module_manager,
   VTR_LOG("Done\n");
 }
 
+/********************************************************************
+ * Find the pb_graph_node whose module has a given name, 
+ * among the physical modes of a pb_graph, using a Depth First Search
+ * Return nullptr if not found
+ *******************************************************************/
+static 
+t_pb_graph_node* rec_find_physical_pb_graph_node_by_module_name(const VprDeviceAnnotation& device_annotation,
+                                                                t_pb_graph_node* physical_pb_graph_node,
+                                                                const std::string& module_name) {
+  t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type; 
+  if (module_name == generate_physical_block_module_name(physical_pb_type)) {
+    return physical_pb_graph_node;
+  }
+
+  if (true == is_primitive_pb_type(physical_pb_type)) { 
+    return nullptr;
+  }
+
+  t_mode* physical_mode = device_annotation.physical_mode(physical_pb_type);
+  for (int ipb = 0; ipb < physical_mode->num_pb_type_children; ++ipb) {
+    t_pb_graph_node* found_pb_graph_node = rec_find_physical_pb_graph_node_by_module_name(device_annotation,
+                                                                                          &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][0]),
+                                                                                          module_name);
+    if (nullptr != found_pb_graph_node) {
+      return found_pb_graph_node;
+    }
+  }
+
+  return nullptr;
+}
+
+/********************************************************************
+ * Build only the grid module with a given name and the modules it requires,
+ * which is an on-demand alternative to build_grid_modules().
+ * The module can be
+ * - a physical tile, which requires the logical tile modules 
+ *   of its equivalent sites. Only the border side of I/O tiles 
+ *   in the name is built.
+ * - a pb_type in the physical mode of a logical tile, which requires 
+ *   the modules of its child pb_types only
+ * The modules are built in the same way as build_grid_modules().
+ * Primitive modules, e.g., LUTs and multiplexers, should have been built.
+ *
+ * Return the id of the module, or an invalid id if no grid module 
+ * has the given name
+ *******************************************************************/
+ModuleId build_grid_module_by_name(ModuleManager& module_manager,
+                                   DecoderLibrary& decoder_lib,
+                                   const DeviceContext& device_ctx,
+                                   const VprDeviceAnnotation& device_annotation,
+                                   const CircuitLibrary& circuit_lib,
+                                   const MuxLibrary& mux_lib,
+                                   const e_config_protocol_type& sram_orgz_type,
+                                   const CircuitModelId& sram_model,
+                                   const std::string& module_name,
+                                   const bool& duplicate_grid_pin,
+                                   const bool& verbose) {
+  /* Find the physical tile and its border side from the name */
+  for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
+    if (true == is_empty_type(&physical_tile)) {
+      continue;
+    }
+    std::set<e_side> tile_sides = {NUM_SIDES};
+    if (true == is_io_type(&physical_tile)) {
+      tile_sides = find_physical_io_tile_located_sides(device_ctx.grid, &physical_tile);
+    }
+    for (const e_side& tile_side : tile_sides) {
+      if (module_name != generate_grid_block_module_name(std::string(GRID_MODULE_NAME_PREFIX), 
+                                                         std::string(physical_tile.name),
+                                                         is_io_type(&physical_tile),
+                                                         tile_side)) {
+        continue;
+      }
+      for (t_logical_block_type_ptr lb_type : physical_tile.equivalent_sites) {
+        if (nullptr == lb_type->pb_graph_head) {
+          continue;
+        }
+        rec_build_logical_tile_modules(module_manager, decoder_lib,
+                                       device_annotation,
+                                       circuit_lib, mux_lib,
+                                       sram_orgz_type, sram_model, 
+                                       lb_type->pb_graph_head,
+                                       verbose);
+      }
+      build_physical_tile_module(module_manager, decoder_lib,
+                                 circuit_lib,
+                                 sram_orgz_type, sram_model,
+                                 &physical_tile,
+                                 tile_side,
+                                 duplicate_grid_pin,
+                                 verbose);
+      return module_manager.find_module(module_name);
+    }
+  }
+
+  /* Find the pb_type in the logical tiles from the name */
+  for (const t_logical_block_type& logical_tile : device_ctx.logical_block_types) {
+    if (nullptr == logical_tile.pb_graph_head) {
+      continue;
+    }
+    t_pb_graph_node* pb_graph_node = rec_find_physical_pb_graph_node_by_module_name(device_annotation,
+                                                                                    logical_tile.pb_graph_head,
+                                                                                    module_name);
+    if (nullptr == pb_graph_node) {
+      continue;
+    }
+    rec_build_logical_tile_modules(module_manager, decoder_lib,
+                                   device_annotation,
+                                   circuit_lib, mux_lib,
+                                   sram_orgz_type, sram_model, 
+                                   pb_graph_node,
+                                   verbose);
+    return module_manager.find_module(module_name);
+  }
+
+  return ModuleId::INVALID();
+}
+
 } /* end namespace openfpga */
@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <string>
 #include "vpr_context.h"
 #include "vpr_device_annotation.h"
 #include "module_manager.h"
@@ -28,6 +29,18 @@ void build_grid_modules(ModuleManager& module_manager,
                         const bool& duplicate_grid_pin,
                         const bool& verbose);
 
+ModuleId build_grid_module_by_name(ModuleManager& module_manager,
+                                   DecoderLibrary& decoder_lib,
+                                   const DeviceContext& device_ctx,
+                                   const VprDeviceAnnotation& device_annotation,
+                                   const CircuitLibrary& circuit_lib,
+                                   const MuxLibrary& mux_lib,
+                                   const e_config_protocol_type& sram_orgz_type,
+                                   const CircuitModelId& sram_model,
+                                   const std::string& module_name,
+                                   const bool& duplicate_grid_pin,
+                                   const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
@@ -5,6 +5,7 @@
  * 1. Connection blocks
  * 2. Switch blocks
  *******************************************************************/
+#include <map>
 #include <vector>
 
 /* Headers from vtrutil library */
@@ -1050,4 +1051,92 @@ void build_unique_routing_modules(ModuleManager& module_manager,
   }
 }
 
+/********************************************************************
+ * Build only the Switch Block or the Connection Block module 
+ * with a given name, which is an on-demand alternative to 
+ * build_flatten_routing_modules() and build_unique_routing_modules().
+ * When the routing hierarchy is compressed, only the unique modules
+ * can be built.
+ * Primitive modules, e.g., multiplexers, should have been built.
+ *
+ * Return the id of the module, or an invalid id if no routing module 
+ * has the given name
+ *******************************************************************/
+ModuleId build_routing_module_by_name(ModuleManager& module_manager,
+                                      DecoderLibrary& decoder_lib,
+                                      const DeviceContext& device_ctx,
+                                      const VprDeviceAnnotation& device_annotation,
+                                      const DeviceRRGSB& device_rr_gsb,
+                                      const CircuitLibrary& circuit_lib,
+                                      const e_config_protocol_type& sram_orgz_type,
+                                      const CircuitModelId& sram_model,
+                                      const bool& compact_routing_hierarchy,
+                                      const std::string& module_name,
+                                      const bool& verbose) {
+  /* Collect the GSBs whose routing modules are built, in the same way as the full builders */
+  std::vector<const RRGSB*> sb_gsbs;
+  std::map<t_rr_type, std::vector<const RRGSB*>> cb_gsbs;
+  if (true == compact_routing_hierarchy) {
+    for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
+      sb_gsbs.push_back(&(device_rr_gsb.get_sb_unique_module(isb)));
+    }
+    for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+      for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(cb_type); ++icb) {
+        cb_gsbs[cb_type].push_back(&(device_rr_gsb.get_cb_unique_module(cb_type, icb)));
+      }
+    }
+  } else {
+    vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+    for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+      for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+        const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+        if (true == rr_gsb.is_sb_exist()) {
+          sb_gsbs.push_back(&rr_gsb);
+        }
+        for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+          if (true == rr_gsb.is_cb_exist(cb_type)) {
+            cb_gsbs[cb_type].push_back(&rr_gsb);
+          }
+        }
+      }
+    }
+  }
+
+  for (const RRGSB* rr_gsb : sb_gsbs) {
+    vtr::Point<size_t> gsb_coordinate(rr_gsb->get_sb_x(), rr_gsb->get_sb_y());
+    if (module_name != generate_switch_block_module_name(gsb_coordinate)) {
+      continue;
+    }
+    build_switch_block_module(module_manager,
+                              decoder_lib,
+                              device_annotation,
+                              device_ctx.rr_graph,
+                              circuit_lib, 
+                              sram_orgz_type, sram_model, 
+                              *rr_gsb,
+                              verbose);
+    return module_manager.find_module(module_name);
+  }
+
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (const RRGSB* rr_gsb : cb_gsbs[cb_type]) {
+      vtr::Point<size_t> gsb_coordinate(rr_gsb->get_cb_x(cb_type), rr_gsb->get_cb_y(cb_type));
+      if (module_name != generate_connection_block_module_name(cb_type, gsb_coordinate)) {
+        continue;
+      }
+      build_connection_block_module(module_manager, 
+                                    decoder_lib,
+                                    device_annotation,
+                                    device_ctx.rr_graph,
+                                    circuit_lib, 
+                                    sram_orgz_type, sram_model, 
+                                    *rr_gsb, cb_type,
+                                    verbose);
+      return module_manager.find_module(module_name);
+    }
+  }
+
+  return ModuleId::INVALID();
+}
+
 } /* end namespace openfpga */
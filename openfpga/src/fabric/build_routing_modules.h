@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <string>
 #include "vpr_context.h"
 #include "vpr_device_annotation.h"
 #include "device_rr_gsb.h"
@@ -39,6 +40,18 @@ void build_unique_routing_modules(ModuleManager& module_manager,
                                   const CircuitModelId& sram_model,
                                   const bool& verbose); 
 
+ModuleId build_routing_module_by_name(ModuleManager& module_manager,
+                                      DecoderLibrary& decoder_lib,
+                                      const DeviceContext& device_ctx,
+                                      const VprDeviceAnnotation& device_annotation,
+                                      const DeviceRRGSB& device_rr_gsb,
+                                      const CircuitLibrary& circuit_lib,
+                                      const e_config_protocol_type& sram_orgz_type,
+                                      const CircuitModelId& sram_model,
+                                      const bool& compact_routing_hierarchy,
+                                      const std::string& module_name,
+                                      const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
@@ -388,7 +388,7 @@ int build_top_module(ModuleManager& module_manager,
 
   /* Shuffle the configurable children in a random sequence */
   if (true == generate_random_fabric_key) {
-    shuffle_top_module_configurable_children(module_manager, top_module, config_protocol);
+    shuffle_top_module_configurable_children(module_manager, top_module, circuit_lib, config_protocol);
   }
 
   /* Add shared SRAM ports from the sub-modules under this Verilog module
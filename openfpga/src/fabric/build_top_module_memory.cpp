@@ -3,6 +3,8 @@
  * in the top module of FPGA fabric
  *******************************************************************/
 #include <cmath>
+#include <algorithm>
+#include <map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -177,6 +179,233 @@ void organize_top_module_tile_memory_modules(ModuleManager& module_manager,
 }
 
 
+/********************************************************************
+ * Estimate the number of configuration bits of a region in the top module
+ * with the statistics on its configurable children
+ * - For flatten, chain and memory bank configuration protocol
+ *   The number of configuration bits is the sum of configuration bits 
+ *   per configurable children 
+ * - For frame-based configuration protocol
+ *   The number of configuration bits is the sum of
+ *   - the maximum of configuration bits among configurable children
+ *   - and the address size of the decoder for the configurable children
+ *     (only required when there are more than 1 configurable children)
+ *******************************************************************/
+static 
+size_t estimate_top_module_region_num_config_bits(const e_config_protocol_type& config_protocol_type,
+                                                  const size_t& sum_child_num_config_bits,
+                                                  const size_t& max_child_num_config_bits,
+                                                  const size_t& num_children) {
+  if (CONFIG_MEM_FRAME_BASED != config_protocol_type) {
+    return sum_child_num_config_bits;
+  }
+
+  size_t num_config_bits = max_child_num_config_bits;
+  if (1 < num_children) {
+    num_config_bits += find_mux_local_decoder_addr_size(num_children);
+  }
+  return num_config_bits;
+}
+
+/********************************************************************
+ * Find the minimum number of regions required to split a list of 
+ * configurable children (in sequence), when no region can 
+ * exceed a given number of configuration bits
+ *******************************************************************/
+static 
+size_t find_top_module_num_regions_under_capacity(const std::vector<size_t>& child_num_config_bits,
+                                                  const e_config_protocol_type& config_protocol_type,
+                                                  const size_t& region_capacity) {
+  size_t num_regions = 0;
+  size_t sum_bits = 0;
+  size_t max_bits = 0;
+  size_t num_children = 0;
+  for (const size_t& child_bits : child_num_config_bits) {
+    size_t region_bits = estimate_top_module_region_num_config_bits(config_protocol_type,
+                                                                    sum_bits + child_bits,
+                                                                    std::max(max_bits, child_bits),
+                                                                    num_children + 1);
+    if ((0 == num_children) || (region_bits > region_capacity)) {
+      /* Start a new region */
+      num_regions++;
+      sum_bits = 0;
+      max_bits = 0;
+      num_children = 0;
+    }
+    sum_bits += child_bits;
+    max_bits = std::max(max_bits, child_bits);
+    num_children++;
+  }
+  return num_regions;
+}
+
+/********************************************************************
+ * Split configurable children evenly by their number, following
+ * the sequence of configurable children.
+ * The last region contains all the remaining children
+ *******************************************************************/
+static  
+void build_top_module_even_configurable_regions(ModuleManager& module_manager,
+                                                const ModuleId& top_module,
+                                                const ConfigProtocol& config_protocol) {
+  /* Exclude decoders from the list */
+  size_t num_configurable_children = module_manager.configurable_children(top_module).size();
+  if (CONFIG_MEM_MEMORY_BANK == config_protocol.type()) {
+    num_configurable_children -= 2;
+  } else if (CONFIG_MEM_FRAME_BASED == config_protocol.type()) {
+    num_configurable_children -= 1;
+  }
+
+  /* Evenly place each configurable child to each region */
+  size_t num_children_per_region = num_configurable_children / config_protocol.num_regions(); 
+  size_t region_child_counter = 0;
+  bool create_region = true;
+  ConfigRegionId curr_region = ConfigRegionId::INVALID();
+  for (size_t ichild = 0; ichild < module_manager.configurable_children(top_module).size(); ++ichild) {
+    if (true == create_region) {
+      curr_region = module_manager.add_config_region(top_module);
+    }
+
+    /* Add the child to a region */
+    module_manager.add_configurable_child_to_region(top_module,
+                                                    curr_region,
+                                                    module_manager.configurable_children(top_module)[ichild],
+                                                    module_manager.configurable_child_instances(top_module)[ichild],
+                                                    ichild);
+
+    /* See if the current region is full or not:
+     * For the last region, we will keep adding until we finish all the children 
+     */
+    region_child_counter++;
+    if (region_child_counter < num_children_per_region) {
+      create_region = false;
+    } else if (size_t(curr_region) < (size_t)config_protocol.num_regions() - 1) {
+      create_region = true;
+      region_child_counter = 0;
+    }
+  }
+
+  /* Ensure that the number of configurable regions created matches the definition */
+  VTR_ASSERT((size_t)config_protocol.num_regions() == module_manager.regions(top_module).size());
+}
+
+/********************************************************************
+ * Split configurable children into contiguous groups, following
+ * the sequence of configurable children, so that the number of 
+ * configuration bits of each region is balanced. 
+ * As the regions are configured in parallel, the configuration time 
+ * is bounded by the region with the largest number of bits. 
+ * Therefore, we look for the partition which minimizes the largest 
+ * number of configuration bits among the regions.
+ *******************************************************************/
+static  
+void build_top_module_balanced_configurable_regions(ModuleManager& module_manager,
+                                                    const ModuleId& top_module,
+                                                    const CircuitLibrary& circuit_lib,
+                                                    const ConfigProtocol& config_protocol) {
+  size_t num_regions = config_protocol.num_regions();
+
+  /* Note that decoders are added to the configurable children 
+   * only after the regions are built, so all the children are considered here
+   */
+  std::vector<ModuleId> configurable_children = module_manager.configurable_children(top_module);
+  std::vector<size_t> configurable_child_instances = module_manager.configurable_child_instances(top_module);
+  size_t num_configurable_children = configurable_children.size();
+  if (num_configurable_children < num_regions) {
+    VTR_LOG_ERROR("Unable to split %lu configurable children into %lu configurable regions!\n",
+                  num_configurable_children, num_regions);
+    exit(1);
+  }
+
+  /* Find the number of configuration bits of each child; 
+   * many children share the same module, so cache the results
+   */
+  std::map<ModuleId, size_t> module_num_config_bits;
+  std::vector<size_t> child_num_config_bits;
+  child_num_config_bits.reserve(num_configurable_children);
+  for (const ModuleId& child_module : configurable_children) {
+    auto result = module_num_config_bits.find(child_module);
+    if (result == module_num_config_bits.end()) {
+      result = module_num_config_bits.insert(std::make_pair(child_module,
+                                                            find_module_num_config_bits(module_manager, child_module, 
+                                                                                        circuit_lib, config_protocol.memory_model(), 
+                                                                                        config_protocol.type()))).first;
+    }
+    child_num_config_bits.push_back(result->second);
+  }
+
+  /* Binary search the smallest capacity of a region, 
+   * under which the children can be split into the given number of regions
+   * - Lower bound: a region contains at least one child
+   * - Upper bound: all the children are in one region
+   */
+  size_t min_capacity = 0;
+  size_t sum_bits = 0;
+  size_t max_bits = 0;
+  for (const size_t& child_bits : child_num_config_bits) {
+    min_capacity = std::max(min_capacity, estimate_top_module_region_num_config_bits(config_protocol.type(), child_bits, child_bits, 1)); 
+    sum_bits += child_bits;
+    max_bits = std::max(max_bits, child_bits);
+  }
+  size_t max_capacity = estimate_top_module_region_num_config_bits(config_protocol.type(), sum_bits, max_bits, num_configurable_children);
+  while (min_capacity < max_capacity) {
+    size_t capacity = min_capacity + (max_capacity - min_capacity) / 2;
+    if (num_regions >= find_top_module_num_regions_under_capacity(child_num_config_bits, config_protocol.type(), capacity)) {
+      max_capacity = capacity;
+    } else {
+      min_capacity = capacity + 1;
+    }
+  }
+  size_t region_capacity = max_capacity;
+
+  /* Place configurable children to regions in sequence 
+   * A new region is started when 
+   * - the current region will exceed the capacity, or
+   * - each of the remaining children has to be in a region of its own,
+   *   so that no region is left empty 
+   */
+  ConfigRegionId curr_region = ConfigRegionId::INVALID();
+  sum_bits = 0;
+  max_bits = 0;
+  size_t region_num_children = 0;
+  for (size_t ichild = 0; ichild < num_configurable_children; ++ichild) {
+    size_t child_bits = child_num_config_bits[ichild];
+    size_t num_regions_to_create = num_regions - module_manager.regions(top_module).size();
+    bool create_region = (ConfigRegionId::INVALID() == curr_region);
+    if ((false == create_region) && (0 < num_regions_to_create)) {
+      size_t region_bits = estimate_top_module_region_num_config_bits(config_protocol.type(),
+                                                                      sum_bits + child_bits,
+                                                                      std::max(max_bits, child_bits),
+                                                                      region_num_children + 1);
+      create_region = (region_bits > region_capacity)
+                   || (num_configurable_children - ichild == num_regions_to_create);
+    }
+
+    if (true == create_region) {
+      curr_region = module_manager.add_config_region(top_module);
+      sum_bits = 0;
+      max_bits = 0;
+      region_num_children = 0;
+    }
+
+    /* Add the child to a region */
+    module_manager.add_configurable_child_to_region(top_module,
+                                                    curr_region,
+                                                    configurable_children[ichild],
+                                                    configurable_child_instances[ichild],
+                                                    ichild);
+    sum_bits += child_bits;
+    max_bits = std::max(max_bits, child_bits);
+    region_num_children++;
+  }
+
+  /* Ensure that the number of configurable regions created matches the definition */
+  VTR_ASSERT(num_regions == module_manager.regions(top_module).size());
+
+  VTR_LOG("Maximum number of configuration bits in a region: %lu\n",
+          region_capacity);
+}
+
 /********************************************************************
  * Split memory modules into different configurable regions
  * This function will create regions based on the definition
@@ -212,6 +441,12 @@ void organize_top_module_tile_memory_modules(ModuleManager& module_manager,
  *  | +------+ +------+     |
  *  +-----------------------+
  *
+ * Configurable children are split into contiguous groups, following
+ * the sequence of configurable children, either
+ * - evenly by the number of children, or
+ * - by the number of configuration bits, when required by
+ *   the configuration protocol
+ *
  * Note:
  *   - This function should NOT modify configurable children
  *
@@ -219,6 +454,7 @@ void organize_top_module_tile_memory_modules(ModuleManager& module_manager,
 static  
 void build_top_module_configurable_regions(ModuleManager& module_manager,
                                            const ModuleId& top_module,
+                                           const CircuitLibrary& circuit_lib,
                                            const ConfigProtocol& config_protocol) {
 
   vtr::ScopedStartFinishTimer timer("Build configurable regions for the top module");
@@ -229,45 +465,11 @@ void build_top_module_configurable_regions(ModuleManager& module_manager,
   /* Ensure that our region definition is valid */
   VTR_ASSERT(1 <= config_protocol.num_regions());
 
-  /* Exclude decoders from the list */
-  size_t num_configurable_children = module_manager.configurable_children(top_module).size();
-  if (CONFIG_MEM_MEMORY_BANK == config_protocol.type()) {
-    num_configurable_children -= 2;
-  } else if (CONFIG_MEM_FRAME_BASED == config_protocol.type()) {
-    num_configurable_children -= 1;
+  if (true == config_protocol.balance_regions()) {
+    build_top_module_balanced_configurable_regions(module_manager, top_module, circuit_lib, config_protocol);
+  } else {
+    build_top_module_even_configurable_regions(module_manager, top_module, config_protocol);
   }
-
-  /* Evenly place each configurable child to each region */
-  size_t num_children_per_region = num_configurable_children / config_protocol.num_regions(); 
-  size_t region_child_counter = 0;
-  bool create_region = true;
-  ConfigRegionId curr_region = ConfigRegionId::INVALID();
-  for (size_t ichild = 0; ichild < module_manager.configurable_children(top_module).size(); ++ichild) {
-    if (true == create_region) {
-      curr_region = module_manager.add_config_region(top_module);
-    }
-
-    /* Add the child to a region */
-    module_manager.add_configurable_child_to_region(top_module,
-                                                    curr_region,
-                                                    module_manager.configurable_children(top_module)[ichild],
-                                                    module_manager.configurable_child_instances(top_module)[ichild],
-                                                    ichild);
-
-    /* See if the current region is full or not:
-     * For the last region, we will keep adding until we finish all the children 
-     */
-    region_child_counter++;
-    if (region_child_counter < num_children_per_region) {
-      create_region = false;
-    } else if (size_t(curr_region) < (size_t)config_protocol.num_regions() - 1) {
-      create_region = true;
-      region_child_counter = 0;
-    }
-  }
-
-  /* Ensure that the number of configurable regions created matches the definition */
-  VTR_ASSERT((size_t)config_protocol.num_regions() == module_manager.regions(top_module).size());
 }
 
 /********************************************************************
@@ -464,7 +666,7 @@ void organize_top_module_memory_modules(ModuleManager& module_manager,
   }
 
   /* Split memory modules into different regions */
-  build_top_module_configurable_regions(module_manager, top_module, config_protocol);  
+  build_top_module_configurable_regions(module_manager, top_module, circuit_lib, config_protocol);  
 }
 
 
@@ -483,6 +685,7 @@ void organize_top_module_memory_modules(ModuleManager& module_manager,
  ********************************************************************/
 void shuffle_top_module_configurable_children(ModuleManager& module_manager, 
                                               const ModuleId& top_module,
+                                              const CircuitLibrary& circuit_lib,
                                               const ConfigProtocol& config_protocol) {
   size_t num_keys = module_manager.configurable_children(top_module).size();
   std::vector<size_t> shuffled_keys;
@@ -508,7 +711,7 @@ void shuffle_top_module_configurable_children(ModuleManager& module_manager,
 
   /* Reset configurable regions */
   module_manager.clear_config_region(top_module);
-  build_top_module_configurable_regions(module_manager, top_module, config_protocol);  
+  build_top_module_configurable_regions(module_manager, top_module, circuit_lib, config_protocol);  
 }
 
 /********************************************************************
@@ -625,38 +828,20 @@ vtr::vector<ConfigRegionId, size_t> find_top_module_regional_num_config_bit(cons
   switch (config_protocol_type) {
   case CONFIG_MEM_STANDALONE: 
   case CONFIG_MEM_SCAN_CHAIN: 
-  case CONFIG_MEM_MEMORY_BANK: {
-    /* For flatten, chain and memory bank configuration protocol
-     * The number of configuration bits is the sum of configuration bits 
-     * per configurable children in each region 
-     */
-    for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
-      for (const ModuleId& child_module : module_manager.region_configurable_children(top_module, config_region)) {
-        num_config_bits[config_region] += find_module_num_config_bits(module_manager, child_module, circuit_lib, sram_model, config_protocol_type);
-      }
-    } 
-    break;
-  }
+  case CONFIG_MEM_MEMORY_BANK: 
   case CONFIG_MEM_FRAME_BASED: {
-    /* For frame-based configuration protocol
-     * The number of configuration bits is the sum of
-     * - the maximum of configuration bits among configurable children
-     * - and the number of configurable children
-     */
     for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+      size_t sum_bits = 0;
+      size_t max_bits = 0;
       for (const ModuleId& child_module : module_manager.region_configurable_children(top_module, config_region)) {
         size_t temp_num_config_bits = find_module_num_config_bits(module_manager, child_module, circuit_lib, sram_model, config_protocol_type);
-        num_config_bits[config_region] = std::max((int)temp_num_config_bits, (int)num_config_bits[config_region]);
-      }
-
-      /* If there are more than 2 configurable children, we need a decoder
-       * Otherwise, we can just short wire the address port to the children
-       */
-      if (1 < module_manager.region_configurable_children(top_module, config_region).size()) {
-        num_config_bits[config_region] += find_mux_local_decoder_addr_size(module_manager.region_configurable_children(top_module, config_region).size());
+        sum_bits += temp_num_config_bits;
+        max_bits = std::max(max_bits, temp_num_config_bits);
       }
+      num_config_bits[config_region] = estimate_top_module_region_num_config_bits(config_protocol_type,
+                                                                                  sum_bits, max_bits,
+                                                                                  module_manager.region_configurable_children(top_module, config_region).size());
     } 
-
     break;
   }
 
@@ -40,6 +40,7 @@ void organize_top_module_memory_modules(ModuleManager& module_manager,
 
 void shuffle_top_module_configurable_children(ModuleManager& module_manager, 
                                               const ModuleId& top_module,
+                                              const CircuitLibrary& circuit_lib,
                                               const ConfigProtocol& config_protocol);
 
 int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager,
@@ -79,7 +79,7 @@ int rec_output_module_hierarchy_to_text_file(std::fstream& fp,
 }
 
 /***************************************************************************************
- * Write the hierarchy of modules to a plain text file
+ * Write the hierarchy of modules under a root module to a plain text file
  * e.g.,
  *    <module_name>
  *      <child_module_name>
@@ -91,6 +91,7 @@ int rec_output_module_hierarchy_to_text_file(std::fstream& fp,
  * Return 2 if fail when creating files
  ***************************************************************************************/
 int write_fabric_hierarchy_to_text_file(const ModuleManager& module_manager,
+                                        const std::string& root_module_name,
                                         const std::string& fname,
                                         const size_t& hie_depth_to_stop,
                                         const bool& verbose) {
@@ -115,31 +116,30 @@ int write_fabric_hierarchy_to_text_file(const ModuleManager& module_manager,
   /* Validate the file stream */
   check_file_stream(fname.c_str(), fp);
 
-  /* Find top-level module */
-  std::string top_module_name = generate_fpga_top_module_name();
-  ModuleId top_module = module_manager.find_module(top_module_name);
-  if (true != module_manager.valid_module_id(top_module)) {
+  /* Find the root module, which is typically the top-level module */
+  ModuleId root_module = module_manager.find_module(root_module_name);
+  if (true != module_manager.valid_module_id(root_module)) {
     VTR_LOGV_ERROR(verbose,
-                   "Unable to find the top-level module '%s'!\n",
-                   top_module_name.c_str());
+                   "Unable to find the root module '%s'!\n",
+                   root_module_name.c_str());
     return 1;
   }
   
-  /* Record current depth of module: top module is the root with 0 depth */
+  /* Record current depth of module: root module is the root with 0 depth */
   size_t hie_depth = 0;
 
   if (hie_depth_to_stop < hie_depth) {
     return 0;
   }
 
-  fp << top_module_name << ":" << "\n";
+  fp << root_module_name << ":" << "\n";
 
   /* Visit child module recursively and output the hierarchy */
   int err_code = rec_output_module_hierarchy_to_text_file(fp,
                                                           hie_depth_to_stop,
                                                           hie_depth + 1, /* Start with level 1 */
                                                           module_manager,  
-                                                          top_module,
+                                                          root_module,
                                                           verbose);
 
   /* close a file */
@@ -15,6 +15,7 @@
 namespace openfpga {
 
 int write_fabric_hierarchy_to_text_file(const ModuleManager& module_manager,
+                                        const std::string& root_module_name,
                                         const std::string& fname,
                                         const size_t& hie_depth_to_stop,
                                         const bool& verbose);
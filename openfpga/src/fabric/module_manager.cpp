@@ -52,14 +52,8 @@ std::vector<size_t> ModuleManager::child_module_instances(const ModuleId& parent
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
   /* Ensure that the child module is in the child list of parent module */
-  size_t child_index = children_[parent_module].size();
-  for (size_t i = 0; i < children_[parent_module].size(); ++i) {
-    if (child_module == children_[parent_module][i]) {
-      child_index = i;
-      break;
-    } 
-  }
-  VTR_ASSERT(child_index != children_[parent_module].size());
+  size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
+  VTR_ASSERT(child_index < children_[parent_module].size());
   
   /* Create a vector, with sequentially increasing numbers */
   std::vector<size_t> instance_range(num_child_instances_[parent_module][child_index], 0);
@@ -229,9 +223,10 @@ BasicPort ModuleManager::module_port(const ModuleId& module_id, const ModulePort
 
 /* Find the module id by a given name, return invalid if not found */
 ModuleId ModuleManager::find_module(const std::string& name) const {
-  if (name_id_map_.find(name) != name_id_map_.end()) {
+  auto result = name_id_map_.find(name);
+  if (result != name_id_map_.end()) {
     /* Find it, return the id */
-    return name_id_map_.at(name); 
+    return result->second; 
   }
   /* Not found, return an invalid id */
   return ModuleId::INVALID();
@@ -274,12 +269,20 @@ size_t ModuleManager::instance_id(const ModuleId& parent_module, const ModuleId&
   size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
   VTR_ASSERT (child_index < children_[parent_module].size());
 
-  /* Search the instance name list and try to find a match */
-  for (size_t name_id = 0; name_id < child_instance_names_[parent_module][child_index].size(); ++name_id) {
-    const std::string& name = child_instance_names_[parent_module][child_index][name_id];
-    if (0 == name.compare(instance_name)) {
-      return name_id;
+  /* Unnamed instances are not in the fast look-up, search the instance name list */
+  if (true == instance_name.empty()) {
+    for (size_t name_id = 0; name_id < child_instance_names_[parent_module][child_index].size(); ++name_id) {
+      if (true == child_instance_names_[parent_module][child_index][name_id].empty()) {
+        return name_id;
+      }
     }
+    return size_t(-1);
+  }
+
+  const auto& name_lookup = child_instance_name_lookup_[parent_module][child_index];
+  auto result = name_lookup.find(instance_name);
+  if (result != name_lookup.end()) {
+    return result->second;
   }
   
   /* Not found, return an invalid name */
@@ -499,11 +502,10 @@ size_t ModuleManager::find_child_module_index_in_parent_module(const ModuleId& p
   VTR_ASSERT(valid_module_id(parent_module));
   VTR_ASSERT(valid_module_id(child_module));
   /* Try to find the child_module in the children list of parent_module*/
-  for (size_t i = 0; i < children_[parent_module].size(); ++i) {
-    if (child_module == children_[parent_module][i]) {
-      /* Found, return the number of instances */
-      return i; 
-    }
+  auto result = child_index_lookup_[parent_module].find(child_module);
+  if (result != child_index_lookup_[parent_module].end()) {
+    /* Found, return the index */
+    return result->second; 
   }
   /* Not found: return an valid value */
   return size_t(-1);
@@ -515,7 +517,7 @@ size_t ModuleManager::find_child_module_index_in_parent_module(const ModuleId& p
 /* Add a module */
 ModuleId ModuleManager::add_module(const std::string& name) {
   /* Find if the name has been used. If used, return an invalid Id and report error! */
-  std::map<std::string, ModuleId>::iterator it = name_id_map_.find(name);
+  auto it = name_id_map_.find(name);
   if (it != name_id_map_.end()) {
     return ModuleId::INVALID();
   }
@@ -531,6 +533,8 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   children_.emplace_back();
   num_child_instances_.emplace_back();
   child_instance_names_.emplace_back();
+  child_index_lookup_.emplace_back();
+  child_instance_name_lookup_.emplace_back();
   configurable_children_.emplace_back();
   configurable_child_instances_.emplace_back();
   configurable_child_regions_.emplace_back();
@@ -614,7 +618,12 @@ void ModuleManager::set_module_port_name(const ModuleId& module, const ModulePor
 void ModuleManager::set_module_name(const ModuleId& module, const std::string& name) {
   /* Validate the id of module */
   VTR_ASSERT( valid_module_id(module) );
+  /* The new name should not be used by another module */
+  VTR_ASSERT( (ModuleId::INVALID() == find_module(name)) || (module == find_module(name)) );
+  /* Update the name-to-id map */
+  name_id_map_.erase(names_[module]);
   names_[module] = name;
+  name_id_map_[name] = module;
 }
 
 void ModuleManager::set_module_usage(const ModuleId& module, const e_module_usage_type& usage) {
@@ -668,18 +677,20 @@ void ModuleManager::add_child_module(const ModuleId& parent_module, const Module
     parents_[child_module].push_back(parent_module);
   }
 
-  std::vector<ModuleId>::iterator child_it = std::find(children_[parent_module].begin(), children_[parent_module].end(), child_module);
-  if (child_it == children_[parent_module].end()) {
+  size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
+  if (size_t(-1) == child_index) {
     /* Update the child module of parent module */
+    child_index_lookup_[parent_module][child_module] = children_[parent_module].size();
     children_[parent_module].push_back(child_module);
     num_child_instances_[parent_module].push_back(1); /* By default give one */
     /* Update the instance name list */
     child_instance_names_[parent_module].emplace_back();
     child_instance_names_[parent_module].back().emplace_back();
+    child_instance_name_lookup_[parent_module].emplace_back();
   } else {
     /* Increase the counter of instances */
-    num_child_instances_[parent_module][child_it - children_[parent_module].begin()]++;
-    child_instance_names_[parent_module][child_it - children_[parent_module].begin()].emplace_back();
+    num_child_instances_[parent_module][child_index]++;
+    child_instance_names_[parent_module][child_index].emplace_back();
   }
 
   /* Update fast look-up for nets */
@@ -705,8 +716,34 @@ void ModuleManager::set_child_instance_name(const ModuleId& parent_module,
   size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
   /* We must find something! */
   VTR_ASSERT(size_t(-1) != child_index);
+  /* Unregister the previous name from the fast look-up */
+  std::vector<std::string>& instance_names = child_instance_names_[parent_module][child_index];
+  std::unordered_map<std::string, size_t>& name_lookup = child_instance_name_lookup_[parent_module][child_index];
+  const std::string prev_instance_name = instance_names[instance_id];
+  auto prev_result = name_lookup.find(prev_instance_name);
+  if ( (prev_result != name_lookup.end())
+    && (instance_id == prev_result->second) ) {
+    name_lookup.erase(prev_result);
+    /* Another instance may share the previous name */
+    for (size_t inst = instance_id + 1; inst < instance_names.size(); ++inst) {
+      if (prev_instance_name == instance_names[inst]) {
+        name_lookup[prev_instance_name] = inst;
+        break;
+      }
+    }
+  }
+
   /* Set the name */
-  child_instance_names_[parent_module][child_index][instance_id] = instance_name;
+  instance_names[instance_id] = instance_name;
+
+  /* Register the name in the fast look-up, the smallest instance id wins */
+  if (false == instance_name.empty()) {
+    auto result = name_lookup.find(instance_name);
+    if ( (result == name_lookup.end())
+      || (instance_id < result->second) ) {
+      name_lookup[instance_name] = instance_id;
+    }
+  }
 }
 
 /* Add a configurable child module to module
@@ -875,16 +912,7 @@ ModuleNetSrcId ModuleManager::add_module_net_source(const ModuleId& module, cons
    * Otherwise, add the pair
    */
   std::pair<ModuleId, ModulePortId> terminal(src_module, src_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(net_terminal_storage_.begin(),
-                                                                          net_terminal_storage_.end(),
-                                                                          terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_src_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-   VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-   net_src_terminal_ids_[module][net].push_back(std::distance(net_terminal_storage_.begin(), it));
-  }
+  net_src_terminal_ids_[module][net].push_back(find_or_add_net_terminal(terminal));
 
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t src_instance_id = instance_id;
@@ -940,16 +968,7 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(const ModuleId& module, const
    * Otherwise, add the pair
    */
   std::pair<ModuleId, ModulePortId> terminal(sink_module, sink_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(net_terminal_storage_.begin(),
-                                                                          net_terminal_storage_.end(),
-                                                                          terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_sink_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-   VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-   net_sink_terminal_ids_[module][net].push_back(std::distance(net_terminal_storage_.begin(), it));
-  }
+  net_sink_terminal_ids_[module][net].push_back(find_or_add_net_terminal(terminal));
 
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t sink_instance_id = instance_id;
@@ -990,6 +1009,22 @@ void ModuleManager::clear_config_region(const ModuleId& parent_module) {
   config_region_children_[parent_module].clear();
 }
 
+/******************************************************************************
+ * Private mutators
+ ******************************************************************************/
+/* Find the index of a pair of module and port in the net terminal storage
+ * If not found, the pair is added to the storage
+ * The look-up avoids a linear search on the storage, which grows with
+ * the number of ports of all the modules
+ */
+size_t ModuleManager::find_or_add_net_terminal(const std::pair<ModuleId, ModulePortId>& terminal) {
+  auto result = net_terminal_lookup_.emplace(terminal, net_terminal_storage_.size());
+  if (true == result.second) {
+    net_terminal_storage_.push_back(terminal);
+  }
+  return result.first->second;
+}
+
 /******************************************************************************
  * Private validators/invalidators
  ******************************************************************************/
@@ -327,6 +327,8 @@ class ModuleManager {
                                   const size_t& instance_id) const;
     bool valid_region_id(const ModuleId& module,
                          const ConfigRegionId& region) const;
+  private: /* Private mutators */
+    size_t find_or_add_net_terminal(const std::pair<ModuleId, ModulePortId>& terminal);
   private: /* Private validators/invalidators */
     void invalidate_name2id_map();
     void invalidate_port_lookup();
@@ -388,7 +390,14 @@ class ModuleManager {
     vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, size_t>>> net_sink_pin_ids_;  /* Pin ids that drive the net */ 
 
     /* fast look-up for module */
-    std::map<std::string, ModuleId> name_id_map_;
+    std::unordered_map<std::string, ModuleId> name_id_map_;
+    /* fast look-up for the index of a child module in the children_ list of its parent module */
+    vtr::vector<ModuleId, std::unordered_map<ModuleId, size_t>> child_index_lookup_; /* [parent_module][child_module] */
+    /* fast look-up for the instance id of a child module by its name.
+     * Only named instances are registered. When several instances share a name,
+     * the one with the smallest id is registered
+     */
+    vtr::vector<ModuleId, std::vector<std::unordered_map<std::string, size_t>>> child_instance_name_lookup_; /* [parent_module][child_index][instance_name] */
     /* fast look-up for ports */
     typedef vtr::vector<ModuleId, std::vector<std::vector<ModulePortId>>> PortLookup;
     mutable PortLookup port_lookup_; /* [module_ids][port_types][port_ids] */ 
@@ -401,6 +410,8 @@ class ModuleManager {
      * (either source or sink)
      */
     std::vector<std::pair<ModuleId, ModulePortId>> net_terminal_storage_;
+    /* Fast look-up to find the index of a pair in the net terminal storage */
+    std::map<std::pair<ModuleId, ModulePortId>, size_t> net_terminal_lookup_;
 };
 
 } /* end namespace openfpga */
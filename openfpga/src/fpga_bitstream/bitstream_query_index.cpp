@@ -0,0 +1,230 @@
+/******************************************************************************
+ * This file includes member functions for data structure BitstreamQueryIndex
+ ******************************************************************************/
+#include <algorithm>
+#include <cctype>
+
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+#include "bitstream_manager_utils.h"
+#include "bitstream_query_index.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Separator between block names in a hierarchy path */
+constexpr char BITSTREAM_PATH_SEPARATOR = '.';
+
+/**************************************************
+ * Public Constructor
+ *************************************************/
+BitstreamQueryIndex::BitstreamQueryIndex() {
+  clear();
+}
+
+/******************************************************************************
+ * Public Accessors
+ ******************************************************************************/
+bool BitstreamQueryIndex::empty() const {
+  return ConfigBlockId::INVALID() == top_block_;
+}
+
+bool BitstreamQueryIndex::fabric_bitstream_indexed() const {
+  return false == config_bit_fabric_bits_.empty();
+}
+
+ConfigBlockId BitstreamQueryIndex::find_block(const std::string& block_path) const {
+  std::vector<ConfigBlockId> blocks = find_blocks_by_path_prefix(block_path);
+  for (const ConfigBlockId& block : blocks) {
+    if (block_path == this->block_path(block)) {
+      return block;
+    }
+  }
+  return ConfigBlockId::INVALID();
+}
+
+std::vector<ConfigBlockId> BitstreamQueryIndex::find_blocks_by_path_prefix(const std::string& path_prefix) const {
+  std::vector<ConfigBlockId> blocks;
+  if (true == empty()) {
+    return blocks;
+  }
+
+  /* Split the path into names of blocks */
+  std::vector<std::string> names;
+  size_t name_begin = 0;
+  while (true) {
+    size_t name_end = path_prefix.find(BITSTREAM_PATH_SEPARATOR, name_begin);
+    if (std::string::npos == name_end) {
+      names.push_back(path_prefix.substr(name_begin));
+      break;
+    }
+    names.push_back(path_prefix.substr(name_begin, name_end - name_begin));
+    name_begin = name_end + 1;
+  }
+
+  /* The first name is the top block, which may be partial */
+  if (1 == names.size()) {
+    if (0 == block_names_[top_block_].compare(0, names[0].size(), names[0])) {
+      blocks.push_back(top_block_);
+    }
+    return blocks;
+  }
+  if (names[0] != block_names_[top_block_]) {
+    return blocks;
+  }
+
+  /* Go down the trie with the full names */
+  ConfigBlockId curr_block = top_block_;
+  for (size_t iname = 1; iname < names.size() - 1; ++iname) {
+    const std::vector<std::pair<std::string, ConfigBlockId>>& children = sorted_child_blocks_[curr_block];
+    auto it = std::lower_bound(children.begin(), children.end(), names[iname],
+                               [](const std::pair<std::string, ConfigBlockId>& child, const std::string& name) {
+                                 return child.first < name;
+                               });
+    if ( (it == children.end()) || (it->first != names[iname]) ) {
+      return blocks;
+    }
+    curr_block = it->second;
+  }
+
+  /* The last name can be partial: all the child blocks starting with it are matched */
+  const std::string& last_name = names.back();
+  const std::vector<std::pair<std::string, ConfigBlockId>>& children = sorted_child_blocks_[curr_block];
+  auto it = std::lower_bound(children.begin(), children.end(), last_name,
+                             [](const std::pair<std::string, ConfigBlockId>& child, const std::string& name) {
+                               return child.first < name;
+                             });
+  for (; it != children.end(); ++it) {
+    if (0 != it->first.compare(0, last_name.size(), last_name)) {
+      break;
+    }
+    blocks.push_back(it->second);
+  }
+
+  return blocks;
+}
+
+std::vector<ConfigBlockId> BitstreamQueryIndex::find_blocks_by_coordinate(const vtr::Point<size_t>& coord) const {
+  auto it = coord_blocks_.find(std::make_pair(coord.x(), coord.y()));
+  if (it == coord_blocks_.end()) {
+    return std::vector<ConfigBlockId>();
+  }
+  return it->second;
+}
+
+std::string BitstreamQueryIndex::block_path(const ConfigBlockId& block) const {
+  VTR_ASSERT(size_t(block) < block_names_.size());
+
+  std::vector<ConfigBlockId> hierarchy;
+  for (ConfigBlockId temp_block = block; ConfigBlockId::INVALID() != temp_block; temp_block = block_parents_[temp_block]) {
+    hierarchy.push_back(temp_block);
+  }
+
+  std::string path;
+  for (auto it = hierarchy.rbegin(); it != hierarchy.rend(); ++it) {
+    if (false == path.empty()) {
+      path.push_back(BITSTREAM_PATH_SEPARATOR);
+    }
+    path += block_names_[*it];
+  }
+  return path;
+}
+
+FabricBitId BitstreamQueryIndex::config_bit_fabric_bit(const ConfigBitId& config_bit) const {
+  if (size_t(config_bit) >= config_bit_fabric_bits_.size()) {
+    return FabricBitId::INVALID();
+  }
+  return config_bit_fabric_bits_[config_bit];
+}
+
+/******************************************************************************
+ * Public Mutators
+ ******************************************************************************/
+/* Parse the coordinate at the end of a block name, which follows the naming
+ * of grid and routing block instances, e.g., grid_clb_1__2_ and sb_1__2_ are at (1, 2)
+ * Return false if the name does not end with a coordinate
+ */
+static
+bool parse_block_name_coordinate(const std::string& name, vtr::Point<size_t>& coord) {
+  /* Parse the digits right before the given position, which should follow a separator */
+  auto parse_number = [&](size_t& pos, const std::string& separator, size_t& number) {
+    size_t begin = pos;
+    while ( (0 < begin) && (0 != std::isdigit(name[begin - 1])) ) {
+      --begin;
+    }
+    if ( (begin == pos) || (begin < separator.size())
+      || (0 != name.compare(begin - separator.size(), separator.size(), separator)) ) {
+      return false;
+    }
+    number = std::stoul(name.substr(begin, pos - begin));
+    pos = begin - separator.size();
+    return true;
+  };
+
+  if ( (true == name.empty()) || ('_' != name.back()) ) {
+    return false;
+  }
+  size_t pos = name.size() - 1;
+  size_t x = 0;
+  size_t y = 0;
+  if ( (false == parse_number(pos, std::string("__"), y))
+    || (false == parse_number(pos, std::string("_"), x)) ) {
+    return false;
+  }
+  coord.set(x, y);
+  return true;
+}
+
+void BitstreamQueryIndex::build(const BitstreamManager& bitstream_manager) {
+  vtr::ScopedStartFinishTimer timer("Build query index of bitstream database");
+
+  clear();
+
+  std::vector<ConfigBlockId> top_blocks = find_bitstream_manager_top_blocks(bitstream_manager);
+  VTR_ASSERT(1 == top_blocks.size());
+  top_block_ = top_blocks[0];
+
+  block_names_.resize(bitstream_manager.num_blocks());
+  sorted_child_blocks_.resize(bitstream_manager.num_blocks());
+  block_parents_.resize(bitstream_manager.num_blocks(), ConfigBlockId::INVALID());
+  for (const ConfigBlockId& block : bitstream_manager.blocks()) {
+    block_names_[block] = bitstream_manager.block_name(block);
+    block_parents_[block] = bitstream_manager.block_parent(block);
+    for (const ConfigBlockId& child_block : bitstream_manager.block_children(block)) {
+      sorted_child_blocks_[block].push_back(std::make_pair(bitstream_manager.block_name(child_block), child_block));
+    }
+    std::sort(sorted_child_blocks_[block].begin(), sorted_child_blocks_[block].end());
+  }
+
+  for (const std::pair<std::string, ConfigBlockId>& child : sorted_child_blocks_[top_block_]) {
+    vtr::Point<size_t> coord;
+    if (true == parse_block_name_coordinate(child.first, coord)) {
+      coord_blocks_[std::make_pair(coord.x(), coord.y())].push_back(child.second);
+    }
+  }
+}
+
+void BitstreamQueryIndex::build_fabric_bitstream_index(const BitstreamManager& bitstream_manager,
+                                                       const FabricBitstream& fabric_bitstream) {
+  config_bit_fabric_bits_.clear();
+  config_bit_fabric_bits_.resize(bitstream_manager.num_bits(), FabricBitId::INVALID());
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    ConfigBitId config_bit = fabric_bitstream.config_bit(fabric_bit);
+    VTR_ASSERT(size_t(config_bit) < config_bit_fabric_bits_.size());
+    /* Each configuration bit is loaded by only one fabric bit */
+    VTR_ASSERT(FabricBitId::INVALID() == config_bit_fabric_bits_[config_bit]);
+    config_bit_fabric_bits_[config_bit] = fabric_bit;
+  }
+}
+
+void BitstreamQueryIndex::clear() {
+  top_block_ = ConfigBlockId::INVALID();
+  block_names_.clear();
+  sorted_child_blocks_.clear();
+  block_parents_.clear();
+  coord_blocks_.clear();
+  config_bit_fabric_bits_.clear();
+}
+
+} /* end namespace openfpga */
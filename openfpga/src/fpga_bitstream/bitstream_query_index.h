@@ -0,0 +1,98 @@
+/******************************************************************************
+ * This file introduces a data structure to look up the bitstream database
+ * and the fabric bitstream without visiting all the blocks and bits
+ *
+ * General concept
+ * ---------------
+ * Debugging and ECO flows ask questions like:
+ * - which bits configure a tile, a routing multiplexer or a LUT?
+ * - which block owns a fabric bit?
+ * The index is built once from BitstreamManager and FabricBitstream,
+ * and then answers each question without a full traversal:
+ *
+ * 1. A trie over the hierarchy paths of blocks, e.g., fpga_top.grid_clb_1__1_.
+ *    Each node of the trie is a block, whose child blocks are sorted by name,
+ *    so that blocks are found by an exact path or by a path prefix,
+ *    where the last name in the path can be partial, e.g., fpga_top.grid_clb_1__
+ * 2. A coordinate index of the blocks under the top-level block,
+ *    whose names end with coordinates, e.g., grid_clb_1__1_, sb_1__1_, cbx_1__1_
+ * 3. A map from configuration bits to fabric bits.
+ *    Fabric bits are mapped to configuration bits by the FabricBitstream itself.
+ *
+ * The index only stores the ids of blocks and bits, so it is still valid
+ * when the values of bits are changed. It should be rebuilt when the blocks
+ * or the fabric bitstream are rebuilt.
+ ******************************************************************************/
+#ifndef BITSTREAM_QUERY_INDEX_H
+#define BITSTREAM_QUERY_INDEX_H
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "vtr_vector.h"
+#include "vtr_geometry.h"
+
+#include "bitstream_manager.h"
+#include "fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+class BitstreamQueryIndex {
+  public: /* Public constructor */
+    BitstreamQueryIndex();
+
+  public:  /* Public Accessors */
+    /* Check if the index has been built */
+    bool empty() const;
+
+    /* Check if the fabric bitstream is indexed */
+    bool fabric_bitstream_indexed() const;
+
+    /* Find the block with the given hierarchy path, e.g., fpga_top.grid_clb_1__1_ */
+    ConfigBlockId find_block(const std::string& block_path) const;
+
+    /* Find the blocks whose hierarchy paths start with the given prefix.
+     * Only the highest blocks are returned; their child blocks also match the prefix
+     */
+    std::vector<ConfigBlockId> find_blocks_by_path_prefix(const std::string& path_prefix) const;
+
+    /* Find the blocks under the top-level block which locate at the given coordinate */
+    std::vector<ConfigBlockId> find_blocks_by_coordinate(const vtr::Point<size_t>& coord) const;
+
+    /* Find the hierarchy path of a block */
+    std::string block_path(const ConfigBlockId& block) const;
+
+    /* Find the fabric bit of a configuration bit */
+    FabricBitId config_bit_fabric_bit(const ConfigBitId& config_bit) const;
+
+  public:  /* Public Mutators */
+    /* Index the blocks of a bitstream database */
+    void build(const BitstreamManager& bitstream_manager);
+
+    /* Index the bits of a fabric bitstream, which is built on the indexed bitstream database */
+    void build_fabric_bitstream_index(const BitstreamManager& bitstream_manager,
+                                      const FabricBitstream& fabric_bitstream);
+
+    void clear();
+
+  private: /* Internal data */
+    /* The block at the root of the trie */
+    ConfigBlockId top_block_;
+
+    /* Names of blocks and their child blocks sorted by name, which are the nodes of the trie */
+    vtr::vector<ConfigBlockId, std::string> block_names_;
+    vtr::vector<ConfigBlockId, std::vector<std::pair<std::string, ConfigBlockId>>> sorted_child_blocks_;
+    vtr::vector<ConfigBlockId, ConfigBlockId> block_parents_;
+
+    /* Blocks under the top-level block, indexed by coordinate */
+    std::map<std::pair<size_t, size_t>, std::vector<ConfigBlockId>> coord_blocks_;
+
+    /* Fabric bit of each configuration bit */
+    vtr::vector<ConfigBitId, FabricBitId> config_bit_fabric_bits_;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -14,6 +14,7 @@
 #include "openfpga_naming.h"
 
 #include "module_manager_utils.h"
+#include "bitstream_manager_utils.h"
 
 #include "build_grid_bitstream.h"
 #include "build_routing_bitstream.h"
@@ -137,6 +138,8 @@ size_t rec_estimate_device_bitstream_num_bits(const ModuleManager& module_manage
  *    global routing architecture
  * 3. It will decode configuration bits from routing multiplexers and LUTs
  *    used in CLBs
+ * Grids and routing blocks can be decoded by multiple threads,
+ * which does not change the resulting bitstream
  *
  * Note: this function create a bitstream which is binding to the module graphs
  * of the FPGA fabric that FPGA-X2P generates!
@@ -144,6 +147,7 @@ size_t rec_estimate_device_bitstream_num_bits(const ModuleManager& module_manage
  *******************************************************************/
 BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                                         const OpenfpgaContext& openfpga_ctx,
+                                        const ThreadPool& thread_pool,
                                         const bool& verbose) {
 
   std::string timer_message = std::string("\nBuild fabric-independent bitstream for implementation '") + vpr_ctx.atom().nlist.netlist_name() + std::string("'\n");
@@ -189,6 +193,7 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                        openfpga_ctx.vpr_device_annotation(),
                        openfpga_ctx.vpr_clustering_annotation(),
                        openfpga_ctx.vpr_placement_annotation(),
+                       thread_pool,
                        verbose);
   VTR_LOGV(verbose, "Done\n");
 
@@ -203,7 +208,8 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                           openfpga_ctx.vpr_routing_annotation(),
                           vpr_ctx.device().rr_graph,
                           openfpga_ctx.device_rr_gsb(),
-                          openfpga_ctx.flow_manager().compress_routing());
+                          openfpga_ctx.flow_manager().compress_routing(),
+                          thread_pool);
   VTR_LOGV(verbose, "Done\n");
 
   VTR_LOGV(verbose,
@@ -217,4 +223,81 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
   return bitstream_manager;
 }
 
+/********************************************************************
+ * A top-level function to update a bistream of the FPGA device
+ * when only routing results are changed, e.g., a design is re-routed
+ * with the same packing and placement results.
+ * - The configuration bits of routing multiplexers are rewritten 
+ *   in place when their paths change.
+ * - The bitstream of grids whose pins are fixed up after routing is
+ *   regenerated, as the repacking results of these grids may change,
+ *   while the bitstream of other grids is kept.
+ * The hierarchy of blocks and the sequence of bits are not changed.
+ * The bitstream should be built for the same fabric, otherwise
+ * an error is reported and the bitstream may be partially updated.
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the bitstream does not match the fabric
+ *******************************************************************/
+int update_device_bitstream(BitstreamManager& bitstream_manager,
+                            const VprContext& vpr_ctx,
+                            const OpenfpgaContext& openfpga_ctx,
+                            const ThreadPool& thread_pool,
+                            const bool& verbose) {
+
+  std::string timer_message = std::string("\nUpdate bitstream for re-routed implementation '") + vpr_ctx.atom().nlist.netlist_name() + std::string("'\n");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Find the top-level block, whose name is the same as the top-level module */
+  std::string top_block_name = generate_fpga_top_module_name();
+  std::vector<ConfigBlockId> top_block = find_bitstream_manager_top_blocks(bitstream_manager);
+  if ( (1 != top_block.size())
+    || (top_block_name != bitstream_manager.block_name(top_block[0])) ) {
+    VTR_LOG_ERROR("The bitstream database should have a single top-level block '%s'!\n",
+                  top_block_name.c_str());
+    return 1;
+  }
+
+  size_t num_changed_grid_bits = 0;
+  if (0 != update_grid_bitstream(bitstream_manager, top_block[0],
+                                 openfpga_ctx.module_graph(),
+                                 openfpga_ctx.arch().circuit_lib,
+                                 openfpga_ctx.mux_lib(),
+                                 vpr_ctx.device().grid,
+                                 vpr_ctx.atom(),
+                                 openfpga_ctx.vpr_device_annotation(),
+                                 openfpga_ctx.vpr_clustering_annotation(),
+                                 openfpga_ctx.vpr_placement_annotation(),
+                                 thread_pool,
+                                 verbose,
+                                 num_changed_grid_bits)) {
+    return 1;
+  }
+
+  std::vector<ConfigBitId> changed_bits;
+  if (0 != update_routing_bitstream(bitstream_manager, top_block[0], 
+                                    openfpga_ctx.module_graph(),
+                                    openfpga_ctx.arch().circuit_lib,
+                                    openfpga_ctx.mux_lib(),
+                                    vpr_ctx.atom(),
+                                    openfpga_ctx.vpr_device_annotation(),
+                                    openfpga_ctx.vpr_routing_annotation(),
+                                    vpr_ctx.device().rr_graph,
+                                    openfpga_ctx.device_rr_gsb(),
+                                    openfpga_ctx.flow_manager().compress_routing(),
+                                    thread_pool,
+                                    changed_bits)) {
+    return 1;
+  }
+
+  VTR_LOGV(verbose,
+           "Changed %lu grid and %lu routing of %lu configuration bits\n",
+           num_changed_grid_bits,
+           changed_bits.size(),
+           bitstream_manager.num_bits());
+
+  return 0;
+}
+
 } /* end namespace openfpga */
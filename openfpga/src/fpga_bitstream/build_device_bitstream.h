@@ -17,8 +17,15 @@ namespace openfpga {
 
 BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                                         const OpenfpgaContext& openfpga_ctx,
+                                        const ThreadPool& thread_pool,
                                         const bool& verbose);
 
+int update_device_bitstream(BitstreamManager& bitstream_manager,
+                            const VprContext& vpr_ctx,
+                            const OpenfpgaContext& openfpga_ctx,
+                            const ThreadPool& thread_pool,
+                            const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
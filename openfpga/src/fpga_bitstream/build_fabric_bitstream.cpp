@@ -724,4 +724,24 @@ FabricBitstream build_fabric_dependent_bitstream(const BitstreamManager& bitstre
   return fabric_bitstream;
 }
 
+/********************************************************************
+ * Update the data inputs of a fabric bitstream after the values of 
+ * configuration bits in the bitstream database are changed,
+ * e.g., when the routing bitstream is updated for new routing results.
+ * The sequence and addresses of configuration bits are only dependent on
+ * the FPGA fabric, so the fabric bitstream does not need to be rebuilt.
+ * Only the fabric bitstream which uses addresses stores data inputs,
+ * other fabric bitstreams get the values from the bitstream database
+ *******************************************************************/
+void update_fabric_bitstream_bit_dins(FabricBitstream& fabric_bitstream,
+                                      const BitstreamManager& bitstream_manager) {
+  if (false == fabric_bitstream.use_address()) {
+    return;
+  }
+
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    fabric_bitstream.set_bit_din(fabric_bit, bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)));
+  }
+}
+
 } /* end namespace openfpga */
@@ -22,6 +22,9 @@ FabricBitstream build_fabric_dependent_bitstream(const BitstreamManager& bitstre
                                                  const ConfigProtocol& config_protocol,
                                                  const bool& verbose);
 
+void update_fabric_bitstream_bit_dins(FabricBitstream& fabric_bitstream,
+                                      const BitstreamManager& bitstream_manager);
+
 } /* end namespace openfpga */
 
 #endif
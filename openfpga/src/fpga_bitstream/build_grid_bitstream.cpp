@@ -3,6 +3,7 @@
  * for grids (CLBs, heterogenerous blocks, I/Os, etc.)
  *******************************************************************/
 #include <cmath>
+#include <map>
 #include <string>
 
 /* Headers from vtrutil library */
@@ -28,6 +29,7 @@
 
 #include "build_mux_bitstream.h"
 #include "openfpga_device_grid_utils.h"
+#include "bitstream_manager_utils.h"
 
 #include "build_grid_bitstream.h"
 
@@ -435,11 +437,11 @@ void build_lut_bitstream(BitstreamManager& bitstream_manager,
     VTR_ASSERT(true == physical_pb.valid_pb_id(lut_pb_id));
 
     /* Find MUX graph correlated to the LUT */
-    MuxId lut_mux_id = mux_lib.mux_graph(lut_model, (size_t)pow(2., lut_size)); 
+    MuxId lut_mux_id = mux_lib.mux_graph(lut_model, size_t(1) << lut_size); 
     const MuxGraph& mux_graph = mux_lib.mux_graph(lut_mux_id);
     /* Ensure the LUT MUX has the expected input and SRAM port sizes */
     VTR_ASSERT(mux_graph.num_memory_bits() == lut_size);
-    VTR_ASSERT(mux_graph.num_inputs() == (size_t)pow(2., lut_size));
+    VTR_ASSERT(mux_graph.num_inputs() == (size_t(1) << lut_size));
     /* Generate LUT bitstream */
     lut_bitstream = build_frac_lut_bitstream(circuit_lib, mux_graph,
                                              device_annotation,
@@ -679,26 +681,12 @@ void build_physical_block_bitstream(BitstreamManager& bitstream_manager,
 
 
 /********************************************************************
- * Top-level function of this file: 
- * Generate bitstreams for all the grids, including 
- * 1. core grids that sit in the center of the fabric
- * 2. side grids (I/O grids) that sit in the borders for the fabric
+ * Collect the core grids which sit in the center of the fabric
+ * and own a bitstream, in the order of bitstream generation
  *******************************************************************/
-void build_grid_bitstream(BitstreamManager& bitstream_manager,
-                          const ConfigBlockId& top_block,
-                          const ModuleManager& module_manager,
-                          const CircuitLibrary& circuit_lib,
-                          const MuxLibrary& mux_lib,
-                          const DeviceGrid& grids,
-                          const AtomContext& atom_ctx,
-                          const VprDeviceAnnotation& device_annotation,
-                          const VprClusteringAnnotation& cluster_annotation,
-                          const VprPlacementAnnotation& place_annotation,
-                          const bool& verbose) {
-
-  VTR_LOGV(verbose, "Generating bitstream for core grids...");
-
-  /* Generate bitstream for the core logic block one by one */
+static 
+std::vector<vtr::Point<size_t>> find_core_grid_bitstream_coordinates(const DeviceGrid& grids) {
+  std::vector<vtr::Point<size_t>> core_coordinates;
   for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
     for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
       /* Bypass EMPTY grid */
@@ -710,24 +698,22 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
         || (0 < grids[ix][iy].height_offset) ) {
         continue;
       }
-      /* Add a grid module to top_module*/
-      vtr::Point<size_t> grid_coord(ix, iy);
-      build_physical_block_bitstream(bitstream_manager, top_block, module_manager,
-                                     circuit_lib, mux_lib,
-                                     atom_ctx,
-                                     device_annotation, cluster_annotation,
-                                     place_annotation,
-                                     grids, grid_coord, NUM_SIDES);
+      core_coordinates.push_back(vtr::Point<size_t>(ix, iy));
     }
   }
-  VTR_LOGV(verbose, "Done\n");
-
-  VTR_LOGV(verbose, "Generating bitstream for I/O grids...");
+  return core_coordinates;
+}
 
+/********************************************************************
+ * Collect the I/O grids which sit in the borders of the fabric
+ * and own a bitstream, side by side, in the order of bitstream generation
+ *******************************************************************/
+static 
+std::vector<std::pair<vtr::Point<size_t>, e_side>> find_io_grid_bitstream_coordinates(const DeviceGrid& grids) {
   /* Create the coordinate range for each side of FPGA fabric */
   std::map<e_side, std::vector<vtr::Point<size_t>>> io_coordinates = generate_perimeter_grid_coordinates( grids);
 
-  /* Add instances of I/O grids to top_module */
+  std::vector<std::pair<vtr::Point<size_t>, e_side>> io_grids;
   for (const e_side& io_side : FPGA_SIDES_CLOCKWISE) {
     for (const vtr::Point<size_t>& io_coordinate : io_coordinates[io_side]) {
       /* Bypass EMPTY grid */
@@ -739,15 +725,190 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
         || (0 < grids[io_coordinate.x()][io_coordinate.y()].height_offset) ) {
         continue;
       }
-      build_physical_block_bitstream(bitstream_manager, top_block, module_manager,
-                                     circuit_lib, mux_lib,
-                                     atom_ctx,
-                                     device_annotation, cluster_annotation, 
-                                     place_annotation,
-                                     grids, io_coordinate, io_side);
+      io_grids.push_back(std::make_pair(io_coordinate, io_side));
+    }
+  }
+  return io_grids;
+}
+
+/********************************************************************
+ * Top-level function of this file: 
+ * Generate bitstreams for all the grids, including 
+ * 1. core grids that sit in the center of the fabric
+ * 2. side grids (I/O grids) that sit in the borders for the fabric
+ *
+ * Grids are independent from each other, so their bitstreams 
+ * can be built by multiple threads.
+ * Blocks are always added to the bitstream manager in the same order,
+ * whatever the number of threads is.
+ *******************************************************************/
+void build_grid_bitstream(BitstreamManager& bitstream_manager,
+                          const ConfigBlockId& top_block,
+                          const ModuleManager& module_manager,
+                          const CircuitLibrary& circuit_lib,
+                          const MuxLibrary& mux_lib,
+                          const DeviceGrid& grids,
+                          const AtomContext& atom_ctx,
+                          const VprDeviceAnnotation& device_annotation,
+                          const VprClusteringAnnotation& cluster_annotation,
+                          const VprPlacementAnnotation& place_annotation,
+                          const ThreadPool& thread_pool,
+                          const bool& verbose) {
+
+  VTR_LOGV(verbose, "Generating bitstream for core grids...");
+
+  /* Collect the core logic blocks to generate bitstream for */
+  std::vector<vtr::Point<size_t>> core_coordinates = find_core_grid_bitstream_coordinates(grids);
+
+  /* Generate bitstream for the core logic block one by one */
+  build_bitstream_manager_child_blocks(bitstream_manager, top_block,
+                                       core_coordinates.size(), thread_pool, 
+                                       [&](BitstreamManager& task_bitstream_manager,
+                                           const ConfigBlockId& task_top_block,
+                                           const size_t& itask) {
+    build_physical_block_bitstream(task_bitstream_manager, task_top_block, module_manager,
+                                   circuit_lib, mux_lib,
+                                   atom_ctx,
+                                   device_annotation, cluster_annotation,
+                                   place_annotation,
+                                   grids, core_coordinates[itask], NUM_SIDES);
+  });
+  VTR_LOGV(verbose, "Done\n");
+
+  VTR_LOGV(verbose, "Generating bitstream for I/O grids...");
+
+  /* Collect the I/O grids, side by side */
+  std::vector<std::pair<vtr::Point<size_t>, e_side>> io_grids = find_io_grid_bitstream_coordinates(grids);
+
+  build_bitstream_manager_child_blocks(bitstream_manager, top_block,
+                                       io_grids.size(), thread_pool, 
+                                       [&](BitstreamManager& task_bitstream_manager,
+                                           const ConfigBlockId& task_top_block,
+                                           const size_t& itask) {
+    build_physical_block_bitstream(task_bitstream_manager, task_top_block, module_manager,
+                                   circuit_lib, mux_lib,
+                                   atom_ctx,
+                                   device_annotation, cluster_annotation, 
+                                   place_annotation,
+                                   grids, io_grids[itask].first, io_grids[itask].second);
+  });
+  VTR_LOGV(verbose, "Done\n");
+}
+
+/********************************************************************
+ * Regenerate the bitstream of the grids whose clustered blocks 
+ * have pins fixed up after routing, in an existing bitstream database.
+ * This is required when a design is re-routed with the same packing 
+ * and placement results: the router may swap the nets of equivalent pins,
+ * which changes the repacking results and the bitstream inside the grids.
+ *
+ * A pin fixed up for any routing is kept as renamed in the clustering 
+ * annotation, so that the grids changed by the previous routing 
+ * are regenerated as well.
+ *
+ * Each grid is built in a private bitstream manager,
+ * whose bits overwrite those of the grid in the bitstream database.
+ * The hierarchy of blocks and the sequence of bits are not changed.
+ * The blocks of all the grids are checked before any bit is overwritten,
+ * so that a bitstream which does not match the fabric, e.g., read from
+ * a file of another fabric, is reported as an error and kept unchanged.
+ *
+ * The number of configuration bits whose values are changed
+ * is added to num_changed_bits
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the bitstream does not match the fabric
+ *******************************************************************/
+int update_grid_bitstream(BitstreamManager& bitstream_manager,
+                          const ConfigBlockId& top_block,
+                          const ModuleManager& module_manager,
+                          const CircuitLibrary& circuit_lib,
+                          const MuxLibrary& mux_lib,
+                          const DeviceGrid& grids,
+                          const AtomContext& atom_ctx,
+                          const VprDeviceAnnotation& device_annotation,
+                          const VprClusteringAnnotation& cluster_annotation,
+                          const VprPlacementAnnotation& place_annotation,
+                          const ThreadPool& thread_pool,
+                          const bool& verbose,
+                          size_t& num_changed_bits) {
+  /* Collect all the grids in the order of bitstream generation */
+  std::vector<std::pair<vtr::Point<size_t>, e_side>> grid_coordinates;
+  for (const vtr::Point<size_t>& core_coordinate : find_core_grid_bitstream_coordinates(grids)) {
+    grid_coordinates.push_back(std::make_pair(core_coordinate, NUM_SIDES));
+  }
+  for (const std::pair<vtr::Point<size_t>, e_side>& io_grid : find_io_grid_bitstream_coordinates(grids)) {
+    grid_coordinates.push_back(io_grid);
+  }
+
+  /* Only the grids with any fixed-up pin are changed */
+  std::vector<std::pair<vtr::Point<size_t>, e_side>> changed_grids;
+  for (const std::pair<vtr::Point<size_t>, e_side>& grid_coordinate : grid_coordinates) {
+    for (const ClusterBlockId& cluster_blk : place_annotation.grid_blocks(grid_coordinate.first)) {
+      if ( (ClusterBlockId::INVALID() != cluster_blk)
+        && (true == cluster_annotation.is_block_net_renamed(cluster_blk)) ) {
+        changed_grids.push_back(grid_coordinate);
+        break;
+      }
     }
   }
+
+  VTR_LOGV(verbose, "Regenerating bitstream for %lu grids with pins fixed up...",
+           changed_grids.size());
+
+  std::vector<BitstreamManager> grid_bitstream_managers(changed_grids.size());
+  thread_pool.parallel_for(changed_grids.size(), [&](const size_t& itask) {
+    BitstreamManager& grid_bitstream_manager = grid_bitstream_managers[itask];
+    ConfigBlockId grid_top_block = grid_bitstream_manager.add_block(bitstream_manager.block_name(top_block));
+    build_physical_block_bitstream(grid_bitstream_manager, grid_top_block, module_manager,
+                                   circuit_lib, mux_lib,
+                                   atom_ctx,
+                                   device_annotation, cluster_annotation, 
+                                   place_annotation,
+                                   grids, changed_grids[itask].first, changed_grids[itask].second);
+  });
+
+  /* Find the blocks of grids by name in the bitstream database */
+  std::map<std::string, ConfigBlockId> top_child_blocks;
+  for (const ConfigBlockId& child_block : bitstream_manager.block_children(top_block)) {
+    top_child_blocks[bitstream_manager.block_name(child_block)] = child_block;
+  }
+
+  /* Match the block of each grid before overwriting any bit */
+  std::vector<ConfigBlockId> changed_grid_blocks(changed_grids.size(), ConfigBlockId::INVALID());
+  for (size_t itask = 0; itask < changed_grids.size(); ++itask) {
+    const BitstreamManager& grid_bitstream_manager = grid_bitstream_managers[itask];
+    /* Grids without configurable children have no block */
+    std::vector<ConfigBlockId> grid_blocks = grid_bitstream_manager.block_children(ConfigBlockId(0));
+    if (true == grid_blocks.empty()) {
+      continue;
+    }
+    VTR_ASSERT(1 == grid_blocks.size());
+    auto grid_block_it = top_child_blocks.find(grid_bitstream_manager.block_name(grid_blocks[0]));
+    if ( (grid_block_it == top_child_blocks.end())
+      || (false == bitstream_manager_block_trees_match(bitstream_manager, grid_block_it->second,
+                                                       grid_bitstream_manager, grid_blocks[0])) ) {
+      VTR_LOG_ERROR("Bitstream block '%s' of a grid does not match the fabric!\n",
+                    grid_bitstream_manager.block_name(grid_blocks[0]).c_str());
+      return 1;
+    }
+    changed_grid_blocks[itask] = grid_block_it->second;
+  }
+
+  for (size_t itask = 0; itask < changed_grids.size(); ++itask) {
+    if (ConfigBlockId::INVALID() == changed_grid_blocks[itask]) {
+      continue;
+    }
+    const BitstreamManager& grid_bitstream_manager = grid_bitstream_managers[itask];
+    num_changed_bits += bitstream_manager.overwrite_blocks_from(changed_grid_blocks[itask], grid_bitstream_manager, 
+                                                                grid_bitstream_manager.block_children(ConfigBlockId(0))[0]);
+    /* Release memory as soon as possible */
+    grid_bitstream_managers[itask] = BitstreamManager();
+  }
   VTR_LOGV(verbose, "Done\n");
+
+  return 0;
 }
 
 } /* end namespace openfpga */
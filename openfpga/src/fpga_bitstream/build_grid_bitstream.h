@@ -14,6 +14,7 @@
 #include "vpr_device_annotation.h"
 #include "vpr_clustering_annotation.h"
 #include "vpr_placement_annotation.h"
+#include "openfpga_thread_pool.h"
 
 /********************************************************************
  * Function declaration
@@ -32,8 +33,23 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
                           const VprDeviceAnnotation& device_annotation,
                           const VprClusteringAnnotation& cluster_annotation,
                           const VprPlacementAnnotation& place_annotation,
+                          const ThreadPool& thread_pool,
                           const bool& verbose);
 
+int update_grid_bitstream(BitstreamManager& bitstream_manager,
+                          const ConfigBlockId& top_block,
+                          const ModuleManager& module_manager,
+                          const CircuitLibrary& circuit_lib,
+                          const MuxLibrary& mux_lib,
+                          const DeviceGrid& grids,
+                          const AtomContext& atom_ctx,
+                          const VprDeviceAnnotation& device_annotation,
+                          const VprClusteringAnnotation& cluster_annotation,
+                          const VprPlacementAnnotation& place_annotation,
+                          const ThreadPool& thread_pool,
+                          const bool& verbose,
+                          size_t& num_changed_bits);
+
 } /* end namespace openfpga */
 
 #endif
@@ -52,7 +52,7 @@ size_t find_mux_default_path_id(const CircuitLibrary& circuit_lib,
  * Thanks to MuxGraph object has already describe the internal multiplexing 
  * structure, bitstream generation is simply done by routing the signal
  * to from a given input to the output
- * All the memory bits can be generated by an API of MuxGraph
+ * All the memory bits are decoded by MuxLibrary when the MuxGraph is built
  *
  * To be generic, this function only returns a vector bit values
  * without touching an bitstream-relate data structure
@@ -70,7 +70,7 @@ std::vector<bool> build_cmos_mux_bitstream(const CircuitLibrary& circuit_lib,
   size_t implemented_mux_size = find_mux_implementation_num_inputs(circuit_lib, mux_model, mux_size);
   /* Note that the mux graph is indexed using datapath MUX size!!!! */
   MuxId mux_graph_id = mux_lib.mux_graph(mux_model, mux_size);
-  const MuxGraph mux_graph = mux_lib.mux_graph(mux_graph_id);
+  const MuxGraph& mux_graph = mux_lib.mux_graph(mux_graph_id);
 
   size_t datapath_id = path_id;
 
@@ -85,13 +85,10 @@ std::vector<bool> build_cmos_mux_bitstream(const CircuitLibrary& circuit_lib,
   /* We should have only one output for this MUX! */
   VTR_ASSERT(1 == mux_graph.outputs().size());
 
-  /* Generate the memory bits */
-  vtr::vector<MuxMemId, bool> raw_bitstream = mux_graph.decode_memory_bits(MuxInputId(datapath_id), mux_graph.output_id(mux_graph.outputs()[0]));
+  /* Generate the memory bits, which are precomputed in the MUX library */
+  vtr::vector<MuxMemId, bool> raw_bitstream = mux_lib.mux_memory_bits(mux_graph_id, MuxInputId(datapath_id));
 
-  std::vector<bool> mux_bitstream;
-  for (const bool& bit : raw_bitstream) {
-    mux_bitstream.push_back(bit);
-  }
+  std::vector<bool> mux_bitstream(raw_bitstream.begin(), raw_bitstream.end());
 
   /* Consider local encoder support, we need further encode the bitstream */
   if (false == circuit_lib.mux_use_local_encoder(mux_model)) {
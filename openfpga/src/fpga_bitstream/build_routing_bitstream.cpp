@@ -4,6 +4,7 @@
  * We decode the bitstream from configuration of routing multiplexers 
  * which locate in global routing architecture
  *******************************************************************/
+#include <map>
 #include <vector>
 
 /* Headers from vtrutil library */
@@ -15,11 +16,14 @@
 
 #include "mux_utils.h"
 #include "rr_gsb_utils.h"
+#include "openfpga_parallel_utils.h"
 #include "openfpga_reserved_words.h"
 #include "openfpga_naming.h"
 #include "openfpga_rr_graph_utils.h"
 #include "module_manager_utils.h"
 
+#include "bitstream_manager_utils.h"
+
 #include "mux_bitstream_constants.h"
 #include "build_mux_bitstream.h"
 #include "build_routing_bitstream.h"
@@ -27,24 +31,181 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * This function adds the bitstream of a routing multiplexer 
+ * to its block in the bitstream manager
+ * When the bitstream is updated for new routing results, the block
+ * should already have the bits of the multiplexer. The bits are
+ * overwritten only when the selected path changes, and the bits
+ * whose values change are added to changed_bits
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the existing bits do not match the multiplexer
+ *******************************************************************/
+static 
+int add_routing_mux_bitstream_to_block(BitstreamManager& bitstream_manager,
+                                       const ConfigBlockId& mux_mem_block,
+                                       const ModuleManager& module_manager,
+                                       const CircuitLibrary& circuit_lib,
+                                       const MuxLibrary& mux_lib,
+                                       const CircuitModelId& mux_model,
+                                       const size_t& datapath_mux_size,
+                                       const int& path_id,
+                                       const bool& incremental,
+                                       std::vector<ConfigBitId>& changed_bits) {
+  /* Find the module in module manager to know the bitstream size */
+  std::string mem_module_name = generate_mux_subckt_name(circuit_lib, mux_model, datapath_mux_size, std::string(MEMORY_MODULE_POSTFIX)); 
+  ModuleId mux_mem_module = module_manager.find_module(mem_module_name); 
+  VTR_ASSERT (true == module_manager.valid_module_id(mux_mem_module));
+  ModulePortId mux_mem_out_port_id = module_manager.find_module_port(mux_mem_module, generate_configurable_memory_data_out_name());
+  size_t num_mem_bits = module_manager.module_port(mux_mem_module, mux_mem_out_port_id).get_width();
+
+  std::vector<ConfigBitId> existing_bits = bitstream_manager.block_bits(mux_mem_block);
+  if (true == incremental) {
+    if (num_mem_bits != existing_bits.size()) {
+      VTR_LOG_ERROR("Bitstream block '%s' has %lu bits while its routing multiplexer requires %lu bits!\n",
+                    bitstream_manager.block_name(mux_mem_block).c_str(),
+                    existing_bits.size(), num_mem_bits);
+      return 1;
+    }
+    if (path_id == bitstream_manager.block_path_id(mux_mem_block)) {
+      return 0;
+    }
+  }
+
+  /* Generate bitstream depend on both technology and structure of this MUX */
+  std::vector<bool> mux_bitstream = build_mux_bitstream(circuit_lib, mux_model, mux_lib, datapath_mux_size, path_id); 
+  /* Ensure the bitstream size matches! */
+  VTR_ASSERT(mux_bitstream.size() == num_mem_bits);
+
+  /* Add the bistream to the bitstream manager */
+  if (false == incremental) {
+    bitstream_manager.add_block_bits(mux_mem_block, mux_bitstream);
+  } else {
+    for (size_t ibit = 0; ibit < existing_bits.size(); ++ibit) {
+      if (mux_bitstream[ibit] != bitstream_manager.bit_value(existing_bits[ibit])) {
+        changed_bits.push_back(existing_bits[ibit]);
+      }
+    }
+    bitstream_manager.set_block_bits(mux_mem_block, mux_bitstream);
+  }
+  /* Record path ids */
+  bitstream_manager.add_path_id_to_block(mux_mem_block, path_id);
+
+  return 0;
+}
+
+/********************************************************************
+ * This function records the input and output nets of a routing multiplexer 
+ * to its block in the bitstream manager
+ *******************************************************************/
+static 
+void add_routing_mux_net_ids_to_block(BitstreamManager& bitstream_manager,
+                                      const ConfigBlockId& mux_mem_block,
+                                      const AtomContext& atom_ctx,
+                                      const std::vector<ClusterNetId>& input_nets,
+                                      const ClusterNetId& output_net) {
+  /* Add input nets */
+  bool need_splitter = false;
+  std::string input_net_ids;
+  for (const ClusterNetId& input_net : input_nets) {
+    /* Add a space as a splitter*/
+    if (true == need_splitter) {
+      input_net_ids += std::string(" ");
+    }
+    AtomNetId input_atom_net = atom_ctx.lookup.atom_net(input_net);
+    if (true == atom_ctx.nlist.valid_net_id(input_atom_net)) {
+      input_net_ids += atom_ctx.nlist.net_name(input_atom_net);
+    } else {
+      input_net_ids += std::string("unmapped");
+    }
+    need_splitter = true;
+  }
+  bitstream_manager.add_input_net_id_to_block(mux_mem_block, input_net_ids);
+
+  /* Add output nets */
+  std::string output_net_ids;
+  AtomNetId output_atom_net = atom_ctx.lookup.atom_net(output_net);
+  if (true == atom_ctx.nlist.valid_net_id(output_atom_net)) {
+    output_net_ids += atom_ctx.nlist.net_name(output_atom_net);
+  } else {
+    output_net_ids += std::string("unmapped");
+  }
+  bitstream_manager.add_output_net_id_to_block(mux_mem_block, output_net_ids);
+}
+
+/********************************************************************
+ * Find the block of a routing multiplexer in a routing block
+ * - When the bitstream is updated for new routing results, the block
+ *   should exist in the given blocks, and it is removed from them,
+ *   so that the blocks left after visiting all the multiplexers 
+ *   are not in the fabric. 
+ *   An invalid id is returned if the block does not exist, as the blocks
+ *   can not be added by the threads updating the bitstream
+ * - Otherwise, a new block is created
+ *******************************************************************/
+static 
+ConfigBlockId find_or_add_routing_mux_block(BitstreamManager& bitstream_manager,
+                                            const ConfigBlockId& routing_block,
+                                            const bool& incremental,
+                                            std::map<std::string, ConfigBlockId>& existing_mux_blocks,
+                                            const std::string& mem_block_name) {
+  if (true == incremental) {
+    std::map<std::string, ConfigBlockId>::iterator it = existing_mux_blocks.find(mem_block_name);
+    if (it == existing_mux_blocks.end()) {
+      VTR_LOG_ERROR("Bitstream block '%s' of a routing multiplexer is not found under block '%s'!\n",
+                    mem_block_name.c_str(),
+                    bitstream_manager.block_name(routing_block).c_str());
+      return ConfigBlockId::INVALID();
+    }
+    ConfigBlockId mux_mem_block = it->second;
+    existing_mux_blocks.erase(it);
+    return mux_mem_block;
+  }
+
+  ConfigBlockId mux_mem_block = bitstream_manager.add_block(mem_block_name);
+  bitstream_manager.add_child_block(routing_block, mux_mem_block);
+  return mux_mem_block;
+}
+
+/********************************************************************
+ * Index the child blocks of a block by their names
+ *******************************************************************/
+static 
+std::map<std::string, ConfigBlockId> build_bitstream_child_block_lookup(const BitstreamManager& bitstream_manager,
+                                                                         const ConfigBlockId& parent_block) {
+  std::map<std::string, ConfigBlockId> child_blocks;
+  for (const ConfigBlockId& child_block : bitstream_manager.block_children(parent_block)) {
+    child_blocks[bitstream_manager.block_name(child_block)] = child_block;
+  }
+  return child_blocks;
+}
+
 /********************************************************************
  * This function generates bitstream for a routing multiplexer
  * This function will identify if a node indicates a routing multiplexer
  * If not a routing multiplexer, no bitstream is needed here
  * If yes, we will generate the bitstream for the routing multiplexer
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the existing bits do not match the multiplexer
  *******************************************************************/
 static 
-void build_switch_block_mux_bitstream(BitstreamManager& bitstream_manager,
-                                      const ConfigBlockId& mux_mem_block,
-                                      const ModuleManager& module_manager,
-                                      const CircuitLibrary& circuit_lib,
-                                      const MuxLibrary& mux_lib,
-                                      const RRGraph& rr_graph,
-                                      const RRNodeId& cur_rr_node,
-                                      const std::vector<RRNodeId>& drive_rr_nodes,
-                                      const AtomContext& atom_ctx,
-                                      const VprDeviceAnnotation& device_annotation,
-                                      const VprRoutingAnnotation& routing_annotation) {
+int build_switch_block_mux_bitstream(BitstreamManager& bitstream_manager,
+                                     const ConfigBlockId& mux_mem_block,
+                                     const ModuleManager& module_manager,
+                                     const CircuitLibrary& circuit_lib,
+                                     const MuxLibrary& mux_lib,
+                                     const RRGraph& rr_graph,
+                                     const RRNodeId& cur_rr_node,
+                                     const std::vector<RRNodeId>& drive_rr_nodes,
+                                     const AtomContext& atom_ctx,
+                                     const VprDeviceAnnotation& device_annotation,
+                                     const VprRoutingAnnotation& routing_annotation,
+                                     const bool& incremental,
+                                     std::vector<ConfigBitId>& changed_bits) {
   /* Check current rr_node is CHANX or CHANY*/
   VTR_ASSERT( (CHANX == rr_graph.node_type(cur_rr_node))
            || (CHANY == rr_graph.node_type(cur_rr_node)));
@@ -88,59 +249,34 @@ void build_switch_block_mux_bitstream(BitstreamManager& bitstream_manager,
   VTR_ASSERT(1 == driver_switches.size());
   CircuitModelId mux_model = device_annotation.rr_switch_circuit_model(driver_switches[0]);
 
-  /* Generate bitstream depend on both technology and structure of this MUX */
-  std::vector<bool> mux_bitstream = build_mux_bitstream(circuit_lib, mux_model, mux_lib, datapath_mux_size, path_id); 
-
-  /* Find the module in module manager and ensure the bitstream size matches! */
-  std::string mem_module_name = generate_mux_subckt_name(circuit_lib, mux_model, datapath_mux_size, std::string(MEMORY_MODULE_POSTFIX)); 
-  ModuleId mux_mem_module = module_manager.find_module(mem_module_name); 
-  VTR_ASSERT (true == module_manager.valid_module_id(mux_mem_module));
-  ModulePortId mux_mem_out_port_id = module_manager.find_module_port(mux_mem_module, generate_configurable_memory_data_out_name());
-  VTR_ASSERT(mux_bitstream.size() == module_manager.module_port(mux_mem_module, mux_mem_out_port_id).get_width());
-
-  /* Add the bistream to the bitstream manager */
-  bitstream_manager.add_block_bits(mux_mem_block, mux_bitstream);
-  /* Record path ids, input and output nets */
-  bitstream_manager.add_path_id_to_block(mux_mem_block, path_id);
-
-  /* Add input nets */
-  bool need_splitter = false;
-  std::string input_net_ids;
-  for (const ClusterNetId& input_net : input_nets) {
-    /* Add a space as a splitter*/
-    if (true == need_splitter) {
-      input_net_ids += std::string(" ");
-    }
-    AtomNetId input_atom_net = atom_ctx.lookup.atom_net(input_net);
-    if (true == atom_ctx.nlist.valid_net_id(input_atom_net)) {
-      input_net_ids += atom_ctx.nlist.net_name(input_atom_net);
-    } else {
-      input_net_ids += std::string("unmapped");
-    }
-    need_splitter = true;
+  /* Add the bistream and record path ids, input and output nets */
+  if (0 != add_routing_mux_bitstream_to_block(bitstream_manager, mux_mem_block,
+                                              module_manager, circuit_lib, mux_lib,
+                                              mux_model, datapath_mux_size, path_id,
+                                              incremental, changed_bits)) {
+    return 1;
   }
-  bitstream_manager.add_input_net_id_to_block(mux_mem_block, input_net_ids);
+  add_routing_mux_net_ids_to_block(bitstream_manager, mux_mem_block, atom_ctx, input_nets, output_net);
 
-  /* Add output nets */
-  std::string output_net_ids;
-  AtomNetId output_atom_net = atom_ctx.lookup.atom_net(output_net);
-  if (true == atom_ctx.nlist.valid_net_id(output_atom_net)) {
-    output_net_ids += atom_ctx.nlist.net_name(output_atom_net);
-  } else {
-    output_net_ids += std::string("unmapped");
-  }
-  bitstream_manager.add_output_net_id_to_block(mux_mem_block, output_net_ids);
+  return 0;
 }
 
 /********************************************************************
  * This function generates bitstream for an interconnection, 
  * i.e., a routing multiplexer, in a Switch Block
+ * The block of the routing multiplexer is found from the existing blocks
+ * when the bitstream is updated, and the bits whose values change
+ * are added to changed_bits
  * This function will identify if a node indicates a routing multiplexer
  * If not a routing multiplexer, no bitstream is needed here
  * If yes, we will generate the bitstream for the routing multiplexer
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the existing blocks do not match the multiplexer
  *******************************************************************/
 static 
-void build_switch_block_interc_bitstream(BitstreamManager& bitstream_manager,
+int build_switch_block_interc_bitstream(BitstreamManager& bitstream_manager,
                                          const ConfigBlockId& sb_configurable_block,
                                          const ModuleManager& module_manager,
                                          const CircuitLibrary& circuit_lib,
@@ -151,7 +287,10 @@ void build_switch_block_interc_bitstream(BitstreamManager& bitstream_manager,
                                          const VprRoutingAnnotation& routing_annotation,
                                          const RRGSB& rr_gsb,
                                          const e_side& chan_side,
-                                         const size_t& chan_node_id) {
+                                         const size_t& chan_node_id,
+                                         const bool& incremental,
+                                         std::map<std::string, ConfigBlockId>& existing_mux_blocks,
+                                         std::vector<ConfigBitId>& changed_bits) {
 
   std::vector<RRNodeId> driver_rr_nodes;
 
@@ -163,25 +302,31 @@ void build_switch_block_interc_bitstream(BitstreamManager& bitstream_manager,
     driver_rr_nodes = get_rr_gsb_chan_node_configurable_driver_nodes(rr_graph, rr_gsb, chan_side, chan_node_id);
     /* Special: if there are zero-driver nodes. We skip here */
     if (0 == driver_rr_nodes.size()) {
-      return; 
+      return 0; 
     }
   }
 
   if ( (0 == driver_rr_nodes.size())
     || (0 == driver_rr_nodes.size()) ) {
     /* No bitstream generation required by a special direct connection*/
-    return;
+    return 0;
   } else if (1 < driver_rr_nodes.size()) {
     /* Create the block denoting the memory instances that drives this node in Switch Block */
     std::string mem_block_name = generate_sb_memory_instance_name(SWITCH_BLOCK_MEM_INSTANCE_PREFIX, chan_side, chan_node_id, std::string(""));
-    ConfigBlockId mux_mem_block = bitstream_manager.add_block(mem_block_name);
-    bitstream_manager.add_child_block(sb_configurable_block, mux_mem_block);
+    ConfigBlockId mux_mem_block = find_or_add_routing_mux_block(bitstream_manager, sb_configurable_block,
+                                                                incremental, existing_mux_blocks, mem_block_name);
+    if (ConfigBlockId::INVALID() == mux_mem_block) {
+      return 1;
+    }
     /* This is a routing multiplexer! Generate bitstream */
-    build_switch_block_mux_bitstream(bitstream_manager, mux_mem_block, module_manager,
-                                     circuit_lib, mux_lib, rr_graph, 
-                                     cur_rr_node, driver_rr_nodes, 
-                                     atom_ctx, device_annotation, routing_annotation);
+    return build_switch_block_mux_bitstream(bitstream_manager, mux_mem_block, module_manager,
+                                            circuit_lib, mux_lib, rr_graph, 
+                                            cur_rr_node, driver_rr_nodes, 
+                                            atom_ctx, device_annotation, routing_annotation,
+                                            incremental, changed_bits);
   } /*Nothing should be done else*/ 
+
+  return 0;
 }
 
 /********************************************************************
@@ -194,9 +339,13 @@ void build_switch_block_interc_bitstream(BitstreamManager& bitstream_manager,
  *
  * Note that the output nodes typically spread over all the sides of a Switch Block
  * So, we will iterate over that.
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the existing blocks do not match the multiplexers
  *******************************************************************/
 static 
-void build_switch_block_bitstream(BitstreamManager& bitstream_manager,
+int build_switch_block_bitstream(BitstreamManager& bitstream_manager,
                                   const ConfigBlockId& sb_config_block,
                                   const ModuleManager& module_manager,
                                   const CircuitLibrary& circuit_lib,
@@ -205,7 +354,10 @@ void build_switch_block_bitstream(BitstreamManager& bitstream_manager,
                                   const VprDeviceAnnotation& device_annotation,
                                   const VprRoutingAnnotation& routing_annotation,
                                   const RRGraph& rr_graph,
-                                  const RRGSB& rr_gsb) {
+                                  const RRGSB& rr_gsb,
+                                  const bool& incremental,
+                                  std::map<std::string, ConfigBlockId>& existing_mux_blocks,
+                                  std::vector<ConfigBitId>& changed_bits) {
 
   /* Iterate over all the multiplexers */
   for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
@@ -217,13 +369,18 @@ void build_switch_block_bitstream(BitstreamManager& bitstream_manager,
       if (OUT_PORT != rr_gsb.get_chan_node_direction(side_manager.get_side(), itrack)) {
         continue;
       }
-      build_switch_block_interc_bitstream(bitstream_manager, sb_config_block, 
-                                          module_manager, 
-                                          circuit_lib, mux_lib, rr_graph,
-                                          atom_ctx, device_annotation, routing_annotation,
-                                          rr_gsb, side_manager.get_side(), itrack);
+      if (0 != build_switch_block_interc_bitstream(bitstream_manager, sb_config_block, 
+                                                   module_manager, 
+                                                   circuit_lib, mux_lib, rr_graph,
+                                                   atom_ctx, device_annotation, routing_annotation,
+                                                   rr_gsb, side_manager.get_side(), itrack,
+                                                   incremental, existing_mux_blocks, changed_bits)) {
+        return 1;
+      }
     }
   }
+
+  return 0;
 }
 
 /********************************************************************
@@ -232,18 +389,24 @@ void build_switch_block_bitstream(BitstreamManager& bitstream_manager,
  * This function will identify if a node indicates a routing multiplexer
  * If not a routing multiplexer, no bitstream is needed here
  * If yes, we will generate the bitstream for the routing multiplexer
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the existing bits do not match the multiplexer
  *******************************************************************/
 static 
-void build_connection_block_mux_bitstream(BitstreamManager& bitstream_manager,
-                                          const ConfigBlockId& mux_mem_block,
-                                          const ModuleManager& module_manager,
-                                          const CircuitLibrary& circuit_lib,
-                                          const MuxLibrary& mux_lib,
-                                          const AtomContext& atom_ctx,
-                                          const VprDeviceAnnotation& device_annotation,
-                                          const VprRoutingAnnotation& routing_annotation,
-                                          const RRGraph& rr_graph,
-                                          const RRNodeId& src_rr_node) {
+int build_connection_block_mux_bitstream(BitstreamManager& bitstream_manager,
+                                         const ConfigBlockId& mux_mem_block,
+                                         const ModuleManager& module_manager,
+                                         const CircuitLibrary& circuit_lib,
+                                         const MuxLibrary& mux_lib,
+                                         const AtomContext& atom_ctx,
+                                         const VprDeviceAnnotation& device_annotation,
+                                         const VprRoutingAnnotation& routing_annotation,
+                                         const RRGraph& rr_graph,
+                                         const RRNodeId& src_rr_node,
+                                         const bool& incremental,
+                                         std::vector<ConfigBitId>& changed_bits) {
 
   /* Find drive_rr_nodes*/
   size_t datapath_mux_size = rr_graph.node_fan_in(src_rr_node);
@@ -289,60 +452,34 @@ void build_connection_block_mux_bitstream(BitstreamManager& bitstream_manager,
   VTR_ASSERT(1 == driver_switches.size());
   CircuitModelId mux_model = device_annotation.rr_switch_circuit_model(driver_switches[0]);
 
-  /* Generate bitstream depend on both technology and structure of this MUX */
-  std::vector<bool> mux_bitstream = build_mux_bitstream(circuit_lib, mux_model, mux_lib, datapath_mux_size, path_id); 
-
-  /* Find the module in module manager and ensure the bitstream size matches! */
-  std::string mem_module_name = generate_mux_subckt_name(circuit_lib, mux_model, datapath_mux_size, std::string(MEMORY_MODULE_POSTFIX)); 
-  ModuleId mux_mem_module = module_manager.find_module(mem_module_name); 
-  VTR_ASSERT (true == module_manager.valid_module_id(mux_mem_module));
-  ModulePortId mux_mem_out_port_id = module_manager.find_module_port(mux_mem_module, generate_configurable_memory_data_out_name());
-  VTR_ASSERT(mux_bitstream.size() == module_manager.module_port(mux_mem_module, mux_mem_out_port_id).get_width());
-
-  /* Add the bistream to the bitstream manager */
-  bitstream_manager.add_block_bits(mux_mem_block, mux_bitstream);
-  /* Record path ids, input and output nets */
-  bitstream_manager.add_path_id_to_block(mux_mem_block, path_id);
-
-  /* Add input nets */
-  bool need_splitter = false;
-  std::string input_net_ids;
-  for (const ClusterNetId& input_net : input_nets) {
-    /* Add a space as a splitter*/
-    if (true == need_splitter) {
-      input_net_ids += std::string(" ");
-    }
-    AtomNetId input_atom_net = atom_ctx.lookup.atom_net(input_net);
-    if (true == atom_ctx.nlist.valid_net_id(input_atom_net)) {
-      input_net_ids += atom_ctx.nlist.net_name(input_atom_net);
-    } else {
-      input_net_ids += std::string("unmapped");
-    }
-    need_splitter = true;
-  }
-  bitstream_manager.add_input_net_id_to_block(mux_mem_block, input_net_ids);
-
-  /* Add output nets */
-  std::string output_net_ids;
-  AtomNetId output_atom_net = atom_ctx.lookup.atom_net(output_net);
-  if (true == atom_ctx.nlist.valid_net_id(output_atom_net)) {
-    output_net_ids += atom_ctx.nlist.net_name(output_atom_net);
-  } else {
-    output_net_ids += std::string("unmapped");
+  /* Add the bistream and record path ids, input and output nets */
+  if (0 != add_routing_mux_bitstream_to_block(bitstream_manager, mux_mem_block,
+                                              module_manager, circuit_lib, mux_lib,
+                                              mux_model, datapath_mux_size, path_id,
+                                              incremental, changed_bits)) {
+    return 1;
   }
-  bitstream_manager.add_output_net_id_to_block(mux_mem_block, output_net_ids);
+  add_routing_mux_net_ids_to_block(bitstream_manager, mux_mem_block, atom_ctx, input_nets, output_net);
 
+  return 0;
 }
 
 /********************************************************************
  * This function generates bitstream for an interconnection, 
  * i.e., a routing multiplexer, in a Connection Block
+ * The block of the routing multiplexer is found from the existing blocks
+ * when the bitstream is updated, and the bits whose values change
+ * are added to changed_bits
  * This function will identify if a node indicates a routing multiplexer
  * If not a routing multiplexer, no bitstream is needed here
  * If yes, we will generate the bitstream for the routing multiplexer
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the existing blocks do not match the multiplexer
  *******************************************************************/
 static 
-void build_connection_block_interc_bitstream(BitstreamManager& bitstream_manager,
+int build_connection_block_interc_bitstream(BitstreamManager& bitstream_manager,
                                          const ConfigBlockId& cb_configurable_block,
                                          const ModuleManager& module_manager,
                                          const CircuitLibrary& circuit_lib,
@@ -353,7 +490,10 @@ void build_connection_block_interc_bitstream(BitstreamManager& bitstream_manager
                                          const RRGraph& rr_graph,
                                          const RRGSB& rr_gsb,
                                          const e_side& cb_ipin_side, 
-                                         const size_t& ipin_index) {
+                                         const size_t& ipin_index,
+                                         const bool& incremental,
+                                         std::map<std::string, ConfigBlockId>& existing_mux_blocks,
+                                         std::vector<ConfigBitId>& changed_bits) {
 
   RRNodeId src_rr_node = rr_gsb.get_ipin_node(cb_ipin_side, ipin_index);
 
@@ -365,14 +505,20 @@ void build_connection_block_interc_bitstream(BitstreamManager& bitstream_manager
   } else if (1 < driver_rr_nodes.size()) {
     /* Create the block denoting the memory instances that drives this node in Switch Block */
     std::string mem_block_name = generate_cb_memory_instance_name(CONNECTION_BLOCK_MEM_INSTANCE_PREFIX, rr_graph.node_side(src_rr_node), ipin_index, std::string(""));
-    ConfigBlockId mux_mem_block = bitstream_manager.add_block(mem_block_name);
-    bitstream_manager.add_child_block(cb_configurable_block, mux_mem_block);
+    ConfigBlockId mux_mem_block = find_or_add_routing_mux_block(bitstream_manager, cb_configurable_block,
+                                                                incremental, existing_mux_blocks, mem_block_name);
+    if (ConfigBlockId::INVALID() == mux_mem_block) {
+      return 1;
+    }
     /* This is a routing multiplexer! Generate bitstream */
-    build_connection_block_mux_bitstream(bitstream_manager, mux_mem_block, 
-                                         module_manager, circuit_lib, mux_lib, 
-                                         atom_ctx, device_annotation, routing_annotation,
-                                         rr_graph, src_rr_node);
+    return build_connection_block_mux_bitstream(bitstream_manager, mux_mem_block, 
+                                                module_manager, circuit_lib, mux_lib, 
+                                                atom_ctx, device_annotation, routing_annotation,
+                                                rr_graph, src_rr_node,
+                                                incremental, changed_bits);
   } /*Nothing should be done else*/ 
+
+  return 0;
 }
 
 /********************************************************************
@@ -385,9 +531,13 @@ void build_connection_block_interc_bitstream(BitstreamManager& bitstream_manager
  *
  * Note that the output nodes are the IPIN rr node in a Connection Block
  * So, we will iterate over that.
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the existing blocks do not match the multiplexers
  *******************************************************************/
 static 
-void build_connection_block_bitstream(BitstreamManager& bitstream_manager,
+int build_connection_block_bitstream(BitstreamManager& bitstream_manager,
                                       const ConfigBlockId& cb_configurable_block,
                                       const ModuleManager& module_manager,
                                       const CircuitLibrary& circuit_lib,
@@ -397,7 +547,10 @@ void build_connection_block_bitstream(BitstreamManager& bitstream_manager,
                                       const VprRoutingAnnotation& routing_annotation,
                                       const RRGraph& rr_graph,
                                       const RRGSB& rr_gsb,
-                                      const t_rr_type& cb_type) {
+                                      const t_rr_type& cb_type,
+                                      const bool& incremental,
+                                      std::map<std::string, ConfigBlockId>& existing_mux_blocks,
+                                      std::vector<ConfigBitId>& changed_bits) {
    
   /* Find routing multiplexers on the sides of a Connection block where IPIN nodes locate */
   std::vector<enum e_side> cb_sides = rr_gsb.get_cb_ipin_sides(cb_type);
@@ -406,17 +559,112 @@ void build_connection_block_bitstream(BitstreamManager& bitstream_manager,
     enum e_side cb_ipin_side = cb_sides[side];
     SideManager side_manager(cb_ipin_side);
     for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(cb_ipin_side); ++inode) { 
-      build_connection_block_interc_bitstream(bitstream_manager, cb_configurable_block,
-                                              module_manager, circuit_lib, mux_lib, 
-                                              atom_ctx, device_annotation, routing_annotation,
-                                              rr_graph, rr_gsb,
-                                              cb_ipin_side, inode);
+      if (0 != build_connection_block_interc_bitstream(bitstream_manager, cb_configurable_block,
+                                                       module_manager, circuit_lib, mux_lib, 
+                                                       atom_ctx, device_annotation, routing_annotation,
+                                                       rr_graph, rr_gsb,
+                                                       cb_ipin_side, inode,
+                                                       incremental, existing_mux_blocks, changed_bits)) {
+        return 1;
+      }
     }
   }
+
+  return 0;
+}
+
+/********************************************************************
+ * Find the module of the connection block at a GSB coordinate
+ * Return an invalid id if the connection block has no bitstream, i.e.,
+ * it does not exist or contains no configuration bits
+ *******************************************************************/
+static 
+ModuleId find_connection_block_bitstream_module(const ModuleManager& module_manager,
+                                                const DeviceRRGSB& device_rr_gsb,
+                                                const bool& compact_routing_hierarchy,
+                                                const t_rr_type& cb_type,
+                                                const vtr::Point<size_t>& gsb_coord) {
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coord);
+  /* Check if the connection block exists in the device!
+   * Some of them do NOT exist due to heterogeneous blocks (height > 1) 
+   * We will skip those modules
+   */
+  if (false == rr_gsb.is_cb_exist(cb_type)) {
+    return ModuleId::INVALID();
+  }
+  /* Skip if the cb does not contain any configuration bits! */
+  if (true == connection_block_contain_only_routing_tracks(rr_gsb, cb_type)) {
+    return ModuleId::INVALID();
+  }
+
+  /* Find the cb module so that we can precisely reserve child blocks */
+  vtr::Point<size_t> cb_coord(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
+  std::string cb_module_name = generate_connection_block_module_name(cb_type, cb_coord);
+  if (true == compact_routing_hierarchy) {
+    vtr::Point<size_t> unique_cb_coord(gsb_coord);
+    /* Note: use GSB coordinate when inquire for unique modules!!! */
+    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, unique_cb_coord);
+    unique_cb_coord.set_x(unique_mirror.get_cb_x(cb_type)); 
+    unique_cb_coord.set_y(unique_mirror.get_cb_y(cb_type)); 
+    cb_module_name = generate_connection_block_module_name(cb_type, unique_cb_coord);
+  } 
+  ModuleId cb_module = module_manager.find_module(cb_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
+
+  /* Bypass empty blocks which have none configurable children */
+  if (0 == count_module_manager_module_configurable_children(module_manager, cb_module)) {
+    return ModuleId::INVALID();
+  } 
+
+  return cb_module;
+}
+
+/********************************************************************
+ * Find the module of the switch block at a GSB coordinate
+ * Return an invalid id if the switch block has no bitstream, i.e.,
+ * it does not exist or contains no configuration bits
+ *******************************************************************/
+static 
+ModuleId find_switch_block_bitstream_module(const ModuleManager& module_manager,
+                                            const DeviceRRGSB& device_rr_gsb,
+                                            const bool& compact_routing_hierarchy,
+                                            const vtr::Point<size_t>& gsb_coord) {
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coord);
+  /* Check if the switch block exists in the device!
+   * Some of them do NOT exist due to heterogeneous blocks (width > 1) 
+   * We will skip those modules
+   */
+  if (false == rr_gsb.is_sb_exist()) {
+    return ModuleId::INVALID();
+  }
+
+  vtr::Point<size_t> sb_coord(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+
+  /* Find the sb module so that we can precisely reserve child blocks */
+  std::string sb_module_name = generate_switch_block_module_name(sb_coord);
+  if (true == compact_routing_hierarchy) {
+    vtr::Point<size_t> unique_sb_coord(gsb_coord);
+    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(sb_coord);
+    unique_sb_coord.set_x(unique_mirror.get_sb_x()); 
+    unique_sb_coord.set_y(unique_mirror.get_sb_y()); 
+    sb_module_name = generate_switch_block_module_name(unique_sb_coord);
+  } 
+  ModuleId sb_module = module_manager.find_module(sb_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
+
+  /* Bypass empty blocks which have none configurable children */
+  if (0 == count_module_manager_module_configurable_children(module_manager, sb_module)) {
+    return ModuleId::INVALID();
+  } 
+
+  return sb_module;
 }
 
 /********************************************************************
- * Create bitstream for a X-direction or Y-direction Connection Blocks
+ * Create a bitstream block for a connection block at a GSB coordinate
+ * and generate its bitstream
+ * Connection blocks which do not exist or contain no configuration bits
+ * are skipped
  *******************************************************************/
 static 
 void build_connection_block_bitstreams(BitstreamManager& bitstream_manager,
@@ -430,60 +678,260 @@ void build_connection_block_bitstreams(BitstreamManager& bitstream_manager,
                                        const RRGraph& rr_graph,
                                        const DeviceRRGSB& device_rr_gsb,
                                        const bool& compact_routing_hierarchy,
-                                       const t_rr_type& cb_type) {
-
-  vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
-
-  for (size_t ix = 0; ix < cb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < cb_range.y(); ++iy) {
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      /* Check if the connection block exists in the device!
-       * Some of them do NOT exist due to heterogeneous blocks (height > 1) 
-       * We will skip those modules
-       */
-      if (false == rr_gsb.is_cb_exist(cb_type)) {
-        continue;
-      }
-      /* Skip if the cb does not contain any configuration bits! */
-      if (true == connection_block_contain_only_routing_tracks(rr_gsb, cb_type)) {
-        continue;
-      }
+                                       const t_rr_type& cb_type,
+                                       const vtr::Point<size_t>& gsb_coord) {
+  ModuleId cb_module = find_connection_block_bitstream_module(module_manager, device_rr_gsb,
+                                                              compact_routing_hierarchy,
+                                                              cb_type, gsb_coord);
+  if (false == module_manager.valid_module_id(cb_module)) {
+    return;
+  }
 
-      /* Find the cb module so that we can precisely reserve child blocks */
-      vtr::Point<size_t> cb_coord(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
-      std::string cb_module_name = generate_connection_block_module_name(cb_type, cb_coord);
-      if (true == compact_routing_hierarchy) {
-        vtr::Point<size_t> unique_cb_coord(ix, iy);
-        /* Note: use GSB coordinate when inquire for unique modules!!! */
-        const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, unique_cb_coord);
-        unique_cb_coord.set_x(unique_mirror.get_cb_x(cb_type)); 
-        unique_cb_coord.set_y(unique_mirror.get_cb_y(cb_type)); 
-        cb_module_name = generate_connection_block_module_name(cb_type, unique_cb_coord);
-      } 
-      ModuleId cb_module = module_manager.find_module(cb_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
-
-      /* Bypass empty blocks which have none configurable children */
-      if (0 == count_module_manager_module_configurable_children(module_manager, cb_module)) {
-        continue;
-      } 
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coord);
+  vtr::Point<size_t> cb_coord(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
 
-      /* Create a block for the bitstream which corresponds to the Switch block */
-      ConfigBlockId cb_configurable_block = bitstream_manager.add_block(generate_connection_block_module_name(cb_type, cb_coord));
-      /* Set switch block as a child of top block */
-      bitstream_manager.add_child_block(top_configurable_block, cb_configurable_block);
+  /* Create a block for the bitstream which corresponds to the Switch block */
+  ConfigBlockId cb_configurable_block = bitstream_manager.add_block(generate_connection_block_module_name(cb_type, cb_coord));
+  /* Set switch block as a child of top block */
+  bitstream_manager.add_child_block(top_configurable_block, cb_configurable_block);
 
-      /* Reserve child blocks for new created block */
-      bitstream_manager.reserve_child_blocks(cb_configurable_block,
-                                             count_module_manager_module_configurable_children(module_manager, cb_module)); 
-  
-      build_connection_block_bitstream(bitstream_manager, cb_configurable_block, module_manager,  
-                                       circuit_lib, mux_lib,
-                                       atom_ctx, device_annotation, routing_annotation,
-                                       rr_graph,
-                                       rr_gsb, cb_type);
+  /* Reserve child blocks for new created block */
+  bitstream_manager.reserve_child_blocks(cb_configurable_block,
+                                         count_module_manager_module_configurable_children(module_manager, cb_module)); 
+
+  std::map<std::string, ConfigBlockId> no_mux_blocks;
+  std::vector<ConfigBitId> changed_bits;
+  build_connection_block_bitstream(bitstream_manager, cb_configurable_block, module_manager,  
+                                   circuit_lib, mux_lib,
+                                   atom_ctx, device_annotation, routing_annotation,
+                                   rr_graph,
+                                   rr_gsb, cb_type,
+                                   false, no_mux_blocks, changed_bits);
+}
+
+/********************************************************************
+ * Create a bitstream block for a switch block at a GSB coordinate
+ * and generate its bitstream
+ * Switch blocks which do not exist or contain no configuration bits
+ * are skipped
+ *******************************************************************/
+static 
+void build_switch_block_bitstreams(BitstreamManager& bitstream_manager,
+                                   const ConfigBlockId& top_configurable_block,
+                                   const ModuleManager& module_manager,
+                                   const CircuitLibrary& circuit_lib,
+                                   const MuxLibrary& mux_lib,
+                                   const AtomContext& atom_ctx,
+                                   const VprDeviceAnnotation& device_annotation,
+                                   const VprRoutingAnnotation& routing_annotation,
+                                   const RRGraph& rr_graph,
+                                   const DeviceRRGSB& device_rr_gsb,
+                                   const bool& compact_routing_hierarchy,
+                                   const vtr::Point<size_t>& gsb_coord) {
+  ModuleId sb_module = find_switch_block_bitstream_module(module_manager, device_rr_gsb,
+                                                          compact_routing_hierarchy,
+                                                          gsb_coord);
+  if (false == module_manager.valid_module_id(sb_module)) {
+    return;
+  }
+
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coord);
+  vtr::Point<size_t> sb_coord(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+
+  /* Create a block for the bitstream which corresponds to the Switch block */
+  ConfigBlockId sb_configurable_block = bitstream_manager.add_block(generate_switch_block_module_name(sb_coord));
+  /* Set switch block as a child of top block */
+  bitstream_manager.add_child_block(top_configurable_block, sb_configurable_block);
+
+  /* Reserve child blocks for new created block */
+  bitstream_manager.reserve_child_blocks(sb_configurable_block,
+                                         count_module_manager_module_configurable_children(module_manager, sb_module)); 
+
+  std::map<std::string, ConfigBlockId> no_mux_blocks;
+  std::vector<ConfigBitId> changed_bits;
+  build_switch_block_bitstream(bitstream_manager, sb_configurable_block, module_manager,  
+                               circuit_lib, mux_lib,
+                               atom_ctx, device_annotation, routing_annotation,
+                               rr_graph,
+                               rr_gsb,
+                               false, no_mux_blocks, changed_bits);
+}
+
+/********************************************************************
+ * Find the existing block of a routing block to be updated
+ * The block should exist if and only if the routing block 
+ * has a bitstream in the current fabric
+ * Return an invalid id if the routing block has no bitstream
+ * or its block does not match (an error is then reported)
+ *******************************************************************/
+static 
+ConfigBlockId find_routing_block_to_update(const BitstreamManager& bitstream_manager,
+                                           const std::map<std::string, ConfigBlockId>& top_child_blocks,
+                                           const std::string& block_name,
+                                           const bool& has_bitstream,
+                                           int& status) {
+  std::map<std::string, ConfigBlockId>::const_iterator it = top_child_blocks.find(block_name);
+  if (false == has_bitstream) {
+    if (it != top_child_blocks.end()) {
+      VTR_LOG_ERROR("Bitstream block '%s' is found while the routing block has no configuration bits in the fabric!\n",
+                    block_name.c_str());
+      status = 1;
     }
+    return ConfigBlockId::INVALID();
   }
+  if (it == top_child_blocks.end()) {
+    VTR_LOG_ERROR("Bitstream block '%s' of a routing block is not found!\n",
+                  block_name.c_str());
+    status = 1;
+    return ConfigBlockId::INVALID();
+  }
+  /* Ensure that the block has bits */
+  if (0 == bitstream_manager.block_children(it->second).size()) {
+    VTR_LOG_ERROR("Bitstream block '%s' of a routing block has no configuration bits!\n",
+                  block_name.c_str());
+    status = 1;
+    return ConfigBlockId::INVALID();
+  }
+  return it->second;
+}
+
+/********************************************************************
+ * Ensure that all the blocks of routing multiplexers under a routing block
+ * are visited when updating its bitstream, i.e., there is no block
+ * of a multiplexer which does not exist in the fabric
+ *******************************************************************/
+static 
+int check_unvisited_routing_mux_blocks(const BitstreamManager& bitstream_manager,
+                                       const ConfigBlockId& routing_block,
+                                       const std::map<std::string, ConfigBlockId>& unvisited_mux_blocks) {
+  if (true == unvisited_mux_blocks.empty()) {
+    return 0;
+  }
+  VTR_LOG_ERROR("Bitstream block '%s' of a routing multiplexer is not found in the fabric under block '%s'!\n",
+                unvisited_mux_blocks.begin()->first.c_str(),
+                bitstream_manager.block_name(routing_block).c_str());
+  return 1;
+}
+
+/********************************************************************
+ * Update the bitstream of the switch block at a GSB coordinate
+ * for new routing results
+ * The block of the switch block is found from the child blocks of
+ * the top-level block. The block should exist if and only if
+ * the switch block contains configuration bits in the fabric,
+ * and its children should be the blocks of the multiplexers of the 
+ * switch block, as the blocks can not be added by the threads
+ * updating the bitstream.
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the blocks do not match the fabric
+ *******************************************************************/
+static 
+int update_switch_block_bitstreams(BitstreamManager& bitstream_manager,
+                                   const std::map<std::string, ConfigBlockId>& top_child_blocks,
+                                   const ModuleManager& module_manager,
+                                   const CircuitLibrary& circuit_lib,
+                                   const MuxLibrary& mux_lib,
+                                   const AtomContext& atom_ctx,
+                                   const VprDeviceAnnotation& device_annotation,
+                                   const VprRoutingAnnotation& routing_annotation,
+                                   const RRGraph& rr_graph,
+                                   const DeviceRRGSB& device_rr_gsb,
+                                   const bool& compact_routing_hierarchy,
+                                   const vtr::Point<size_t>& gsb_coord,
+                                   std::vector<ConfigBitId>& changed_bits) {
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coord);
+  if (false == rr_gsb.is_sb_exist()) {
+    return 0;
+  }
+
+  vtr::Point<size_t> sb_coord(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+  ModuleId sb_module = find_switch_block_bitstream_module(module_manager, device_rr_gsb,
+                                                          compact_routing_hierarchy,
+                                                          gsb_coord);
+  int status = 0;
+  ConfigBlockId sb_configurable_block = find_routing_block_to_update(bitstream_manager, top_child_blocks,
+                                                                     generate_switch_block_module_name(sb_coord),
+                                                                     module_manager.valid_module_id(sb_module),
+                                                                     status);
+  if (ConfigBlockId::INVALID() == sb_configurable_block) {
+    return status;
+  }
+
+  std::map<std::string, ConfigBlockId> mux_blocks = build_bitstream_child_block_lookup(bitstream_manager, sb_configurable_block);
+  if (0 != build_switch_block_bitstream(bitstream_manager, sb_configurable_block, module_manager,  
+                                        circuit_lib, mux_lib,
+                                        atom_ctx, device_annotation, routing_annotation,
+                                        rr_graph,
+                                        rr_gsb,
+                                        true, mux_blocks,
+                                        changed_bits)) {
+    return 1;
+  }
+
+  return check_unvisited_routing_mux_blocks(bitstream_manager, sb_configurable_block, mux_blocks);
+}
+
+/********************************************************************
+ * Update the bitstream of the connection block at a GSB coordinate
+ * for new routing results
+ * The block of the connection block is found from the child blocks of
+ * the top-level block. The block should exist if and only if
+ * the connection block contains configuration bits in the fabric,
+ * and its children should be the blocks of the multiplexers of the 
+ * connection block, as the blocks can not be added by the threads
+ * updating the bitstream.
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the blocks do not match the fabric
+ *******************************************************************/
+static 
+int update_connection_block_bitstreams(BitstreamManager& bitstream_manager,
+                                       const std::map<std::string, ConfigBlockId>& top_child_blocks,
+                                       const ModuleManager& module_manager,
+                                       const CircuitLibrary& circuit_lib,
+                                       const MuxLibrary& mux_lib,
+                                       const AtomContext& atom_ctx,
+                                       const VprDeviceAnnotation& device_annotation,
+                                       const VprRoutingAnnotation& routing_annotation,
+                                       const RRGraph& rr_graph,
+                                       const DeviceRRGSB& device_rr_gsb,
+                                       const bool& compact_routing_hierarchy,
+                                       const t_rr_type& cb_type,
+                                       const vtr::Point<size_t>& gsb_coord,
+                                       std::vector<ConfigBitId>& changed_bits) {
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coord);
+  if (false == rr_gsb.is_cb_exist(cb_type)) {
+    return 0;
+  }
+
+  vtr::Point<size_t> cb_coord(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
+  ModuleId cb_module = find_connection_block_bitstream_module(module_manager, device_rr_gsb,
+                                                              compact_routing_hierarchy,
+                                                              cb_type, gsb_coord);
+  int status = 0;
+  ConfigBlockId cb_configurable_block = find_routing_block_to_update(bitstream_manager, top_child_blocks,
+                                                                     generate_connection_block_module_name(cb_type, cb_coord),
+                                                                     module_manager.valid_module_id(cb_module),
+                                                                     status);
+  if (ConfigBlockId::INVALID() == cb_configurable_block) {
+    return status;
+  }
+
+  std::map<std::string, ConfigBlockId> mux_blocks = build_bitstream_child_block_lookup(bitstream_manager, cb_configurable_block);
+  if (0 != build_connection_block_bitstream(bitstream_manager, cb_configurable_block, module_manager,  
+                                            circuit_lib, mux_lib,
+                                            atom_ctx, device_annotation, routing_annotation,
+                                            rr_graph,
+                                            rr_gsb, cb_type,
+                                            true, mux_blocks,
+                                            changed_bits)) {
+    return 1;
+  }
+
+  return check_unvisited_routing_mux_blocks(bitstream_manager, cb_configurable_block, mux_blocks);
 }
 
 /********************************************************************
@@ -491,6 +939,8 @@ void build_connection_block_bitstreams(BitstreamManager& bitstream_manager,
  * Two major tasks: 
  * 1. Generate bitstreams for Switch Blocks
  * 2. Generate bitstreams for both X-direction and Y-direction Connection Blocks
+ * Each routing block is independent from the others, so their bitstreams
+ * can be built by multiple threads.
  *******************************************************************/
 void build_routing_bitstream(BitstreamManager& bitstream_manager,
                              const ConfigBlockId& top_configurable_block,
@@ -502,88 +952,138 @@ void build_routing_bitstream(BitstreamManager& bitstream_manager,
                              const VprRoutingAnnotation& routing_annotation,
                              const RRGraph& rr_graph,
                              const DeviceRRGSB& device_rr_gsb,
-                             const bool& compact_routing_hierarchy) {
+                             const bool& compact_routing_hierarchy,
+                             const ThreadPool& thread_pool) {
+
+  /* Each GSB is a task, visited in the same order as in the top-level module */
+  std::vector<vtr::Point<size_t>> gsb_coordinates = collect_device_rr_gsb_coordinates(device_rr_gsb);
 
   /* Generate bitstream for each switch blocks
    * To organize the bitstream in blocks, we create a block for each switch block 
    * and give names which are same as they are in top-level module managers
    */
   VTR_LOG("Generating bitstream for Switch blocks...");
-  vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
-  for (size_t ix = 0; ix < sb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < sb_range.y(); ++iy) {
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      /* Check if the switch block exists in the device!
-       * Some of them do NOT exist due to heterogeneous blocks (width > 1) 
-       * We will skip those modules
-       */
-      if (false == rr_gsb.is_sb_exist()) {
-        continue;
-      }
-
-      vtr::Point<size_t> sb_coord(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-
-      /* Find the sb module so that we can precisely reserve child blocks */
-      std::string sb_module_name = generate_switch_block_module_name(sb_coord);
-      if (true == compact_routing_hierarchy) {
-        vtr::Point<size_t> unique_sb_coord(ix, iy);
-        const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(sb_coord);
-        unique_sb_coord.set_x(unique_mirror.get_sb_x()); 
-        unique_sb_coord.set_y(unique_mirror.get_sb_y()); 
-        sb_module_name = generate_switch_block_module_name(unique_sb_coord);
-      } 
-      ModuleId sb_module = module_manager.find_module(sb_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
-
-      /* Bypass empty blocks which have none configurable children */
-      if (0 == count_module_manager_module_configurable_children(module_manager, sb_module)) {
-        continue;
-      } 
-
-      /* Create a block for the bitstream which corresponds to the Switch block */
-      ConfigBlockId sb_configurable_block = bitstream_manager.add_block(generate_switch_block_module_name(sb_coord));
-      /* Set switch block as a child of top block */
-      bitstream_manager.add_child_block(top_configurable_block, sb_configurable_block);
-
-      /* Reserve child blocks for new created block */
-      bitstream_manager.reserve_child_blocks(sb_configurable_block,
-                                             count_module_manager_module_configurable_children(module_manager, sb_module)); 
-
-      build_switch_block_bitstream(bitstream_manager, sb_configurable_block, module_manager,  
-                                   circuit_lib, mux_lib,
-                                   atom_ctx, device_annotation, routing_annotation,
-                                   rr_graph,
-                                   rr_gsb);
-    }
-  }
+  build_bitstream_manager_child_blocks(bitstream_manager, top_configurable_block,
+                                       gsb_coordinates.size(), thread_pool,
+                                       [&](BitstreamManager& task_bitstream_manager,
+                                           const ConfigBlockId& task_top_block,
+                                           const size_t& itask) {
+    build_switch_block_bitstreams(task_bitstream_manager, task_top_block, module_manager,  
+                                  circuit_lib, mux_lib,
+                                  atom_ctx, device_annotation, routing_annotation,
+                                  rr_graph,
+                                  device_rr_gsb,
+                                  compact_routing_hierarchy,
+                                  gsb_coordinates[itask]);
+  });
   VTR_LOG("Done\n");
 
   /* Generate bitstream for each connection blocks
    * To organize the bitstream in blocks, we create a block for each connection block 
    * and give names which are same as they are in top-level module managers
    */
-  VTR_LOG("Generating bitstream for X-direction Connection blocks ...");
-
-  build_connection_block_bitstreams(bitstream_manager, top_configurable_block, module_manager,  
-                                    circuit_lib, mux_lib,
-                                    atom_ctx, device_annotation, routing_annotation,
-                                    rr_graph,
-                                    device_rr_gsb,
-                                    compact_routing_hierarchy,
-                                    CHANX);
-  VTR_LOG("Done\n");
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    if (CHANX == cb_type) {
+      VTR_LOG("Generating bitstream for X-direction Connection blocks ...");
+    } else {
+      VTR_LOG("Generating bitstream for Y-direction Connection blocks ...");
+    }
+
+    build_bitstream_manager_child_blocks(bitstream_manager, top_configurable_block,
+                                         gsb_coordinates.size(), thread_pool,
+                                         [&](BitstreamManager& task_bitstream_manager,
+                                             const ConfigBlockId& task_top_block,
+                                             const size_t& itask) {
+      build_connection_block_bitstreams(task_bitstream_manager, task_top_block, module_manager,  
+                                        circuit_lib, mux_lib,
+                                        atom_ctx, device_annotation, routing_annotation,
+                                        rr_graph,
+                                        device_rr_gsb,
+                                        compact_routing_hierarchy,
+                                        cb_type,
+                                        gsb_coordinates[itask]);
+    });
+    VTR_LOG("Done\n");
+  }
+}
+
+/********************************************************************
+ * Top-level function to update the bitstream of global routing architecture
+ * when only the routing results change, e.g., after re-routing a design
+ * with the same packing and placement results.
+ * The bitstream of each routing multiplexer is regenerated only when 
+ * its selected path differs from the path id recorded in the bitstream.
+ * The blocks of routing multiplexers are not changed, so that each GSB
+ * is updated by a thread, which writes only the bits of its own blocks.
+ * A bitstream whose blocks do not match the fabric, e.g., read from 
+ * a file of another fabric, can not be updated and is reported as an error.
+ * The bitstream is then partially updated and should be rebuilt.
+ *
+ * The configuration bits whose values are changed are added to changed_bits
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the bitstream does not match the fabric
+ *******************************************************************/
+int update_routing_bitstream(BitstreamManager& bitstream_manager,
+                             const ConfigBlockId& top_configurable_block,
+                             const ModuleManager& module_manager,
+                             const CircuitLibrary& circuit_lib,
+                             const MuxLibrary& mux_lib,
+                             const AtomContext& atom_ctx,
+                             const VprDeviceAnnotation& device_annotation,
+                             const VprRoutingAnnotation& routing_annotation,
+                             const RRGraph& rr_graph,
+                             const DeviceRRGSB& device_rr_gsb,
+                             const bool& compact_routing_hierarchy,
+                             const ThreadPool& thread_pool,
+                             std::vector<ConfigBitId>& changed_bits) {
+  /* Find the blocks of routing blocks by their names */
+  std::map<std::string, ConfigBlockId> top_child_blocks = build_bitstream_child_block_lookup(bitstream_manager, top_configurable_block);
+
+  std::vector<vtr::Point<size_t>> gsb_coordinates = collect_device_rr_gsb_coordinates(device_rr_gsb);
 
-  VTR_LOG("Generating bitstream for Y-direction Connection blocks ...");
+  /* Each task collects the changed bits and the status of its own GSB */
+  std::vector<std::vector<ConfigBitId>> task_changed_bits(gsb_coordinates.size());
+  std::vector<int> task_status(gsb_coordinates.size(), 0);
 
-  build_connection_block_bitstreams(bitstream_manager, top_configurable_block, module_manager,  
-                                    circuit_lib, mux_lib,
-                                    atom_ctx, device_annotation, routing_annotation,
-                                    rr_graph,
-                                    device_rr_gsb,
-                                    compact_routing_hierarchy,
-                                    CHANY);
+  VTR_LOG("Updating bitstream for Switch blocks and Connection blocks...");
+  thread_pool.parallel_for(gsb_coordinates.size(),
+                           [&](const size_t& itask) {
+    task_status[itask] = update_switch_block_bitstreams(bitstream_manager, top_child_blocks, module_manager,  
+                                                        circuit_lib, mux_lib,
+                                                        atom_ctx, device_annotation, routing_annotation,
+                                                        rr_graph,
+                                                        device_rr_gsb,
+                                                        compact_routing_hierarchy,
+                                                        gsb_coordinates[itask],
+                                                        task_changed_bits[itask]);
+    for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+      if (0 != task_status[itask]) {
+        break;
+      }
+      task_status[itask] = update_connection_block_bitstreams(bitstream_manager, top_child_blocks, module_manager,  
+                                                              circuit_lib, mux_lib,
+                                                              atom_ctx, device_annotation, routing_annotation,
+                                                              rr_graph,
+                                                              device_rr_gsb,
+                                                              compact_routing_hierarchy,
+                                                              cb_type,
+                                                              gsb_coordinates[itask],
+                                                              task_changed_bits[itask]);
+    }
+  });
+
+  for (size_t itask = 0; itask < gsb_coordinates.size(); ++itask) {
+    if (0 != task_status[itask]) {
+      VTR_LOG("Failed\n");
+      return 1;
+    }
+    changed_bits.insert(changed_bits.end(), task_changed_bits[itask].begin(), task_changed_bits[itask].end());
+  }
   VTR_LOG("Done\n");
 
+  return 0;
 }
 
 } /* end namespace openfpga */
@@ -16,6 +16,7 @@
 #include "device_rr_gsb.h"
 #include "vpr_device_annotation.h"
 #include "vpr_routing_annotation.h"
+#include "openfpga_thread_pool.h"
 
 /********************************************************************
  * Function declaration
@@ -34,7 +35,22 @@ void build_routing_bitstream(BitstreamManager& bitstream_manager,
                              const VprRoutingAnnotation& routing_annotation,
                              const RRGraph& rr_graph,
                              const DeviceRRGSB& device_rr_gsb,
-                             const bool& compact_routing_hierarchy);
+                             const bool& compact_routing_hierarchy,
+                             const ThreadPool& thread_pool);
+
+int update_routing_bitstream(BitstreamManager& bitstream_manager,
+                             const ConfigBlockId& top_configurable_block,
+                             const ModuleManager& module_manager,
+                             const CircuitLibrary& circuit_lib,
+                             const MuxLibrary& mux_lib,
+                             const AtomContext& atom_ctx,
+                             const VprDeviceAnnotation& device_annotation,
+                             const VprRoutingAnnotation& routing_annotation,
+                             const RRGraph& rr_graph,
+                             const DeviceRRGSB& device_rr_gsb,
+                             const bool& compact_routing_hierarchy,
+                             const ThreadPool& thread_pool,
+                             std::vector<ConfigBitId>& changed_bits);
 
 } /* end namespace openfpga */
 
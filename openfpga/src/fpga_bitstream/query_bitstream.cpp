@@ -0,0 +1,141 @@
+/********************************************************************
+ * This file includes functions to report the results of queries 
+ * on the bitstream database and the fabric bitstream, which are
+ * answered by a BitstreamQueryIndex
+ *******************************************************************/
+#include <string>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+#include "bitstream_manager_utils.h"
+#include "query_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Represent the fabric bits of a block in ranges, e.g., 0-15, 32
+ *******************************************************************/
+static 
+std::string generate_fabric_bit_ranges(const BitstreamManager& bitstream_manager,
+                                       const BitstreamQueryIndex& query_index,
+                                       const ConfigBlockId& block) {
+  std::string ranges;
+  size_t range_begin = 0;
+  size_t range_end = 0;
+  bool in_range = false;
+
+  auto add_range = [&]() {
+    if (false == ranges.empty()) {
+      ranges += std::string(", ");
+    }
+    ranges += std::to_string(range_begin);
+    if (range_end != range_begin) {
+      ranges += std::string("-") + std::to_string(range_end);
+    }
+  };
+
+  for (const ConfigBitId& bit : bitstream_manager.block_bits(block)) {
+    FabricBitId fabric_bit = query_index.config_bit_fabric_bit(bit);
+    if (FabricBitId::INVALID() == fabric_bit) {
+      continue;
+    }
+    if ( (true == in_range) && (size_t(fabric_bit) == range_end + 1) ) {
+      range_end = size_t(fabric_bit);
+      continue;
+    }
+    if (true == in_range) {
+      add_range();
+    }
+    range_begin = size_t(fabric_bit);
+    range_end = size_t(fabric_bit);
+    in_range = true;
+  }
+  if (true == in_range) {
+    add_range();
+  }
+
+  return ranges;
+}
+
+/********************************************************************
+ * Report the bits of the given blocks and all their child blocks.
+ * Only the blocks which contain configuration bits are reported, e.g.,
+ *   fpga_top.sb_1__1_.mem_top_track_0: 0110 (fabric bits: 104-107)
+ * The fabric bits are reported only when the fabric bitstream is indexed
+ *******************************************************************/
+void report_bitstream_blocks(const BitstreamManager& bitstream_manager,
+                             const BitstreamQueryIndex& query_index,
+                             const std::vector<ConfigBlockId>& blocks) {
+  size_t num_reported_blocks = 0;
+  size_t num_reported_bits = 0;
+
+  /* Depth-first search, so that blocks are reported in the same order as bitstream files */
+  std::vector<ConfigBlockId> block_stack(blocks.rbegin(), blocks.rend());
+  while (false == block_stack.empty()) {
+    ConfigBlockId block = block_stack.back();
+    block_stack.pop_back();
+
+    std::vector<ConfigBlockId> child_blocks = bitstream_manager.block_children(block);
+    block_stack.insert(block_stack.end(), child_blocks.rbegin(), child_blocks.rend());
+
+    std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(block);
+    if (true == block_bits.empty()) {
+      continue;
+    }
+
+    std::string bit_values;
+    for (const ConfigBitId& bit : block_bits) {
+      bit_values.push_back(true == bitstream_manager.bit_value(bit) ? '1' : '0');
+    }
+    VTR_LOG("%s: %s",
+            query_index.block_path(block).c_str(),
+            bit_values.c_str());
+    if (true == query_index.fabric_bitstream_indexed()) {
+      VTR_LOG(" (fabric bits: %s)",
+              generate_fabric_bit_ranges(bitstream_manager, query_index, block).c_str());
+    }
+    VTR_LOG("\n");
+
+    num_reported_blocks++;
+    num_reported_bits += block_bits.size();
+  }
+
+  VTR_LOG("Found %lu configuration bits in %lu blocks\n",
+          num_reported_bits, num_reported_blocks);
+}
+
+/********************************************************************
+ * Report the block which owns a fabric bit, e.g.,
+ *   Fabric bit 104: configuration bit 2048 at fpga_top.sb_1__1_.mem_top_track_0[0] with value 0
+ *
+ * Return 0 if successful
+ * Return 1 if the fabric bit does not exist
+ *******************************************************************/
+int report_fabric_bit_owner(const BitstreamManager& bitstream_manager,
+                            const FabricBitstream& fabric_bitstream,
+                            const BitstreamQueryIndex& query_index,
+                            const size_t& fabric_bit_index) {
+  FabricBitId fabric_bit(fabric_bit_index);
+  if (false == fabric_bitstream.valid_bit_id(fabric_bit)) {
+    VTR_LOG_ERROR("Fabric bit '%lu' does not exist! The fabric bitstream contains %lu bits.\n",
+                  fabric_bit_index, fabric_bitstream.num_bits());
+    return 1;
+  }
+
+  ConfigBitId config_bit = fabric_bitstream.config_bit(fabric_bit);
+  ConfigBlockId block = bitstream_manager.bit_parent_block(config_bit);
+
+  VTR_LOG("Fabric bit %lu: configuration bit %lu at %s[%lu] with value %d\n",
+          fabric_bit_index,
+          size_t(config_bit),
+          query_index.block_path(block).c_str(),
+          find_bitstream_manager_config_bit_index_in_parent_block(bitstream_manager, config_bit),
+          bitstream_manager.bit_value(config_bit));
+
+  return 0;
+}
+
+} /* end namespace openfpga */
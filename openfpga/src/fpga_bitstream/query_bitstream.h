@@ -0,0 +1,30 @@
+#ifndef QUERY_BITSTREAM_H
+#define QUERY_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <vector>
+#include "bitstream_manager.h"
+#include "fabric_bitstream.h"
+#include "bitstream_query_index.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void report_bitstream_blocks(const BitstreamManager& bitstream_manager,
+                             const BitstreamQueryIndex& query_index,
+                             const std::vector<ConfigBlockId>& blocks);
+
+int report_fabric_bit_owner(const BitstreamManager& bitstream_manager,
+                            const FabricBitstream& fabric_bitstream,
+                            const BitstreamQueryIndex& query_index,
+                            const size_t& fabric_bit_index);
+
+} /* end namespace openfpga */
+
+#endif
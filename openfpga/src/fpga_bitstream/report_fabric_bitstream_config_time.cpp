@@ -0,0 +1,168 @@
+/********************************************************************
+ * This file includes functions that report the number of
+ * configuration clock cycles required to load a fabric bitstream,
+ * without generating and simulating any testbench
+ *******************************************************************/
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "fabric_bitstream_utils.h"
+#include "fabric_global_port_info_utils.h"
+#include "report_fabric_bitstream_config_time.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Report the configuration time of a fabric bitstream, including
+ * - The exact number of configuration clock cycles, the same as
+ *   the full testbench applies, with and without fast configuration
+ * - The number of configuration clock cycles required by each region
+ * - The imbalance among the regions and the speed-up that could be
+ *   achieved if the configuration bits were perfectly balanced
+ *
+ * The report is outputted to a file when a file name is provided,
+ * otherwise it is outputted to the log
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int report_fabric_bitstream_config_time(const BitstreamManager& bitstream_manager,
+                                        const FabricBitstream& fabric_bitstream,
+                                        const ConfigProtocol& config_protocol,
+                                        const FabricGlobalPortInfo& global_ports,
+                                        const float& prog_clock_freq,
+                                        const bool& fast_configuration,
+                                        const std::string& fname,
+                                        const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Report configuration time of fabric bitstream");
+
+  /* Identify if we can apply fast configuration */
+  std::vector<FabricGlobalPortId> global_prog_reset_ports = find_fabric_global_programming_reset_ports(global_ports);
+  std::vector<FabricGlobalPortId> global_prog_set_ports = find_fabric_global_programming_set_ports(global_ports);
+
+  bool apply_fast_configuration = fast_configuration;
+  if ( (global_prog_set_ports.empty() && global_prog_reset_ports.empty())
+     && (true == fast_configuration)) {
+    VTR_LOG_WARN("None of global reset and set ports are defined for programming purpose. Fast configuration is turned off\n");
+    apply_fast_configuration = false;
+  }
+  bool bit_value_to_skip = find_bit_value_to_skip_for_fast_configuration(config_protocol.type(),
+                                                                         apply_fast_configuration,
+                                                                         global_prog_reset_ports,
+                                                                         global_prog_set_ports,
+                                                                         bitstream_manager, fabric_bitstream,
+                                                                         verbose);
+
+  /* Count the clock cycles of the whole fabric, which already include the reset cycle */
+  size_t full_num_config_clock_cycles = find_fabric_num_config_clock_cycles(config_protocol.type(),
+                                                                            false,
+                                                                            bit_value_to_skip,
+                                                                            bitstream_manager,
+                                                                            fabric_bitstream);
+  size_t num_config_clock_cycles = full_num_config_clock_cycles;
+  if (true == apply_fast_configuration) {
+    num_config_clock_cycles = find_fabric_num_config_clock_cycles(config_protocol.type(),
+                                                                  true,
+                                                                  bit_value_to_skip,
+                                                                  bitstream_manager,
+                                                                  fabric_bitstream);
+  }
+
+  /* Count the clock cycles of each region */
+  std::vector<size_t> regional_num_config_clock_cycles = find_fabric_regional_num_config_clock_cycles(config_protocol.type(),
+                                                                                                      apply_fast_configuration,
+                                                                                                      bit_value_to_skip,
+                                                                                                      bitstream_manager,
+                                                                                                      fabric_bitstream);
+
+  size_t num_regions = regional_num_config_clock_cycles.size();
+  size_t regional_max = 0;
+  size_t regional_sum = 0;
+  for (const size_t& regional_cycles : regional_num_config_clock_cycles) {
+    regional_max = std::max(regional_max, regional_cycles);
+    regional_sum += regional_cycles;
+  }
+  float regional_avg = (0 == num_regions) ? 0. : (float)regional_sum / (float)num_regions;
+
+  /* The best case is that every region requires the same number of clock cycles */
+  size_t balanced_num_config_clock_cycles = num_config_clock_cycles;
+  if (0 < num_regions) {
+    balanced_num_config_clock_cycles = std::min(num_config_clock_cycles,
+                                                1 + (regional_sum + num_regions - 1) / num_regions);
+  }
+
+  /* Write the report */
+  std::stringstream report;
+  report << "Configuration protocol: " << CONFIG_PROTOCOL_TYPE_STRING[config_protocol.type()] << "\n";
+  report << "Number of configuration bits: " << fabric_bitstream.num_bits() << "\n";
+  report << "Number of configurable regions: " << num_regions << "\n";
+  if (true == apply_fast_configuration) {
+    report << "Fast configuration: on (skipping bits of '" << bit_value_to_skip << "')\n";
+  } else {
+    report << "Fast configuration: off\n";
+  }
+
+  report << "\n";
+  report << std::setw(10) << "Region" << std::setw(16) << "Bits" << std::setw(16) << "Clock cycles" << "\n";
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    report << std::setw(10) << size_t(region)
+           << std::setw(16) << fabric_bitstream.region_bits(region).size()
+           << std::setw(16) << regional_num_config_clock_cycles[size_t(region)] << "\n";
+  }
+  report << "\n";
+
+  report << "Number of configuration clock cycles (including 1 reset cycle): " << num_config_clock_cycles << "\n";
+  if (true == apply_fast_configuration) {
+    report << "Number of configuration clock cycles without fast configuration: " << full_num_config_clock_cycles << "\n";
+    report << "Speed-up by fast configuration: " << std::fixed << std::setprecision(3)
+           << (float)full_num_config_clock_cycles / (float)num_config_clock_cycles << "\n";
+  }
+  if (0. < prog_clock_freq) {
+    report << "Configuration time at programming clock of " << std::fixed << std::setprecision(3)
+           << prog_clock_freq / 1e6 << " MHz: "
+           << (float)num_config_clock_cycles / prog_clock_freq * 1e6 << " us\n";
+  }
+
+  report << "Region imbalance (maximum / average clock cycles): " << std::fixed << std::setprecision(3)
+         << ((0. == regional_avg) ? 1. : (float)regional_max / regional_avg) << "\n";
+  report << "Number of configuration clock cycles when regions are balanced: " << balanced_num_config_clock_cycles << "\n";
+  report << "Achievable speed-up by balancing regions: " << std::fixed << std::setprecision(3)
+         << (float)num_config_clock_cycles / (float)balanced_num_config_clock_cycles << "\n";
+
+  /* Output to the log when no file is specified */
+  if (true == fname.empty()) {
+    VTR_LOG("%s", report.str().c_str());
+    return 0;
+  }
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(fname.c_str(), fp);
+
+  fp << report.str();
+
+  /* Close file handler */
+  fp.close();
+
+  VTR_LOGV(verbose,
+           "Outputted configuration time report to file: %s\n",
+           fname.c_str());
+
+  return 0;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,31 @@
+#ifndef REPORT_FABRIC_BITSTREAM_CONFIG_TIME_H
+#define REPORT_FABRIC_BITSTREAM_CONFIG_TIME_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "bitstream_manager.h"
+#include "fabric_bitstream.h"
+#include "config_protocol.h"
+#include "fabric_global_port_info.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int report_fabric_bitstream_config_time(const BitstreamManager& bitstream_manager,
+                                        const FabricBitstream& fabric_bitstream,
+                                        const ConfigProtocol& config_protocol,
+                                        const FabricGlobalPortInfo& global_ports,
+                                        const float& prog_clock_freq,
+                                        const bool& fast_configuration,
+                                        const std::string& fname,
+                                        const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
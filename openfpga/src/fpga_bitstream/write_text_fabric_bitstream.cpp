@@ -5,6 +5,7 @@
 #include <chrono>
 #include <ctime>
 #include <fstream>
+#include <map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -13,6 +14,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_tokenizer.h"
 
 #include "openfpga_naming.h"
 
@@ -136,4 +138,237 @@ int write_fabric_bitstream_to_text_file(const BitstreamManager& bitstream_manage
   return status;
 }
 
+/********************************************************************
+ * Build the address of a configuration bit, which is the same string 
+ * as in the plain text file
+ * - Memory bank :  <BL address> <WL address>
+ * - Frame-based configuration protocol :  <address>
+ *******************************************************************/
+static 
+std::string build_fabric_config_bit_address_string(const FabricBitstream& fabric_bitstream,
+                                                   const FabricBitId& fabric_bit,
+                                                   const e_config_protocol_type& config_type) {
+  std::string addr_str;
+  if (CONFIG_MEM_MEMORY_BANK == config_type) {
+    for (const char& addr_bit : fabric_bitstream.bit_bl_address(fabric_bit)) {
+      addr_str.push_back(addr_bit);
+    }
+    addr_str.push_back(' ');
+    for (const char& addr_bit : fabric_bitstream.bit_wl_address(fabric_bit)) {
+      addr_str.push_back(addr_bit);
+    }
+  } else {
+    VTR_ASSERT(CONFIG_MEM_FRAME_BASED == config_type);
+    for (const char& addr_bit : fabric_bitstream.bit_address(fabric_bit)) {
+      addr_str.push_back(addr_bit);
+    }
+  }
+  return addr_str;
+}
+
+/********************************************************************
+ * Read a fabric bitstream from a plain text file, which is written by
+ * write_fabric_bitstream_to_text_file() for a memory bank or 
+ * frame-based configuration protocol
+ * Bits are grouped by frames, i.e., the bits sharing the same address,
+ * and the values of a frame are stored in the same sequence as in the file 
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+static 
+int read_fabric_bitstream_frames_from_text_file(const std::string& fname,
+                                                std::map<std::string, std::string>& frames) {
+  std::fstream fp;
+  fp.open(fname, std::fstream::in);
+  if (false == fp.is_open()) {
+    VTR_LOG_ERROR("Unable to open reference bitstream file '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  std::string line;
+  while (std::getline(fp, line)) {
+    StringToken tokenizer(line);
+    std::vector<std::string> tokens = tokenizer.split(std::string(" \t\r"));
+    if (true == tokens.empty()) {
+      continue;
+    }
+    /* The last token is the bit value, the others are the address */
+    if ( (1 == tokens.size())
+      || (1 != tokens.back().size())
+      || (('0' != tokens.back()[0]) && ('1' != tokens.back()[0])) ) {
+      VTR_LOG_ERROR("Invalid line '%s' in reference bitstream file '%s'!\n\tExpect <address> <0|1>\n",
+                    line.c_str(), fname.c_str());
+      return 1;
+    }
+    std::string addr_str = tokens[0];
+    for (size_t itoken = 1; itoken < tokens.size() - 1; ++itoken) {
+      addr_str += std::string(" ") + tokens[itoken];
+    }
+    frames[addr_str].push_back(tokens.back()[0]);
+  }
+
+  fp.close();
+
+  return 0;
+}
+
+/********************************************************************
+ * Check that a reference bitstream is compatible with the frames of the
+ * fabric bitstream, i.e., it is written for the same fabric and
+ * configuration protocol:
+ * - Each frame of the reference should exist in the fabric bitstream
+ * - Frames sharing the same address should have the same number of bits
+ * Frames which only exist in the fabric bitstream are allowed,
+ * and will be outputted as changed frames
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+static 
+int check_reference_fabric_bitstream_frames(const std::map<std::string, std::string>& ref_frames,
+                                            const std::map<std::string, std::string>& frames,
+                                            const std::string& ref_fname) {
+  size_t num_unknown_frames = 0;
+  size_t num_resized_frames = 0;
+  for (const auto& ref_frame : ref_frames) {
+    auto frame = frames.find(ref_frame.first);
+    if (frame == frames.end()) {
+      if (0 == num_unknown_frames) {
+        VTR_LOG_ERROR("Address '%s' of reference bitstream file '%s' does not exist in the fabric bitstream!\n",
+                      ref_frame.first.c_str(), ref_fname.c_str());
+      }
+      num_unknown_frames++;
+    } else if (frame->second.size() != ref_frame.second.size()) {
+      if (0 == num_resized_frames) {
+        VTR_LOG_ERROR("Frame at address '%s' has %lu bits in reference bitstream file '%s' but %lu bits in the fabric bitstream!\n",
+                      ref_frame.first.c_str(), ref_frame.second.size(), ref_fname.c_str(), frame->second.size());
+      }
+      num_resized_frames++;
+    }
+  }
+
+  if ( (0 < num_unknown_frames) || (0 < num_resized_frames) ) {
+    VTR_LOG_ERROR("Reference bitstream file '%s' is not compatible with the fabric bitstream: %lu unknown frames and %lu frames of different sizes!\n\tThe reference should be written for the same fabric and configuration protocol.\n",
+                  ref_fname.c_str(), num_unknown_frames, num_resized_frames);
+    return 1;
+  }
+
+  return 0;
+}
+
+/********************************************************************
+ * Write the difference between the fabric bitstream and a reference 
+ * fabric bitstream (previously written to a plain text file) 
+ * to a plain text file
+ * Only the frames (the bits sharing the same address) whose values 
+ * are different from the reference are written,
+ * so that a fabric already configured by the reference bitstream 
+ * can be updated with fewer programming cycles.
+ * The format is the same as write_fabric_bitstream_to_text_file()
+ *
+ * Note: 
+ *   - Only applicable to the configuration protocols with addresses,
+ *     i.e., memory bank and frame-based 
+ *   - The reference should be written for the same fabric,
+ *     otherwise, an error is reported
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_fabric_bitstream_diff_to_text_file(const BitstreamManager& bitstream_manager,
+                                             const FabricBitstream& fabric_bitstream,
+                                             const ConfigProtocol& config_protocol,
+                                             const std::string& ref_fname,
+                                             const std::string& fname,
+                                             const bool& verbose) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output bitstream!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  if ( (CONFIG_MEM_MEMORY_BANK != config_protocol.type())
+    && (CONFIG_MEM_FRAME_BASED != config_protocol.type()) ) {
+    VTR_LOG_ERROR("Differential bitstream is only applicable to memory bank and frame-based configuration protocols!\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write fabric bitstream difference from '") + ref_fname + std::string("' into plain text file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Load the frames of the reference bitstream */
+  std::map<std::string, std::string> ref_frames;
+  if (1 == read_fabric_bitstream_frames_from_text_file(ref_fname, ref_frames)) {
+    return 1;
+  }
+
+  /* Group the bits of the current bitstream by frames, in the same way */
+  std::vector<std::string> bit_addresses;
+  bit_addresses.reserve(fabric_bitstream.num_bits());
+  std::map<std::string, std::string> frames;
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    bit_addresses.push_back(build_fabric_config_bit_address_string(fabric_bitstream, fabric_bit, config_protocol.type()));
+    frames[bit_addresses.back()].push_back(bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)) ? '1' : '0');
+  }
+
+  /* A diff against a bitstream of another fabric is meaningless */
+  if (1 == check_reference_fabric_bitstream_frames(ref_frames, frames, ref_fname)) {
+    return 1;
+  }
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(fname.c_str(), fp);
+
+  /* Output the bits of changed frames only */
+  size_t num_bits = 0;
+  size_t num_changed_frames = 0;
+  std::map<std::string, bool> frame_changed;
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    const std::string& addr_str = bit_addresses[size_t(fabric_bit)];
+    auto result = frame_changed.find(addr_str);
+    if (result == frame_changed.end()) {
+      auto ref_frame = ref_frames.find(addr_str);
+      bool changed = (ref_frame == ref_frames.end()) || (ref_frame->second != frames.at(addr_str));
+      result = frame_changed.insert(std::make_pair(addr_str, changed)).first;
+      if (true == changed) {
+        num_changed_frames++;
+      }
+    }
+    if (false == result->second) {
+      continue;
+    }
+    int status = write_fabric_config_bit_to_text_file(fp, bitstream_manager,
+                                                      fabric_bitstream,
+                                                      fabric_bit,
+                                                      config_protocol.type());
+    if (1 == status) {
+      fp.close();
+      return status;
+    }
+    num_bits++;
+  }
+  /* Print an end to the file here */
+  fp << std::endl;
+
+  /* Close file handler */
+  fp.close();
+
+  VTR_LOG("Outputted %lu changed frames out of %lu frames\n",
+          num_changed_frames, frames.size());
+  VTR_LOGV(verbose,
+           "Outputted %lu configuration bits to plain text file: %s\n",
+           num_bits,
+           fname.c_str());
+
+  return 0;
+}
+
 } /* end namespace openfpga */
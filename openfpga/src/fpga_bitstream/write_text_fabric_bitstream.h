@@ -23,6 +23,13 @@ int write_fabric_bitstream_to_text_file(const BitstreamManager& bitstream_manage
                                         const std::string& fname,
                                         const bool& verbose);
 
+int write_fabric_bitstream_diff_to_text_file(const BitstreamManager& bitstream_manager,
+                                             const FabricBitstream& fabric_bitstream,
+                                             const ConfigProtocol& config_protocol,
+                                             const std::string& ref_fname,
+                                             const std::string& fname,
+                                             const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
@@ -1,15 +1,15 @@
 /********************************************************************
- * This file includes functions that output a fabric-dependent 
+ * This file includes functions that output a fabric-dependent
  * bitstream database to files in XML format
  *******************************************************************/
-#include <chrono>
-#include <ctime>
-#include <fstream>
+#include <string>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
+#include "vtr_vector.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
@@ -27,36 +27,79 @@ namespace openfpga {
 /********************************************************************
  * This function write header information to a bitstream file
  *******************************************************************/
-static 
-void write_fabric_bitstream_xml_file_head(std::fstream& fp) {
-  valid_file_stream(fp);
- 
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
-
-  fp << "<!--" << std::endl;
-  fp << "\t- Fabric bitstream" << std::endl;
-  fp << "\t- Author: Xifan TANG" << std::endl;
-  fp << "\t- Organization: University of Utah" << std::endl;
-  fp << "\t- Date: " << std::ctime(&end_time) ;
-  fp << "-->" << std::endl;
-  fp << std::endl;
+static
+void write_fabric_bitstream_xml_file_head(FileWriter& fp) {
+  fp.write("<!--\n");
+  fp.write("\t- Fabric bitstream\n");
+  fp.write("\t- Author: Xifan TANG\n");
+  fp.write("\t- Organization: University of Utah\n");
+  fp.write("\t- Date: ");
+  fp.write(get_current_date_string());
+  fp.write("-->\n");
+  fp.write("\n");
+}
+
+static
+void write_tabs_to_xml_file(FileWriter& fp, const size_t& num_tab) {
+  for (size_t itab = 0; itab < num_tab; ++itab) {
+    fp.write('\t');
+  }
+}
+
+/********************************************************************
+ * Find the hierarchy path of a block, e.g., fpga_top.grid_clb_1__1_.mem_lut
+ * The path is built only at the first call for each block,
+ * so that it is not built again for each of the bits of the block
+ *******************************************************************/
+static
+const std::string& find_fabric_bitstream_xml_block_path(const BitstreamManager& bitstream_manager,
+                                                        const ConfigBlockId& block,
+                                                        vtr::vector<ConfigBlockId, std::string>& block_paths) {
+  std::string& block_path = block_paths[block];
+  if (true == block_path.empty()) {
+    for (const ConfigBlockId& temp_block : find_bitstream_manager_block_hierarchy(bitstream_manager, block)) {
+      if (false == block_path.empty()) {
+        block_path.push_back('.');
+      }
+      block_path += bitstream_manager.block_name(temp_block);
+    }
+  }
+  return block_path;
+}
+
+/********************************************************************
+ * Find the index of a configuration bit in the bits of its parent block
+ * The bits of a block have consecutive ids, so only the first bit
+ * of each block is searched, at the first call for the block
+ *******************************************************************/
+static
+size_t find_fabric_bitstream_xml_bit_index(const BitstreamManager& bitstream_manager,
+                                           const ConfigBitId& config_bit,
+                                           vtr::vector<ConfigBlockId, ConfigBitId>& block_first_bits) {
+  const ConfigBlockId& block = bitstream_manager.bit_parent_block(config_bit);
+  if (ConfigBitId::INVALID() == block_first_bits[block]) {
+    block_first_bits[block] = bitstream_manager.block_bits(block).front();
+  }
+  VTR_ASSERT(size_t(block_first_bits[block]) <= size_t(config_bit));
+  return size_t(config_bit) - size_t(block_first_bits[block]);
 }
 
 /********************************************************************
  * Write a configuration bit into a plain text file
  * General format
- *   <bit id="<fabric_bit>" value="<config_bit_value>">
- *     <hierarchy>
- *       <!-- configurable memory hierarchy -->
- *     </hierarchy>
+ *   <bit id="<fabric_bit>" value="<config_bit_value>" path="<block_path>.mem_out[<index>]">
  *     <!-- address information -->
  *     ...
  *   </bit>
+ * When bits are grouped by block, the path of the block is outputted
+ * by the parent <block> node, and the path of the bit is relative to it,
+ * i.e., path="mem_out[<index>]". A bit without address is a single node
+ *   <bit id="<fabric_bit>" value="<config_bit_value>" path="mem_out[<index>]"/>
+ *
  * The format depends on the type of configuration protocol
  * - Vanilla (standalone): No more information to be included
  * - Configuration chain: No more information to be included
- * - Memory bank : 
+ * - Memory bank :
  *     <bl address="<bl_address_value>"/>
  *     <wl address="<wl_address_value>"/>
  * - Frame-based configuration protocol :
@@ -66,66 +109,65 @@ void write_fabric_bitstream_xml_file_head(std::fstream& fp) {
  *  - 0 if succeed
  *  - 1 if critical errors occured
  *******************************************************************/
-static 
-int write_fabric_config_bit_to_xml_file(std::fstream& fp,
+static
+int write_fabric_config_bit_to_xml_file(FileWriter& fp,
                                         const BitstreamManager& bitstream_manager,
                                         const FabricBitstream& fabric_bitstream,
                                         const FabricBitId& fabric_bit,
-                                        const e_config_protocol_type& config_type) {
-  if (false == valid_file_stream(fp)) {
-    return 1;
-  }
-
-  write_tab_to_file(fp, 1);
-  fp << "<bit id=\"" << size_t(fabric_bit) << "\"";
-  fp << " value=\"";
-  fp << bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
-  fp << "\"";
-
-  /* Output hierarchy of this parent*/
+                                        const e_config_protocol_type& config_type,
+                                        const std::string& block_path,
+                                        const size_t& bit_index,
+                                        const size_t& num_tab) {
   const ConfigBitId& config_bit = fabric_bitstream.config_bit(fabric_bit);
-  const ConfigBlockId& config_block = bitstream_manager.bit_parent_block(config_bit);
-  std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block); 
-  std::string hie_path;
-  for (const ConfigBlockId& temp_block : block_hierarchy) {
-    hie_path += bitstream_manager.block_name(temp_block);
-    hie_path += std::string(".");
-  }
-  hie_path += generate_configurable_memory_data_out_name();
-  hie_path += std::string("[");
-  hie_path += std::to_string(find_bitstream_manager_config_bit_index_in_parent_block(bitstream_manager, config_bit));
-  hie_path += std::string("]");
 
-  fp << " path=\"" << hie_path << "\">\n";
+  write_tabs_to_xml_file(fp, num_tab);
+  fp.write("<bit id=\"");
+  fp.write_number(size_t(fabric_bit));
+  fp.write("\" value=\"");
+  fp.write(true == bitstream_manager.bit_value(config_bit) ? '1' : '0');
+  fp.write("\" path=\"");
+  if (false == block_path.empty()) {
+    fp.write(block_path);
+    fp.write('.');
+  }
+  fp.write(generate_configurable_memory_data_out_name());
+  fp.write('[');
+  fp.write_number(bit_index);
+  fp.write("]\"");
 
   switch (config_type) {
-  case CONFIG_MEM_STANDALONE: 
+  case CONFIG_MEM_STANDALONE:
   case CONFIG_MEM_SCAN_CHAIN:
+    /* Bits grouped by block are compact */
+    if (true == block_path.empty()) {
+      fp.write("/>\n");
+      return 0;
+    }
+    fp.write(">\n");
     break;
-  case CONFIG_MEM_MEMORY_BANK: { 
+  case CONFIG_MEM_MEMORY_BANK: {
+    fp.write(">\n");
     /* Bit line address */
-    write_tab_to_file(fp, 2);
-    fp << "<bl address=\"";
-    for (const char& addr_bit : fabric_bitstream.bit_bl_address(fabric_bit)) {
-      fp << addr_bit;
-    }
-    fp << "\"/>\n";   
- 
-    write_tab_to_file(fp, 2);
-    fp << "<wl address=\"";
-    for (const char& addr_bit : fabric_bitstream.bit_wl_address(fabric_bit)) {
-      fp << addr_bit;
-    }
-    fp << "\"/>\n";   
+    std::vector<char> bl_address = fabric_bitstream.bit_bl_address(fabric_bit);
+    write_tabs_to_xml_file(fp, num_tab + 1);
+    fp.write("<bl address=\"");
+    fp.write(bl_address.data(), bl_address.size());
+    fp.write("\"/>\n");
+
+    std::vector<char> wl_address = fabric_bitstream.bit_wl_address(fabric_bit);
+    write_tabs_to_xml_file(fp, num_tab + 1);
+    fp.write("<wl address=\"");
+    fp.write(wl_address.data(), wl_address.size());
+    fp.write("\"/>\n");
     break;
   }
   case CONFIG_MEM_FRAME_BASED: {
-    write_tab_to_file(fp, 2);
-    fp << "<frame address=\"";
-    for (const char& addr_bit : fabric_bitstream.bit_address(fabric_bit)) {
-      fp << addr_bit;
-    }
-    fp << "\"/>\n";   
+    fp.write(">\n");
+    std::vector<char> address = fabric_bitstream.bit_address(fabric_bit);
+    write_tabs_to_xml_file(fp, num_tab + 1);
+    fp.write("<frame address=\"");
+    fp.write(address.data(), address.size());
+    fp.write("\"/>\n");
     break;
   }
   default:
@@ -134,18 +176,26 @@ int write_fabric_config_bit_to_xml_file(std::fstream& fp,
     return 1;
   }
 
-  write_tab_to_file(fp, 1);
-  fp << "</bit>\n";
+  write_tabs_to_xml_file(fp, num_tab);
+  fp.write("</bit>\n");
 
   return 0;
 }
 
 /********************************************************************
- * Write the fabric bitstream to an XML file 
- * Notes: 
+ * Write the fabric bitstream to an XML file
+ * Notes:
  *   - This file is designed to be reused by testbench generators, e.g., CocoTB
  *   - It can NOT be directly loaded to the FPGA fabric
  *   - It include configurable memory paths in full hierarchy
+ *   - When bits are grouped by block, the consecutive bits of the same block
+ *     are outputted under a <block> node, which includes the hierarchy path,
+ *     instead of outputting the path for each bit
+ *       <block path="<block_path>">
+ *         <bit id="<fabric_bit>" value="<config_bit_value>" path="mem_out[<index>]"/>
+ *         ...
+ *       </block>
+ *   - The file is compressed on the fly if required
  *
  * Return:
  *  - 0 if succeed
@@ -155,6 +205,8 @@ int write_fabric_bitstream_to_xml_file(const BitstreamManager& bitstream_manager
                                        const FabricBitstream& fabric_bitstream,
                                        const ConfigProtocol& config_protocol,
                                        const std::string& fname,
+                                       const bool& group_by_block,
+                                       const e_file_compression& compression,
                                        const bool& verbose) {
   /* Ensure that we have a valid file name */
   if (true == fname.empty()) {
@@ -165,33 +217,73 @@ int write_fabric_bitstream_to_xml_file(const BitstreamManager& bitstream_manager
   vtr::ScopedStartFinishTimer timer(timer_message);
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(fname, std::fstream::out | std::fstream::trunc);
-
-  check_file_stream(fname.c_str(), fp);
+  FileWriter fp;
+  if (false == fp.open(fname, compression)) {
+    VTR_LOG_ERROR("Unable to open file '%s' to write fabric bitstream!\n",
+                  fname.c_str());
+    return 1;
+  }
 
   /* Write XML head */
   write_fabric_bitstream_xml_file_head(fp);
 
-  fp << "<fabric_bitstream>\n";
+  fp.write("<fabric_bitstream>\n");
+
+  /* Paths of blocks are built on demand */
+  vtr::vector<ConfigBlockId, std::string> block_paths(bitstream_manager.num_blocks());
+  vtr::vector<ConfigBlockId, ConfigBitId> block_first_bits(bitstream_manager.num_blocks(), ConfigBitId::INVALID());
+  const std::string no_block_path;
 
   /* Output fabric bitstream to the file */
   int status = 0;
+  ConfigBlockId curr_block = ConfigBlockId::INVALID();
   for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
-    status = write_fabric_config_bit_to_xml_file(fp, bitstream_manager,
-                                                 fabric_bitstream,
-                                                 fabric_bit,
-                                                 config_protocol.type());
+    const ConfigBitId& config_bit = fabric_bitstream.config_bit(fabric_bit);
+    const ConfigBlockId& config_block = bitstream_manager.bit_parent_block(config_bit);
+    const std::string& block_path = find_fabric_bitstream_xml_block_path(bitstream_manager, config_block, block_paths);
+    size_t bit_index = find_fabric_bitstream_xml_bit_index(bitstream_manager, config_bit, block_first_bits);
+
+    if (false == group_by_block) {
+      status = write_fabric_config_bit_to_xml_file(fp, bitstream_manager,
+                                                   fabric_bitstream,
+                                                   fabric_bit,
+                                                   config_protocol.type(),
+                                                   block_path, bit_index, 1);
+    } else {
+      /* Start a new block node when the bit belongs to another block */
+      if (config_block != curr_block) {
+        if (ConfigBlockId::INVALID() != curr_block) {
+          fp.write("\t</block>\n");
+        }
+        fp.write("\t<block path=\"");
+        fp.write(block_path);
+        fp.write("\">\n");
+        curr_block = config_block;
+      }
+      status = write_fabric_config_bit_to_xml_file(fp, bitstream_manager,
+                                                   fabric_bitstream,
+                                                   fabric_bit,
+                                                   config_protocol.type(),
+                                                   no_block_path, bit_index, 2);
+    }
     if (1 == status) {
       break;
     }
   }
 
+  if (ConfigBlockId::INVALID() != curr_block) {
+    fp.write("\t</block>\n");
+  }
+
   /* Print an end to the file here */
-  fp << "</fabric_bitstream>\n";
+  fp.write("</fabric_bitstream>\n");
 
   /* Close file handler */
-  fp.close();
+  if (false == fp.close()) {
+    VTR_LOG_ERROR("Failed to write fabric bitstream to file '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
 
   VTR_LOGV(verbose,
            "Outputted %lu configuration bits to XML file: %s\n",
@@ -20,6 +20,7 @@
 #include "openfpga_port.h"
 #include "openfpga_side_manager.h"
 #include "openfpga_digest.h"
+#include "openfpga_thread_pool.h"
 
 #include "mux_utils.h"
 
@@ -44,6 +45,20 @@ float find_pnr_sdc_switch_tmax(const t_rr_switch_inf& switch_inf) {
   return switch_inf.R * switch_inf.Cout + switch_inf.Tdel;
 }
 
+/********************************************************************
+ * Find the timing constraints of all the switches in the routing resource graph
+ * The delays are computed once and shared by all the routing modules,
+ * rather than being derived again for each path of each multiplexer
+ *******************************************************************/
+static 
+vtr::vector<RRSwitchId, float> build_pnr_sdc_switch_tmax(const RRGraph& rr_graph) {
+  vtr::vector<RRSwitchId, float> switch_tmax(rr_graph.switches().size(), 0.);
+  for (const RRSwitchId& switch_id : rr_graph.switches()) {
+    switch_tmax[switch_id] = find_pnr_sdc_switch_tmax(rr_graph.get_switch(switch_id));
+  }
+  return switch_tmax;
+}
+
 /********************************************************************
  * Set timing constraints between the inputs and outputs of a routing
  * multiplexer in a Switch Block
@@ -59,6 +74,7 @@ void print_pnr_sdc_constrain_sb_mux_timing(std::fstream& fp,
                                            const RRGSB& rr_gsb,
                                            const e_side& output_node_side,
                                            const RRNodeId& output_rr_node,
+                                           const vtr::vector<RRSwitchId, float>& switch_tmax,
                                            const bool& constrain_zero_delay_paths) {
   /* Validate file stream */
   valid_file_stream(fp);
@@ -88,7 +104,7 @@ void print_pnr_sdc_constrain_sb_mux_timing(std::fstream& fp,
   for (const RREdgeId& edge : rr_graph.node_configurable_in_edges(output_rr_node)) {
     /* Get the switch delay */
     const RRSwitchId& driver_switch = rr_graph.edge_switch(edge);
-    switch_delays[module_input_ports[edge_counter]] = find_pnr_sdc_switch_tmax(rr_graph.get_switch(driver_switch));
+    switch_delays[module_input_ports[edge_counter]] = switch_tmax[driver_switch];
     edge_counter++;
   }
 
@@ -145,6 +161,7 @@ void print_pnr_sdc_constrain_sb_timing(const std::string& sdc_dir,
                                        const ModuleManager& module_manager,
                                        const RRGraph& rr_graph,
                                        const RRGSB& rr_gsb,
+                                       const vtr::vector<RRSwitchId, float>& switch_tmax,
                                        const bool& constrain_zero_delay_paths) {
 
   /* Create the file name for Verilog netlist */
@@ -190,6 +207,7 @@ void print_pnr_sdc_constrain_sb_timing(const std::string& sdc_dir,
                                             rr_gsb,
                                             side_manager.get_side(),
                                             chan_rr_node,
+                                            switch_tmax,
                                             constrain_zero_delay_paths);
     }
   }
@@ -201,6 +219,8 @@ void print_pnr_sdc_constrain_sb_timing(const std::string& sdc_dir,
 /********************************************************************
  * Print SDC timing constraints for Switch blocks
  * This function is designed for flatten routing hierarchy
+ * Each switch block is outputted to a separated file,
+ * so that the files can be written by multiple threads
  *******************************************************************/
 void print_pnr_sdc_flatten_routing_constrain_sb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
@@ -209,46 +229,57 @@ void print_pnr_sdc_flatten_routing_constrain_sb_timing(const std::string& sdc_di
                                                        const ModuleId& top_module,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const ThreadPool& thread_pool) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constrain Switch Block timing for P&R flow");
 
   std::string root_path = module_manager.module_name(top_module);
 
-  /* Get the range of SB array */
+  vtr::vector<RRSwitchId, float> switch_tmax = build_pnr_sdc_switch_tmax(rr_graph);
+
+  /* Collect the SBs which exist in the device */
+  std::vector<vtr::Point<size_t>> gsb_coords;
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
-  /* Go for each SB */
   for (size_t ix = 0; ix < sb_range.x(); ++ix) {
     for (size_t iy = 0; iy < sb_range.y(); ++iy) {
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      if (false == rr_gsb.is_sb_exist()) {
+      if (false == device_rr_gsb.get_gsb(ix, iy).is_sb_exist()) {
         continue;
       }
+      gsb_coords.push_back(vtr::Point<size_t>(ix, iy));
+    }
+  }
 
-      vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-      std::string sb_instance_name = generate_switch_block_module_name(gsb_coordinate); 
+  /* Go for each SB */
+  thread_pool.parallel_for(gsb_coords.size(), [&](const size_t& isb) {
+    const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coords[isb]);
 
-      ModuleId sb_module = module_manager.find_module(sb_instance_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
+    vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+    std::string sb_instance_name = generate_switch_block_module_name(gsb_coordinate); 
 
-      std::string module_path = format_dir_path(root_path) + sb_instance_name;
+    ModuleId sb_module = module_manager.find_module(sb_instance_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
 
-      print_pnr_sdc_constrain_sb_timing(sdc_dir,
-                                        time_unit,
-                                        hierarchical,
-                                        module_path,
-                                        module_manager,
-                                        rr_graph,
-                                        rr_gsb,
-                                        constrain_zero_delay_paths);
-    }
-  }
+    std::string module_path = format_dir_path(root_path) + sb_instance_name;
+
+    print_pnr_sdc_constrain_sb_timing(sdc_dir,
+                                      time_unit,
+                                      hierarchical,
+                                      module_path,
+                                      module_manager,
+                                      rr_graph,
+                                      rr_gsb,
+                                      switch_tmax,
+                                      constrain_zero_delay_paths);
+  });
 }
 
 /********************************************************************
  * Print SDC timing constraints for Switch blocks
  * This function is designed for compact routing hierarchy
+ * Only the unique modules are constrained, each of which
+ * is outputted to a separated file by one of the threads
  *******************************************************************/
 void print_pnr_sdc_compact_routing_constrain_sb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
@@ -257,17 +288,20 @@ void print_pnr_sdc_compact_routing_constrain_sb_timing(const std::string& sdc_di
                                                        const ModuleId& top_module,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const ThreadPool& thread_pool) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constrain Switch Block timing for P&R flow");
 
   std::string root_path = module_manager.module_name(top_module);
 
-  for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
+  vtr::vector<RRSwitchId, float> switch_tmax = build_pnr_sdc_switch_tmax(rr_graph);
+
+  thread_pool.parallel_for(device_rr_gsb.get_num_sb_unique_module(), [&](const size_t& isb) {
     const RRGSB& rr_gsb = device_rr_gsb.get_sb_unique_module(isb);
     if (false == rr_gsb.is_sb_exist()) {
-      continue;
+      return;
     }
 
     /* Find all the sb instance under this module
@@ -288,8 +322,9 @@ void print_pnr_sdc_compact_routing_constrain_sb_timing(const std::string& sdc_di
                                       module_manager,
                                       rr_graph,
                                       rr_gsb,
+                                      switch_tmax,
                                       constrain_zero_delay_paths);
-  }
+  });
 }
 
 /********************************************************************
@@ -307,6 +342,7 @@ void print_pnr_sdc_constrain_cb_mux_timing(std::fstream& fp,
                                            const RRGSB& rr_gsb,
                                            const t_rr_type& cb_type,
                                            const RRNodeId& output_rr_node,
+                                           const vtr::vector<RRSwitchId, float>& switch_tmax,
                                            const bool& constrain_zero_delay_paths) {
   /* Validate file stream */
   valid_file_stream(fp);
@@ -356,7 +392,7 @@ void print_pnr_sdc_constrain_cb_mux_timing(std::fstream& fp,
   for (const RREdgeId& edge : rr_graph.node_configurable_in_edges(output_rr_node)) {
     /* Get the switch delay */
     const RRSwitchId& driver_switch = rr_graph.edge_switch(edge);
-    switch_delays[module_input_ports[edge_counter]] = find_pnr_sdc_switch_tmax(rr_graph.get_switch(driver_switch));
+    switch_delays[module_input_ports[edge_counter]] = switch_tmax[driver_switch];
     edge_counter++;
   }
 
@@ -408,6 +444,7 @@ void print_pnr_sdc_constrain_cb_timing(const std::string& sdc_dir,
                                        const RRGraph& rr_graph,
                                        const RRGSB& rr_gsb, 
                                        const t_rr_type& cb_type,
+                                       const vtr::vector<RRSwitchId, float>& switch_tmax,
                                        const bool& constrain_zero_delay_paths) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
@@ -501,6 +538,7 @@ void print_pnr_sdc_constrain_cb_timing(const std::string& sdc_dir,
                                             module_manager, cb_module, 
                                             rr_graph, rr_gsb, cb_type,
                                             ipin_rr_node,
+                                            switch_tmax,
                                             constrain_zero_delay_paths);
     }
   }
@@ -510,62 +548,47 @@ void print_pnr_sdc_constrain_cb_timing(const std::string& sdc_dir,
 }
 
 /********************************************************************
- * Iterate over all the connection blocks in a device
- * and print SDC file for each of them 
+ * Print SDC file for a connection block
+ * The module path is derived from the top-level module
  *******************************************************************/
 static 
-void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_dir,
-                                                       const float& time_unit,
-                                                       const bool& hierarchical,
-                                                       const ModuleManager& module_manager, 
-                                                       const ModuleId& top_module,
-                                                       const RRGraph& rr_graph,
-                                                       const DeviceRRGSB& device_rr_gsb,
-                                                       const t_rr_type& cb_type,
-                                                       const bool& constrain_zero_delay_paths) {
-  /* Build unique X-direction connection block modules */
-  vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
-
-  std::string root_path = module_manager.module_name(top_module);
-
-  for (size_t ix = 0; ix < cb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < cb_range.y(); ++iy) {
-      /* Check if the connection block exists in the device!
-       * Some of them do NOT exist due to heterogeneous blocks (height > 1) 
-       * We will skip those modules
-       */
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      if (false == rr_gsb.is_cb_exist(cb_type)) {
-        continue;
-      }
-
-      /* Find all the cb instance under this module
-       * Create a regular expression to include these instance names 
-       */
-      vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
-      std::string cb_instance_name = generate_connection_block_module_name(cb_type, gsb_coordinate); 
-      ModuleId cb_module = module_manager.find_module(cb_instance_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
-
-      std::string module_path = format_dir_path(root_path) + cb_instance_name;
-
-      print_pnr_sdc_constrain_cb_timing(sdc_dir,
-                                        time_unit,
-                                        hierarchical,
-                                        module_path,
-                                        module_manager,
-                                        rr_graph, 
-                                        rr_gsb, 
-                                        cb_type,
-                                        constrain_zero_delay_paths);
+void print_pnr_sdc_routing_constrain_cb_timing(const std::string& sdc_dir,
+                                               const float& time_unit,
+                                               const bool& hierarchical,
+                                               const ModuleManager& module_manager, 
+                                               const std::string& root_path,
+                                               const RRGraph& rr_graph,
+                                               const RRGSB& rr_gsb,
+                                               const t_rr_type& cb_type,
+                                               const vtr::vector<RRSwitchId, float>& switch_tmax,
+                                               const bool& constrain_zero_delay_paths) {
+  /* Find all the cb instance under this module
+   * Create a regular expression to include these instance names 
+   */
+  vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
+  std::string cb_module_name = generate_connection_block_module_name(cb_type, gsb_coordinate); 
+  ModuleId cb_module = module_manager.find_module(cb_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
 
-    }
-  }
+  std::string module_path = format_dir_path(root_path) + cb_module_name;
+
+  print_pnr_sdc_constrain_cb_timing(sdc_dir,
+                                    time_unit,
+                                    hierarchical,
+                                    module_path,
+                                    module_manager,
+                                    rr_graph, 
+                                    rr_gsb, 
+                                    cb_type,
+                                    switch_tmax,
+                                    constrain_zero_delay_paths);
 }
 
 /********************************************************************
  * Iterate over all the connection blocks in a device
  * and print SDC file for each of them 
+ * Each connection block is outputted to a separated file,
+ * so that the files can be written by multiple threads
  *******************************************************************/
 void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
@@ -574,31 +597,50 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const ModuleId& top_module,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const ThreadPool& thread_pool) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constrain Connection Block timing for P&R flow");
 
-  print_pnr_sdc_flatten_routing_constrain_cb_timing(sdc_dir, time_unit,
-                                                    hierarchical,
-                                                    module_manager, top_module,
-                                                    rr_graph,
-                                                    device_rr_gsb,
-                                                    CHANX,
-                                                    constrain_zero_delay_paths);
-
-  print_pnr_sdc_flatten_routing_constrain_cb_timing(sdc_dir, time_unit,
-                                                    hierarchical, 
-                                                    module_manager, top_module,
-                                                    rr_graph,
-                                                    device_rr_gsb,
-                                                    CHANY,
-                                                    constrain_zero_delay_paths);
+  std::string root_path = module_manager.module_name(top_module);
+
+  vtr::vector<RRSwitchId, float> switch_tmax = build_pnr_sdc_switch_tmax(rr_graph);
+
+  /* Collect the X- and Y-direction connection blocks which exist in the device
+   * Some of them do NOT exist due to heterogeneous blocks (height > 1) 
+   * We will skip those modules
+   */
+  std::vector<std::pair<t_rr_type, vtr::Point<size_t>>> cbs;
+  vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (size_t ix = 0; ix < cb_range.x(); ++ix) {
+      for (size_t iy = 0; iy < cb_range.y(); ++iy) {
+        if (false == device_rr_gsb.get_gsb(ix, iy).is_cb_exist(cb_type)) {
+          continue;
+        }
+        cbs.push_back(std::make_pair(cb_type, vtr::Point<size_t>(ix, iy)));
+      }
+    }
+  }
+
+  thread_pool.parallel_for(cbs.size(), [&](const size_t& icb) {
+    print_pnr_sdc_routing_constrain_cb_timing(sdc_dir, time_unit,
+                                              hierarchical,
+                                              module_manager, root_path,
+                                              rr_graph,
+                                              device_rr_gsb.get_gsb(cbs[icb].second),
+                                              cbs[icb].first,
+                                              switch_tmax,
+                                              constrain_zero_delay_paths);
+  });
 }
 
 /********************************************************************
  * Print SDC timing constraints for Connection blocks
  * This function is designed for compact routing hierarchy
+ * Only the unique modules are constrained, each of which
+ * is outputted to a separated file by one of the threads
  *******************************************************************/
 void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
@@ -607,62 +649,35 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const ModuleId& top_module,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const ThreadPool& thread_pool) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constrain Connection Block timing for P&R flow");
 
   std::string root_path = module_manager.module_name(top_module);
 
-  /* Print SDC for unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
+  vtr::vector<RRSwitchId, float> switch_tmax = build_pnr_sdc_switch_tmax(rr_graph);
 
-    /* Find all the cb instance under this module
-     * Create a regular expression to include these instance names 
-     */
-    vtr::Point<size_t> gsb_coordinate(unique_mirror.get_cb_x(CHANX), unique_mirror.get_cb_y(CHANX));
-    std::string cb_module_name = generate_connection_block_module_name(CHANX, gsb_coordinate); 
-    ModuleId cb_module = module_manager.find_module(cb_module_name);
-    VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
-
-    std::string module_path = format_dir_path(root_path) + cb_module_name;
-
-    print_pnr_sdc_constrain_cb_timing(sdc_dir,
-                                      time_unit,
-                                      hierarchical,
-                                      module_path,
-                                      module_manager,
-                                      rr_graph, 
-                                      unique_mirror, 
-                                      CHANX,
-                                      constrain_zero_delay_paths);
+  /* Collect the unique X- and Y-direction connection block modules */
+  std::vector<std::pair<t_rr_type, size_t>> unique_cbs;
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(cb_type); ++icb) {
+      unique_cbs.push_back(std::make_pair(cb_type, icb));
+    }
   }
 
-  /* Print SDC for unique Y-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    /* Find all the cb instance under this module
-     * Create a regular expression to include these instance names 
-     */
-    vtr::Point<size_t> gsb_coordinate(unique_mirror.get_cb_x(CHANY), unique_mirror.get_cb_y(CHANY));
-    std::string cb_module_name = generate_connection_block_module_name(CHANY, gsb_coordinate); 
-    ModuleId cb_module = module_manager.find_module(cb_module_name);
-    VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
-
-    std::string module_path = format_dir_path(root_path) + cb_module_name;
-
-    print_pnr_sdc_constrain_cb_timing(sdc_dir,
-                                      time_unit,
-                                      hierarchical,
-                                      module_path,
-                                      module_manager,
-                                      rr_graph, 
-                                      unique_mirror, 
-                                      CHANY,
-                                      constrain_zero_delay_paths);
-  }
+  thread_pool.parallel_for(unique_cbs.size(), [&](const size_t& icb) {
+    const t_rr_type& cb_type = unique_cbs[icb].first;
+    print_pnr_sdc_routing_constrain_cb_timing(sdc_dir, time_unit,
+                                              hierarchical,
+                                              module_manager, root_path,
+                                              rr_graph,
+                                              device_rr_gsb.get_cb_unique_module(cb_type, unique_cbs[icb].second),
+                                              cb_type,
+                                              switch_tmax,
+                                              constrain_zero_delay_paths);
+  });
 }
 
 } /* end namespace openfpga */
@@ -9,6 +9,7 @@
 #include "module_manager.h"
 #include "device_rr_gsb.h"
 #include "rr_graph_obj.h"
+#include "openfpga_thread_pool.h"
 
 /********************************************************************
  * Function declaration
@@ -24,7 +25,8 @@ void print_pnr_sdc_flatten_routing_constrain_sb_timing(const std::string& sdc_di
                                                        const ModuleId& top_module,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths);
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const ThreadPool& thread_pool);
 
 void print_pnr_sdc_compact_routing_constrain_sb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
@@ -33,7 +35,8 @@ void print_pnr_sdc_compact_routing_constrain_sb_timing(const std::string& sdc_di
                                                        const ModuleId& top_module,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths);
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const ThreadPool& thread_pool);
 
 void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
@@ -42,7 +45,8 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const ModuleId& top_module,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths);
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const ThreadPool& thread_pool);
 
 void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
@@ -51,7 +55,8 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const ModuleId& top_module,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths);
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const ThreadPool& thread_pool);
 
 } /* end namespace openfpga */
 
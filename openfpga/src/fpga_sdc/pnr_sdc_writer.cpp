@@ -328,7 +328,8 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                    const MuxLibrary& mux_lib,
                    const CircuitLibrary& circuit_lib,
                    const FabricGlobalPortInfo& global_ports,
-                   const bool& compact_routing_hierarchy) {
+                   const bool& compact_routing_hierarchy,
+                   const ThreadPool& thread_pool) {
 
   std::string top_module_name = generate_fpga_top_module_name();
   ModuleId top_module = module_manager.find_module(top_module_name);
@@ -386,7 +387,8 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                                         top_module,
                                                         device_ctx.rr_graph,
                                                         device_rr_gsb,
-                                                        sdc_options.constrain_zero_delay_paths());
+                                                        sdc_options.constrain_zero_delay_paths(),
+                                                        thread_pool);
     } else {
 	  VTR_ASSERT_SAFE (false == compact_routing_hierarchy);
       print_pnr_sdc_flatten_routing_constrain_sb_timing(sdc_options.sdc_dir(),
@@ -396,7 +398,8 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                                         top_module,
                                                         device_ctx.rr_graph,
                                                         device_rr_gsb,
-                                                        sdc_options.constrain_zero_delay_paths());
+                                                        sdc_options.constrain_zero_delay_paths(),
+                                                        thread_pool);
     }
   }
 
@@ -420,7 +423,8 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                                         top_module,
                                                         device_ctx.rr_graph,
                                                         device_rr_gsb,
-                                                        sdc_options.constrain_zero_delay_paths());
+                                                        sdc_options.constrain_zero_delay_paths(),
+                                                        thread_pool);
     } else {
 	  VTR_ASSERT_SAFE (false == compact_routing_hierarchy);
       print_pnr_sdc_flatten_routing_constrain_cb_timing(sdc_options.sdc_dir(),
@@ -430,7 +434,8 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                                         top_module,
                                                         device_ctx.rr_graph,
                                                         device_rr_gsb,
-                                                        sdc_options.constrain_zero_delay_paths());
+                                                        sdc_options.constrain_zero_delay_paths(),
+                                                        thread_pool);
     }
   }
 
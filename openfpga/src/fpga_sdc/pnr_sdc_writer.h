@@ -14,6 +14,7 @@
 #include "circuit_library.h"
 #include "fabric_global_port_info.h"
 #include "pnr_sdc_option.h"
+#include "openfpga_thread_pool.h"
 
 /********************************************************************
  * Function declaration
@@ -32,7 +33,8 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                    const MuxLibrary& mux_lib,
                    const CircuitLibrary& circuit_lib,
                    const FabricGlobalPortInfo& global_ports,
-                   const bool& compact_routing_hierarchy);
+                   const bool& compact_routing_hierarchy,
+                   const ThreadPool& thread_pool);
 
 } /* end namespace openfpga */
 
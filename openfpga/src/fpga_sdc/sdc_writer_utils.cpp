@@ -28,18 +28,17 @@ void print_sdc_file_header(std::fstream& fp,
 
   valid_file_stream(fp);
 
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
-
-  fp << "#############################################" << std::endl;
-  fp << "#\tSynopsys Design Constraints (SDC)" << std::endl;
-  fp << "#\tFor FPGA fabric " << std::endl;
-  fp << "#\tDescription: " << usage << std::endl;
-  fp << "#\tAuthor: Xifan TANG " << std::endl;
-  fp << "#\tOrganization: University of Utah " << std::endl;
-  fp << "#\tDate: " << std::ctime(&end_time);
-  fp << "#############################################" << std::endl;
-  fp << std::endl;
+  std::string end_time_str = get_current_date_string();
+
+  fp << "#############################################\n";
+  fp << "#\tSynopsys Design Constraints (SDC)\n";
+  fp << "#\tFor FPGA fabric \n";
+  fp << "#\tDescription: " << usage << "\n";
+  fp << "#\tAuthor: Xifan TANG \n";
+  fp << "#\tOrganization: University of Utah \n";
+  fp << "#\tDate: " << end_time_str;
+  fp << "#############################################\n";
+  fp << "\n";
 }
 
 /********************************************************************
@@ -50,11 +49,11 @@ void print_sdc_timescale(std::fstream& fp,
 
   valid_file_stream(fp);
 
-  fp << "#############################################" << std::endl;
-  fp << "#\tDefine time unit " << std::endl;
-  fp << "#############################################" << std::endl;
-  fp << "set_units -time " << timescale << std::endl;
-  fp << std::endl;
+  fp << "#############################################\n";
+  fp << "#\tDefine time unit \n";
+  fp << "#############################################\n";
+  fp << "set_units -time " << timescale << "\n";
+  fp << "\n";
 }
 
 /********************************************************************
@@ -112,7 +111,7 @@ void print_pnr_sdc_constrain_max_delay(std::fstream& fp,
 
   fp << " " << std::setprecision(10) << delay;
 
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -152,7 +151,7 @@ void print_pnr_sdc_regexp_constrain_max_delay(std::fstream& fp,
 
   fp << " " << std::setprecision(10) << delay;
 
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -184,7 +183,7 @@ void print_pnr_sdc_constrain_min_delay(std::fstream& fp,
 
   fp << " " << std::setprecision(10) << delay;
 
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -240,7 +239,7 @@ void print_sdc_disable_port_timing(std::fstream& fp,
 
   fp << generate_sdc_port(port);
 
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -268,7 +267,7 @@ void print_sdc_set_port_input_delay(std::fstream& fp,
 
   fp << generate_sdc_port(port);
 
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -296,7 +295,7 @@ void print_sdc_set_port_output_delay(std::fstream& fp,
 
   fp << generate_sdc_port(port);
 
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -399,7 +398,7 @@ int rec_print_sdc_disable_timing_for_module_ports(std::fstream& fp,
       }
       fp << "set_disable_timing ";
       fp << child_module_path << module_manager.module_port(module_to_disable, port_to_disable).get_name();
-      fp << std::endl;
+      fp << "\n";
     }
   }
 
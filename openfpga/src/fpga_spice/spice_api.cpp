@@ -48,7 +48,8 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
                       const DeviceContext &device_ctx,
                       const VprDeviceAnnotation &device_annotation,
                       const DeviceRRGSB &device_rr_gsb,
-                      const FabricSpiceOption& options) {
+                      const FabricSpiceOption& options,
+                      const ThreadPool& thread_pool) {
 
   vtr::ScopedStartFinishTimer timer("Write SPICE netlists for FPGA fabric\n");
 
@@ -93,13 +94,15 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
     print_spice_unique_routing_modules(netlist_manager,
                                        module_manager,
                                        device_rr_gsb,
-                                       rr_dir_path);
+                                       rr_dir_path,
+                                       thread_pool);
   } else {
     VTR_ASSERT(false == options.compress_routing());
     print_spice_flatten_routing_modules(netlist_manager,
                                         module_manager,
                                         device_rr_gsb,
-                                        rr_dir_path);
+                                        rr_dir_path,
+                                        thread_pool);
   }
 
   /* Generate grids */
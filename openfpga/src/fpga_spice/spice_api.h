@@ -15,6 +15,7 @@
 #include "vpr_device_annotation.h"
 #include "device_rr_gsb.h"
 #include "fabric_spice_options.h"
+#include "openfpga_thread_pool.h"
 
 /********************************************************************
  * Function declaration
@@ -30,7 +31,8 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
                       const DeviceContext &device_ctx,
                       const VprDeviceAnnotation &device_annotation,
                       const DeviceRRGSB &device_rr_gsb,
-                      const FabricSpiceOption& options);
+                      const FabricSpiceOption& options,
+                      const ThreadPool& thread_pool);
 
 } /* end namespace openfpga */
 
@@ -175,7 +175,7 @@ int print_spice_submodule_mux_primitives(NetlistManager& netlist_manager,
     /* Create a mux graph for the branch circuit */
     std::vector<MuxGraph> branch_mux_graphs = mux_graph.build_mux_branch_graphs();
     /* Create branch circuits, which are N:1 one-level or 2:1 tree-like MUXes */
-    for (auto branch_mux_graph : branch_mux_graphs) {
+    for (const MuxGraph& branch_mux_graph : branch_mux_graphs) {
       generate_spice_mux_branch_subckt(module_manager, circuit_lib, fp, mux_circuit_model, 
                                        branch_mux_graph,
                                        branch_mux_module_is_outputted);
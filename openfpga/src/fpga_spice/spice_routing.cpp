@@ -9,6 +9,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_thread_pool.h"
 
 /* Include FPGA-Verilog header files*/
 #include "openfpga_naming.h"
@@ -73,10 +74,12 @@ namespace openfpga {
  *
  *  W: routing channel width
  *              
+ * Return the name of the netlist, which should be registered
+ * in the netlist manager by the caller. This function does not
+ * modify any shared data, so that it can be called by multiple threads
  ********************************************************************/
 static 
-void print_spice_routing_connection_box_unique_module(NetlistManager& netlist_manager,
-                                                      const ModuleManager& module_manager, 
+std::string print_spice_routing_connection_box_unique_module(const ModuleManager& module_manager, 
                                                       const std::string& subckt_dir, 
                                                       const RRGSB& rr_gsb,
                                                       const t_rr_type& cb_type) {
@@ -105,10 +108,7 @@ void print_spice_routing_connection_box_unique_module(NetlistManager& netlist_ma
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  return spice_fname;
 }
 
 /*********************************************************************
@@ -172,11 +172,12 @@ void print_spice_routing_connection_box_unique_module(NetlistManager& netlist_ma
  *                       Grid[x][y]     ChanY[x][y]      Grid[x+1][y] 
  *                       right_pins    inputs/outputs      left_pins
  *
- *
+ * Return the name of the netlist, which should be registered
+ * in the netlist manager by the caller. This function does not
+ * modify any shared data, so that it can be called by multiple threads
  ********************************************************************/
 static 
-void print_spice_routing_switch_box_unique_module(NetlistManager& netlist_manager,
-                                                  const ModuleManager& module_manager, 
+std::string print_spice_routing_switch_box_unique_module(const ModuleManager& module_manager, 
                                                   const std::string& subckt_dir, 
                                                   const RRGSB& rr_gsb) {
   /* Create the netlist */
@@ -201,40 +202,44 @@ void print_spice_routing_switch_box_unique_module(NetlistManager& netlist_manage
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  return spice_fname;
 }
 
 /********************************************************************
- * Iterate over all the connection blocks in a device
- * and build a module for each of them 
+ * Write the netlists of a list of routing blocks using multiple threads
+ * Each routing block is outputted to a separated netlist.
+ * The netlists are registered in the netlist manager in the order of the list,
+ * so that the results are the same whatever the number of threads is
+ *   - A routing block is described by a GSB and a type:
+ *     either a switch block (NUM_RR_TYPES) or a connection block (CHANX|CHANY)
  *******************************************************************/
 static 
-void print_spice_flatten_connection_block_modules(NetlistManager& netlist_manager,
-                                                  const ModuleManager& module_manager, 
-                                                  const DeviceRRGSB& device_rr_gsb,
-                                                  const std::string& subckt_dir,
-                                                  const t_rr_type& cb_type) {
-  /* Build unique X-direction connection block modules */
-  vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
-
-  for (size_t ix = 0; ix < cb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < cb_range.y(); ++iy) {
-      /* Check if the connection block exists in the device!
-       * Some of them do NOT exist due to heterogeneous blocks (height > 1) 
-       * We will skip those modules
-       */
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      if (true != rr_gsb.is_cb_exist(cb_type)) {
-        continue;
-      }
-      print_spice_routing_connection_box_unique_module(netlist_manager, 
-                                                       module_manager,
-                                                       subckt_dir, 
-                                                       rr_gsb, cb_type);
+void print_spice_routing_modules(NetlistManager& netlist_manager,
+                                 const ModuleManager& module_manager,
+                                 const std::vector<std::pair<const RRGSB*, t_rr_type>>& routing_blocks,
+                                 const std::string& subckt_dir,
+                                 const ThreadPool& thread_pool) {
+  std::vector<std::string> spice_fnames(routing_blocks.size());
+
+  thread_pool.parallel_for(routing_blocks.size(), [&](const size_t& iblk) {
+    const RRGSB& rr_gsb = *(routing_blocks[iblk].first);
+    if (NUM_RR_TYPES == routing_blocks[iblk].second) {
+      spice_fnames[iblk] = print_spice_routing_switch_box_unique_module(module_manager, 
+                                                                        subckt_dir, 
+                                                                        rr_gsb);
+    } else {
+      spice_fnames[iblk] = print_spice_routing_connection_box_unique_module(module_manager, 
+                                                                            subckt_dir, 
+                                                                            rr_gsb,
+                                                                            routing_blocks[iblk].second);
     }
+  });
+
+  /* Add fname to the netlist name list */
+  for (const std::string& spice_fname : spice_fnames) {
+    NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
   }
 }
 
@@ -250,39 +255,43 @@ void print_spice_flatten_connection_block_modules(NetlistManager& netlist_manage
 void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
                                          const ModuleManager& module_manager,
                                          const DeviceRRGSB& device_rr_gsb,
-                                         const std::string& subckt_dir) {
-  /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
-  std::vector<std::string> netlist_names;
+                                         const std::string& subckt_dir,
+                                         const ThreadPool& thread_pool) {
+  std::vector<std::pair<const RRGSB*, t_rr_type>> routing_blocks;
 
-  vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
 
   /* Build unique switch block modules */
-  for (size_t ix = 0; ix < sb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < sb_range.y(); ++iy) {
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
       const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
       if (true != rr_gsb.is_sb_exist()) {
         continue;
       }
-      print_spice_routing_switch_box_unique_module(netlist_manager,
-                                                   module_manager, 
-                                                   subckt_dir, 
-                                                   rr_gsb);
+      routing_blocks.push_back(std::make_pair(&rr_gsb, NUM_RR_TYPES));
     }
   }
 
-  print_spice_flatten_connection_block_modules(netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANX);
-
-  print_spice_flatten_connection_block_modules(netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANY);
+  /* Build unique X- and Y-direction connection block modules */
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+      for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+        /* Check if the connection block exists in the device!
+         * Some of them do NOT exist due to heterogeneous blocks (height > 1) 
+         * We will skip those modules
+         */
+        const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+        if (true != rr_gsb.is_cb_exist(cb_type)) {
+          continue;
+        }
+        routing_blocks.push_back(std::make_pair(&rr_gsb, cb_type));
+      }
+    }
+  }
 
-  /*
-  VTR_LOG("Writing header file for routing submodules '%s'...",
-          ROUTING_VERILOG_FILE_NAME);
-  print_spice_netlist_include_header_file(netlist_names,
-                                          subckt_dir.c_str(),
-                                          ROUTING_VERILOG_FILE_NAME);
-  VTR_LOG("Done\n");
-  VTR_LOG("\n");
-   */
+  print_spice_routing_modules(netlist_manager, module_manager,
+                              routing_blocks, subckt_dir,
+                              thread_pool);
 }
 
 
@@ -297,49 +306,28 @@ void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
  * the option compact_routing_hierarchy is turned on!!!
  *******************************************************************/
 void print_spice_unique_routing_modules(NetlistManager& netlist_manager,
-                                          const ModuleManager& module_manager,
-                                          const DeviceRRGSB& device_rr_gsb,
-                                          const std::string& subckt_dir) {
-  /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
-  std::vector<std::string> netlist_names;
+                                        const ModuleManager& module_manager,
+                                        const DeviceRRGSB& device_rr_gsb,
+                                        const std::string& subckt_dir,
+                                        const ThreadPool& thread_pool) {
+  std::vector<std::pair<const RRGSB*, t_rr_type>> routing_blocks;
 
   /* Build unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    print_spice_routing_switch_box_unique_module(netlist_manager,
-                                                 module_manager,
-                                                 subckt_dir, 
-                                                 unique_mirror);
+    routing_blocks.push_back(std::make_pair(&device_rr_gsb.get_sb_unique_module(isb), NUM_RR_TYPES));
   }
 
-  /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    print_spice_routing_connection_box_unique_module(netlist_manager,
-                                                     module_manager,
-                                                     subckt_dir, 
-                                                     unique_mirror, CHANX);
+  /* Build unique X- and Y-direction connection block modules */
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(cb_type); ++icb) {
+      routing_blocks.push_back(std::make_pair(&device_rr_gsb.get_cb_unique_module(cb_type, icb), cb_type));
+    }
   }
 
-  /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    print_spice_routing_connection_box_unique_module(netlist_manager, 
-                                                     module_manager,
-                                                     subckt_dir, 
-                                                     unique_mirror, CHANY);
-  }
+  print_spice_routing_modules(netlist_manager, module_manager,
+                              routing_blocks, subckt_dir,
+                              thread_pool);
 
-  /*
-  VTR_LOG("Writing header file for routing submodules '%s'...",
-          ROUTING_VERILOG_FILE_NAME);
-  print_spice_netlist_include_header_file(netlist_names,
-                                          subckt_dir.c_str(),
-                                          ROUTING_VERILOG_FILE_NAME);
-  VTR_LOG("Done\n");
-   */
   VTR_LOG("\n");
 }
 
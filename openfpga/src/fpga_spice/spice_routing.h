@@ -9,6 +9,7 @@
 #include "module_manager.h"
 #include "netlist_manager.h"
 #include "device_rr_gsb.h"
+#include "openfpga_thread_pool.h"
 
 /********************************************************************
  * Function declaration
@@ -20,12 +21,14 @@ namespace openfpga {
 void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
                                          const ModuleManager& module_manager,
                                          const DeviceRRGSB& device_rr_gsb,
-                                         const std::string& subckt_dir);
+                                         const std::string& subckt_dir,
+                                         const ThreadPool& thread_pool);
 
 void print_spice_unique_routing_modules(NetlistManager& netlist_manager,
                                         const ModuleManager& module_manager,
                                         const DeviceRRGSB& device_rr_gsb,
-                                        const std::string& subckt_dir);
+                                        const std::string& subckt_dir,
+                                        const ThreadPool& thread_pool);
 
 } /* end namespace openfpga */
 
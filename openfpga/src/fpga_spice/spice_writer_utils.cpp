@@ -32,17 +32,16 @@ void print_spice_file_header(std::fstream& fp,
                              const std::string& usage) {
   VTR_ASSERT(true == valid_file_stream(fp));
  
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
-
-  fp << "*********************************************" << std::endl;
-  fp << "*\tFPGA-SPICE Netlist" << std::endl;
-  fp << "*\tDescription: " << usage << std::endl;
-  fp << "*\tAuthor: Xifan TANG" << std::endl;
-  fp << "*\tOrganization: University of Utah" << std::endl;
-  fp << "*\tDate: " << std::ctime(&end_time) ;
-  fp << "*********************************************" << std::endl;
-  fp << std::endl;
+  std::string end_time_str = get_current_date_string();
+
+  fp << "*********************************************\n";
+  fp << "*\tFPGA-SPICE Netlist\n";
+  fp << "*\tDescription: " << usage << "\n";
+  fp << "*\tAuthor: Xifan TANG\n";
+  fp << "*\tOrganization: University of Utah\n";
+  fp << "*\tDate: " << end_time_str;
+  fp << "*********************************************\n";
+  fp << "\n";
 }
 
 /********************************************************************
@@ -52,7 +51,7 @@ void print_spice_include_netlist(std::fstream& fp,
                                  const std::string& netlist_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << ".include \"" << netlist_name << "\"" << std::endl; 
+  fp << ".include \"" << netlist_name << "\"\n"; 
 }
 
 /************************************************
@@ -63,9 +62,9 @@ void print_spice_comment(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   std::string comment_cover(comment.length() + 4, '*');
-  fp << comment_cover << std::endl;
-  fp << "* " << comment << " *" << std::endl;
-  fp << comment_cover << std::endl;
+  fp << comment_cover << "\n";
+  fp << "* " << comment << " *\n";
+  fp << comment_cover << "\n";
 }
 
 
@@ -150,7 +149,7 @@ void print_spice_subckt_definition(std::fstream& fp,
         new_line = false;
         if (SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE == pin_cnt) {
           pin_cnt = 0;
-          fp << std::endl;
+          fp << "\n";
           new_line = true;
         }
       }
@@ -172,7 +171,7 @@ void print_spice_subckt_definition(std::fstream& fp,
     fp << SPICE_SUBCKT_GND_PORT_NAME;
   }
 
-  fp << std::endl;
+  fp << "\n";
 }
 
 /************************************************
@@ -182,9 +181,9 @@ void print_spice_subckt_end(std::fstream& fp,
                             const std::string& module_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << ".ends" << std::endl;
+  fp << ".ends\n";
   print_spice_comment(fp, std::string("***** END SPICE module for " + module_name + " *****"));
-  fp << std::endl;
+  fp << "\n";
 }
 
 /************************************************
@@ -201,7 +200,7 @@ void print_spice_resistor(std::fstream& fp,
   fp << " " << input_port;
   fp << " " << output_port;
   fp << " " << std::setprecision(10) << resistance;
-  fp << std::endl;
+  fp << "\n";
 }
 
 /************************************************
@@ -218,7 +217,7 @@ void print_spice_capacitor(std::fstream& fp,
   fp << " " << input_port;
   fp << " " << output_port;
   fp << " " << std::setprecision(10) << capacitance;
-  fp << std::endl;
+  fp << "\n";
 }
 
 /************************************************
@@ -320,7 +319,7 @@ void print_spice_subckt_instance(std::fstream& fp,
         new_line = false;
         if (SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE == pin_cnt) {
           pin_cnt = 0;
-          fp << std::endl;
+          fp << "\n";
           new_line = true;
           fit_one_line = false;
         }
@@ -346,7 +345,7 @@ void print_spice_subckt_instance(std::fstream& fp,
   new_line = false;
   if (SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE == pin_cnt) {
     pin_cnt = 0;
-    fp << std::endl;
+    fp << "\n";
     new_line = true;
     fit_one_line = false;
   }
@@ -355,14 +354,14 @@ void print_spice_subckt_instance(std::fstream& fp,
    * if port print cannot fit one line, we create a new line for the module for a clean format
    */
   if (false == fit_one_line) {
-    fp << std::endl;
+    fp << "\n";
     fp << "+";
   }
   write_space_to_file(fp, 1);
   fp << module_manager.module_name(module_id);
   
   /* Print an end to the instance */
-  fp << std::endl;
+  fp << "\n";
 }
 
 } /* end namespace openfpga */
@@ -20,6 +20,8 @@
 #include "verilog_routing.h"
 #include "verilog_grid.h"
 #include "verilog_top_module.h"
+#include "verilog_writer_utils.h"
+#include "verilog_module_writer.h"
 
 #include "verilog_preconfig_top_module.h"
 #include "verilog_formal_random_top_testbench.h"
@@ -138,6 +140,141 @@ void fpga_fabric_verilog(ModuleManager &module_manager,
            module_manager.num_modules());
 }
 
+/********************************************************************
+ * Recursively collect the modules under a parent module which are 
+ * written by the fabric-level netlist writers, i.e., grids, routing blocks
+ * and top-level module. The other modules are written by the submodule 
+ * writers.
+ * Modules are collected in a Depth-First Search (DFS) so that 
+ * a child module always comes before its parent module
+ ********************************************************************/
+static 
+void rec_collect_fabric_verilog_modules(const ModuleManager& module_manager,
+                                        const ModuleId& parent_module,
+                                        std::vector<bool>& visited,
+                                        std::vector<ModuleId>& modules) {
+  if (true == visited[size_t(parent_module)]) {
+    return;
+  }
+  visited[size_t(parent_module)] = true;
+
+  for (const ModuleId& child_module : module_manager.child_modules(parent_module)) {
+    rec_collect_fabric_verilog_modules(module_manager, child_module, visited, modules);
+  }
+
+  ModuleManager::e_module_usage_type usage = module_manager.module_usage(parent_module);
+  if ( (ModuleManager::MODULE_TOP == usage)
+    || (ModuleManager::MODULE_GRID == usage)
+    || (ModuleManager::MODULE_SB == usage)
+    || (ModuleManager::MODULE_CB == usage) ) {
+    modules.push_back(parent_module);
+  }
+}
+
+/********************************************************************
+ * A top-level function of FPGA-Verilog which focuses on the Verilog 
+ * generation of a single module of the fabric
+ * This function will generate
+ *  - primitive modules, same as the full fabric generation
+ *  - a netlist '<module_name>.v' which contains the module and all 
+ *    the grid and routing modules in its hierarchy
+ * This is mainly used by hierarchical P&R flow on a single tile,
+ * where the module graph can be built on demand
+ *
+ * Return 0 if successful
+ * Return 1 if the module does not exist
+ ********************************************************************/
+int fpga_fabric_verilog_module(ModuleManager &module_manager,
+                               NetlistManager &netlist_manager,
+                               const CircuitLibrary &circuit_lib,
+                               const MuxLibrary &mux_lib,
+                               const DecoderLibrary &decoder_lib,
+                               const std::string& module_name,
+                               const FabricVerilogOption &options) {
+
+  vtr::ScopedStartFinishTimer timer("Write Verilog netlists for module '" + module_name + "'\n");
+
+  ModuleId module = module_manager.find_module(module_name);
+  if (false == module_manager.valid_module_id(module)) {
+    VTR_LOG_ERROR("Unable to find module '%s' in the fabric!\n",
+                  module_name.c_str());
+    return 1;
+  }
+
+  std::string src_dir_path = format_dir_path(options.output_directory());
+
+  /* Create directories */
+  create_directory(src_dir_path);
+
+  /* Sub directory under SRC directory to contain all the primitive block netlists */
+  std::string submodule_dir_path = src_dir_path + std::string(DEFAULT_SUBMODULE_DIR_NAME);
+  create_directory(submodule_dir_path);
+
+  /* Print Verilog files containing preprocessing flags */
+  print_verilog_preprocessing_flags_netlist(std::string(src_dir_path),
+                                            options);
+
+  /* Generate primitive Verilog modules, which are required by any module */
+  print_verilog_submodule(module_manager, netlist_manager,
+                          mux_lib, decoder_lib, circuit_lib,
+                          submodule_dir_path,
+                          options);
+
+  /* Find the modules which are not covered by the primitive netlists */
+  std::vector<bool> visited(module_manager.num_modules(), false);
+  std::vector<ModuleId> modules;
+  rec_collect_fabric_verilog_modules(module_manager, module, visited, modules);
+
+  if (false == modules.empty()) {
+    std::string verilog_fname = src_dir_path + module_name + std::string(VERILOG_NETLIST_FILE_POSTFIX);
+
+    /* Create the file stream */
+    std::fstream fp;
+    fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+
+    check_file_stream(verilog_fname.c_str(), fp);
+
+    print_verilog_file_header(fp, std::string("Verilog modules for module '" + module_name + "'"));
+
+    for (const ModuleId& curr_module : modules) {
+      write_verilog_module_to_file(fp, const_cast<const ModuleManager &>(module_manager), curr_module, options.explicit_port_mapping());
+
+      /* Add an empty line as a splitter */
+      fp << "\n";
+    }
+
+    /* Close file handler */
+    fp.close();
+
+    /* Add fname to the netlist name list */
+    NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    if ( (ModuleManager::MODULE_SB == module_manager.module_usage(module))
+      || (ModuleManager::MODULE_CB == module_manager.module_usage(module)) ) {
+      netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+    } else if (ModuleManager::MODULE_GRID == module_manager.module_usage(module)) {
+      netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
+    } else {
+      VTR_ASSERT(ModuleManager::MODULE_TOP == module_manager.module_usage(module));
+      netlist_manager.set_netlist_type(nlist_id, NetlistManager::TOP_MODULE_NETLIST);
+    }
+  } else {
+    VTR_LOG("Module '%s' is a primitive module, which is included in the netlists under '%s'\n",
+            module_name.c_str(), submodule_dir_path.c_str());
+  }
+
+  /* Generate an netlist including all the netlists that have been written */
+  print_verilog_fabric_include_netlist(const_cast<const NetlistManager &>(netlist_manager),
+                                       src_dir_path,
+                                       circuit_lib);
+
+  VTR_LOGV(options.verbose_output(),
+           "Written %lu Verilog modules for module '%s'\n",
+           modules.size(), module_name.c_str());
+
+  return 0;
+}
+
 /********************************************************************
  * A top-level function of FPGA-Verilog which focuses on fabric Verilog generation
  * This function will generate
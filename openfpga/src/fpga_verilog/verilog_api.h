@@ -42,6 +42,14 @@ void fpga_fabric_verilog(ModuleManager& module_manager,
                          const DeviceRRGSB& device_rr_gsb,
                          const FabricVerilogOption& options);
 
+int fpga_fabric_verilog_module(ModuleManager& module_manager,
+                               NetlistManager& netlist_manager,
+                               const CircuitLibrary& circuit_lib,
+                               const MuxLibrary& mux_lib,
+                               const DecoderLibrary& decoder_lib,
+                               const std::string& module_name,
+                               const FabricVerilogOption& options);
+
 void fpga_verilog_testbench(const ModuleManager& module_manager,
                             const BitstreamManager& bitstream_manager, 
                             const FabricBitstream& fabric_bitstream, 
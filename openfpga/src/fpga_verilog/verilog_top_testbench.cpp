@@ -599,11 +599,9 @@ void print_verilog_top_testbench_ports(std::fstream& fp,
 
 /********************************************************************
  * Estimate the number of configuration clock cycles
- * by traversing the linked-list and count the number of SRAM=1 or BL=1&WL=1 in it.
  * We plus 1 additional config clock cycle here because we need to reset everything during the first clock cycle
  * If we consider fast configuration, the number of clock cycles will be
  * the number of non-zero data points in the fabric bitstream
- * Note that this will not applicable to configuration chain!!!
  *******************************************************************/
 static
 size_t calculate_num_config_clock_cycles(const e_config_protocol_type& sram_orgz_type,
@@ -611,69 +609,23 @@ size_t calculate_num_config_clock_cycles(const e_config_protocol_type& sram_orgz
                                          const bool& bit_value_to_skip,
                                          const BitstreamManager& bitstream_manager,
                                          const FabricBitstream& fabric_bitstream) {
-  /* Find the longest regional bitstream */
-  size_t regional_bitstream_max_size = find_fabric_regional_bitstream_max_size(fabric_bitstream);
-
-  size_t num_config_clock_cycles = 1 + regional_bitstream_max_size;
-
-  /* Branch on the type of configuration protocol */
-  switch (sram_orgz_type) {
-  case CONFIG_MEM_STANDALONE:
-    /* We just need 1 clock cycle to load all the configuration bits
-     * since all the ports are exposed at the top-level
-     */
-    num_config_clock_cycles = 2;
-    break;
-  case CONFIG_MEM_SCAN_CHAIN:
-    /* For fast configuration, the bitstream size counts from the first bit '1' */
-    if (true == fast_configuration) {
-      /* For fast configuration, the number of bits to be skipped
-       * depends on each regional bitstream
-       * For example:
-       *   Region 0: 000000001111101010
-       *   Region 1:     00000011010101
-       *   Region 2:   0010101111000110
-       * The number of bits that can be skipped is limited by Region 2
-       */
-      size_t num_bits_to_skip = find_configuration_chain_fabric_bitstream_size_to_be_skipped(fabric_bitstream, bitstream_manager, bit_value_to_skip);
-
-      num_config_clock_cycles = 1 + regional_bitstream_max_size - num_bits_to_skip;
-
-      VTR_LOG("Fast configuration reduces number of configuration clock cycles from %lu to %lu (compression_rate = %f%)\n",
-              1 + regional_bitstream_max_size,
-              num_config_clock_cycles,
-              100. * ((float)num_config_clock_cycles / (float)(1 + regional_bitstream_max_size) - 1.));
-    }
-    break;
-  case CONFIG_MEM_MEMORY_BANK: {
-    /* For fast configuration, we will skip all the zero data points */
-    num_config_clock_cycles = 1 + build_memory_bank_fabric_bitstream_by_address(fabric_bitstream).size();
-    if (true == fast_configuration) {
-      size_t full_num_config_clock_cycles = num_config_clock_cycles;
-      num_config_clock_cycles = 1 + find_memory_bank_fast_configuration_fabric_bitstream_size(fabric_bitstream, bit_value_to_skip);
-      VTR_LOG("Fast configuration reduces number of configuration clock cycles from %lu to %lu (compression_rate = %f%)\n",
-              full_num_config_clock_cycles,
-              num_config_clock_cycles,
-              100. * ((float)num_config_clock_cycles / (float)full_num_config_clock_cycles - 1.));
-    }
-    break;
-  }
-  case CONFIG_MEM_FRAME_BASED: {
-    num_config_clock_cycles = 1 + build_frame_based_fabric_bitstream_by_address(fabric_bitstream).size();
-    if (true == fast_configuration) {
-      size_t full_num_config_clock_cycles = num_config_clock_cycles;
-      num_config_clock_cycles = 1 + find_frame_based_fast_configuration_fabric_bitstream_size(fabric_bitstream, bit_value_to_skip);
-      VTR_LOG("Fast configuration reduces number of configuration clock cycles from %lu to %lu (compression_rate = %f%)\n",
-              full_num_config_clock_cycles,
-              num_config_clock_cycles,
-              100. * ((float)num_config_clock_cycles / (float)full_num_config_clock_cycles - 1.));
-    }
-    break;
-  }
-  default:
-    VTR_LOGF_ERROR(__FILE__, __LINE__,
-                   "Invalid SRAM organization type!\n");
-    exit(1);
+  size_t num_config_clock_cycles = find_fabric_num_config_clock_cycles(sram_orgz_type,
+                                                                       fast_configuration,
+                                                                       bit_value_to_skip,
+                                                                       bitstream_manager,
+                                                                       fabric_bitstream);
+
+  if ( (true == fast_configuration)
+    && (CONFIG_MEM_STANDALONE != sram_orgz_type)) {
+    size_t full_num_config_clock_cycles = find_fabric_num_config_clock_cycles(sram_orgz_type,
+                                                                              false,
+                                                                              bit_value_to_skip,
+                                                                              bitstream_manager,
+                                                                              fabric_bitstream);
+    VTR_LOG("Fast configuration reduces number of configuration clock cycles from %lu to %lu (compression_rate = %f%)\n",
+            full_num_config_clock_cycles,
+            num_config_clock_cycles,
+            100. * ((float)num_config_clock_cycles / (float)full_num_config_clock_cycles - 1.));
   }
 
   VTR_LOG("Will use %ld configuration clock cycles to top testbench\n",
@@ -1215,102 +1167,6 @@ void print_verilog_top_testbench_vanilla_bitstream(std::fstream& fp,
   print_verilog_comment(fp, "----- End bitstream loading during configuration phase -----");
 }
 
-/********************************************************************
- * Decide if we should use reset or set signal to acheive fast configuration
- * - If only one type signal is specified, we use that type
- *   For example, only reset signal is defined, we will use reset  
- * - If both are defined, pick the one that will bring bigger reduction
- *   i.e., larger number of configuration bits can be skipped
- *******************************************************************/
-static 
-bool find_bit_value_to_skip_for_fast_configuration(const e_config_protocol_type& config_protocol_type,  
-                                                   const bool& fast_configuration,
-                                                   const std::vector<FabricGlobalPortId>& global_prog_reset_ports,
-                                                   const std::vector<FabricGlobalPortId>& global_prog_set_ports,
-                                                   const BitstreamManager& bitstream_manager,
-                                                   const FabricBitstream& fabric_bitstream) {
-
-  /* Early exit conditions */
-  if (!global_prog_reset_ports.empty() && global_prog_set_ports.empty()) {
-    return false; 
-  } else if (!global_prog_set_ports.empty() && global_prog_reset_ports.empty()) {
-    return true; 
-  } else if (global_prog_set_ports.empty() && global_prog_reset_ports.empty()) {
-    /* If both types of ports are not defined, the fast configuration should be turned off */
-    VTR_ASSERT(false == fast_configuration); 
-    return false;
-  }
-
-  VTR_ASSERT(!global_prog_set_ports.empty() && !global_prog_reset_ports.empty());
-  bool bit_value_to_skip = false;
-
-  VTR_LOG("Both reset and set ports are defined for programming controls, selecting the best-fit one...\n");
-
-  size_t num_ones_to_skip = 0;
-  size_t num_zeros_to_skip = 0;
-
-  /* Branch on the type of configuration protocol */
-  switch (config_protocol_type) {
-  case CONFIG_MEM_STANDALONE:
-    break;
-  case CONFIG_MEM_SCAN_CHAIN: {
-    /* We can only skip the ones/zeros at the beginning of the bitstream */
-    /* Count how many logic '1' bits we can skip */
-    for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-      if (false == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
-        break;
-      }
-      VTR_ASSERT(true == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id)));
-      num_ones_to_skip++;
-    }
-    /* Count how many logic '0' bits we can skip */
-    for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-      if (true == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
-        break;
-      }
-      VTR_ASSERT(false == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id)));
-      num_zeros_to_skip++;
-    }
-    break;
-  }
-  case CONFIG_MEM_MEMORY_BANK:
-  case CONFIG_MEM_FRAME_BASED: {
-    /* Count how many logic '1' and logic '0' bits we can skip */
-    for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-      if (false == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
-        num_zeros_to_skip++;
-      } else {
-        VTR_ASSERT(true == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id)));
-        num_ones_to_skip++;
-      }
-    }
-    break;
-  }
-  default:
-    VTR_LOGF_ERROR(__FILE__, __LINE__,
-                   "Invalid SRAM organization type!\n");
-    exit(1);
-  }
-
-  VTR_LOG("Using reset will skip %g% (%lu/%lu) of configuration bitstream.\n",
-          100. * (float) num_zeros_to_skip / (float) fabric_bitstream.num_bits(),
-          num_zeros_to_skip, fabric_bitstream.num_bits());
-
-  VTR_LOG("Using set will skip %g% (%lu/%lu) of configuration bitstream.\n",
-          100. * (float) num_ones_to_skip / (float) fabric_bitstream.num_bits(),
-          num_ones_to_skip, fabric_bitstream.num_bits());
-
-  /* By default, we prefer to skip zeros (when the numbers are the same */
-  if (num_ones_to_skip > num_zeros_to_skip) {
-    VTR_LOG("Will use set signal in fast configuration\n");
-    bit_value_to_skip = true;
-  } else {
-    VTR_LOG("Will use reset signal in fast configuration\n");
-  }
-
-  return bit_value_to_skip;
-}
-
 /********************************************************************
  * Print stimulus for a FPGA fabric with a configuration chain protocol
  * where configuration bits are programming in serial (one by one)
@@ -1822,7 +1678,8 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
                                                                          apply_fast_configuration,
                                                                          global_prog_reset_ports, 
                                                                          global_prog_set_ports, 
-                                                                         bitstream_manager, fabric_bitstream);
+                                                                         bitstream_manager, fabric_bitstream,
+                                                                         true);
 
   /* Start of testbench */
   print_verilog_top_testbench_ports(fp, module_manager, top_module,
@@ -1,6 +1,8 @@
 /********************************************************************
  * Build the OpenFPGA shell interface 
  *******************************************************************/
+#include <cstdlib>
+
 /* Header file from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_log.h"
@@ -21,6 +23,10 @@
 
 #include "openfpga_title.h"
 #include "openfpga_context.h"
+#include "openfpga_design_reset.h"
+
+/* Environment variable to set the number of threads without the option '--threads' */
+constexpr const char* OPENFPGA_NUM_THREADS_ENV_VAR = "OPENFPGA_NUM_THREADS";
 
 /********************************************************************
  * Main function to start OpenFPGA shell interface
@@ -40,6 +46,22 @@ int main(int argc, char** argv) {
   start_cmd.set_option_require_value(opt_script_mode, openfpga::OPT_STRING);
   start_cmd.set_option_short_name(opt_script_mode, "f");
 
+  /* Add an option '--server': launch the server mode listening to a UNIX socket */
+  openfpga::CommandOptionId opt_server_mode = start_cmd.add_option("server", false, "Launch OpenFPGA in server mode listening to a UNIX socket. The script of '--file' is executed once as a setup for all the requests");
+  start_cmd.set_option_require_value(opt_server_mode, openfpga::OPT_STRING);
+
+  /* Add an option '--concurrent_commands': execute independent read-only commands concurrently in script mode */
+  openfpga::CommandOptionId opt_concurrent_cmds = start_cmd.add_option("concurrent_commands", false, "Maximum number of read-only commands to be executed concurrently in script mode");
+  start_cmd.set_option_require_value(opt_concurrent_cmds, openfpga::OPT_INT);
+
+  /* Add an option '--threads': number of threads shared by the parallel loops of all the commands */
+  openfpga::CommandOptionId opt_threads = start_cmd.add_option("threads", false, "Number of threads shared by all the commands. By default, it is the environment variable OPENFPGA_NUM_THREADS if defined, otherwise 1");
+  start_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  /* Add an option '--profile': output runtime and memory usage of each command to a JSON file */
+  openfpga::CommandOptionId opt_profile = start_cmd.add_option("profile", false, "Output the runtime and memory usage of each command to a JSON file");
+  start_cmd.set_option_require_value(opt_profile, openfpga::OPT_STRING);
+
   openfpga::CommandOptionId opt_help = start_cmd.add_option("help", false, "Help desk"); 
   start_cmd.set_option_short_name(opt_help, "h");
 
@@ -92,15 +114,68 @@ int main(int argc, char** argv) {
     openfpga::print_command_options(start_cmd);
   } else {
     /* Parse succeed. Start a shell */ 
+    if (true == start_cmd_context.option_enable(start_cmd, opt_profile)) {
+      shell.set_profile_file(start_cmd_context.option_value(start_cmd, opt_profile));
+    }
+
+    /* The threads are shared by all the commands, unless a command specifies its own number of threads */
+    int num_threads = 1;
+    std::string num_threads_source;
+    if (true == start_cmd_context.option_enable(start_cmd, opt_threads)) {
+      num_threads = std::atoi(start_cmd_context.option_value(start_cmd, opt_threads).c_str());
+      num_threads_source = std::string("--") + start_cmd.option_name(opt_threads);
+    } else if (nullptr != std::getenv(OPENFPGA_NUM_THREADS_ENV_VAR)) {
+      num_threads = std::atoi(std::getenv(OPENFPGA_NUM_THREADS_ENV_VAR));
+      num_threads_source = std::string(OPENFPGA_NUM_THREADS_ENV_VAR);
+    }
+    if (0 >= num_threads) {
+      VTR_LOG_ERROR("Invalid number of threads '%d' from %s which should be a positive number!\n",
+                    num_threads, num_threads_source.c_str());
+      return 1;
+    }
+    openfpga_context.mutable_thread_pool().set_num_threads(size_t(num_threads));
+
     if (true == start_cmd_context.option_enable(start_cmd, opt_interactive)) {
 
       shell.run_interactive_mode(openfpga_context);
       return 0;
     } 
 
+    /* By default, commands are executed one by one */
+    int num_concurrent_cmds = 1;
+    if (true == start_cmd_context.option_enable(start_cmd, opt_concurrent_cmds)) {
+      num_concurrent_cmds = std::atoi(start_cmd_context.option_value(start_cmd, opt_concurrent_cmds).c_str());
+      if (0 >= num_concurrent_cmds) {
+        VTR_LOG_ERROR("Invalid number of concurrent commands '%d' which should be a positive number!\n",
+                      num_concurrent_cmds);
+        return 1;
+      }
+    }
+
+    if (true == start_cmd_context.option_enable(start_cmd, opt_server_mode)) {
+      /* The fabric built by the setup script is kept, 
+       * while the data of each design is cleared before a request 
+       */
+      shell.set_server_request_reset_function(openfpga::reset_openfpga_design_data,
+                                              openfpga::find_openfpga_design_dependent_command_names());
+
+      std::string setup_script;
+      if (true == start_cmd_context.option_enable(start_cmd, opt_script_mode)) {
+        setup_script = start_cmd_context.option_value(start_cmd, opt_script_mode);
+      }
+
+      shell.run_server_mode(start_cmd_context.option_value(start_cmd, opt_server_mode).c_str(),
+                            setup_script.empty() ? nullptr : setup_script.c_str(),
+                            openfpga_context,
+                            size_t(num_concurrent_cmds));
+      /* Reach here only when the server fails to start */
+      return 1;
+    }
+
     if (true == start_cmd_context.option_enable(start_cmd, opt_script_mode)) {
       shell.run_script_mode(start_cmd_context.option_value(start_cmd, opt_script_mode).c_str(),
-                            openfpga_context);
+                            openfpga_context,
+                            size_t(num_concurrent_cmds));
       return 0;
     }
     /* Reach here there is something wrong, show the help desk */
@@ -565,6 +565,9 @@ vtr::vector<MuxMemId, bool> MuxGraph::decode_memory_bits(const MuxInputId& input
   visited[node_id(input_id)] = true; 
   queue.push_back(node_id(input_id)); 
 
+  /* Find the output node only once, as it requires a search */
+  MuxNodeId des_node = node_id(output_id);
+
   /* Create a flag to indicate if the route is success or not */
   bool route_success = false;
 
@@ -600,7 +603,7 @@ vtr::vector<MuxMemId, bool> MuxGraph::decode_memory_bits(const MuxInputId& input
     MuxNodeId next_node = edge_sink_nodes_[edge][0]; 
 
     /* If next node is the output node we want, we can finish here */
-    if (next_node == node_id(output_id)) {
+    if (next_node == des_node) {
       route_success = true;
       break;
     }
@@ -32,7 +32,8 @@ MuxId MuxLibrary::mux_graph(const CircuitModelId& circuit_model,
   /* Validate circuit model id and mux_size */
   VTR_ASSERT_SAFE(valid_mux_size(circuit_model, mux_size));
 
-  return mux_lookup_[circuit_model][mux_size];
+  /* Use read-only accesses so that it is safe to query from multiple threads */
+  return mux_lookup_.at(circuit_model).at(mux_size);
 }
 
 const MuxGraph& MuxLibrary::mux_graph(const MuxId& mux_id) const {
@@ -56,6 +57,26 @@ size_t MuxLibrary::max_mux_size() const {
   return max_mux_size;
 }
 
+/* Get the memory bits which propagate an input to the output of a MUX 
+ * For single-output MUXes, this is a copy from the table built when adding the mux
+ */
+vtr::vector<MuxMemId, bool> MuxLibrary::mux_memory_bits(const MuxId& mux_id, const MuxInputId& input_id) const {
+  VTR_ASSERT_SAFE(valid_mux_id(mux_id));
+  const MuxGraph& graph = mux_graphs_[mux_id];
+  VTR_ASSERT(size_t(input_id) < graph.num_inputs());
+
+  if (true == mux_memory_bits_[mux_id].empty()) {
+    /* Only single-output MUXes are supported */
+    VTR_ASSERT(1 == graph.num_outputs());
+    return graph.decode_memory_bits(input_id, graph.output_id(graph.outputs()[0]));
+  }
+
+  size_t num_mems = graph.num_memory_bits();
+  std::vector<bool>::const_iterator first = mux_memory_bits_[mux_id].begin() + size_t(input_id) * num_mems;
+  vtr::vector<MuxMemId, bool> mem_bits(first, first + num_mems);
+  return mem_bits;
+}
+
 /**************************************************
  * Private mutators:
  *************************************************/
@@ -74,6 +95,8 @@ void MuxLibrary::add_mux(const CircuitLibrary& circuit_lib, const CircuitModelId
   mux_graphs_.push_back(MuxGraph(circuit_lib, circuit_model, mux_size));
   /* Recorde mux cirucit model id */
   mux_circuit_models_.push_back(circuit_model);
+  /* Precompute memory bits for each input */
+  build_mux_memory_bits(mux);
 
   /* update mux_lookup*/
   mux_lookup_[circuit_model][mux_size] = mux;
@@ -99,8 +122,8 @@ bool MuxLibrary::valid_mux_size(const CircuitModelId& circuit_model, const size_
   if (false == valid_mux_circuit_model_id(circuit_model)) {
     return false;
   }
-  std::map<size_t, MuxId>::iterator it = mux_lookup_[circuit_model].find(mux_size);
-  return (it != mux_lookup_[circuit_model].end());
+  const std::map<size_t, MuxId>& mux_sizes = mux_lookup_.at(circuit_model);
+  return (mux_sizes.find(mux_size) != mux_sizes.end());
 }
 
 /**************************************************
@@ -118,4 +141,27 @@ void MuxLibrary::invalidate_mux_lookup() {
   mux_lookup_.clear();
 }
 
+/* Decode the memory bits of each input of a mux, so that
+ * bitstream generation only requires a table look-up per multiplexer.
+ * The tables are built when the mux is added rather than on demand, 
+ * so that the library can be queried by multiple threads.
+ * Only single-output MUXes (routing and LUT MUXes) are considered 
+ */
+void MuxLibrary::build_mux_memory_bits(const MuxId& mux) {
+  VTR_ASSERT(size_t(mux) == mux_memory_bits_.size());
+  mux_memory_bits_.emplace_back();
+
+  const MuxGraph& graph = mux_graphs_[mux];
+  if (1 != graph.num_outputs()) {
+    return;
+  }
+
+  MuxOutputId output_id = graph.output_id(graph.outputs()[0]);
+  mux_memory_bits_[mux].reserve(graph.num_inputs() * graph.num_memory_bits());
+  for (size_t input = 0; input < graph.num_inputs(); ++input) {
+    vtr::vector<MuxMemId, bool> mem_bits = graph.decode_memory_bits(MuxInputId(input), output_id);
+    mux_memory_bits_[mux].insert(mux_memory_bits_[mux].end(), mem_bits.begin(), mem_bits.end());
+  }
+}
+
 } /* end namespace openfpga */
@@ -32,6 +32,8 @@ class MuxLibrary {
     CircuitModelId mux_circuit_model(const MuxId& mux_id) const;
     /* Find the mux sizes */
     size_t max_mux_size() const;
+    /* Get the memory bits which propagate an input to the output of a MUX */
+    vtr::vector<MuxMemId, bool> mux_memory_bits(const MuxId& mux_id, const MuxInputId& input_id) const;
   public:  /* Public mutators */
     /* Add a mux to the library */
     void add_mux(const CircuitLibrary& circuit_lib, const CircuitModelId& circuit_model, const size_t& mux_size); 
@@ -45,12 +47,20 @@ class MuxLibrary {
     void build_mux_lookup();
     /* Invalidate (empty) the mux fast lookup*/
     void invalidate_mux_lookup();
+    /* Decode the memory bits of each input of a mux */
+    void build_mux_memory_bits(const MuxId& mux);
   private:  /* Internal data */
     /* MUX graph-based desription */
     vtr::vector<MuxId, MuxId> mux_ids_; /* Unique identifier for each mux graph */
     vtr::vector<MuxId, MuxGraph> mux_graphs_; /* Graphs describing MUX internal structures */
     vtr::vector<MuxId, CircuitModelId> mux_circuit_models_; /* circuit model id in circuit library */
 
+    /* Memory bits routing each input to the output of single-output MUXes, 
+     * which are packed as [input_id][mem_id]
+     * Empty for the MUXes with multiple outputs
+     */
+    vtr::vector<MuxId, std::vector<bool>> mux_memory_bits_;
+
     /* Local encoder description */
     //vtr::vector<MuxLocalDecoderId, Decoder> mux_local_encoders_; /* Graphs describing MUX internal structures */
 
@@ -15,6 +15,7 @@
 #include "lb_router.h"
 #include "lb_router_utils.h"
 #include "physical_pb_utils.h"
+#include "openfpga_parallel_utils.h"
 #include "repack.h"
 
 /* begin namespace openfpga */
@@ -535,15 +536,24 @@ void add_lb_router_nets(LbRouter& lb_router,
  * - Create nets to be routed, including the source nodes and terminals
  *   This should consider the net remapping in the clustering_annotation 
  * - Run the router to finish the repacking
- * - Output routing results to data structure PhysicalPb and store it in clustering annotation
+ * - Output routing results to data structure PhysicalPb
+ *
+ * Each clustered block has its own router and physical pb, 
+ * while the clustering annotation is only read, 
+ * so that clustered blocks can be repacked by multiple threads
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the clustered block can not be routed in the physical mode
  ***************************************************************************************/
 static 
-void repack_cluster(const AtomContext& atom_ctx,
-                    const ClusteringContext& clustering_ctx,
-                    const VprDeviceAnnotation& device_annotation,
-                    VprClusteringAnnotation& clustering_annotation,
-                    const ClusterBlockId& block_id,
-                    const bool& verbose) {
+int repack_cluster(const AtomContext& atom_ctx,
+                   const ClusteringContext& clustering_ctx,
+                   const VprDeviceAnnotation& device_annotation,
+                   const VprClusteringAnnotation& clustering_annotation,
+                   const ClusterBlockId& block_id,
+                   PhysicalPb& phy_pb,
+                   const bool& verbose) {
   /* Get the pb graph that current clustered block is mapped to */
   t_logical_block_type_ptr lb_type = clustering_ctx.clb_nlist.block_type(block_id);
   t_pb_graph_node* pb_graph_head = lb_type->pb_graph_head;
@@ -553,16 +563,16 @@ void repack_cluster(const AtomContext& atom_ctx,
   const LbRRGraph& lb_rr_graph = device_annotation.physical_lb_rr_graph(pb_graph_head);
   VTR_ASSERT(!lb_rr_graph.empty());
 
-  VTR_LOG("Repack clustered block '%s'...",
-          clustering_ctx.clb_nlist.block_name(block_id).c_str());
-  VTR_LOGV(verbose, "\n");
+  VTR_LOGV(verbose,
+           "Repack clustered block '%s'...\n",
+           clustering_ctx.clb_nlist.block_name(block_id).c_str());
 
   /* Initialize the router */
   LbRouter lb_router(lb_rr_graph, lb_type);
 
   /* Add nets to be routed with source and terminals */
   add_lb_router_nets(lb_router, lb_type, lb_rr_graph, atom_ctx, device_annotation,
-                     clustering_ctx, const_cast<const VprClusteringAnnotation&>(clustering_annotation),
+                     clustering_ctx, clustering_annotation,
                      block_id, verbose);
 
   /* Initialize the modes to expand routing trees with the physical modes in device annotation
@@ -574,14 +584,13 @@ void repack_cluster(const AtomContext& atom_ctx,
   bool route_success = lb_router.try_route(lb_rr_graph, atom_ctx.nlist, verbose);
 
   if (false == route_success) {
-    VTR_LOGV(verbose, "Reroute failed\n");
-    exit(1);
+    VTR_LOG_ERROR("Repack clustered block '%s' failed: reroute failed\n",
+                  clustering_ctx.clb_nlist.block_name(block_id).c_str());
+    return 1;
   }
-  VTR_ASSERT(true == route_success);
   VTR_LOGV(verbose, "Reroute succeed\n");
 
   /* Annotate routing results to physical pb */
-  PhysicalPb phy_pb;
   alloc_physical_pb_from_pb_graph(phy_pb, pb_graph_head, device_annotation);
   rec_update_physical_pb_from_operating_pb(phy_pb,
                                            clustering_ctx.clb_nlist.block_pb(block_id),
@@ -593,28 +602,53 @@ void repack_cluster(const AtomContext& atom_ctx,
   save_lb_router_results_to_physical_pb(phy_pb, lb_router, lb_rr_graph);
   VTR_LOGV(verbose, "Saved results in physical pb\n");
 
-  /* Add the pb to clustering context */
-  clustering_annotation.add_physical_pb(block_id, phy_pb);
+  /* Log in a single message, which is not interleaved with other threads */
+  VTR_LOG("Repack clustered block '%s'...Done\n",
+          clustering_ctx.clb_nlist.block_name(block_id).c_str());
 
-  VTR_LOG("Done\n");
+  return 0;
 }
 
 /***************************************************************************************
  * Repack each clustered blocks in the clustering context
+ * Each clustered block is a task, whose physical pb is added 
+ * to the clustering annotation in the order of clustered blocks 
+ * after all the blocks are repacked
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if any clustered block fails
  ***************************************************************************************/
 static 
-void repack_clusters(const AtomContext& atom_ctx,
-                     const ClusteringContext& clustering_ctx,
-                     const VprDeviceAnnotation& device_annotation,
-                     VprClusteringAnnotation& clustering_annotation,
-                     const bool& verbose) {
+int repack_clusters(const AtomContext& atom_ctx,
+                    const ClusteringContext& clustering_ctx,
+                    const VprDeviceAnnotation& device_annotation,
+                    VprClusteringAnnotation& clustering_annotation,
+                    const ThreadPool& thread_pool,
+                    const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Repack clustered blocks to physical implementation of logical tile");
 
-  for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
-    repack_cluster(atom_ctx, clustering_ctx, 
-                   device_annotation, clustering_annotation, 
-                   blk_id, verbose);
+  std::vector<ClusterBlockId> blocks = collect_clustered_netlist_blocks(clustering_ctx.clb_nlist);
+  std::vector<PhysicalPb> task_physical_pbs(blocks.size());
+  std::vector<int> task_status(blocks.size(), 0);
+
+  parallel_for_clusters(thread_pool, clustering_ctx.clb_nlist,
+                        [&](const size_t& itask, const ClusterBlockId& blk_id) {
+    task_status[itask] = repack_cluster(atom_ctx, clustering_ctx, 
+                                        device_annotation, 
+                                        const_cast<const VprClusteringAnnotation&>(clustering_annotation), 
+                                        blk_id, task_physical_pbs[itask], verbose);
+  });
+
+  for (size_t itask = 0; itask < blocks.size(); ++itask) {
+    if (0 != task_status[itask]) {
+      return 1;
+    }
+    /* Add the pb to clustering context */
+    clustering_annotation.add_physical_pb(blocks[itask], task_physical_pbs[itask]);
   }
+
+  return 0;
 }
 
 /***************************************************************************************
@@ -626,13 +660,19 @@ void repack_clusters(const AtomContext& atom_ctx,
  *    to physical modes of pb_graph
  *  - rerun the routing for each clustered block
  *  - store the packing results to clustering annotation
+ * The clustered blocks are rerouted by the threads of the pool
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if any clustered block can not be repacked
  ***************************************************************************************/
-void pack_physical_pbs(const DeviceContext& device_ctx,
-                       const AtomContext& atom_ctx,
-                       const ClusteringContext& clustering_ctx,
-                       VprDeviceAnnotation& device_annotation,
-                       VprClusteringAnnotation& clustering_annotation,
-                       const bool& verbose) {
+int pack_physical_pbs(const DeviceContext& device_ctx,
+                      const AtomContext& atom_ctx,
+                      const ClusteringContext& clustering_ctx,
+                      VprDeviceAnnotation& device_annotation,
+                      VprClusteringAnnotation& clustering_annotation,
+                      const ThreadPool& thread_pool,
+                      const bool& verbose) {
 
   /* build the routing resource graph for each logical tile */
   build_physical_lb_rr_graphs(device_ctx,
@@ -640,9 +680,10 @@ void pack_physical_pbs(const DeviceContext& device_ctx,
                               verbose);
 
   /* Call the LbRouter to re-pack each clustered block to physical implementation */ 
-  repack_clusters(atom_ctx, clustering_ctx, 
-                  const_cast<const VprDeviceAnnotation&>(device_annotation), clustering_annotation, 
-                  verbose);
+  return repack_clusters(atom_ctx, clustering_ctx, 
+                         const_cast<const VprDeviceAnnotation&>(device_annotation), clustering_annotation, 
+                         thread_pool,
+                         verbose);
 }
 
 } /* end namespace openfpga */
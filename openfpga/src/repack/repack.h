@@ -8,6 +8,7 @@
 #include "vpr_device_annotation.h"
 #include "vpr_clustering_annotation.h"
 #include "vpr_routing_annotation.h"
+#include "openfpga_thread_pool.h"
 
 /********************************************************************
  * Function declaration
@@ -16,12 +17,13 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
-void pack_physical_pbs(const DeviceContext& device_ctx,
-                       const AtomContext& atom_ctx,
-                       const ClusteringContext& clustering_ctx,
-                       VprDeviceAnnotation& device_annotation,
-                       VprClusteringAnnotation& clustering_annotation,
-                       const bool& verbose);
+int pack_physical_pbs(const DeviceContext& device_ctx,
+                      const AtomContext& atom_ctx,
+                      const ClusteringContext& clustering_ctx,
+                      VprDeviceAnnotation& device_annotation,
+                      VprClusteringAnnotation& clustering_annotation,
+                      const ThreadPool& thread_pool,
+                      const bool& verbose);
 
 } /* end namespace openfpga */
 
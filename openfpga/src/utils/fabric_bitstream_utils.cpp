@@ -238,4 +238,238 @@ size_t find_memory_bank_fast_configuration_fabric_bitstream_size(const FabricBit
   return num_bits;
 }
 
+/********************************************************************
+ * Decide if we should use reset or set signal to acheive fast configuration
+ * - If only one type signal is specified, we use that type
+ *   For example, only reset signal is defined, we will use reset  
+ * - If both are defined, pick the one that will bring bigger reduction
+ *   i.e., larger number of configuration bits can be skipped
+ *******************************************************************/
+bool find_bit_value_to_skip_for_fast_configuration(const e_config_protocol_type& config_protocol_type,  
+                                                   const bool& fast_configuration,
+                                                   const std::vector<FabricGlobalPortId>& global_prog_reset_ports,
+                                                   const std::vector<FabricGlobalPortId>& global_prog_set_ports,
+                                                   const BitstreamManager& bitstream_manager,
+                                                   const FabricBitstream& fabric_bitstream,
+                                                   const bool& verbose) {
+
+  /* Early exit conditions */
+  if (!global_prog_reset_ports.empty() && global_prog_set_ports.empty()) {
+    return false; 
+  } else if (!global_prog_set_ports.empty() && global_prog_reset_ports.empty()) {
+    return true; 
+  } else if (global_prog_set_ports.empty() && global_prog_reset_ports.empty()) {
+    /* If both types of ports are not defined, the fast configuration should be turned off */
+    VTR_ASSERT(false == fast_configuration); 
+    return false;
+  }
+
+  VTR_ASSERT(!global_prog_set_ports.empty() && !global_prog_reset_ports.empty());
+  bool bit_value_to_skip = false;
+
+  VTR_LOGV(verbose, "Both reset and set ports are defined for programming controls, selecting the best-fit one...\n");
+
+  size_t num_ones_to_skip = 0;
+  size_t num_zeros_to_skip = 0;
+
+  /* Branch on the type of configuration protocol */
+  switch (config_protocol_type) {
+  case CONFIG_MEM_STANDALONE:
+    break;
+  case CONFIG_MEM_SCAN_CHAIN: {
+    /* We can only skip the ones/zeros at the beginning of the bitstream */
+    /* Count how many logic '1' bits we can skip */
+    for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
+      if (false == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
+        break;
+      }
+      VTR_ASSERT(true == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id)));
+      num_ones_to_skip++;
+    }
+    /* Count how many logic '0' bits we can skip */
+    for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
+      if (true == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
+        break;
+      }
+      VTR_ASSERT(false == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id)));
+      num_zeros_to_skip++;
+    }
+    break;
+  }
+  case CONFIG_MEM_MEMORY_BANK:
+  case CONFIG_MEM_FRAME_BASED: {
+    /* Count how many logic '1' and logic '0' bits we can skip */
+    for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
+      if (false == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
+        num_zeros_to_skip++;
+      } else {
+        VTR_ASSERT(true == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id)));
+        num_ones_to_skip++;
+      }
+    }
+    break;
+  }
+  default:
+    VTR_LOGF_ERROR(__FILE__, __LINE__,
+                   "Invalid SRAM organization type!\n");
+    exit(1);
+  }
+
+  VTR_LOGV(verbose, "Using reset will skip %g% (%lu/%lu) of configuration bitstream.\n",
+           100. * (float) num_zeros_to_skip / (float) fabric_bitstream.num_bits(),
+           num_zeros_to_skip, fabric_bitstream.num_bits());
+
+  VTR_LOGV(verbose, "Using set will skip %g% (%lu/%lu) of configuration bitstream.\n",
+           100. * (float) num_ones_to_skip / (float) fabric_bitstream.num_bits(),
+           num_ones_to_skip, fabric_bitstream.num_bits());
+
+  /* By default, we prefer to skip zeros (when the numbers are the same */
+  if (num_ones_to_skip > num_zeros_to_skip) {
+    VTR_LOGV(verbose, "Will use set signal in fast configuration\n");
+    bit_value_to_skip = true;
+  } else {
+    VTR_LOGV(verbose, "Will use reset signal in fast configuration\n");
+  }
+
+  return bit_value_to_skip;
+}
+
+/********************************************************************
+ * Count the number of configuration clock cycles required
+ * to load a fabric bitstream, which is exactly what the full testbench applies
+ * - The first clock cycle is always spent to reset everything
+ * - Configuration chain: the longest regional bitstream is loaded bit by bit.
+ *   For fast configuration, the leading bits which can be skipped
+ *   in all the regions are not loaded
+ * - Memory bank and frame-based: each address (shared by all the regions)
+ *   costs one clock cycle. For fast configuration, the addresses whose
+ *   data inputs of all the regions match the value to skip are not loaded
+ * - Standalone: all the configuration bits are loaded in one clock cycle
+ *******************************************************************/
+size_t find_fabric_num_config_clock_cycles(const e_config_protocol_type& config_protocol_type,
+                                           const bool& fast_configuration,
+                                           const bool& bit_value_to_skip,
+                                           const BitstreamManager& bitstream_manager,
+                                           const FabricBitstream& fabric_bitstream) {
+  size_t num_config_clock_cycles = 0;
+
+  switch (config_protocol_type) {
+  case CONFIG_MEM_STANDALONE:
+    num_config_clock_cycles = 1;
+    break;
+  case CONFIG_MEM_SCAN_CHAIN:
+    num_config_clock_cycles = find_fabric_regional_bitstream_max_size(fabric_bitstream);
+    if (true == fast_configuration) {
+      num_config_clock_cycles -= find_configuration_chain_fabric_bitstream_size_to_be_skipped(fabric_bitstream, bitstream_manager, bit_value_to_skip);
+    }
+    break;
+  case CONFIG_MEM_MEMORY_BANK:
+    if (true == fast_configuration) {
+      num_config_clock_cycles = find_memory_bank_fast_configuration_fabric_bitstream_size(fabric_bitstream, bit_value_to_skip);
+    } else {
+      num_config_clock_cycles = build_memory_bank_fabric_bitstream_by_address(fabric_bitstream).size();
+    }
+    break;
+  case CONFIG_MEM_FRAME_BASED:
+    if (true == fast_configuration) {
+      num_config_clock_cycles = find_frame_based_fast_configuration_fabric_bitstream_size(fabric_bitstream, bit_value_to_skip);
+    } else {
+      num_config_clock_cycles = build_frame_based_fabric_bitstream_by_address(fabric_bitstream).size();
+    }
+    break;
+  default:
+    VTR_LOGF_ERROR(__FILE__, __LINE__,
+                   "Invalid SRAM organization type!\n");
+    exit(1);
+  }
+
+  /* Reset cycle */
+  return 1 + num_config_clock_cycles;
+}
+
+/********************************************************************
+ * Count the number of configuration clock cycles that each region
+ * would require if it was loaded alone, excluding the reset cycle.
+ * This is the workload of each region, which indicates how well
+ * the configuration bits are balanced among the regions.
+ * Note that the configuration time of the whole fabric is not
+ * the maximum of the regional numbers for memory bank and frame-based protocols,
+ * since a clock cycle can be skipped only when all the regions agree.
+ * Use find_fabric_num_config_clock_cycles() to get the exact number.
+ *******************************************************************/
+std::vector<size_t> find_fabric_regional_num_config_clock_cycles(const e_config_protocol_type& config_protocol_type,
+                                                                 const bool& fast_configuration,
+                                                                 const bool& bit_value_to_skip,
+                                                                 const BitstreamManager& bitstream_manager,
+                                                                 const FabricBitstream& fabric_bitstream) {
+  std::vector<size_t> regional_num_config_clock_cycles(fabric_bitstream.regions().size(), 0);
+
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    size_t& num_config_clock_cycles = regional_num_config_clock_cycles[size_t(region)];
+
+    switch (config_protocol_type) {
+    case CONFIG_MEM_STANDALONE:
+      num_config_clock_cycles = 1;
+      break;
+    case CONFIG_MEM_SCAN_CHAIN: {
+      num_config_clock_cycles = fabric_bitstream.region_bits(region).size();
+      if (false == fast_configuration) {
+        break;
+      }
+      /* Skip the leading bits which match the value to skip */
+      for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
+        if (bit_value_to_skip != bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
+          break;
+        }
+        num_config_clock_cycles--;
+      }
+      break;
+    }
+    case CONFIG_MEM_MEMORY_BANK:
+    case CONFIG_MEM_FRAME_BASED: {
+      /* The last bit written to an address wins, as in the full fabric bitstream */
+      std::map<std::string, bool> region_bits_by_addr;
+      for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
+        std::vector<std::string> addr_strs;
+        if (CONFIG_MEM_MEMORY_BANK == config_protocol_type) {
+          std::string addr_str;
+          for (const char& addr_bit : fabric_bitstream.bit_bl_address(bit_id)) {
+            addr_str.push_back(addr_bit);
+          }
+          addr_str.push_back(' ');
+          for (const char& addr_bit : fabric_bitstream.bit_wl_address(bit_id)) {
+            addr_str.push_back(addr_bit);
+          }
+          addr_strs.push_back(addr_str);
+        } else {
+          std::string addr_str;
+          for (const char& addr_bit : fabric_bitstream.bit_address(bit_id)) {
+            addr_str.push_back(addr_bit);
+          }
+          addr_strs = expand_dont_care_bin_str(addr_str);
+        }
+        for (const std::string& addr_str : addr_strs) {
+          region_bits_by_addr[addr_str] = fabric_bitstream.bit_din(bit_id);
+        }
+      }
+
+      for (const auto& addr_din_pair : region_bits_by_addr) {
+        if ( (true == fast_configuration)
+          && (bit_value_to_skip == addr_din_pair.second)) {
+          continue;
+        }
+        num_config_clock_cycles++;
+      }
+      break;
+    }
+    default:
+      VTR_LOGF_ERROR(__FILE__, __LINE__,
+                     "Invalid SRAM organization type!\n");
+      exit(1);
+    }
+  }
+
+  return regional_num_config_clock_cycles;
+}
+
 } /* end namespace openfpga */
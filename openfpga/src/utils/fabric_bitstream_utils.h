@@ -11,6 +11,8 @@
 #include <map>
 #include "bitstream_manager.h"
 #include "fabric_bitstream.h"
+#include "circuit_types.h"
+#include "fabric_global_port_info.h"
 
 /********************************************************************
  * Function declaration
@@ -35,6 +37,26 @@ std::map<std::pair<std::string, std::string>, std::vector<bool>> build_memory_ba
 size_t find_memory_bank_fast_configuration_fabric_bitstream_size(const FabricBitstream& fabric_bitstream,
                                                                  const bool& bit_value_to_skip);
 
+bool find_bit_value_to_skip_for_fast_configuration(const e_config_protocol_type& config_protocol_type,
+                                                   const bool& fast_configuration,
+                                                   const std::vector<FabricGlobalPortId>& global_prog_reset_ports,
+                                                   const std::vector<FabricGlobalPortId>& global_prog_set_ports,
+                                                   const BitstreamManager& bitstream_manager,
+                                                   const FabricBitstream& fabric_bitstream,
+                                                   const bool& verbose);
+
+size_t find_fabric_num_config_clock_cycles(const e_config_protocol_type& config_protocol_type,
+                                           const bool& fast_configuration,
+                                           const bool& bit_value_to_skip,
+                                           const BitstreamManager& bitstream_manager,
+                                           const FabricBitstream& fabric_bitstream);
+
+std::vector<size_t> find_fabric_regional_num_config_clock_cycles(const e_config_protocol_type& config_protocol_type,
+                                                                 const bool& fast_configuration,
+                                                                 const bool& bit_value_to_skip,
+                                                                 const BitstreamManager& bitstream_manager,
+                                                                 const FabricBitstream& fabric_bitstream);
+
 } /* end namespace openfpga */
 
 #endif
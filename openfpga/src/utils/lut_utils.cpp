@@ -2,7 +2,8 @@
  * This file includes most utilized functions to manipulate LUTs, 
  * especially their truth tables, in the OpenFPGA context
  *******************************************************************/
-#include <cmath>
+#include <cstdint>
+#include <algorithm>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -53,11 +54,13 @@ namespace openfpga {
 AtomNetlist::TruthTable lut_truth_table_adaption(const AtomNetlist::TruthTable& orig_tt, 
                                                  const std::vector<int>& rotated_pin_map) {
   AtomNetlist::TruthTable tt;
+  tt.reserve(orig_tt.size());
 
-  for (auto row : orig_tt) {
+  for (const std::vector<vtr::LogicValue>& row : orig_tt) {
     VTR_ASSERT(row.size() - 1 <= rotated_pin_map.size());
 
     std::vector<vtr::LogicValue> tt_line;
+    tt_line.reserve(rotated_pin_map.size() + 1);
     /* We do not care about the last digit, which is the output value */
     for (size_t i = 0; i < rotated_pin_map.size(); ++i) {
       if (-1 == rotated_pin_map[i]) {
@@ -71,7 +74,7 @@ AtomNetlist::TruthTable lut_truth_table_adaption(const AtomNetlist::TruthTable&
 
     /* Do not miss the last digit in the final result */
     tt_line.push_back(row.back());
-    tt.push_back(tt_line);
+    tt.push_back(std::move(tt_line));
   }
 
   return tt;
@@ -82,7 +85,7 @@ AtomNetlist::TruthTable lut_truth_table_adaption(const AtomNetlist::TruthTable&
  *******************************************************************/
 std::vector<std::string> truth_table_to_string(const AtomNetlist::TruthTable& tt) { 
   std::vector<std::string> tt_str;
-  for (auto row : tt) {
+  for (const std::vector<vtr::LogicValue>& row : tt) {
     std::string row_str;
     for (size_t i = 0; i < row.size(); ++i) {
       /* Add a gap between inputs and outputs */
@@ -189,6 +192,7 @@ AtomNetlist::TruthTable adapt_truth_table_for_frac_lut(const size_t& lut_frac_le
   }
 
   AtomNetlist::TruthTable adapt_truth_table;
+  adapt_truth_table.reserve(truth_table.size());
 
   /* Apply modification to the truth table */
   for (const std::vector<vtr::LogicValue>& tt_line : truth_table) {
@@ -205,7 +209,7 @@ AtomNetlist::TruthTable adapt_truth_table_for_frac_lut(const size_t& lut_frac_le
     }
     /* Modify bits starting from lut_frac_level */
     /* Decode the lut_output_mask to LUT input codes */ 
-    int temp = pow(2., num_mask_bits) - 1 - lut_output_mask;
+    int temp = (1 << num_mask_bits) - 1 - lut_output_mask;
     VTR_ASSERT(0 <= temp);
     std::vector<size_t> mask_bits_vec = itobin_vec(temp, num_mask_bits);
     /* Copy the bits to the truth table line */
@@ -264,115 +268,110 @@ bool lut_truth_table_use_on_set(const AtomNetlist::TruthTable& truth_table) {
 }
 
 /********************************************************************
- * Complete a line in truth table with a given lut size
+ * Number of LUT inputs whose minterms are packed in a 64-bit word
+ *******************************************************************/
+constexpr size_t LUT_WORD_NUM_INPUTS = 6;
+constexpr size_t LUT_WORD_SIZE = 64;
+
+/********************************************************************
+ * Masks of the minterms in a 64-bit word where an input of a LUT is '1'.
+ * The index of a minterm is the index of the SRAM bit in a LUT
+ *******************************************************************/
+static const uint64_t LUT_WORD_INPUT_MASKS[LUT_WORD_NUM_INPUTS] = {
+  0xAAAAAAAAAAAAAAAAULL,
+  0xCCCCCCCCCCCCCCCCULL,
+  0xF0F0F0F0F0F0F0F0ULL,
+  0xFF00FF00FF00FF00ULL,
+  0xFFFF0000FFFF0000ULL,
+  0xFFFFFFFF00000000ULL
+};
+
+/********************************************************************
+ * Convert a line of truth table to a cube, which is represented by 
+ * - a care mask, where bit i is '1' if input i is not a don't care
+ * - a value, where bit i is '1' if input i is '0', 
+ *   as we assume the 1-lut pass sram1 when input = 0 
  * Due to the size of truth table may be less than the lut size.
  * i.e. in LUT-6 architecture, there exists LUT1-6 in technology-mapped netlists
- * So, in truth table line, there may be 10- 1
- * In this case, we should complete it by --10- 1
+ * The missing inputs are treated as don't cares, 
+ * i.e. 10- 1 is the same as --10- 1 
  *******************************************************************/
 static 
-std::vector<vtr::LogicValue> complete_truth_table_line(const size_t& lut_size,
-                                                       const std::vector<vtr::LogicValue>& tt_line) {
-  std::vector<vtr::LogicValue> ret;
-
+void build_truth_table_line_cube(const size_t& lut_size,
+                                 const std::vector<vtr::LogicValue>& tt_line,
+                                 size_t& care_mask,
+                                 size_t& value) {
   VTR_ASSERT(0 < tt_line.size());
 
-  /* Complete the truth table line*/
   size_t cover_len = tt_line.size() - 1; 
   VTR_ASSERT(cover_len <= lut_size);
 
-  /* Copy the original truth table line */ 
-  ret = tt_line;
-  /* Kick out the last value for now as it is the output value */
-  ret.pop_back();
-
-  /* Add the number of '-' we should add in the back !!! */
-  for (size_t j = cover_len; j < lut_size; ++j) {
-    ret.push_back(vtr::LogicValue::DONT_CARE);
-  }
-
-  /* Copy the original truth table line */ 
-  ret.push_back(tt_line.back());
-
-  /* Check if the size of ret matches our expectation */
-  VTR_ASSERT(lut_size + 1 == ret.size());
-  
-  return ret;
-}
-
-/********************************************************************
- * For each lut_bit_lines, we should recover the truth table,
- * and then set the sram bits to "1" if the truth table defines so.
- * Start_point: the position we start converting don't care sign '-'
- *              to explicit '0' or '1'
- *******************************************************************/
-static 
-void rec_build_lut_bitstream_per_line(std::vector<bool>& lut_bitstream, 
-                                      const size_t& lut_size,
-                                      const std::vector<vtr::LogicValue>& tt_line,
-                                      const size_t& start_point) {
-  std::vector<vtr::LogicValue> temp_line = tt_line;
-
-  /* Check the length of sram bits and truth table line */
-  VTR_ASSERT(lut_size + 1 == tt_line.size()); /* lut_size + '1|0' */
-
-  /* End of truth_table_line should be "space" and "1" */ 
-  VTR_ASSERT( (vtr::LogicValue::TRUE == tt_line.back())
-           || (vtr::LogicValue::FALSE == tt_line.back()) );
-
-  /* Make sure before start point there is no '-' */
-  VTR_ASSERT(start_point < tt_line.size());
-  for (size_t i = 0; i < start_point; ++i) {
-    VTR_ASSERT(vtr::LogicValue::DONT_CARE != tt_line[i]);
-  }
-
-  /* Configure sram bits recursively */
-  for (size_t i = start_point; i < lut_size; ++i) {
-    if (vtr::LogicValue::DONT_CARE == tt_line[i]) {
-      /* if we find a dont_care, we don't do configure now but recursively*/
-      /* '0' branch */
-      temp_line[i] = vtr::LogicValue::FALSE; 
-      rec_build_lut_bitstream_per_line(lut_bitstream, lut_size, temp_line, start_point + 1);
-      /* '1' branch */
-      temp_line[i] = vtr::LogicValue::TRUE; 
-      rec_build_lut_bitstream_per_line(lut_bitstream, lut_size, temp_line, start_point + 1);
-      return; 
-    }
-  }
-
-  /* TODO: Use MuxGraph to decode this!!! */
-  /* Decode bitstream only when there are only 0 or 1 in the truth table */
-  size_t sram_id = 0;
-  for (size_t i = 0; i < lut_size; ++i) {
-    /* Should be either '0' or '1' */
+  care_mask = 0;
+  value = 0;
+  for (size_t i = 0; i < cover_len; ++i) {
     switch (tt_line[i]) {
     case vtr::LogicValue::FALSE :
-      /* We assume the 1-lut pass sram1 when input = 0 */
-      sram_id += (size_t)pow(2., (double)(i));
+      care_mask |= (size_t(1) << i);
+      value |= (size_t(1) << i);
       break;
     case vtr::LogicValue::TRUE :
-      /* We assume the 1-lut pass sram0 when input = 1 */
+      care_mask |= (size_t(1) << i);
       break;
     case vtr::LogicValue::DONT_CARE :
+      break;
     default :
       VTR_LOGF_ERROR(__FILE__, __LINE__, 
-                     "Invalid truth_table bit '%s', should be [0|1|]!\n",
+                     "Invalid truth_table bit '%s', should be [0|1|-]!\n",
                      vtr::LOGIC_VALUE_STRING[size_t(tt_line[i])]); 
       exit(1);
     }
   }
-  /* Set the sram bit to '1'*/
-  VTR_ASSERT(sram_id < lut_bitstream.size());
-  if (vtr::LogicValue::TRUE == tt_line.back()) {
-    lut_bitstream[sram_id] = true; /* on set*/
-  } else if (vtr::LogicValue::FALSE == tt_line.back()) {
-    lut_bitstream[sram_id] = false; /* off set */
-  } else {
-    VTR_LOGF_ERROR(__FILE__, __LINE__, 
-                   "Invalid truth_table_line ending '%s'!\n",
-                   vtr::LOGIC_VALUE_STRING[size_t(tt_line.back())]);
-    exit(1);
+}
+
+/********************************************************************
+ * Set all the sram bits covered by a cube to a given value,
+ * i.e., the bits whose index satisfies (index & care_mask) == value
+ * The LUT sram bits are packed in 64-bit words:
+ * - the first 6 inputs select bits inside a word, 
+ *   which are updated at once using the input masks
+ * - the other inputs select words, where only the words 
+ *   matching the cube are visited
+ *******************************************************************/
+static 
+void apply_cube_to_lut_words(std::vector<uint64_t>& lut_words,
+                             const size_t& lut_size,
+                             const size_t& care_mask,
+                             const size_t& value,
+                             const bool& output_value) {
+  /* Find the bits covered by the cube inside a word */
+  uint64_t word_mask = ~uint64_t(0);
+  for (size_t i = 0; i < std::min(lut_size, LUT_WORD_NUM_INPUTS); ++i) {
+    if (0 == (care_mask & (size_t(1) << i))) {
+      continue;
+    }
+    if (0 != (value & (size_t(1) << i))) {
+      word_mask &= LUT_WORD_INPUT_MASKS[i];
+    } else {
+      word_mask &= ~LUT_WORD_INPUT_MASKS[i];
+    }
   }
+
+  /* Find the words covered by the cube */
+  size_t word_care_mask = care_mask >> LUT_WORD_NUM_INPUTS;
+  size_t word_value = value >> LUT_WORD_NUM_INPUTS;
+  size_t word_free_mask = (lut_words.size() - 1) & ~word_care_mask;
+
+  /* Enumerate all the subsets of free inputs */
+  size_t free_bits = 0;
+  do {
+    uint64_t& word = lut_words[word_value | free_bits];
+    if (true == output_value) {
+      word |= word_mask;
+    } else {
+      word &= ~word_mask;
+    }
+    free_bits = (free_bits - word_free_mask) & word_free_mask;
+  } while (0 != free_bits);
 }
 
 /********************************************************************
@@ -387,8 +386,9 @@ std::vector<bool> build_single_output_lut_bitstream(const AtomNetlist::TruthTabl
                                                     const size_t& default_sram_bit_value) {
   size_t lut_size = lut_mux_graph.num_memory_bits();
   size_t bitstream_size = lut_mux_graph.num_inputs();
-  std::vector<bool> lut_bitstream(bitstream_size, false);
-  AtomNetlist::TruthTable completed_truth_table;
+  /* Each input of the LUT multiplexer is a minterm of the LUT inputs */
+  VTR_ASSERT(lut_size < sizeof(size_t) * 8);
+  VTR_ASSERT(bitstream_size == (size_t(1) << lut_size));
   bool on_set = false;
   bool off_set = false;
 
@@ -414,24 +414,37 @@ std::vector<bool> build_single_output_lut_bitstream(const AtomNetlist::TruthTabl
     off_set = !on_set;
   }
 
+  /* Initial all the bits in the bitstream 
+   * By default, the lut_bitstream is initialize for on_set
+   * For off set, it should be flipped
+   */
+  size_t num_words = (bitstream_size + LUT_WORD_SIZE - 1) / LUT_WORD_SIZE;
+  std::vector<uint64_t> lut_words(num_words, true == off_set ? ~uint64_t(0) : uint64_t(0));
+
   /* Read in truth table lines, decode one by one */
   for (const std::vector<vtr::LogicValue>& tt_line : truth_table) {
-    /* Complete the truth table line by line*/
-    completed_truth_table.push_back(complete_truth_table_line(lut_size, tt_line));
-  }
+    bool output_value = false;
+    if (vtr::LogicValue::TRUE == tt_line.back()) {
+      output_value = true; /* on set*/
+    } else if (vtr::LogicValue::FALSE == tt_line.back()) {
+      output_value = false; /* off set */
+    } else {
+      VTR_LOGF_ERROR(__FILE__, __LINE__, 
+                     "Invalid truth_table_line ending '%s'!\n",
+                     vtr::LOGIC_VALUE_STRING[size_t(tt_line.back())]);
+      exit(1);
+    }
 
-  /* Initial all the bits in the bitstream */
-  if (true == off_set) {
-    /* By default, the lut_bitstream is initialize for on_set
-     * For off set, it should be flipped
-     */
-    lut_bitstream.clear(); 
-    lut_bitstream.resize(bitstream_size, true);
+    size_t care_mask = 0;
+    size_t value = 0;
+    build_truth_table_line_cube(lut_size, tt_line, care_mask, value);
+    apply_cube_to_lut_words(lut_words, lut_size, care_mask, value, output_value);
   }
 
-  for (const std::vector<vtr::LogicValue>& tt_line : completed_truth_table) {
-    /* Update the truth table, sram_bits */
-    rec_build_lut_bitstream_per_line(lut_bitstream, lut_size, tt_line, 0);
+  /* Unpack the words to the bitstream */
+  std::vector<bool> lut_bitstream(bitstream_size, false);
+  for (size_t ibit = 0; ibit < bitstream_size; ++ibit) {
+    lut_bitstream[ibit] = (0 != ((lut_words[ibit / LUT_WORD_SIZE] >> (ibit % LUT_WORD_SIZE)) & uint64_t(1)));
   }
 
   return lut_bitstream;
@@ -451,7 +464,7 @@ std::vector<bool> build_frac_lut_bitstream(const CircuitLibrary& circuit_lib,
   /* Initialization */
   std::vector<bool> lut_bitstream(lut_mux_graph.num_inputs(), default_sram_bit_value);
 
-  for (const std::pair<const t_pb_graph_pin*, AtomNetlist::TruthTable>& element : truth_tables) {
+  for (const auto& element : truth_tables) {
     /* Find the corresponding circuit model output port and assoicated lut_output_mask */
     CircuitPortId lut_model_output_port = device_annotation.pb_circuit_port(element.first->port);
     size_t lut_frac_level = circuit_lib.port_lut_frac_level(lut_model_output_port);
@@ -467,7 +480,7 @@ std::vector<bool> build_frac_lut_bitstream(const CircuitLibrary& circuit_lib,
     std::vector<bool> temp_bitstream = build_single_output_lut_bitstream(element.second, lut_mux_graph, default_sram_bit_value); 
 
     /* Depending on the frac-level, we get the location(starting/end points) of sram bits */
-    size_t length_of_temp_bitstream_to_copy = (size_t)pow(2., (double)(lut_frac_level)); 
+    size_t length_of_temp_bitstream_to_copy = size_t(1) << lut_frac_level; 
     size_t bitstream_offset = length_of_temp_bitstream_to_copy * lut_output_mask; 
     /* Ensure the offset is in range */        
     VTR_ASSERT(bitstream_offset < lut_bitstream.size());
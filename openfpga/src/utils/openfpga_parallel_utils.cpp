@@ -0,0 +1,62 @@
+/********************************************************************
+ * This file includes functions to collect the objects of OpenFPGA
+ * in a fixed order, on which parallel loops are executed
+ *******************************************************************/
+#include "openfpga_parallel_utils.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Collect the coordinates of all the grids, column by column
+ *******************************************************************/
+std::vector<vtr::Point<size_t>> collect_device_grid_coordinates(const DeviceGrid& grids) {
+  std::vector<vtr::Point<size_t>> coordinates;
+  coordinates.reserve(grids.width() * grids.height());
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      coordinates.push_back(vtr::Point<size_t>(ix, iy));
+    }
+  }
+  return coordinates;
+}
+
+/********************************************************************
+ * Collect the coordinates of all the GSBs, column by column,
+ * which is the same order as the routing blocks are added to the top-level module
+ *******************************************************************/
+std::vector<vtr::Point<size_t>> collect_device_rr_gsb_coordinates(const DeviceRRGSB& device_rr_gsb) {
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  std::vector<vtr::Point<size_t>> coordinates;
+  coordinates.reserve(gsb_range.x() * gsb_range.y());
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      coordinates.push_back(vtr::Point<size_t>(ix, iy));
+    }
+  }
+  return coordinates;
+}
+
+/********************************************************************
+ * Collect all the modules in the order of their ids
+ *******************************************************************/
+std::vector<ModuleId> collect_module_manager_modules(const ModuleManager& module_manager) {
+  std::vector<ModuleId> modules;
+  for (const ModuleId& module : module_manager.modules()) {
+    modules.push_back(module);
+  }
+  return modules;
+}
+
+/********************************************************************
+ * Collect all the clusters in the order of their ids
+ *******************************************************************/
+std::vector<ClusterBlockId> collect_clustered_netlist_blocks(const ClusteredNetlist& clustered_netlist) {
+  std::vector<ClusterBlockId> clusters;
+  for (const ClusterBlockId& cluster : clustered_netlist.blocks()) {
+    clusters.push_back(cluster);
+  }
+  return clusters;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,85 @@
+#ifndef OPENFPGA_PARALLEL_UTILS_H
+#define OPENFPGA_PARALLEL_UTILS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <vector>
+#include "vtr_geometry.h"
+#include "device_grid.h"
+#include "clustered_netlist.h"
+#include "device_rr_gsb.h"
+#include "module_manager.h"
+#include "openfpga_thread_pool.h"
+
+/********************************************************************
+ * Helpers to run parallel loops on the shared thread pool over the
+ * common objects of OpenFPGA, i.e., grids, GSBs, modules and clusters.
+ *
+ * The objects are always collected in the same order, which is
+ * the order of a loop in a single thread. The function is called
+ * with the index of the task and the object, e.g., 
+ *   func(itask, coordinate) or func(itask, cluster)
+ * A task should only write to the data owned by its object or 
+ * its index, e.g., an element of a vector indexed by the task,
+ * so that the results are identical whatever the number of threads is.
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+std::vector<vtr::Point<size_t>> collect_device_grid_coordinates(const DeviceGrid& grids);
+
+std::vector<vtr::Point<size_t>> collect_device_rr_gsb_coordinates(const DeviceRRGSB& device_rr_gsb);
+
+std::vector<ModuleId> collect_module_manager_modules(const ModuleManager& module_manager);
+
+std::vector<ClusterBlockId> collect_clustered_netlist_blocks(const ClusteredNetlist& clustered_netlist);
+
+/* Run a function on the coordinate of each grid, including the empty grids */
+template<typename Func>
+void parallel_for_device_grids(const ThreadPool& thread_pool,
+                               const DeviceGrid& grids,
+                               const Func& func) {
+  std::vector<vtr::Point<size_t>> coordinates = collect_device_grid_coordinates(grids);
+  thread_pool.parallel_for(coordinates.size(), [&](const size_t& itask) {
+    func(itask, coordinates[itask]);
+  });
+}
+
+/* Run a function on the coordinate of each GSB */
+template<typename Func>
+void parallel_for_device_rr_gsbs(const ThreadPool& thread_pool,
+                                 const DeviceRRGSB& device_rr_gsb,
+                                 const Func& func) {
+  std::vector<vtr::Point<size_t>> coordinates = collect_device_rr_gsb_coordinates(device_rr_gsb);
+  thread_pool.parallel_for(coordinates.size(), [&](const size_t& itask) {
+    func(itask, coordinates[itask]);
+  });
+}
+
+/* Run a function on each module of a module graph */
+template<typename Func>
+void parallel_for_modules(const ThreadPool& thread_pool,
+                          const ModuleManager& module_manager,
+                          const Func& func) {
+  std::vector<ModuleId> modules = collect_module_manager_modules(module_manager);
+  thread_pool.parallel_for(modules.size(), [&](const size_t& itask) {
+    func(itask, modules[itask]);
+  });
+}
+
+/* Run a function on each cluster of a clustered netlist */
+template<typename Func>
+void parallel_for_clusters(const ThreadPool& thread_pool,
+                           const ClusteredNetlist& clustered_netlist,
+                           const Func& func) {
+  std::vector<ClusterBlockId> clusters = collect_clustered_netlist_blocks(clustered_netlist);
+  thread_pool.parallel_for(clusters.size(), [&](const size_t& itask) {
+    func(itask, clusters[itask]);
+  });
+}
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,157 @@
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+# Script Name   : check_xml_fabric_bitstream.py
+# Description   : This script checks the fabric bitstream files in XML format
+#                 written by 'write_fabric_bitstream --format xml'
+#                 - The file written with default options should follow
+#                   exactly the original format, line by line
+#                 - The files written with '--group_by_block' and/or
+#                   '--compress gzip' should include the same bits
+# Args          : python3 check_xml_fabric_bitstream.py --help
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+import re
+import sys
+import gzip
+import argparse
+
+if sys.version_info[0] < 3:
+    raise Exception("check_xml_fabric_bitstream script must be using Python 3")
+
+parser = argparse.ArgumentParser(
+    description="Check fabric bitstream files in XML format")
+parser.add_argument('reference', type=str,
+                    help="Fabric bitstream file written with default options")
+parser.add_argument('files', type=str, nargs='*',
+                    help="Fabric bitstream files written with other options " +
+                    "for the same fabric bitstream. Files ending with .gz " +
+                    "are decompressed")
+args = parser.parse_args()
+
+FILE_HEAD = ["<!--",
+             "\t- Fabric bitstream",
+             "\t- Author: Xifan TANG",
+             "\t- Organization: University of Utah",
+             None,  # Date
+             "-->",
+             ""]
+DATE_RE = re.compile(r'^\t- Date: .+$')
+BIT_RE = re.compile(r'^(\t+)<bit id="(\d+)" value="([01])" path="([^"]+)"(/?)>$')
+ADDRESS_RE = re.compile(r'^(\t+)<(bl|wl|frame) address="([01x]*)"/>$')
+BLOCK_RE = re.compile(r'^\t<block path="([^"]+)">$')
+MEM_OUT_RE = re.compile(r'^mem_out\[\d+\]$')
+
+
+def read_lines(fname):
+    opener = gzip.open if fname.endswith(".gz") else open
+    with opener(fname, 'rt', encoding='utf-8', newline='') as fp:
+        content = fp.read()
+    if not content.endswith("\n"):
+        raise ValueError(f"{fname}: file does not end with a new line")
+    return content[:-1].split("\n")
+
+
+def check_file_head(fname, lines):
+    for iline, expected in enumerate(FILE_HEAD):
+        if expected is None:
+            valid = bool(DATE_RE.match(lines[iline]))
+        else:
+            valid = (lines[iline] == expected)
+        if not valid:
+            raise ValueError(f"{fname}:{iline + 1}: unexpected file head " +
+                             f"'{lines[iline]}'")
+    if lines[len(FILE_HEAD)] != "<fabric_bitstream>":
+        raise ValueError(f"{fname}: missing <fabric_bitstream>")
+    if lines[-1] != "</fabric_bitstream>":
+        raise ValueError(f"{fname}: missing </fabric_bitstream>")
+    return lines[len(FILE_HEAD) + 1:-1]
+
+
+def parse_bits(fname, lines):
+    """
+    Return the bits as a list of (id, value, full path, addresses)
+    Bits may be grouped by <block> nodes, whose paths are
+    the prefix of the paths of their bits
+    """
+    bits = []
+    block_path = None
+    iline = 0
+    while iline < len(lines):
+        line = lines[iline]
+        location = f"{fname}:{len(FILE_HEAD) + 2 + iline}"
+        block = BLOCK_RE.match(line)
+        if block:
+            if block_path is not None:
+                raise ValueError(f"{location}: nested <block>")
+            block_path = block.group(1)
+            iline += 1
+            continue
+        if line == "\t</block>":
+            if block_path is None:
+                raise ValueError(f"{location}: unexpected </block>")
+            block_path = None
+            iline += 1
+            continue
+        bit = BIT_RE.match(line)
+        depth = 1 if block_path is None else 2
+        if (not bit) or (len(bit.group(1)) != depth):
+            raise ValueError(f"{location}: unexpected line '{line}'")
+        path = bit.group(4)
+        if block_path is not None:
+            if not MEM_OUT_RE.match(path):
+                raise ValueError(f"{location}: bit path is not relative")
+            path = block_path + "." + path
+        addresses = []
+        iline += 1
+        if bit.group(5) != "/":
+            while lines[iline] != "\t" * depth + "</bit>":
+                address = ADDRESS_RE.match(lines[iline])
+                if (not address) or (len(address.group(1)) != depth + 1):
+                    raise ValueError(f"{fname}:{len(FILE_HEAD) + 2 + iline}: " +
+                                     f"unexpected line '{lines[iline]}'")
+                addresses.append((address.group(2), address.group(3)))
+                iline += 1
+            iline += 1
+        bits.append((int(bit.group(2)), bit.group(3), path, addresses))
+    if block_path is not None:
+        raise ValueError(f"{fname}: missing </block>")
+    return bits
+
+
+def main():
+    ref_lines = read_lines(args.reference)
+    ref_bits = parse_bits(args.reference,
+                          check_file_head(args.reference, ref_lines))
+
+    # The original format: each bit is a node with the full path,
+    # whose ids are in increasing order
+    for index, (bit_id, value, path, addresses) in enumerate(ref_bits):
+        if bit_id != index:
+            raise ValueError(f"{args.reference}: bit {index} has id {bit_id}")
+    for line in ref_lines:
+        bit = BIT_RE.match(line)
+        if BLOCK_RE.match(line) or (bit and bit.group(5) == "/"):
+            raise ValueError(f"{args.reference}: unexpected line '{line}'")
+    print(f"{args.reference}: {len(ref_bits)} bits in the original format")
+
+    for fname in args.files:
+        lines = read_lines(fname)
+        bits = parse_bits(fname, check_file_head(fname, lines))
+        if bits != ref_bits:
+            raise ValueError(f"{fname}: bits are different from {args.reference}")
+        # A file which is not grouped by blocks is the same as the reference,
+        # except the date
+        if not any(BLOCK_RE.match(line) for line in lines):
+            date_line = FILE_HEAD.index(None)
+            if (lines[:date_line] + lines[date_line + 1:]
+                    != ref_lines[:date_line] + ref_lines[date_line + 1:]):
+                raise ValueError(f"{fname}: content is different from " +
+                                 f"{args.reference}")
+        print(f"{fname}: {len(bits)} bits identical to {args.reference}")
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except ValueError as error:
+        print(f"Error: {error}")
+        sys.exit(1)
@@ -87,6 +87,9 @@ parser.add_argument('--openfpga_shell_template', type=str,
                     help="Sample openfpga shell script")
 parser.add_argument('--openfpga_arch_file', type=str,
                     help="Openfpga architecture file for shell")
+parser.add_argument('--openfpga_shell_options', type=str, default=None,
+                    help="Options to launch openfpga shell, e.g. " +
+                    "'--concurrent_commands 4 --profile profile.json'")
 parser.add_argument('--arch_variable_file', type=str, default=None,
                     help="Openfpga architecture file for shell")
 # parser.add_argument('--openfpga_sim_setting_file', type=str,
@@ -717,6 +720,8 @@ def run_openfpga_shell():
         archfile.write(tmpl.safe_substitute(path_variables))
     command = [cad_tools["openfpga_shell_path"], "-f",
                args.top_module+"_run.openfpga"]
+    if args.openfpga_shell_options:
+        command += shlex.split(args.openfpga_shell_options)
     run_command("OpenFPGA Shell Run", "openfpgashell.log", command)
     ExecTime["VPREnd"] = time.time()
     extract_vpr_stats("vpr_stdout.log")
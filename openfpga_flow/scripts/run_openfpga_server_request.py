@@ -0,0 +1,78 @@
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+# Script Name   : run_openfpga_server_request.py
+# Description   : This script sends a script of commands as a request to
+#                 openfpga launched in server mode, i.e., with '--server',
+#                 and waits for the reply
+# Args          : python3 run_openfpga_server_request.py --help
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+import os
+import sys
+import time
+import socket
+import argparse
+
+if sys.version_info[0] < 3:
+    raise Exception("run_openfpga_server_request script must be using Python 3")
+
+parser = argparse.ArgumentParser(
+    description="Send a request to openfpga in server mode")
+parser.add_argument('socket', type=str,
+                    help="UNIX socket which the server listens to")
+parser.add_argument('script', type=str,
+                    help="Script of commands to be executed by the server")
+parser.add_argument('--timeout', type=int, default=20*60,
+                    help="Time in seconds to wait for the server to listen " +
+                    "to the socket, e.g., while running its setup script")
+parser.add_argument('--server_pid', type=int, default=None,
+                    help="Process id of the server, to stop waiting " +
+                    "when the server exits before listening to the socket")
+args = parser.parse_args()
+
+
+def connect_server():
+    # The socket exists only after the setup script of the server is done
+    start_time = time.time()
+    while True:
+        client = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        try:
+            client.connect(args.socket)
+            return client
+        except (FileNotFoundError, ConnectionRefusedError):
+            client.close()
+            if time.time() - start_time > args.timeout:
+                raise
+            if args.server_pid:
+                # Raise an error if the server process does not exist
+                os.kill(args.server_pid, 0)
+            time.sleep(1)
+
+
+def main():
+    with open(args.script, 'rb') as fp:
+        request = fp.read()
+
+    client = connect_server()
+    client.sendall(request)
+    # The request ends when the writing is shut down
+    client.shutdown(socket.SHUT_WR)
+
+    reply = b""
+    while True:
+        data = client.recv(4096)
+        if not data:
+            break
+        reply += data
+    client.close()
+
+    reply = reply.decode()
+    print(reply, end="")
+
+    # The last line of the reply is the number of errors in the request
+    lines = reply.splitlines()
+    if (not lines) or (lines[-1] != "Finish request with 0 errors"):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -88,6 +88,8 @@ void SetupVPR(const t_options* Options,
     FileNameOpts->PowerFile = Options->PowerFile;
     FileNameOpts->CmosTechFile = Options->CmosTechFile;
     FileNameOpts->out_file_prefix = Options->out_file_prefix;
+    FileNameOpts->read_checkpoint_file = Options->read_checkpoint_file;
+    FileNameOpts->write_checkpoint_file = Options->write_checkpoint_file;
 
     FileNameOpts->verify_file_digests = Options->verify_file_digests;
 
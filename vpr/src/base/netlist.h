@@ -715,7 +715,7 @@ class Netlist {
     //Re-name a block
     //  blk_id   : The block to be renamed
     //  new_name : The new name for the specified block
-    void set_block_name(const BlockId blk_id, const std::string new_name);
+    void set_block_name(const BlockId blk_id, const std::string& new_name);
 
     //Set a block attribute
     //  blk_id   : The block to which the attribute is attached
@@ -760,14 +760,14 @@ class Netlist {
   protected: //Protected Mutators
     //Create or return an existing block in the netlist
     //  name        : The unique name of the block
-    BlockId create_block(const std::string name);
+    BlockId create_block(const std::string& name);
 
     //Create or return an existing port in the netlist
     //  blk_id      : The block the port is associated with
     //  name        : The name of the port (must match the name of a port in the block's model)
     //  width       : The width (number of bits) of the port
     //  type        : The type of the port (INPUT, OUTPUT, CLOCK)
-    PortId create_port(const BlockId blk_id, const std::string name, BitIndex width, PortType type);
+    PortId create_port(const BlockId blk_id, const std::string& name, BitIndex width, PortType type);
 
     //Create or return an existing pin in the netlist
     //  port_id    : The port this pin is associated with
@@ -779,13 +779,13 @@ class Netlist {
 
     //Create an empty, or return an existing net in the netlist
     //  name    : The unique name of the net
-    NetId create_net(const std::string name); //An empty or existing net
+    NetId create_net(const std::string& name); //An empty or existing net
 
     //Create a completely specified net from specified driver and sinks
     //  name    : The name of the net (Note: must not already exist)
     //  driver  : The net's driver pin
     //  sinks   : The net's sink pins
-    NetId add_net(const std::string name, PinId driver, std::vector<PinId> sinks);
+    NetId add_net(const std::string& name, PinId driver, std::vector<PinId> sinks);
 
   protected: //Protected Base Types
     struct string_id_tag;
@@ -611,7 +611,7 @@ bool Netlist<BlockId, PortId, PinId, NetId>::verify_lookups() const {
  *
  */
 template<typename BlockId, typename PortId, typename PinId, typename NetId>
-BlockId Netlist<BlockId, PortId, PinId, NetId>::create_block(const std::string name) {
+BlockId Netlist<BlockId, PortId, PinId, NetId>::create_block(const std::string& name) {
     //Must have a non-empty name
     VTR_ASSERT_MSG(!name.empty(), "Non-Empty block name");
 
@@ -654,7 +654,7 @@ BlockId Netlist<BlockId, PortId, PinId, NetId>::create_block(const std::string n
 }
 
 template<typename BlockId, typename PortId, typename PinId, typename NetId>
-PortId Netlist<BlockId, PortId, PinId, NetId>::create_port(const BlockId blk_id, const std::string name, BitIndex width, PortType type) {
+PortId Netlist<BlockId, PortId, PinId, NetId>::create_port(const BlockId blk_id, const std::string& name, BitIndex width, PortType type) {
     //Check pre-conditions
     VTR_ASSERT_MSG(valid_block_id(blk_id), "Valid block id");
 
@@ -731,7 +731,7 @@ PinId Netlist<BlockId, PortId, PinId, NetId>::create_pin(const PortId port_id, B
 }
 
 template<typename BlockId, typename PortId, typename PinId, typename NetId>
-NetId Netlist<BlockId, PortId, PinId, NetId>::create_net(const std::string name) {
+NetId Netlist<BlockId, PortId, PinId, NetId>::create_net(const std::string& name) {
     //Creates an empty net (or returns an existing one)
     VTR_ASSERT_MSG(!name.empty(), "Valid net name");
 
@@ -768,7 +768,7 @@ NetId Netlist<BlockId, PortId, PinId, NetId>::create_net(const std::string name)
 }
 
 template<typename BlockId, typename PortId, typename PinId, typename NetId>
-NetId Netlist<BlockId, PortId, PinId, NetId>::add_net(const std::string name, PinId driver, std::vector<PinId> sinks) {
+NetId Netlist<BlockId, PortId, PinId, NetId>::add_net(const std::string& name, PinId driver, std::vector<PinId> sinks) {
     //Creates a net with a full set of pins
     VTR_ASSERT_MSG(!find_net(name), "Net should not exist");
 
@@ -825,7 +825,7 @@ void Netlist<BlockId, PortId, PinId, NetId>::set_pin_net(const PinId pin, PinTyp
 }
 
 template<typename BlockId, typename PortId, typename PinId, typename NetId>
-void Netlist<BlockId, PortId, PinId, NetId>::set_block_name(const BlockId blk_id, const std::string new_name) {
+void Netlist<BlockId, PortId, PinId, NetId>::set_block_name(const BlockId blk_id, const std::string& new_name) {
     VTR_ASSERT(valid_block_id(blk_id));
 
     //Names must be unique -- no duplicates allowed
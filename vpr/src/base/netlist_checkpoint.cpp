@@ -0,0 +1,1166 @@
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_util.h"
+#include "vtr_digest.h"
+#include "vtr_time.h"
+
+#include "vpr_types.h"
+#include "vpr_error.h"
+#include "vpr_utils.h"
+#include "globals.h"
+#include "atom_netlist.h"
+#include "clustered_netlist.h"
+#include "netlist_checkpoint.h"
+
+/*
+ * Checkpoint layout (all integers in native byte order, checked through CHECKPOINT_BYTE_ORDER):
+ *
+ *   header:     magic, byte order mark, version, architecture ID, atom netlist ID,
+ *               netlist options key, and the file offset of each section (0 if absent)
+ *   atom:       blocks (name, model, truth table, attributes, parameters), ports, nets,
+ *               and the pins of each net (driver first, then sinks)
+ *   clustering: blocks (name, logical type, pb hierarchy, intra-block routing), ports,
+ *               nets and their pins, and the pb_graph_pin of each atom pin
+ *   placement:  the block locations together with the IDs of the netlist and placement they belong to
+ *
+ * Pins are never referred to by ID: they are stored in net pin order, so re-creating them in
+ * the same order reproduces the driver/sink order of every net.
+ */
+
+//Identifies a checkpoint file; bump CHECKPOINT_VERSION whenever the layout changes
+static constexpr std::array<char, 8> CHECKPOINT_MAGIC = {{'V', 'P', 'R', 'C', 'K', 'P', 'T', '\0'}};
+static constexpr uint32_t CHECKPOINT_VERSION = 1;
+static constexpr uint32_t CHECKPOINT_BYTE_ORDER = 0x01020304;
+
+//Stored in place of an invalid netlist ID
+static constexpr uint32_t CHECKPOINT_INVALID_ID = std::numeric_limits<uint32_t>::max();
+
+enum e_checkpoint_section {
+    CHECKPOINT_ATOM = 0,
+    CHECKPOINT_CLUSTERING,
+    CHECKPOINT_PLACEMENT,
+    NUM_CHECKPOINT_SECTIONS
+};
+
+static constexpr std::array<const char*, NUM_CHECKPOINT_SECTIONS> CHECKPOINT_SECTION_NAMES = {{"atom netlist", "clustering", "placement"}};
+
+//State of a child pb slot in the pb hierarchy
+enum e_checkpoint_pb_child {
+    CHECKPOINT_PB_UNUSED = 0, //No pb_graph_node assigned
+    CHECKPOINT_PB_OPEN,       //Assigned a pb_graph_node, but holds nothing
+    CHECKPOINT_PB_USED        //Holds atoms or routing, followed by its contents
+};
+
+//Thrown when a checkpoint can not be read or does not match the loaded architecture/netlist
+class CheckpointFormatError : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+//Serializes a checkpoint into memory, so the section offsets can be patched before it is written out
+class CheckpointWriter {
+  public:
+    void write_u8(uint8_t value) { write_raw(&value, sizeof(value)); }
+    void write_u32(uint32_t value) { write_raw(&value, sizeof(value)); }
+    void write_i32(int32_t value) { write_raw(&value, sizeof(value)); }
+    void write_u64(uint64_t value) { write_raw(&value, sizeof(value)); }
+
+    void write_str(const std::string& str) {
+        write_u32(str.size());
+        write_raw(str.data(), str.size());
+    }
+
+    template<typename Id>
+    void write_id(const Id id) {
+        write_u32(id ? size_t(id) : CHECKPOINT_INVALID_ID);
+    }
+
+    void write_raw(const void* data, size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        buf_.insert(buf_.end(), bytes, bytes + size);
+    }
+
+    size_t offset() const { return buf_.size(); }
+
+    void patch_u64(size_t offset, uint64_t value) {
+        VTR_ASSERT(offset + sizeof(value) <= buf_.size());
+        std::memcpy(&buf_[offset], &value, sizeof(value));
+    }
+
+    //Writes to a temporary file first, so an interrupted write never leaves a truncated checkpoint behind
+    bool write_file(const std::string& filename) const {
+        std::string tmp_filename = filename + ".tmp";
+        {
+            std::ofstream os(tmp_filename, std::ios::binary | std::ios::trunc);
+            if (!os) return false;
+            os.write(buf_.data(), buf_.size());
+            if (!os) return false;
+        }
+        return std::rename(tmp_filename.c_str(), filename.c_str()) == 0;
+    }
+
+  private:
+    std::vector<char> buf_;
+};
+
+//Reads a memory-mapped checkpoint, throwing CheckpointFormatError on truncated or out-of-range data
+class CheckpointReader {
+  public:
+    CheckpointReader(const char* filename) {
+        int fd = open(filename, O_RDONLY);
+        if (fd < 0) {
+            throw CheckpointFormatError("failed to open file");
+        }
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+            void* data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                data_ = static_cast<const char*>(data);
+                size_ = file_stat.st_size;
+            }
+        }
+        close(fd);
+
+        if (data_ == nullptr) {
+            throw CheckpointFormatError("failed to map file");
+        }
+    }
+
+    ~CheckpointReader() {
+        munmap(const_cast<char*>(data_), size_);
+    }
+
+    CheckpointReader(const CheckpointReader&) = delete;
+    CheckpointReader& operator=(const CheckpointReader&) = delete;
+
+    uint8_t read_u8() { return read_raw<uint8_t>(); }
+    uint32_t read_u32() { return read_raw<uint32_t>(); }
+    int32_t read_i32() { return read_raw<int32_t>(); }
+    uint64_t read_u64() { return read_raw<uint64_t>(); }
+
+    std::string read_str() {
+        size_t len = read_u32();
+        require(len);
+        std::string str(data_ + pos_, len);
+        pos_ += len;
+        return str;
+    }
+
+    //Reads an element count, rejecting counts the rest of the file can not hold
+    size_t read_count(size_t min_bytes_per_item) {
+        size_t count = read_u32();
+        if (count * min_bytes_per_item > size_ - pos_) {
+            throw CheckpointFormatError("truncated file");
+        }
+        return count;
+    }
+
+    //Reads a netlist ID which must be invalid or less than num_ids
+    template<typename Id>
+    Id read_id(size_t num_ids) {
+        uint32_t value = read_u32();
+        if (value == CHECKPOINT_INVALID_ID) {
+            return Id::INVALID();
+        }
+        if (value >= num_ids) {
+            throw CheckpointFormatError("ID out of range");
+        }
+        return Id(value);
+    }
+
+    void read_raw(void* data, size_t size) {
+        require(size);
+        std::memcpy(data, data_ + pos_, size);
+        pos_ += size;
+    }
+
+    void seek(size_t offset) {
+        if (offset > size_) {
+            throw CheckpointFormatError("truncated file");
+        }
+        pos_ = offset;
+    }
+
+  private:
+    template<typename T>
+    T read_raw() {
+        T value;
+        read_raw(&value, sizeof(value));
+        return value;
+    }
+
+    void require(size_t size) const {
+        if (size > size_ - pos_) {
+            throw CheckpointFormatError("truncated file");
+        }
+    }
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    size_t pos_ = 0;
+};
+
+static std::string netlist_opts_key(const t_netlist_opts& netlist_opts);
+
+static bool seek_checkpoint_section(CheckpointReader& in,
+                                    const char* checkpoint_file,
+                                    e_checkpoint_section section,
+                                    const t_arch& arch,
+                                    const t_netlist_opts& netlist_opts,
+                                    std::string& atom_netlist_id);
+static void warn_checkpoint_unused(const char* checkpoint_file, e_checkpoint_section section, const std::string& reason);
+
+static void write_atom_section(CheckpointWriter& out, const AtomNetlist& netlist);
+static void write_atom_pin(CheckpointWriter& out, const AtomNetlist& netlist, const AtomPinId pin);
+static AtomNetlist read_atom_section(CheckpointReader& in, const t_model* user_models, const t_model* library_models);
+static const t_model* find_checkpoint_model(const std::string& name, const t_model* user_models, const t_model* library_models);
+static const t_model_ports* find_checkpoint_model_port(const t_model* model, const std::string& name);
+
+static void write_clustering_section(CheckpointWriter& out, const ClusteredNetlist& clb_nlist, const AtomNetlist& atom_nlist, const AtomLookup& lookup);
+static void write_pb(CheckpointWriter& out, const t_pb* pb);
+static void write_pb_route(CheckpointWriter& out, const t_pb_routes& pb_route);
+static void write_cluster_pin(CheckpointWriter& out, const ClusteredNetlist& clb_nlist, const ClusterPinId pin);
+static void read_clustering_section(CheckpointReader& in, ClusteredNetlist& clb_nlist);
+static void read_pb(CheckpointReader& in,
+                    t_pb* pb,
+                    t_logical_block_type_ptr type,
+                    const IntraLbPbPinLookup& pin_lookup,
+                    std::vector<std::pair<AtomBlockId, t_pb*>>& atom_pbs);
+static t_pb_routes read_pb_route(CheckpointReader& in, t_logical_block_type_ptr type, const IntraLbPbPinLookup& pin_lookup);
+static int read_pb_pin_index(CheckpointReader& in, t_logical_block_type_ptr type);
+static void read_cluster_pin(CheckpointReader& in, ClusteredNetlist& clb_nlist, const ClusterNetId net, const PinType type);
+static std::vector<const t_pb_graph_pin*> primitive_pins(const t_pb_graph_node* gnode);
+
+static void write_placement_section(CheckpointWriter& out, const ClusteredNetlist& clb_nlist, const DeviceGrid& grid);
+
+/*
+ * Writing
+ */
+
+void write_checkpoint(const char* checkpoint_file, const t_arch& arch, const t_netlist_opts& netlist_opts) {
+    vtr::ScopedStartFinishTimer timer("Write Checkpoint");
+
+    const auto& atom_ctx = g_vpr_ctx.atom();
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& place_ctx = g_vpr_ctx.placement();
+    const auto& device_ctx = g_vpr_ctx.device();
+
+    //IDs are written as indices, which requires netlists without removed elements
+    if (!atom_ctx.nlist.is_compressed() || !cluster_ctx.clb_nlist.is_compressed()) {
+        VTR_LOG_WARN("Not writing checkpoint '%s' since the netlist is not compressed\n", checkpoint_file);
+        return;
+    }
+
+    CheckpointWriter out;
+
+    out.write_raw(CHECKPOINT_MAGIC.data(), CHECKPOINT_MAGIC.size());
+    out.write_u32(CHECKPOINT_BYTE_ORDER);
+    out.write_u32(CHECKPOINT_VERSION);
+    out.write_str(arch.architecture_id);
+    out.write_str(atom_ctx.nlist.netlist_id());
+    out.write_str(netlist_opts_key(netlist_opts));
+
+    size_t section_offsets_pos = out.offset();
+    for (size_t isection = 0; isection < NUM_CHECKPOINT_SECTIONS; ++isection) {
+        out.write_u64(0);
+    }
+
+    std::array<uint64_t, NUM_CHECKPOINT_SECTIONS> section_offsets = {};
+
+    section_offsets[CHECKPOINT_ATOM] = out.offset();
+    write_atom_section(out, atom_ctx.nlist);
+
+    bool has_clustering = cluster_ctx.clb_nlist.blocks().size() > 0;
+    if (has_clustering) {
+        section_offsets[CHECKPOINT_CLUSTERING] = out.offset();
+        write_clustering_section(out, cluster_ctx.clb_nlist, atom_ctx.nlist, atom_ctx.lookup);
+    }
+
+    bool has_placement = has_clustering
+                         && !place_ctx.placement_id.empty()
+                         && place_ctx.block_locs.size() == cluster_ctx.clb_nlist.blocks().size();
+    if (has_placement) {
+        section_offsets[CHECKPOINT_PLACEMENT] = out.offset();
+        write_placement_section(out, cluster_ctx.clb_nlist, device_ctx.grid);
+    }
+
+    for (size_t isection = 0; isection < NUM_CHECKPOINT_SECTIONS; ++isection) {
+        out.patch_u64(section_offsets_pos + isection * sizeof(uint64_t), section_offsets[isection]);
+    }
+
+    if (!out.write_file(checkpoint_file)) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Failed to write checkpoint file '%s'\n", checkpoint_file);
+    }
+
+    VTR_LOG("Wrote checkpoint '%s' (%s%s%s)\n", checkpoint_file,
+            CHECKPOINT_SECTION_NAMES[CHECKPOINT_ATOM],
+            has_clustering ? ", clustering" : "",
+            has_placement ? ", placement" : "");
+}
+
+static void write_atom_section(CheckpointWriter& out, const AtomNetlist& netlist) {
+    out.write_str(netlist.netlist_name());
+    out.write_str(netlist.netlist_id());
+
+    out.write_u32(netlist.blocks().size());
+    for (const AtomBlockId blk : netlist.blocks()) {
+        out.write_str(netlist.block_name(blk));
+        out.write_str(netlist.block_model(blk)->name);
+
+        const auto& truth_table = netlist.block_truth_table(blk);
+        out.write_u32(truth_table.size());
+        for (const auto& row : truth_table) {
+            out.write_u32(row.size());
+            for (const vtr::LogicValue value : row) {
+                out.write_u8(static_cast<uint8_t>(value));
+            }
+        }
+
+        auto attrs = netlist.block_attrs(blk);
+        out.write_u32(attrs.size());
+        for (const auto& attr : attrs) {
+            out.write_str(attr.first);
+            out.write_str(attr.second);
+        }
+
+        auto params = netlist.block_params(blk);
+        out.write_u32(params.size());
+        for (const auto& param : params) {
+            out.write_str(param.first);
+            out.write_str(param.second);
+        }
+    }
+
+    out.write_u32(netlist.ports().size());
+    for (const AtomPortId port : netlist.ports()) {
+        out.write_id(netlist.port_block(port));
+        out.write_str(netlist.port_model(port)->name);
+    }
+
+    out.write_u32(netlist.nets().size());
+    for (const AtomNetId net : netlist.nets()) {
+        out.write_str(netlist.net_name(net));
+    }
+
+    for (const AtomNetId net : netlist.nets()) {
+        AtomPinId driver = netlist.net_driver(net);
+        out.write_u8(bool(driver));
+        if (driver) {
+            write_atom_pin(out, netlist, driver);
+        }
+
+        auto sinks = netlist.net_sinks(net);
+        out.write_u32(sinks.size());
+        for (const AtomPinId sink : sinks) {
+            write_atom_pin(out, netlist, sink);
+        }
+    }
+}
+
+static void write_atom_pin(CheckpointWriter& out, const AtomNetlist& netlist, const AtomPinId pin) {
+    out.write_id(netlist.pin_port(pin));
+    out.write_u32(netlist.pin_port_bit(pin));
+    out.write_u8(netlist.pin_is_constant(pin));
+}
+
+static void write_clustering_section(CheckpointWriter& out, const ClusteredNetlist& clb_nlist, const AtomNetlist& atom_nlist, const AtomLookup& lookup) {
+    out.write_str(clb_nlist.netlist_name());
+    out.write_str(clb_nlist.netlist_id());
+
+    //The pb hierarchy refers to the atom netlist by ID, so it is only valid against an identical one
+    out.write_u32(atom_nlist.blocks().size());
+    out.write_u32(atom_nlist.nets().size());
+
+    out.write_u32(clb_nlist.blocks().size());
+    for (const ClusterBlockId blk : clb_nlist.blocks()) {
+        out.write_str(clb_nlist.block_name(blk));
+        out.write_u32(clb_nlist.block_type(blk)->index);
+
+        const t_pb* pb = clb_nlist.block_pb(blk);
+        write_pb(out, pb);
+        write_pb_route(out, pb->pb_route);
+    }
+
+    out.write_u32(clb_nlist.ports().size());
+    for (const ClusterPortId port : clb_nlist.ports()) {
+        out.write_id(clb_nlist.port_block(port));
+        out.write_str(clb_nlist.port_name(port));
+        out.write_u32(clb_nlist.port_width(port));
+        out.write_u8(static_cast<uint8_t>(clb_nlist.port_type(port)));
+    }
+
+    out.write_u32(clb_nlist.nets().size());
+    for (const ClusterNetId net : clb_nlist.nets()) {
+        out.write_str(clb_nlist.net_name(net));
+        out.write_id(lookup.atom_net(net));
+        out.write_u8(clb_nlist.net_is_ignored(net));
+        out.write_u8(clb_nlist.net_is_global(net));
+
+        ClusterPinId driver = clb_nlist.net_driver(net);
+        out.write_u8(bool(driver));
+        if (driver) {
+            write_cluster_pin(out, clb_nlist, driver);
+        }
+
+        auto sinks = clb_nlist.net_sinks(net);
+        out.write_u32(sinks.size());
+        for (const ClusterPinId sink : sinks) {
+            write_cluster_pin(out, clb_nlist, sink);
+        }
+    }
+
+    //The pb_graph_pin of every atom pin, in the same (net) order the atom pins were written in
+    for (const AtomNetId net : atom_nlist.nets()) {
+        for (const AtomPinId pin : atom_nlist.net_pins(net)) {
+            if (!pin) continue; //Undriven net
+
+            const t_pb_graph_pin* gpin = lookup.atom_pin_pb_graph_pin(pin);
+            out.write_i32(gpin ? gpin->pin_count_in_cluster : OPEN);
+        }
+    }
+}
+
+static void write_pb(CheckpointWriter& out, const t_pb* pb) {
+    out.write_u8(pb->name != nullptr);
+    if (pb->name) {
+        out.write_str(pb->name);
+    }
+    out.write_i32(pb->mode);
+
+    const t_pb_type* pb_type = pb->pb_graph_node->pb_type;
+
+    if (pb_type->num_modes == 0) {
+        //Primitive: record any rotations between its pins and the atom's port bits (e.g. on LUT inputs)
+        std::vector<std::pair<int, BitIndex>> rotations;
+        if (pb->name) {
+            for (const t_pb_graph_pin* gpin : primitive_pins(pb->pb_graph_node)) {
+                BitIndex atom_pin_bit = pb->atom_pin_bit_index(gpin);
+                if (atom_pin_bit != BitIndex(gpin->pin_number)) {
+                    rotations.emplace_back(gpin->pin_count_in_cluster, atom_pin_bit);
+                }
+            }
+        }
+
+        out.write_u32(rotations.size());
+        for (const auto& rotation : rotations) {
+            out.write_i32(rotation.first);
+            out.write_u32(rotation.second);
+        }
+        return;
+    }
+
+    out.write_u8(pb->child_pbs != nullptr);
+    if (!pb->child_pbs) return;
+
+    const t_mode& mode = pb_type->modes[pb->mode];
+    for (int i = 0; i < mode.num_pb_type_children; ++i) {
+        for (int j = 0; j < mode.pb_type_children[i].num_pb; ++j) {
+            const t_pb* child_pb = &pb->child_pbs[i][j];
+            if (!child_pb->pb_graph_node) {
+                out.write_u8(CHECKPOINT_PB_UNUSED);
+            } else if (!child_pb->parent_pb) {
+                out.write_u8(CHECKPOINT_PB_OPEN);
+            } else {
+                out.write_u8(CHECKPOINT_PB_USED);
+                write_pb(out, child_pb);
+            }
+        }
+    }
+}
+
+static void write_pb_route(CheckpointWriter& out, const t_pb_routes& pb_route) {
+    out.write_u32(pb_route.size());
+    for (const auto& kv : pb_route) {
+        const t_pb_route& route = kv.second;
+
+        out.write_i32(kv.first);
+        out.write_id(route.atom_net_id);
+        out.write_i32(route.driver_pb_pin_id);
+        out.write_u32(route.sink_pb_pin_ids.size());
+        for (int sink_pb_pin_id : route.sink_pb_pin_ids) {
+            out.write_i32(sink_pb_pin_id);
+        }
+        out.write_i32(route.pb_graph_pin ? route.pb_graph_pin->pin_count_in_cluster : OPEN);
+    }
+}
+
+static void write_cluster_pin(CheckpointWriter& out, const ClusteredNetlist& clb_nlist, const ClusterPinId pin) {
+    out.write_id(clb_nlist.pin_port(pin));
+    out.write_u32(clb_nlist.pin_port_bit(pin));
+    out.write_i32(clb_nlist.pin_logical_index(pin));
+    out.write_u8(clb_nlist.pin_is_constant(pin));
+}
+
+static void write_placement_section(CheckpointWriter& out, const ClusteredNetlist& clb_nlist, const DeviceGrid& grid) {
+    const auto& place_ctx = g_vpr_ctx.placement();
+
+    out.write_str(clb_nlist.netlist_id());
+    out.write_str(place_ctx.placement_id);
+    out.write_u32(grid.width());
+    out.write_u32(grid.height());
+
+    out.write_u32(clb_nlist.blocks().size());
+    for (const ClusterBlockId blk : clb_nlist.blocks()) {
+        const t_pl_loc& loc = place_ctx.block_locs[blk].loc;
+        out.write_i32(loc.x);
+        out.write_i32(loc.y);
+        out.write_i32(loc.z);
+    }
+}
+
+/*
+ * Reading
+ */
+
+bool read_atom_checkpoint(const char* checkpoint_file,
+                          const t_arch& arch,
+                          const char* circuit_file,
+                          const t_netlist_opts& netlist_opts,
+                          const t_model* user_models,
+                          const t_model* library_models) {
+    vtr::ScopedStartFinishTimer timer("Load Atom Netlist Checkpoint");
+
+    try {
+        CheckpointReader in(checkpoint_file);
+
+        std::string atom_netlist_id;
+        if (!seek_checkpoint_section(in, checkpoint_file, CHECKPOINT_ATOM, arch, netlist_opts, atom_netlist_id)) {
+            return false;
+        }
+
+        if (vtr::file_exists(circuit_file) && vtr::secure_digest_file(circuit_file) != atom_netlist_id) {
+            warn_checkpoint_unused(checkpoint_file, CHECKPOINT_ATOM,
+                                   vtr::string_fmt("circuit file '%s' has changed", circuit_file));
+            return false;
+        }
+
+        AtomNetlist netlist = read_atom_section(in, user_models, library_models);
+
+        auto& atom_ctx = g_vpr_ctx.mutable_atom();
+        atom_ctx.nlist = std::move(netlist);
+
+        VTR_LOG("Loaded atom netlist '%s' from checkpoint '%s' (%zu blocks, %zu nets)\n",
+                atom_ctx.nlist.netlist_name().c_str(), checkpoint_file,
+                atom_ctx.nlist.blocks().size(), atom_ctx.nlist.nets().size());
+    } catch (const CheckpointFormatError& e) {
+        warn_checkpoint_unused(checkpoint_file, CHECKPOINT_ATOM, e.what());
+        return false;
+    } catch (const vtr::VtrError& e) {
+        warn_checkpoint_unused(checkpoint_file, CHECKPOINT_ATOM, e.what());
+        return false;
+    }
+
+    return true;
+}
+
+bool read_clustering_checkpoint(const char* checkpoint_file,
+                                const t_arch& arch,
+                                const char* net_file,
+                                const t_netlist_opts& netlist_opts) {
+    vtr::ScopedStartFinishTimer timer("Load Clustering Checkpoint");
+
+    const auto& atom_ctx = g_vpr_ctx.atom();
+
+    try {
+        CheckpointReader in(checkpoint_file);
+
+        std::string atom_netlist_id;
+        if (!seek_checkpoint_section(in, checkpoint_file, CHECKPOINT_CLUSTERING, arch, netlist_opts, atom_netlist_id)) {
+            return false;
+        }
+
+        if (atom_netlist_id != atom_ctx.nlist.netlist_id()) {
+            warn_checkpoint_unused(checkpoint_file, CHECKPOINT_CLUSTERING, "it was generated from a different atom netlist");
+            return false;
+        }
+
+        std::string clb_nlist_name = in.read_str();
+        std::string clb_nlist_id = in.read_str();
+
+        //The .net file takes precedence if it was re-generated since the checkpoint was written
+        if (vtr::file_exists(net_file) && vtr::secure_digest_file(net_file) != clb_nlist_id) {
+            warn_checkpoint_unused(checkpoint_file, CHECKPOINT_CLUSTERING,
+                                   vtr::string_fmt("packed netlist file '%s' has changed", net_file));
+            return false;
+        }
+
+        ClusteredNetlist clb_nlist(clb_nlist_name, clb_nlist_id);
+        read_clustering_section(in, clb_nlist);
+
+        auto& cluster_ctx = g_vpr_ctx.mutable_clustering();
+        cluster_ctx.clb_nlist = std::move(clb_nlist);
+
+        VTR_LOG("Loaded clustering '%s' from checkpoint '%s' (%zu blocks, %zu nets)\n",
+                cluster_ctx.clb_nlist.netlist_name().c_str(), checkpoint_file,
+                cluster_ctx.clb_nlist.blocks().size(), cluster_ctx.clb_nlist.nets().size());
+    } catch (const CheckpointFormatError& e) {
+        warn_checkpoint_unused(checkpoint_file, CHECKPOINT_CLUSTERING, e.what());
+        return false;
+    } catch (const vtr::VtrError& e) {
+        warn_checkpoint_unused(checkpoint_file, CHECKPOINT_CLUSTERING, e.what());
+        return false;
+    }
+
+    return true;
+}
+
+bool read_placement_checkpoint(const char* checkpoint_file,
+                               const t_arch& arch,
+                               const char* place_file,
+                               const t_netlist_opts& netlist_opts,
+                               const DeviceGrid& grid) {
+    vtr::ScopedStartFinishTimer timer("Load Placement Checkpoint");
+
+    const auto& atom_ctx = g_vpr_ctx.atom();
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    try {
+        CheckpointReader in(checkpoint_file);
+
+        std::string atom_netlist_id;
+        if (!seek_checkpoint_section(in, checkpoint_file, CHECKPOINT_PLACEMENT, arch, netlist_opts, atom_netlist_id)) {
+            return false;
+        }
+
+        std::string clb_nlist_id = in.read_str();
+        std::string placement_id = in.read_str();
+
+        if (atom_netlist_id != atom_ctx.nlist.netlist_id() || clb_nlist_id != cluster_ctx.clb_nlist.netlist_id()) {
+            warn_checkpoint_unused(checkpoint_file, CHECKPOINT_PLACEMENT, "it was generated from a different netlist");
+            return false;
+        }
+
+        //The .place file takes precedence if it was re-generated since the checkpoint was written
+        if (vtr::file_exists(place_file) && vtr::secure_digest_file(place_file) != placement_id) {
+            warn_checkpoint_unused(checkpoint_file, CHECKPOINT_PLACEMENT,
+                                   vtr::string_fmt("placement file '%s' has changed", place_file));
+            return false;
+        }
+
+        size_t width = in.read_u32();
+        size_t height = in.read_u32();
+        if (width != grid.width() || height != grid.height()) {
+            warn_checkpoint_unused(checkpoint_file, CHECKPOINT_PLACEMENT,
+                                   vtr::string_fmt("it was generated for a %zu x %zu device, not %zu x %zu",
+                                                   width, height, grid.width(), grid.height()));
+            return false;
+        }
+
+        size_t num_blocks = in.read_count(3 * sizeof(int32_t));
+        if (num_blocks != cluster_ctx.clb_nlist.blocks().size()) {
+            throw CheckpointFormatError("block count does not match the clustered netlist");
+        }
+
+        std::vector<t_pl_loc> locs(num_blocks);
+        for (t_pl_loc& loc : locs) {
+            loc.x = in.read_i32();
+            loc.y = in.read_i32();
+            loc.z = in.read_i32();
+        }
+
+        auto& place_ctx = g_vpr_ctx.mutable_placement();
+        place_ctx.block_locs.resize(num_blocks);
+        for (size_t iblk = 0; iblk < num_blocks; ++iblk) {
+            place_ctx.block_locs[ClusterBlockId(iblk)].loc = locs[iblk];
+        }
+        place_ctx.placement_id = placement_id;
+
+        VTR_LOG("Loaded placement from checkpoint '%s' (%zu blocks)\n", checkpoint_file, num_blocks);
+    } catch (const CheckpointFormatError& e) {
+        warn_checkpoint_unused(checkpoint_file, CHECKPOINT_PLACEMENT, e.what());
+        return false;
+    } catch (const vtr::VtrError& e) {
+        warn_checkpoint_unused(checkpoint_file, CHECKPOINT_PLACEMENT, e.what());
+        return false;
+    }
+
+    return true;
+}
+
+static AtomNetlist read_atom_section(CheckpointReader& in, const t_model* user_models, const t_model* library_models) {
+    std::string netlist_name = in.read_str();
+    std::string netlist_id = in.read_str();
+    AtomNetlist netlist(netlist_name, netlist_id);
+
+    size_t num_blocks = in.read_count(2 * sizeof(uint32_t));
+    for (size_t iblk = 0; iblk < num_blocks; ++iblk) {
+        std::string blk_name = in.read_str();
+        const t_model* model = find_checkpoint_model(in.read_str(), user_models, library_models);
+
+        AtomNetlist::TruthTable truth_table(in.read_count(sizeof(uint32_t)));
+        for (auto& row : truth_table) {
+            row.resize(in.read_count(sizeof(uint8_t)));
+            for (auto& value : row) {
+                uint8_t logic_value = in.read_u8();
+                if (logic_value >= static_cast<uint8_t>(vtr::LogicValue::NUM_LOGIC_VALUE_TYPES)) {
+                    throw CheckpointFormatError("invalid truth table value");
+                }
+                value = static_cast<vtr::LogicValue>(logic_value);
+            }
+        }
+
+        AtomBlockId blk = netlist.create_block(blk_name, model, truth_table);
+        if (size_t(blk) != iblk) {
+            throw CheckpointFormatError("duplicate atom block '" + blk_name + "'");
+        }
+
+        size_t num_attrs = in.read_count(2 * sizeof(uint32_t));
+        for (size_t iattr = 0; iattr < num_attrs; ++iattr) {
+            std::string name = in.read_str();
+            netlist.set_block_attr(blk, name, in.read_str());
+        }
+
+        size_t num_params = in.read_count(2 * sizeof(uint32_t));
+        for (size_t iparam = 0; iparam < num_params; ++iparam) {
+            std::string name = in.read_str();
+            netlist.set_block_param(blk, name, in.read_str());
+        }
+    }
+
+    size_t num_ports = in.read_count(2 * sizeof(uint32_t));
+    for (size_t iport = 0; iport < num_ports; ++iport) {
+        AtomBlockId blk = in.read_id<AtomBlockId>(num_blocks);
+        if (!blk) {
+            throw CheckpointFormatError("atom port without block");
+        }
+        const t_model_ports* model_port = find_checkpoint_model_port(netlist.block_model(blk), in.read_str());
+
+        AtomPortId port = netlist.create_port(blk, model_port);
+        if (size_t(port) != iport) {
+            throw CheckpointFormatError("duplicate atom port");
+        }
+    }
+
+    size_t num_nets = in.read_count(sizeof(uint32_t));
+    for (size_t inet = 0; inet < num_nets; ++inet) {
+        std::string net_name = in.read_str();
+        AtomNetId net = netlist.create_net(net_name);
+        if (size_t(net) != inet) {
+            throw CheckpointFormatError("duplicate atom net '" + net_name + "'");
+        }
+    }
+
+    auto read_atom_pin = [&](const AtomNetId net, const PinType type) {
+        AtomPortId port = in.read_id<AtomPortId>(num_ports);
+        BitIndex bit = in.read_u32();
+        bool is_const = in.read_u8();
+        if (!port || bit >= netlist.port_width(port)) {
+            throw CheckpointFormatError("invalid atom pin");
+        }
+        netlist.create_pin(port, bit, net, type, is_const);
+    };
+
+    for (const AtomNetId net : netlist.nets()) {
+        if (in.read_u8()) {
+            read_atom_pin(net, PinType::DRIVER);
+        }
+
+        size_t num_sinks = in.read_count(2 * sizeof(uint32_t) + sizeof(uint8_t));
+        for (size_t isink = 0; isink < num_sinks; ++isink) {
+            read_atom_pin(net, PinType::SINK);
+        }
+    }
+
+    if (!netlist.verify()) {
+        throw CheckpointFormatError("inconsistent atom netlist");
+    }
+
+    return netlist;
+}
+
+static const t_model* find_checkpoint_model(const std::string& name, const t_model* user_models, const t_model* library_models) {
+    for (const t_model* models : {user_models, library_models}) {
+        for (const t_model* model = models; model != nullptr; model = model->next) {
+            if (name == model->name) {
+                return model;
+            }
+        }
+    }
+    throw CheckpointFormatError("architecture has no model '" + name + "'");
+}
+
+static const t_model_ports* find_checkpoint_model_port(const t_model* model, const std::string& name) {
+    for (const t_model_ports* ports : {model->inputs, model->outputs}) {
+        for (const t_model_ports* port = ports; port != nullptr; port = port->next) {
+            if (name == port->name) {
+                return port;
+            }
+        }
+    }
+    throw CheckpointFormatError("model '" + std::string(model->name) + "' has no port '" + name + "'");
+}
+
+static void read_clustering_section(CheckpointReader& in, ClusteredNetlist& clb_nlist) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    auto& atom_ctx = g_vpr_ctx.mutable_atom();
+
+    size_t num_atom_blocks = in.read_u32();
+    size_t num_atom_nets = in.read_u32();
+    if (num_atom_blocks != atom_ctx.nlist.blocks().size() || num_atom_nets != atom_ctx.nlist.nets().size()) {
+        throw CheckpointFormatError("atom netlist size does not match");
+    }
+
+    IntraLbPbPinLookup pin_lookup(device_ctx.logical_block_types);
+
+    //The atom lookup is only updated once the whole section has been read
+    vtr::vector<ClusterBlockId, std::vector<std::pair<AtomBlockId, t_pb*>>> clb_atom_pbs;
+
+    try {
+        size_t num_blocks = in.read_count(2 * sizeof(uint32_t));
+        for (size_t iblk = 0; iblk < num_blocks; ++iblk) {
+            std::string blk_name = in.read_str();
+            size_t itype = in.read_u32();
+            if (itype >= device_ctx.logical_block_types.size()) {
+                throw CheckpointFormatError("invalid logical block type");
+            }
+            t_logical_block_type_ptr type = &device_ctx.logical_block_types[itype];
+
+            t_pb* pb = new t_pb;
+            pb->pb_graph_node = type->pb_graph_head;
+            ClusterBlockId blk = clb_nlist.create_block(blk_name.c_str(), pb, type);
+            if (size_t(blk) != iblk) {
+                delete pb;
+                throw CheckpointFormatError("duplicate clustered block '" + blk_name + "'");
+            }
+
+            std::vector<std::pair<AtomBlockId, t_pb*>> blk_atom_pbs;
+            read_pb(in, pb, type, pin_lookup, blk_atom_pbs);
+            pb->pb_route = read_pb_route(in, type, pin_lookup);
+            clb_atom_pbs.push_back(std::move(blk_atom_pbs));
+        }
+
+        size_t num_ports = in.read_count(3 * sizeof(uint32_t) + sizeof(uint8_t));
+        for (size_t iport = 0; iport < num_ports; ++iport) {
+            ClusterBlockId blk = in.read_id<ClusterBlockId>(num_blocks);
+            std::string port_name = in.read_str();
+            BitIndex width = in.read_u32();
+            uint8_t port_type = in.read_u8();
+            if (!blk || port_type > static_cast<uint8_t>(PortType::CLOCK)) {
+                throw CheckpointFormatError("invalid clustered port");
+            }
+
+            ClusterPortId port = clb_nlist.create_port(blk, port_name, width, static_cast<PortType>(port_type));
+            if (size_t(port) != iport) {
+                throw CheckpointFormatError("duplicate clustered port '" + port_name + "'");
+            }
+        }
+
+        vtr::vector<ClusterNetId, AtomNetId> clb_atom_nets;
+        size_t num_nets = in.read_count(3 * sizeof(uint32_t));
+        for (size_t inet = 0; inet < num_nets; ++inet) {
+            std::string net_name = in.read_str();
+            ClusterNetId net = clb_nlist.create_net(net_name);
+            if (size_t(net) != inet) {
+                throw CheckpointFormatError("duplicate clustered net '" + net_name + "'");
+            }
+            clb_atom_nets.push_back(in.read_id<AtomNetId>(num_atom_nets));
+
+            bool is_ignored = in.read_u8();
+            bool is_global = in.read_u8();
+
+            if (in.read_u8()) {
+                read_cluster_pin(in, clb_nlist, net, PinType::DRIVER);
+            }
+
+            size_t num_sinks = in.read_count(3 * sizeof(uint32_t) + sizeof(uint8_t));
+            for (size_t isink = 0; isink < num_sinks; ++isink) {
+                read_cluster_pin(in, clb_nlist, net, PinType::SINK);
+            }
+
+            clb_nlist.set_net_is_ignored(net, is_ignored);
+            clb_nlist.set_net_is_global(net, is_global);
+        }
+
+        if (!clb_nlist.verify()) {
+            throw CheckpointFormatError("inconsistent clustered netlist");
+        }
+
+        //Resolve the primitives to their atoms
+        vtr::vector<AtomBlockId, ClusterBlockId> atom_clbs(num_atom_blocks, ClusterBlockId::INVALID());
+        for (const ClusterBlockId blk : clb_nlist.blocks()) {
+            for (const auto& atom_pb : clb_atom_pbs[blk]) {
+                atom_clbs[atom_pb.first] = blk;
+            }
+        }
+        for (const AtomBlockId atom_blk : atom_ctx.nlist.blocks()) {
+            if (!atom_clbs[atom_blk]) {
+                throw CheckpointFormatError("missing atom '" + atom_ctx.nlist.block_name(atom_blk) + "'");
+            }
+        }
+
+        std::vector<std::pair<AtomPinId, const t_pb_graph_pin*>> atom_pin_gpins;
+        for (const AtomNetId atom_net : atom_ctx.nlist.nets()) {
+            for (const AtomPinId atom_pin : atom_ctx.nlist.net_pins(atom_net)) {
+                if (!atom_pin) continue; //Undriven net
+
+                int pin_index = in.read_i32();
+                if (pin_index == OPEN) continue;
+
+                ClusterBlockId blk = atom_clbs[atom_ctx.nlist.pin_block(atom_pin)];
+                t_logical_block_type_ptr type = clb_nlist.block_type(blk);
+                if (pin_index < 0 || pin_index >= type->pb_graph_head->total_pb_pins) {
+                    throw CheckpointFormatError("invalid pb_graph_pin index");
+                }
+                atom_pin_gpins.emplace_back(atom_pin, pin_lookup.pb_gpin(type->index, pin_index));
+            }
+        }
+
+        //Everything has been read: update the atom lookup
+        for (const AtomBlockId atom_blk : atom_ctx.nlist.blocks()) {
+            atom_ctx.lookup.set_atom_pb(atom_blk, nullptr);
+        }
+        for (const ClusterBlockId blk : clb_nlist.blocks()) {
+            for (const auto& atom_pb : clb_atom_pbs[blk]) {
+                atom_ctx.lookup.set_atom_pb(atom_pb.first, atom_pb.second);
+                atom_ctx.lookup.set_atom_clb(atom_pb.first, blk);
+            }
+        }
+
+        for (const AtomNetId atom_net : atom_ctx.nlist.nets()) {
+            atom_ctx.lookup.set_atom_clb_net(atom_net, ClusterNetId::INVALID());
+        }
+        for (const ClusterNetId net : clb_nlist.nets()) {
+            if (clb_atom_nets[net]) {
+                atom_ctx.lookup.set_atom_clb_net(clb_atom_nets[net], net);
+            }
+        }
+
+        for (const auto& atom_pin_gpin : atom_pin_gpins) {
+            atom_ctx.lookup.set_atom_pin_pb_graph_pin(atom_pin_gpin.first, atom_pin_gpin.second);
+        }
+    } catch (...) {
+        //Release the pb hierarchies built so far, which are not yet known to the atom lookup
+        for (const ClusterBlockId blk : clb_nlist.blocks()) {
+            t_pb* pb = clb_nlist.block_pb(blk);
+            free_pb(pb);
+            delete pb;
+        }
+        throw;
+    }
+}
+
+static void read_pb(CheckpointReader& in,
+                    t_pb* pb,
+                    t_logical_block_type_ptr type,
+                    const IntraLbPbPinLookup& pin_lookup,
+                    std::vector<std::pair<AtomBlockId, t_pb*>>& atom_pbs) {
+    const auto& atom_ctx = g_vpr_ctx.atom();
+
+    if (in.read_u8()) {
+        pb->name = vtr::strdup(in.read_str().c_str());
+    }
+    pb->mode = in.read_i32();
+
+    const t_pb_type* pb_type = pb->pb_graph_node->pb_type;
+
+    if (pb_type->num_modes == 0) {
+        if (pb->name) {
+            AtomBlockId atom_blk = atom_ctx.nlist.find_block(pb->name);
+            if (!atom_blk) {
+                throw CheckpointFormatError(std::string("unknown primitive '") + pb->name + "'");
+            }
+            atom_pbs.emplace_back(atom_blk, pb);
+        }
+
+        size_t num_rotations = in.read_count(2 * sizeof(uint32_t));
+        for (size_t irot = 0; irot < num_rotations; ++irot) {
+            const t_pb_graph_pin* gpin = pin_lookup.pb_gpin(type->index, read_pb_pin_index(in, type));
+            if (gpin->parent_node != pb->pb_graph_node) {
+                throw CheckpointFormatError("pin rotation on a different primitive");
+            }
+            pb->set_atom_pin_bit_index(gpin, in.read_u32());
+        }
+        return;
+    }
+
+    if (pb->mode < 0 || pb->mode >= pb_type->num_modes) {
+        pb->mode = 0; //Keep the pb safe to free
+        throw CheckpointFormatError("invalid mode");
+    }
+
+    if (!in.read_u8()) return; //No children
+
+    const t_mode& mode = pb_type->modes[pb->mode];
+    pb->child_pbs = new t_pb*[mode.num_pb_type_children];
+    for (int i = 0; i < mode.num_pb_type_children; ++i) {
+        pb->child_pbs[i] = new t_pb[mode.pb_type_children[i].num_pb];
+    }
+
+    for (int i = 0; i < mode.num_pb_type_children; ++i) {
+        for (int j = 0; j < mode.pb_type_children[i].num_pb; ++j) {
+            t_pb* child_pb = &pb->child_pbs[i][j];
+
+            uint8_t state = in.read_u8();
+            if (state > CHECKPOINT_PB_USED) {
+                throw CheckpointFormatError("invalid pb state");
+            }
+
+            if (state != CHECKPOINT_PB_UNUSED) {
+                child_pb->pb_graph_node = &pb->pb_graph_node->child_pb_graph_nodes[pb->mode][i][j];
+            }
+            if (state == CHECKPOINT_PB_USED) {
+                child_pb->parent_pb = pb;
+                read_pb(in, child_pb, type, pin_lookup, atom_pbs);
+            }
+        }
+    }
+}
+
+static t_pb_routes read_pb_route(CheckpointReader& in, t_logical_block_type_ptr type, const IntraLbPbPinLookup& pin_lookup) {
+    const auto& atom_ctx = g_vpr_ctx.atom();
+
+    std::vector<std::pair<int, t_pb_route>> routes(in.read_count(5 * sizeof(uint32_t)));
+    for (auto& kv : routes) {
+        t_pb_route& route = kv.second;
+
+        kv.first = read_pb_pin_index(in, type);
+        route.atom_net_id = in.read_id<AtomNetId>(atom_ctx.nlist.nets().size());
+
+        route.driver_pb_pin_id = in.read_i32();
+        if (route.driver_pb_pin_id != OPEN && (route.driver_pb_pin_id < 0 || route.driver_pb_pin_id >= type->pb_graph_head->total_pb_pins)) {
+            throw CheckpointFormatError("invalid pb_graph_pin index");
+        }
+
+        route.sink_pb_pin_ids.resize(in.read_count(sizeof(int32_t)));
+        for (int& sink_pb_pin_id : route.sink_pb_pin_ids) {
+            sink_pb_pin_id = read_pb_pin_index(in, type);
+        }
+
+        int gpin_index = in.read_i32();
+        if (gpin_index != OPEN) {
+            if (gpin_index < 0 || gpin_index >= type->pb_graph_head->total_pb_pins) {
+                throw CheckpointFormatError("invalid pb_graph_pin index");
+            }
+            route.pb_graph_pin = pin_lookup.pb_gpin(type->index, gpin_index);
+        }
+    }
+
+    return t_pb_routes(std::move(routes));
+}
+
+static int read_pb_pin_index(CheckpointReader& in, t_logical_block_type_ptr type) {
+    int pin_index = in.read_i32();
+    if (pin_index < 0 || pin_index >= type->pb_graph_head->total_pb_pins) {
+        throw CheckpointFormatError("invalid pb_graph_pin index");
+    }
+    return pin_index;
+}
+
+static void read_cluster_pin(CheckpointReader& in, ClusteredNetlist& clb_nlist, const ClusterNetId net, const PinType type) {
+    ClusterPortId port = in.read_id<ClusterPortId>(clb_nlist.ports().size());
+    BitIndex bit = in.read_u32();
+    int logical_index = in.read_i32();
+    bool is_const = in.read_u8();
+
+    if (!port || bit >= clb_nlist.port_width(port)) {
+        throw CheckpointFormatError("invalid clustered pin");
+    }
+    t_logical_block_type_ptr blk_type = clb_nlist.block_type(clb_nlist.port_block(port));
+    if (logical_index < 0 || logical_index >= blk_type->pb_type->num_pins) {
+        throw CheckpointFormatError("invalid clustered pin index");
+    }
+
+    clb_nlist.create_pin(port, bit, net, type, logical_index, is_const);
+}
+
+static std::vector<const t_pb_graph_pin*> primitive_pins(const t_pb_graph_node* gnode) {
+    std::vector<const t_pb_graph_pin*> pins;
+    for (int iport = 0; iport < gnode->num_input_ports; ++iport) {
+        for (int ipin = 0; ipin < gnode->num_input_pins[iport]; ++ipin) {
+            pins.push_back(&gnode->input_pins[iport][ipin]);
+        }
+    }
+    for (int iport = 0; iport < gnode->num_output_ports; ++iport) {
+        for (int ipin = 0; ipin < gnode->num_output_pins[iport]; ++ipin) {
+            pins.push_back(&gnode->output_pins[iport][ipin]);
+        }
+    }
+    for (int iport = 0; iport < gnode->num_clock_ports; ++iport) {
+        for (int ipin = 0; ipin < gnode->num_clock_pins[iport]; ++ipin) {
+            pins.push_back(&gnode->clock_pins[iport][ipin]);
+        }
+    }
+    return pins;
+}
+
+/*
+ * Header
+ */
+
+//The netlist cleaning options change the atom netlist (and hence all IDs) produced from a circuit
+static std::string netlist_opts_key(const t_netlist_opts& netlist_opts) {
+    return vtr::string_fmt("const_gen_inference=%d absorb_buffer_luts=%d sweep_dangling_primary_ios=%d"
+                           " sweep_dangling_blocks=%d sweep_dangling_nets=%d sweep_constant_primary_outputs=%d",
+                           static_cast<int>(netlist_opts.const_gen_inference),
+                           netlist_opts.absorb_buffer_luts,
+                           netlist_opts.sweep_dangling_primary_ios,
+                           netlist_opts.sweep_dangling_blocks,
+                           netlist_opts.sweep_dangling_nets,
+                           netlist_opts.sweep_constant_primary_outputs);
+}
+
+//Validates the checkpoint header and seeks to the start of section. Returns false (after warning)
+//if the checkpoint does not hold the section or was generated with a different architecture/options.
+static bool seek_checkpoint_section(CheckpointReader& in,
+                                    const char* checkpoint_file,
+                                    e_checkpoint_section section,
+                                    const t_arch& arch,
+                                    const t_netlist_opts& netlist_opts,
+                                    std::string& atom_netlist_id) {
+    std::array<char, CHECKPOINT_MAGIC.size()> magic;
+    in.read_raw(magic.data(), magic.size());
+    if (magic != CHECKPOINT_MAGIC || in.read_u32() != CHECKPOINT_BYTE_ORDER) {
+        throw CheckpointFormatError("not a VPR checkpoint");
+    }
+
+    uint32_t version = in.read_u32();
+    if (version != CHECKPOINT_VERSION) {
+        warn_checkpoint_unused(checkpoint_file, section,
+                               vtr::string_fmt("checkpoint version %u, expected %u", version, CHECKPOINT_VERSION));
+        return false;
+    }
+
+    std::string arch_id = in.read_str();
+    atom_netlist_id = in.read_str();
+    std::string opts_key = in.read_str();
+
+    std::array<uint64_t, NUM_CHECKPOINT_SECTIONS> section_offsets;
+    for (auto& offset : section_offsets) {
+        offset = in.read_u64();
+    }
+
+    if (arch_id != arch.architecture_id) {
+        warn_checkpoint_unused(checkpoint_file, section, "it was generated from a different architecture file");
+        return false;
+    }
+
+    if (opts_key != netlist_opts_key(netlist_opts)) {
+        warn_checkpoint_unused(checkpoint_file, section, "it was generated with different netlist options");
+        return false;
+    }
+
+    if (section_offsets[section] == 0) {
+        warn_checkpoint_unused(checkpoint_file, section, "the checkpoint does not contain it");
+        return false;
+    }
+
+    in.seek(section_offsets[section]);
+    return true;
+}
+
+static void warn_checkpoint_unused(const char* checkpoint_file, e_checkpoint_section section, const std::string& reason) {
+    VTR_LOG_WARN("Not loading %s from checkpoint '%s' (%s), falling back to the input files\n",
+                 CHECKPOINT_SECTION_NAMES[section], checkpoint_file, reason.c_str());
+}
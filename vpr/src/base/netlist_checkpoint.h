@@ -0,0 +1,51 @@
+#ifndef NETLIST_CHECKPOINT_H
+#define NETLIST_CHECKPOINT_H
+
+/*
+ * Binary checkpoints of the netlist state shared between VPR's flow stages.
+ *
+ * A checkpoint holds the (cleaned) atom netlist, the clustered netlist together with
+ * its pb hierarchy and the atom lookup, and the placement -- each section only if it
+ * had been loaded when the checkpoint was written. It is versioned and tagged with the
+ * architecture ID, the atom netlist ID (BLIF digest) and the netlist cleaning options,
+ * as well as the .net/.place digests of the data it mirrors, so a stale checkpoint is
+ * detected and the caller falls back to re-reading the BLIF/.net/.place files.
+ *
+ * Checkpoints are read through mmap and rebuild the netlists directly through their
+ * create_*() interfaces, skipping netlist cleaning and the .net XML parse.
+ */
+
+#include "vpr_types.h"
+#include "device_grid.h"
+
+//Writes the currently loaded atom netlist, clustering and placement to checkpoint_file
+void write_checkpoint(const char* checkpoint_file, const t_arch& arch, const t_netlist_opts& netlist_opts);
+
+//Each of the following loads one section of checkpoint_file into the global context.
+//They return false (after warning) if the checkpoint is missing, malformed or does not
+//match the current inputs, in which case nothing has been modified.
+
+//Loads the atom netlist, provided it was produced from circuit_file with the same netlist options
+bool read_atom_checkpoint(const char* checkpoint_file,
+                          const t_arch& arch,
+                          const char* circuit_file,
+                          const t_netlist_opts& netlist_opts,
+                          const t_model* user_models,
+                          const t_model* library_models);
+
+//Loads the clustered netlist and atom lookup, provided they match the loaded atom netlist
+//and net_file (if it exists)
+bool read_clustering_checkpoint(const char* checkpoint_file,
+                                const t_arch& arch,
+                                const char* net_file,
+                                const t_netlist_opts& netlist_opts);
+
+//Loads the block locations, provided they match the loaded clustering, the device grid
+//and place_file (if it exists)
+bool read_placement_checkpoint(const char* checkpoint_file,
+                               const t_arch& arch,
+                               const char* place_file,
+                               const t_netlist_opts& netlist_opts,
+                               const DeviceGrid& grid);
+
+#endif
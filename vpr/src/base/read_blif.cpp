@@ -14,13 +14,29 @@
  * primitives are encountered by the parser.  The callback methods then create the associated
  * netlist data structures.
  *
+ * Large files are memory-mapped and split into chunks of complete BLIF statements, which
+ * are parsed in parallel by the blifparse library into BlifChunkRecorder objects. The
+ * recorded statements are then replayed, in file order, into the BlifAllocCallback, so the
+ * resulting netlist (and any error reported) is the same as when parsing the file serially.
+ *
  */
 #include <cstdio>
 #include <cstring>
 #include <ctime>
 #include <sstream>
 #include <unordered_set>
+#include <unordered_map>
 #include <cctype> //std::isdigit
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
 
 #include "blifparse.hpp"
 #include "atom_netlist.h"
@@ -132,10 +148,12 @@ struct BlifAllocCallback : public blifparse::Callback {
 
         //Convert the single-output cover to a netlist truth table
         AtomNetlist::TruthTable truth_table;
+        truth_table.reserve(so_cover.size());
         for (const auto& row : so_cover) {
             truth_table.emplace_back();
+            truth_table.back().reserve(row.size());
             for (auto val : row) {
-                truth_table[truth_table.size() - 1].push_back(to_vtr_logic_value(val));
+                truth_table.back().push_back(to_vtr_logic_value(val));
             }
         }
 
@@ -432,7 +450,14 @@ struct BlifAllocCallback : public blifparse::Callback {
     }
 
   private:
-    const t_model* find_model(std::string name) {
+    const t_model* find_model(const std::string& name) {
+        //Most look-ups are for the same few models (e.g. .names and .latch for
+        //every cover and latch), so remember the models already found
+        auto cached_model = model_lookup_.find(name);
+        if (cached_model != model_lookup_.end()) {
+            return cached_model->second;
+        }
+
         const t_model* arch_model = nullptr;
         for (const t_model* arch_models : {user_arch_models_, library_arch_models_}) {
             arch_model = arch_models;
@@ -452,6 +477,7 @@ struct BlifAllocCallback : public blifparse::Callback {
             vpr_throw(VPR_ERROR_BLIF_F, filename_.c_str(), lineno_, "Failed to find matching architecture model for '%s'\n",
                       name.c_str());
         }
+        model_lookup_[name] = arch_model;
         return arch_model;
     }
 
@@ -625,6 +651,7 @@ struct BlifAllocCallback : public blifparse::Callback {
     const std::string netlist_id_; //Unique identifier based on the contents of the blif file
     const t_model* user_arch_models_ = nullptr;
     const t_model* library_arch_models_ = nullptr;
+    std::unordered_map<std::string, const t_model*> model_lookup_; //Architecture models already found by name
 
     size_t unique_subckt_name_counter_ = 0;
 
@@ -634,6 +661,396 @@ struct BlifAllocCallback : public blifparse::Callback {
     e_circuit_format blif_format_ = e_circuit_format::BLIF;
 };
 
+//Size of the chunks a BLIF file is split into to be parsed in parallel.
+//Files no larger than one chunk are parsed serially.
+constexpr size_t BLIF_CHUNK_SIZE = 8 * 1024 * 1024;
+
+//Number of chunks parsed in parallel before their statements are added to the netlist.
+//This bounds the memory used by the recorded statements.
+constexpr size_t BLIF_CHUNKS_PER_BATCH = 32;
+
+//A range of complete BLIF statements in the text of a file
+struct BlifChunk {
+    size_t begin;   //Offset of the first character
+    size_t end;     //Offset past the last character
+    int first_line; //Line number of the first character in the file
+};
+
+//The types of BLIF statements recorded by BlifChunkRecorder
+enum class BlifRecordType {
+    BEGIN_MODEL,
+    INPUTS,
+    OUTPUTS,
+    NAMES,
+    LATCH,
+    SUBCKT,
+    BLACKBOX,
+    END_MODEL,
+    CONN,
+    CNAME,
+    ATTR,
+    PARAM,
+    PARSE_ERROR
+};
+
+//A BLIF statement recorded by BlifChunkRecorder
+struct BlifRecord {
+    BlifRecordType type;
+    int lineno; //Line number in the file
+
+    //Ids of the strings of the statement (names, nets, ports...) in the string pool of the recorder
+    std::vector<size_t> string_ids;
+
+    std::vector<std::vector<blifparse::LogicValue>> so_cover;            //.names only
+    blifparse::LatchType latch_type = blifparse::LatchType::UNSPECIFIED; //.latch only
+    blifparse::LogicValue latch_init = blifparse::LogicValue::UNKOWN;    //.latch only
+};
+
+//Thrown by BlifChunkRecorder to stop parsing a chunk on its first error
+struct BlifChunkParseError {};
+
+//Records the statements of a chunk of a BLIF file, to be replayed later into another callback.
+//Since chunks are parsed concurrently, the recorder does not touch any shared state.
+//
+//The strings of the statements are interned, so each net name is stored once per chunk
+//however many pins it connects to.
+struct BlifChunkRecorder : public blifparse::Callback {
+  public:
+    BlifChunkRecorder(int first_line)
+        : line_offset_(first_line - 1) {}
+
+  public: //Callback interface
+    void start_parse() override {}
+    void finish_parse() override {}
+    void filename(std::string /*fname*/) override {}
+
+    void lineno(int line_num) override { lineno_ = line_num + line_offset_; }
+
+    void begin_model(std::string model_name) override {
+        add_record(BlifRecordType::BEGIN_MODEL, {&model_name});
+    }
+
+    void inputs(std::vector<std::string> input_names) override {
+        add_record(BlifRecordType::INPUTS, input_names);
+    }
+
+    void outputs(std::vector<std::string> output_names) override {
+        add_record(BlifRecordType::OUTPUTS, output_names);
+    }
+
+    void names(std::vector<std::string> nets, std::vector<std::vector<blifparse::LogicValue>> so_cover) override {
+        BlifRecord& record = add_record(BlifRecordType::NAMES, nets);
+        record.so_cover = std::move(so_cover);
+    }
+
+    void latch(std::string input, std::string output, blifparse::LatchType type, std::string control, blifparse::LogicValue init) override {
+        BlifRecord& record = add_record(BlifRecordType::LATCH, {&input, &output, &control});
+        record.latch_type = type;
+        record.latch_init = init;
+    }
+
+    void subckt(std::string subckt_model, std::vector<std::string> ports, std::vector<std::string> nets) override {
+        //Stored as the model, the ports then the nets (there are as many ports as nets)
+        BlifRecord& record = add_record(BlifRecordType::SUBCKT, {&subckt_model});
+        for (auto& port : ports) {
+            record.string_ids.push_back(intern(port));
+        }
+        for (auto& net : nets) {
+            record.string_ids.push_back(intern(net));
+        }
+    }
+
+    void blackbox() override { add_record(BlifRecordType::BLACKBOX, {}); }
+
+    void end_model() override { add_record(BlifRecordType::END_MODEL, {}); }
+
+    void conn(std::string src, std::string dst) override {
+        add_record(BlifRecordType::CONN, {&src, &dst});
+    }
+
+    void cname(std::string cell_name) override {
+        add_record(BlifRecordType::CNAME, {&cell_name});
+    }
+
+    void attr(std::string name, std::string value) override {
+        add_record(BlifRecordType::ATTR, {&name, &value});
+    }
+
+    void param(std::string name, std::string value) override {
+        add_record(BlifRecordType::PARAM, {&name, &value});
+    }
+
+    void parse_error(const int curr_lineno, const std::string& near_text, const std::string& msg) override {
+        record_error(curr_lineno > 0 ? curr_lineno + line_offset_ : curr_lineno, near_text, msg);
+        throw BlifChunkParseError();
+    }
+
+  public:
+    //Records an error, which is reported when the statements are replayed
+    void record_error(const int curr_lineno, std::string near_text, std::string msg) {
+        lineno_ = curr_lineno;
+        add_record(BlifRecordType::PARSE_ERROR, {&near_text, &msg});
+    }
+
+    //Calls the callback methods matching the recorded statements, in order.
+    //The records are consumed.
+    void replay(blifparse::Callback& callback) {
+        for (BlifRecord& record : records_) {
+            callback.lineno(record.lineno);
+
+            switch (record.type) {
+                case BlifRecordType::BEGIN_MODEL:
+                    callback.begin_model(get_string(record, 0));
+                    break;
+                case BlifRecordType::INPUTS:
+                    callback.inputs(get_strings(record, 0, record.string_ids.size()));
+                    break;
+                case BlifRecordType::OUTPUTS:
+                    callback.outputs(get_strings(record, 0, record.string_ids.size()));
+                    break;
+                case BlifRecordType::NAMES:
+                    callback.names(get_strings(record, 0, record.string_ids.size()), std::move(record.so_cover));
+                    break;
+                case BlifRecordType::LATCH:
+                    callback.latch(get_string(record, 0), get_string(record, 1), record.latch_type, get_string(record, 2), record.latch_init);
+                    break;
+                case BlifRecordType::SUBCKT: {
+                    size_t num_ports = (record.string_ids.size() - 1) / 2;
+                    callback.subckt(get_string(record, 0),
+                                    get_strings(record, 1, 1 + num_ports),
+                                    get_strings(record, 1 + num_ports, record.string_ids.size()));
+                    break;
+                }
+                case BlifRecordType::BLACKBOX:
+                    callback.blackbox();
+                    break;
+                case BlifRecordType::END_MODEL:
+                    callback.end_model();
+                    break;
+                case BlifRecordType::CONN:
+                    callback.conn(get_string(record, 0), get_string(record, 1));
+                    break;
+                case BlifRecordType::CNAME:
+                    callback.cname(get_string(record, 0));
+                    break;
+                case BlifRecordType::ATTR:
+                    callback.attr(get_string(record, 0), get_string(record, 1));
+                    break;
+                case BlifRecordType::PARAM:
+                    callback.param(get_string(record, 0), get_string(record, 1));
+                    break;
+                case BlifRecordType::PARSE_ERROR:
+                    callback.parse_error(record.lineno, get_string(record, 0), get_string(record, 1));
+                    break;
+                default:
+                    VTR_ASSERT_MSG(false, "Unknown BLIF record type");
+            }
+        }
+    }
+
+  private:
+    BlifRecord& add_record(BlifRecordType type, std::initializer_list<std::string*> strings) {
+        records_.emplace_back();
+        BlifRecord& record = records_.back();
+        record.type = type;
+        record.lineno = lineno_;
+        record.string_ids.reserve(strings.size());
+        for (std::string* str : strings) {
+            record.string_ids.push_back(intern(*str));
+        }
+        return record;
+    }
+
+    BlifRecord& add_record(BlifRecordType type, std::vector<std::string>& strings) {
+        BlifRecord& record = add_record(type, {});
+        record.string_ids.reserve(strings.size());
+        for (auto& str : strings) {
+            record.string_ids.push_back(intern(str));
+        }
+        return record;
+    }
+
+    //Returns the id of a string in the pool, moving it into the pool if not already there
+    size_t intern(std::string& str) {
+        auto result = string_ids_.emplace(std::move(str), strings_.size());
+        if (result.second) {
+            strings_.push_back(&result.first->first);
+        }
+        return result.first->second;
+    }
+
+    const std::string& get_string(const BlifRecord& record, size_t istr) const {
+        return *strings_[record.string_ids[istr]];
+    }
+
+    std::vector<std::string> get_strings(const BlifRecord& record, size_t first, size_t last) const {
+        std::vector<std::string> strings;
+        strings.reserve(last - first);
+        for (size_t istr = first; istr < last; ++istr) {
+            strings.push_back(get_string(record, istr));
+        }
+        return strings;
+    }
+
+  private:
+    int line_offset_ = 0;
+    int lineno_ = -1;
+
+    std::vector<BlifRecord> records_;
+
+    //String pool: the keys of string_ids_ are the strings, strings_ points to them by id
+    std::unordered_map<std::string, size_t> string_ids_;
+    std::vector<const std::string*> strings_;
+};
+
+//A file mapped in memory (read-only), unmapped on destruction
+class BlifMappedFile {
+  public:
+    BlifMappedFile(const char* filename) {
+        int fd = open(filename, O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+            void* data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                data_ = static_cast<const char*>(data);
+                size_ = file_stat.st_size;
+                madvise(data, size_, MADV_SEQUENTIAL);
+            }
+        }
+        close(fd);
+    }
+
+    ~BlifMappedFile() {
+        if (data_ != nullptr) {
+            munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    BlifMappedFile(const BlifMappedFile&) = delete;
+    BlifMappedFile& operator=(const BlifMappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+  private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+//Returns true if a statement which can start a chunk begins at offset pos of the text,
+//i.e. a .names, .subckt or .latch at the start of a line which does not continue the previous one
+static bool is_blif_chunk_boundary(const char* text, size_t size, size_t pos) {
+    //Must be at the start of a line...
+    if (pos == 0 || text[pos - 1] != '\n') {
+        return false;
+    }
+
+    //...which is not the continuation of the previous line
+    size_t prev = pos - 1;
+    if (prev > 0 && text[prev - 1] == '\r') {
+        --prev;
+    }
+    if (prev > 0 && text[prev - 1] == '\\') {
+        return false;
+    }
+
+    for (const char* keyword : {".names", ".subckt", ".latch"}) {
+        size_t len = std::strlen(keyword);
+        if (pos + len < size
+            && 0 == std::strncmp(text + pos, keyword, len)
+            && std::isspace(static_cast<unsigned char>(text[pos + len]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//Splits the text of a BLIF file into chunks of about chunk_size characters, ending at chunk boundaries
+static std::vector<BlifChunk> split_blif_chunks(const char* text, size_t size, size_t chunk_size) {
+    std::vector<BlifChunk> chunks;
+
+    size_t begin = 0;
+    int first_line = 1;
+    while (begin < size) {
+        size_t end = size;
+        if (size - begin > chunk_size) {
+            //Look for the first boundary after the target size, at the start of a line
+            end = begin + chunk_size;
+            while (end < size && !is_blif_chunk_boundary(text, size, end)) {
+                const void* next_line = std::memchr(text + end, '\n', size - end);
+                end = (next_line == nullptr) ? size : static_cast<const char*>(next_line) - text + 1;
+            }
+        }
+        chunks.push_back({begin, end, first_line});
+        first_line += std::count(text + begin, text + end, '\n');
+        begin = end;
+    }
+    return chunks;
+}
+
+//Parses one chunk of a BLIF file into a recorder
+static void parse_blif_chunk(const char* text, const BlifChunk& chunk, const char* blif_file, BlifChunkRecorder& recorder) {
+    FILE* chunk_file = fmemopen(const_cast<char*>(text + chunk.begin), chunk.end - chunk.begin, "r");
+    if (chunk_file == nullptr) {
+        recorder.record_error(chunk.first_line, "", "Could not read the chunk of the file starting at this line");
+        return;
+    }
+
+    try {
+        blifparse::blif_parse_file(chunk_file, recorder, blif_file);
+    } catch (const BlifChunkParseError&) {
+        //The error is recorded, and reported when the chunk is replayed
+    }
+
+    std::fclose(chunk_file);
+}
+
+//Parses a BLIF file in parallel chunks, and replays the statements into the callback in file order.
+//Returns false (without calling the callback) if the file cannot be mapped in memory or is
+//small enough to be parsed serially.
+static bool parse_blif_chunks(const char* blif_file, blifparse::Callback& callback) {
+    BlifMappedFile mapped_file(blif_file);
+    if (mapped_file.data() == nullptr || mapped_file.size() <= BLIF_CHUNK_SIZE) {
+        return false;
+    }
+
+    std::vector<BlifChunk> chunks = split_blif_chunks(mapped_file.data(), mapped_file.size(), BLIF_CHUNK_SIZE);
+
+    callback.start_parse();
+    callback.filename(blif_file);
+
+    for (size_t batch_begin = 0; batch_begin < chunks.size(); batch_begin += BLIF_CHUNKS_PER_BATCH) {
+        size_t batch_end = std::min(batch_begin + BLIF_CHUNKS_PER_BATCH, chunks.size());
+
+        std::vector<BlifChunkRecorder> recorders;
+        recorders.reserve(batch_end - batch_begin);
+        for (size_t ichunk = batch_begin; ichunk < batch_end; ++ichunk) {
+            recorders.emplace_back(chunks[ichunk].first_line);
+        }
+
+#if defined(VPR_USE_TBB)
+        tbb::parallel_for(batch_begin, batch_end, [&](size_t ichunk) {
+            parse_blif_chunk(mapped_file.data(), chunks[ichunk], blif_file, recorders[ichunk - batch_begin]);
+        });
+#else
+        for (size_t ichunk = batch_begin; ichunk < batch_end; ++ichunk) {
+            parse_blif_chunk(mapped_file.data(), chunks[ichunk], blif_file, recorders[ichunk - batch_begin]);
+        }
+#endif
+
+        for (BlifChunkRecorder& recorder : recorders) {
+            recorder.replay(callback);
+        }
+    }
+
+    callback.finish_parse();
+
+    return true;
+}
+
 vtr::LogicValue to_vtr_logic_value(blifparse::LogicValue val) {
     vtr::LogicValue new_val = vtr::LogicValue::UNKOWN;
     switch (val) {
@@ -663,7 +1080,9 @@ AtomNetlist read_blif(e_circuit_format circuit_format,
     std::string netlist_id = vtr::secure_digest_file(blif_file);
 
     BlifAllocCallback alloc_callback(circuit_format, netlist, netlist_id, user_models, library_models);
-    blifparse::blif_parse_filename(blif_file, alloc_callback);
+    if (!parse_blif_chunks(blif_file, alloc_callback)) {
+        blifparse::blif_parse_filename(blif_file, alloc_callback);
+    }
 
     return netlist;
 }
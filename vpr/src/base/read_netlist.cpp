@@ -9,6 +9,7 @@
 #include <cstring>
 #include <ctime>
 #include <map>
+#include <unordered_map>
 
 #include "pugixml.hpp"
 #include "pugixml_loc.hpp"
@@ -34,6 +35,12 @@
 
 static const char* netlist_file_name = nullptr;
 
+/* Pins already resolved from the '<pin>->' part of the .net pin strings, per
+ * (parent pb_graph_node, children pb_graph_nodes of the selected mode).
+ * The same few pin strings appear in every instance of a logic block, and
+ * resolving them requires tokenizing and allocating port pointer arrays */
+static std::map<std::pair<const t_pb_graph_node*, t_pb_graph_node**>, std::unordered_map<std::string, t_pb_graph_pin*>> pb_graph_pin_string_lookup;
+
 static int processPorts(pugi::xml_node Parent, t_pb* pb, t_pb_routes& pb_route, const pugiutil::loc_data& loc_data);
 
 static void processPb(pugi::xml_node Parent, const ClusterBlockId index, t_pb* pb, t_pb_routes& pb_route, int* num_primitives, const pugiutil::loc_data& loc_data, ClusteredNetlist* clb_nlist);
@@ -46,6 +53,11 @@ static void processComplexBlock(pugi::xml_node Parent,
 
 static int add_net_to_hash(t_hash** nhash, const char* net_name, int* ncount);
 
+static t_pb_graph_pin* find_pb_graph_pin_from_string(const int line_num,
+                                                     const t_pb_graph_node* pb_graph_parent_node,
+                                                     t_pb_graph_node** pb_graph_children_nodes,
+                                                     const std::string& pin_name);
+
 static void load_external_nets_and_cb(ClusteredNetlist& clb_nlist);
 
 static void load_internal_to_block_net_nums(const t_logical_block_type_ptr type, t_pb_routes& pb_route);
@@ -95,6 +107,7 @@ ClusteredNetlist read_netlist(const char* net_file,
     try {
         /* Save netlist file's name in file-scoped variable */
         netlist_file_name = net_file;
+        pb_graph_pin_string_lookup.clear();
 
         /* Root node should be block */
         auto top = doc.child("block");
@@ -230,6 +243,8 @@ ClusteredNetlist read_netlist(const char* net_file,
     /* load mapping between atom pins and pb_graph_pins */
     load_atom_pin_mapping(clb_nlist);
 
+    pb_graph_pin_string_lookup.clear();
+
     clock_t end = clock();
 
     VTR_LOG("Finished loading packed FPGA netlist file (took %g seconds).\n", (float)(end - begin) / CLOCKS_PER_SEC);
@@ -564,12 +579,43 @@ static int add_net_to_hash(t_hash** nhash, const char* net_name, int* ncount) {
     return hash_value->index;
 }
 
+/* Find the pb_graph_pin described by a pin string of the .net file
+ * (e.g. 'memory.addr1[0]'), reusing the pins already resolved */
+static t_pb_graph_pin* find_pb_graph_pin_from_string(const int line_num,
+                                                     const t_pb_graph_node* pb_graph_parent_node,
+                                                     t_pb_graph_node** pb_graph_children_nodes,
+                                                     const std::string& pin_name) {
+    auto& pin_lookup = pb_graph_pin_string_lookup[std::make_pair(pb_graph_parent_node, pb_graph_children_nodes)];
+    auto result = pin_lookup.find(pin_name);
+    if (result != pin_lookup.end()) {
+        return result->second;
+    }
+
+    int* num_ptrs;
+    int num_sets;
+    t_pb_graph_pin*** pin_node = alloc_and_load_port_pin_ptrs_from_string(line_num,
+                                                                          pb_graph_parent_node,
+                                                                          pb_graph_children_nodes,
+                                                                          pin_name.c_str(), &num_ptrs, &num_sets, true,
+                                                                          true);
+    VTR_ASSERT(num_sets == 1 && num_ptrs[0] == 1);
+    t_pb_graph_pin* pb_graph_pin = pin_node[0][0];
+
+    for (int iset = 0; iset < num_sets; iset++) {
+        free(pin_node[iset]);
+    }
+    free(pin_node);
+    free(num_ptrs);
+
+    pin_lookup[pin_name] = pb_graph_pin;
+    return pb_graph_pin;
+}
+
 static int processPorts(pugi::xml_node Parent, t_pb* pb, t_pb_routes& pb_route, const pugiutil::loc_data& loc_data) {
     int i, j, num_tokens;
     int in_port = 0, out_port = 0, clock_port = 0;
     std::vector<std::string> pins;
-    t_pb_graph_pin*** pin_node;
-    int *num_ptrs, num_sets;
+    t_pb_graph_pin* pin_node;
     bool found;
 
     auto& atom_ctx = g_vpr_ctx.atom();
@@ -685,13 +731,11 @@ static int processPorts(pugi::xml_node Parent, t_pb* pb, t_pb_routes& pb_route,
                     std::string interconnect_name = pins[i].substr(loc, std::string::npos);
                     // Interconnect name is the net name
 
-                    pin_node = alloc_and_load_port_pin_ptrs_from_string(
+                    pin_node = find_pb_graph_pin_from_string(
                         pb->pb_graph_node->pb_type->parent_mode->interconnect[0].line_num,
                         pb->pb_graph_node->parent_pb_graph_node,
                         pb->pb_graph_node->parent_pb_graph_node->child_pb_graph_nodes[pb->parent_pb->mode],
-                        pin_name.c_str(), &num_ptrs, &num_sets, true,
-                        true);
-                    VTR_ASSERT(num_sets == 1 && num_ptrs[0] == 1);
+                        pin_name);
 
                     const t_pb_graph_pin* pb_gpin = nullptr;
                     if (0 == strcmp(Parent.name(), "inputs")) {
@@ -703,21 +747,16 @@ static int processPorts(pugi::xml_node Parent, t_pb* pb, t_pb_routes& pb_route,
                     int rr_node_index = pb_gpin->pin_count_in_cluster;
 
                     pb_route.insert(std::make_pair(rr_node_index, t_pb_route()));
-                    pb_route[rr_node_index].driver_pb_pin_id = pin_node[0][0]->pin_count_in_cluster;
+                    pb_route[rr_node_index].driver_pb_pin_id = pin_node->pin_count_in_cluster;
                     pb_route[rr_node_index].pb_graph_pin = pb_gpin;
 
                     found = false;
-                    for (j = 0; j < pin_node[0][0]->num_output_edges; j++) {
-                        if (0 == strcmp(interconnect_name.c_str(), pin_node[0][0]->output_edges[j]->interconnect->name)) {
+                    for (j = 0; j < pin_node->num_output_edges; j++) {
+                        if (0 == strcmp(interconnect_name.c_str(), pin_node->output_edges[j]->interconnect->name)) {
                             found = true;
                             break;
                         }
                     }
-                    for (j = 0; j < num_sets; j++) {
-                        free(pin_node[j]);
-                    }
-                    free(pin_node);
-                    free(num_ptrs);
                     if (!found) {
                         vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(Cur),
                                   "Unknown interconnect %s connecting to pin %s.\n",
@@ -761,32 +800,25 @@ static int processPorts(pugi::xml_node Parent, t_pb* pb, t_pb_routes& pb_route,
                     loc += 2; //Skip over the '->'
                     std::string interconnect_name = pins[i].substr(loc, std::string::npos);
 
-                    pin_node = alloc_and_load_port_pin_ptrs_from_string(
+                    pin_node = find_pb_graph_pin_from_string(
                         pb->pb_graph_node->pb_type->modes[pb->mode].interconnect->line_num,
                         pb->pb_graph_node,
                         pb->pb_graph_node->child_pb_graph_nodes[pb->mode],
-                        pin_name.c_str(), &num_ptrs, &num_sets, true,
-                        true);
-                    VTR_ASSERT(num_sets == 1 && num_ptrs[0] == 1);
+                        pin_name);
                     int rr_node_index = pb->pb_graph_node->output_pins[out_port][i].pin_count_in_cluster;
 
                     //Why does this not use the output pin used to deterimine the rr node index?
                     pb_route.insert(std::make_pair(rr_node_index, t_pb_route()));
-                    pb_route[rr_node_index].driver_pb_pin_id = pin_node[0][0]->pin_count_in_cluster;
-                    pb_route[rr_node_index].pb_graph_pin = pin_node[0][0];
+                    pb_route[rr_node_index].driver_pb_pin_id = pin_node->pin_count_in_cluster;
+                    pb_route[rr_node_index].pb_graph_pin = pin_node;
 
                     found = false;
-                    for (j = 0; j < pin_node[0][0]->num_output_edges; j++) {
-                        if (0 == strcmp(interconnect_name.c_str(), pin_node[0][0]->output_edges[j]->interconnect->name)) {
+                    for (j = 0; j < pin_node->num_output_edges; j++) {
+                        if (0 == strcmp(interconnect_name.c_str(), pin_node->output_edges[j]->interconnect->name)) {
                             found = true;
                             break;
                         }
                     }
-                    for (j = 0; j < num_sets; j++) {
-                        free(pin_node[j]);
-                    }
-                    free(pin_node);
-                    free(num_ptrs);
                     if (!found) {
                         vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(Cur),
                                   "Unknown interconnect %s connecting to pin %s.\n",
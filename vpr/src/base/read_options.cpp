@@ -1041,6 +1041,19 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .help("Writes the placement delay lookup to the specified file.")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument(args.read_checkpoint_file, "--read_checkpoint")
+        .help(
+            "Loads the atom netlist, clustering and placement from the specified binary checkpoint"
+            " instead of parsing the circuit, .net and .place files."
+            " Sections which do not match the current inputs are ignored.")
+        .metavar("CHECKPOINT_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument(args.write_checkpoint_file, "--write_checkpoint")
+        .help("Writes a binary checkpoint of the atom netlist, clustering and placement to the specified file after packing and placement")
+        .metavar("CHECKPOINT_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.out_file_prefix, "--outfile_prefix")
         .help("Prefix for output files")
         .show_in(argparse::ShowIn::HELP_ONLY);
@@ -72,6 +72,7 @@
 #include "read_route.h"
 #include "read_blif.h"
 #include "read_place.h"
+#include "netlist_checkpoint.h"
 
 #include "arch_util.h"
 
@@ -292,19 +293,27 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
     /* flush any messages to user still in stdout that hasn't gotten displayed */
     fflush(stdout);
 
-    /* Read blif file and sweep unused components */
+    /* Read blif file and sweep unused components (unless the cleaned netlist can be loaded from a checkpoint) */
     auto& atom_ctx = g_vpr_ctx.mutable_atom();
-    atom_ctx.nlist = read_and_process_circuit(options->circuit_format,
-                                              vpr_setup->PackerOpts.blif_file_name.c_str(),
-                                              vpr_setup->user_models,
-                                              vpr_setup->library_models,
-                                              vpr_setup->NetlistOpts.const_gen_inference,
-                                              vpr_setup->NetlistOpts.absorb_buffer_luts,
-                                              vpr_setup->NetlistOpts.sweep_dangling_primary_ios,
-                                              vpr_setup->NetlistOpts.sweep_dangling_nets,
-                                              vpr_setup->NetlistOpts.sweep_dangling_blocks,
-                                              vpr_setup->NetlistOpts.sweep_constant_primary_outputs,
-                                              vpr_setup->NetlistOpts.netlist_verbosity);
+    const auto& checkpoint_file = vpr_setup->FileNameOpts.read_checkpoint_file;
+    if (checkpoint_file.empty()
+        || !read_atom_checkpoint(checkpoint_file.c_str(), *arch,
+                                 vpr_setup->PackerOpts.blif_file_name.c_str(),
+                                 vpr_setup->NetlistOpts,
+                                 vpr_setup->user_models,
+                                 vpr_setup->library_models)) {
+        atom_ctx.nlist = read_and_process_circuit(options->circuit_format,
+                                                  vpr_setup->PackerOpts.blif_file_name.c_str(),
+                                                  vpr_setup->user_models,
+                                                  vpr_setup->library_models,
+                                                  vpr_setup->NetlistOpts.const_gen_inference,
+                                                  vpr_setup->NetlistOpts.absorb_buffer_luts,
+                                                  vpr_setup->NetlistOpts.sweep_dangling_primary_ios,
+                                                  vpr_setup->NetlistOpts.sweep_dangling_nets,
+                                                  vpr_setup->NetlistOpts.sweep_dangling_blocks,
+                                                  vpr_setup->NetlistOpts.sweep_constant_primary_outputs,
+                                                  vpr_setup->NetlistOpts.netlist_verbosity);
+    }
 
     if (vpr_setup->PowerOpts.do_power) {
         //Load the net activity file for power estimation
@@ -495,6 +504,10 @@ bool vpr_pack_flow(t_vpr_setup& vpr_setup, const t_arch& arch) {
 
         /* Output the netlist stats to console. */
         printClusteredNetlistStats();
+
+        if (!vpr_setup.FileNameOpts.write_checkpoint_file.empty()) {
+            write_checkpoint(vpr_setup.FileNameOpts.write_checkpoint_file.c_str(), arch, vpr_setup.NetlistOpts);
+        }
     }
 
     return status;
@@ -563,11 +576,16 @@ void vpr_load_packing(t_vpr_setup& vpr_setup, const t_arch& arch) {
                    "Must have valid .net filename to load packing");
 
     auto& cluster_ctx = g_vpr_ctx.mutable_clustering();
+    const auto& filename_opts = vpr_setup.FileNameOpts;
 
-    cluster_ctx.clb_nlist = read_netlist(vpr_setup.FileNameOpts.NetFile.c_str(),
-                                         &arch,
-                                         vpr_setup.FileNameOpts.verify_file_digests,
-                                         vpr_setup.PackerOpts.pack_verbosity);
+    if (filename_opts.read_checkpoint_file.empty()
+        || !read_clustering_checkpoint(filename_opts.read_checkpoint_file.c_str(), arch,
+                                       filename_opts.NetFile.c_str(), vpr_setup.NetlistOpts)) {
+        cluster_ctx.clb_nlist = read_netlist(filename_opts.NetFile.c_str(),
+                                             &arch,
+                                             filename_opts.verify_file_digests,
+                                             vpr_setup.PackerOpts.pack_verbosity);
+    }
 
     process_constant_nets(cluster_ctx.clb_nlist, vpr_setup.constant_net_method, vpr_setup.PackerOpts.pack_verbosity);
 
@@ -596,6 +614,10 @@ bool vpr_place_flow(t_vpr_setup& vpr_setup, const t_arch& arch) {
 
         sync_grid_to_blocks();
         post_place_sync();
+
+        if (!vpr_setup.FileNameOpts.write_checkpoint_file.empty()) {
+            write_checkpoint(vpr_setup.FileNameOpts.write_checkpoint_file.c_str(), arch, vpr_setup.NetlistOpts);
+        }
     }
 
     return true;
@@ -629,8 +651,12 @@ void vpr_load_placement(t_vpr_setup& vpr_setup, const t_arch& arch) {
     auto& place_ctx = g_vpr_ctx.mutable_placement();
     const auto& filename_opts = vpr_setup.FileNameOpts;
 
-    //Load an existing placement from a file
-    read_place(filename_opts.NetFile.c_str(), filename_opts.PlaceFile.c_str(), filename_opts.verify_file_digests, device_ctx.grid);
+    //Load an existing placement from a checkpoint or file
+    if (filename_opts.read_checkpoint_file.empty()
+        || !read_placement_checkpoint(filename_opts.read_checkpoint_file.c_str(), arch,
+                                      filename_opts.PlaceFile.c_str(), vpr_setup.NetlistOpts, device_ctx.grid)) {
+        read_place(filename_opts.NetFile.c_str(), filename_opts.PlaceFile.c_str(), filename_opts.verify_file_digests, device_ctx.grid);
+    }
 
     //Ensure placement macros are loaded so that they can be drawn after placement (e.g. during routing)
     place_ctx.pl_macros = alloc_and_load_placement_macros(arch.Directs, arch.num_directs);
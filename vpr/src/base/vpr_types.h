@@ -657,6 +657,8 @@ struct t_file_name_opts {
     std::string PowerFile;
     std::string CmosTechFile;
     std::string out_file_prefix;
+    std::string read_checkpoint_file;
+    std::string write_checkpoint_file;
     bool verify_file_digests;
 };
 
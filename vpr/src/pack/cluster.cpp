@@ -72,6 +72,7 @@
 
 #define AAPACK_MAX_HIGH_FANOUT_EXPLORE 10 /* For high-fanout nets that are ignored, consider a maximum of this many sinks, must be less than packer_opts.feasible_block_array_size */
 #define AAPACK_MAX_TRANSITIVE_EXPLORE 40  /* When investigating transitive fanout connections in packing, consider a maximum of this many molecules, must be less than packer_opts.feasible_block_array_size */
+#define AAPACK_MAX_LB_ROUTE_CACHE_BYTES (64 * 1024 * 1024) /* Memory budget of the cache of unroutable intra-cluster routing problems */
 
 //Constant allowing all cluster pins to be used
 const t_ext_pin_util FULL_EXTERNAL_PIN_UTIL(1., 1.);
@@ -254,6 +255,7 @@ static void start_new_cluster(t_cluster_placement_stats* cluster_placement_stats
                               const t_arch* arch,
                               std::string device_layout_name,
                               std::vector<t_lb_type_rr_node>* lb_type_rr_graphs,
+                              t_lb_route_cache* lb_route_cache,
                               t_lb_router_data** router_data,
                               const int detailed_routing_stage,
                               ClusteredNetlist* clb_nlist,
@@ -320,7 +322,7 @@ static std::vector<AtomBlockId> initialize_seed_atoms(const e_cluster_seed seed_
                                                       const t_molecule_stats& max_molecule_stats,
                                                       const vtr::vector<AtomBlockId, float>& atom_criticality);
 
-static t_pack_molecule* get_highest_gain_seed_molecule(int* seedindex, const std::multimap<AtomBlockId, t_pack_molecule*>& atom_molecules, const std::vector<AtomBlockId> seed_atoms);
+static t_pack_molecule* get_highest_gain_seed_molecule(int* seedindex, const std::multimap<AtomBlockId, t_pack_molecule*>& atom_molecules, const std::vector<AtomBlockId>& seed_atoms);
 
 static float get_molecule_gain(t_pack_molecule* molecule, std::map<AtomBlockId, float>& blk_gain);
 static int compare_molecule_gain(const void* a, const void* b);
@@ -354,7 +356,7 @@ static t_logical_block_type_ptr identify_logic_block_type(std::map<const t_model
 
 static t_pb_type* identify_le_block_type(t_logical_block_type_ptr logic_block_type);
 
-static bool pb_used_for_blif_model(const t_pb* pb, std::string blif_model_name);
+static bool pb_used_for_blif_model(const t_pb* pb, const std::string& blif_model_name);
 
 static void print_le_count(std::vector<int>& le_count, const t_pb_type* le_pb_type);
 
@@ -404,6 +406,7 @@ std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& pa
     t_cluster_placement_stats *cluster_placement_stats, *cur_cluster_placement_stats_ptr;
     t_pb_graph_node** primitives_list;
     t_lb_router_data* router_data = nullptr;
+    t_lb_route_cache* lb_route_cache = alloc_lb_route_cache(AAPACK_MAX_LB_ROUTE_CACHE_BYTES);
     t_pack_molecule *istart, *next_molecule, *prev_molecule;
 
     auto& atom_ctx = g_vpr_ctx.atom();
@@ -542,6 +545,10 @@ std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& pa
      * Clustering
      *****************************************************************/
 
+    /* NOTE: Clusters are grown strictly one at a time. Packing a molecule updates state shared by
+     *       all clusters (the atom lookup's atom_pb/atom_clb, clb_nlist, cluster_placement_stats,
+     *       the unclustered molecule lists and each molecule's valid flag), so growing clusters
+     *       from several seeds concurrently would first require making that state per-region. */
     while (istart != nullptr) {
         is_cluster_legal = false;
         savedseedindex = seedindex;
@@ -556,7 +563,7 @@ std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& pa
                               packer_opts.target_device_utilization,
                               num_models, max_cluster_size,
                               arch, packer_opts.device_layout,
-                              lb_type_rr_graphs, &router_data,
+                              lb_type_rr_graphs, lb_route_cache, &router_data,
                               detailed_routing_stage, &cluster_ctx.clb_nlist,
                               primitive_candidate_block_types,
                               packer_opts.pack_verbosity,
@@ -781,6 +788,8 @@ std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& pa
 
     free_cluster_placement_stats(cluster_placement_stats);
 
+    free_lb_route_cache(lb_route_cache);
+
     for (auto blk_id : cluster_ctx.clb_nlist.blocks())
         cluster_ctx.clb_nlist.remove_block(blk_id);
 
@@ -1937,6 +1946,7 @@ static void start_new_cluster(t_cluster_placement_stats* cluster_placement_stats
                               const t_arch* arch,
                               std::string device_layout_name,
                               std::vector<t_lb_type_rr_node>* lb_type_rr_graphs,
+                              t_lb_route_cache* lb_route_cache,
                               t_lb_router_data** router_data,
                               const int detailed_routing_stage,
                               ClusteredNetlist* clb_nlist,
@@ -2000,7 +2010,7 @@ static void start_new_cluster(t_cluster_placement_stats* cluster_placement_stats
         alloc_and_load_pb_stats(pb, feasible_block_array_size);
         pb->parent_pb = nullptr;
 
-        *router_data = alloc_and_load_router_data(&lb_type_rr_graphs[type->index], type);
+        *router_data = alloc_and_load_router_data(&lb_type_rr_graphs[type->index], type, lb_route_cache);
 
         //Try packing into each mode
         e_block_pack_status pack_result = BLK_STATUS_UNDEFINED;
@@ -2709,7 +2719,7 @@ static std::vector<AtomBlockId> initialize_seed_atoms(const e_cluster_seed seed_
     return seed_atoms;
 }
 
-static t_pack_molecule* get_highest_gain_seed_molecule(int* seedindex, const std::multimap<AtomBlockId, t_pack_molecule*>& atom_molecules, const std::vector<AtomBlockId> seed_atoms) {
+static t_pack_molecule* get_highest_gain_seed_molecule(int* seedindex, const std::multimap<AtomBlockId, t_pack_molecule*>& atom_molecules, const std::vector<AtomBlockId>& seed_atoms) {
     auto& atom_ctx = g_vpr_ctx.atom();
 
     while (*seedindex < static_cast<int>(seed_atoms.size())) {
@@ -3487,7 +3497,7 @@ static void update_le_count(const t_pb* pb, const t_logical_block_type_ptr logic
  * This function returns true if the given physical block has
  * a primitive matching the given blif model and is used
  */
-static bool pb_used_for_blif_model(const t_pb* pb, std::string blif_model_name) {
+static bool pb_used_for_blif_model(const t_pb* pb, const std::string& blif_model_name) {
     auto pb_graph_node = pb->pb_graph_node;
     auto pb_type = pb_graph_node->pb_type;
     auto mode = &pb_type->modes[pb->mode];
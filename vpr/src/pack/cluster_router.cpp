@@ -18,9 +18,12 @@
 #include <map>
 #include <queue>
 #include <cmath>
+#include <list>
+#include <unordered_map>
 
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "vtr_hash.h"
 
 #include "vpr_error.h"
 #include "vpr_types.h"
@@ -69,10 +72,50 @@ class reservable_pq : public std::priority_queue<T, U, V> {
     size_type cur_cap;
 };
 
+/* Signature of an intra-logic block routing problem: the logic block type,
+ * whether all modes are expanded, the terminals of every net (in routing order)
+ * and the modes currently set on the lb_rr_nodes.
+ * Two routing problems with the same signature are routed identically */
+typedef std::vector<int> t_lb_route_signature;
+
+struct t_lb_route_signature_hash {
+    size_t operator()(const t_lb_route_signature& signature) const {
+        size_t seed = signature.size();
+        for (int value : signature) {
+            vtr::hash_combine(seed, value);
+        }
+        return seed;
+    }
+};
+
+/* Routing problems which are known to be unroutable (without any mode issue).
+ * Packing keeps proposing the same candidate clusters (e.g., when trying the same
+ * molecule pattern in identical DSP/BRAM clusters), so the failures are remembered
+ * to avoid rerouting them from scratch.
+ * The cache is bounded by an estimate of its memory footprint: when it is exceeded,
+ * the problems which have not been hit for the longest time are evicted first */
+struct t_lb_route_cache {
+    /* Signatures of the unroutable problems, pointing to their position in the recency list */
+    std::unordered_map<t_lb_route_signature, std::list<const t_lb_route_signature*>::iterator, t_lb_route_signature_hash> signatures;
+    /* Signatures stored in the map above, the most recently hit first */
+    std::list<const t_lb_route_signature*> recency;
+
+    size_t num_bytes = 0;
+    size_t max_bytes = 0;
+};
+
 /*****************************************************************************************
  * Internal functions declarations
  ******************************************************************************************/
 static void free_lb_net_rt(t_lb_trace* lb_trace);
+static bool build_lb_route_signature(const t_lb_router_data* router_data,
+                                     const t_mode_selection_status* mode_status,
+                                     t_lb_route_signature& signature);
+static size_t lb_route_signature_bytes(const t_lb_route_signature& signature);
+static bool is_lb_route_cached(t_lb_route_cache* route_cache, const t_lb_route_signature& signature);
+static void add_lb_route_to_cache(t_lb_route_cache* route_cache, t_lb_route_signature&& signature);
+static bool try_incremental_intra_lb_route(t_lb_router_data* router_data);
+static bool is_rt_legal_for_modes(const t_lb_trace* rt, t_lb_router_data* router_data);
 static void free_lb_trace(t_lb_trace* lb_trace);
 static void add_pin_to_rt_terminals(t_lb_router_data* router_data, const AtomPinId pin_id);
 static void remove_pin_from_rt_terminals(t_lb_router_data* router_data, const AtomPinId pin_id);
@@ -106,6 +149,7 @@ static bool add_to_rt(t_lb_trace* rt, int node_index, t_lb_router_data* router_d
 static bool is_route_success(t_lb_router_data* router_data);
 static t_lb_trace* find_node_in_rt(t_lb_trace* rt, int rt_index);
 static void reset_explored_node_tb(t_lb_router_data* router_data);
+static void advance_explore_id(t_lb_router_data* router_data);
 static void save_and_reset_lb_route(t_lb_router_data* router_data);
 static void load_trace_to_pb_route(t_pb_routes& pb_route, const int total_pins, const AtomNetId net_id, const int prev_pin_id, const t_lb_trace* trace);
 
@@ -133,7 +177,7 @@ static void print_trace(FILE* fp, t_lb_trace* trace, t_lb_router_data* router_da
 /**
  * Build data structures used by intra-logic block router
  */
-t_lb_router_data* alloc_and_load_router_data(std::vector<t_lb_type_rr_node>* lb_type_graph, t_logical_block_type_ptr type) {
+t_lb_router_data* alloc_and_load_router_data(std::vector<t_lb_type_rr_node>* lb_type_graph, t_logical_block_type_ptr type, t_lb_route_cache* route_cache) {
     t_lb_router_data* router_data = new t_lb_router_data;
     int size;
 
@@ -144,6 +188,7 @@ t_lb_router_data* alloc_and_load_router_data(std::vector<t_lb_type_rr_node>* lb_
     router_data->intra_lb_nets = new std::vector<t_intra_lb_net>;
     router_data->atoms_added = new std::map<AtomBlockId, bool>;
     router_data->lb_type = type;
+    router_data->route_cache = route_cache;
 
     return router_data;
 }
@@ -165,6 +210,19 @@ void free_router_data(t_lb_router_data* router_data) {
     }
 }
 
+/* Build an empty cache of unroutable intra-logic block routing problems,
+ * whose estimated memory footprint is kept below max_bytes */
+t_lb_route_cache* alloc_lb_route_cache(const size_t& max_bytes) {
+    t_lb_route_cache* route_cache = new t_lb_route_cache;
+    route_cache->max_bytes = max_bytes;
+    return route_cache;
+}
+
+/* free the cache of unroutable intra-logic block routing problems */
+void free_lb_route_cache(t_lb_route_cache* route_cache) {
+    delete route_cache;
+}
+
 static bool route_has_conflict(t_lb_trace* rt, t_lb_router_data* router_data) {
     std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
 
@@ -411,6 +469,27 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
     mode_status->is_mode_conflict = false;
     mode_status->try_expand_all_modes = false;
 
+    /* Skip the problems which are already known to be unroutable */
+    t_lb_route_signature route_signature;
+    bool is_cacheable = build_lb_route_signature(router_data, mode_status, route_signature);
+    if (is_cacheable && is_lb_route_cached(router_data->route_cache, route_signature)) {
+        VTR_LOGV(verbosity > 3, "Proposed %s cluster is known to be unroutable\n", router_data->lb_type->name);
+        for (unsigned int inet = 0; inet < lb_nets.size(); inet++) {
+            free_lb_net_rt(lb_nets[inet].rt_tree);
+            lb_nets[inet].rt_tree = nullptr;
+        }
+        return false;
+    }
+
+    /* Only reroute the nets touched since the last successful route.
+     * Modes are not explored in this pass: any failure falls back to the full route below */
+    if (is_cacheable && !mode_status->expand_all_modes && router_data->saved_lb_nets != nullptr) {
+        if (try_incremental_intra_lb_route(router_data)) {
+            save_and_reset_lb_route(router_data);
+            return true;
+        }
+    }
+
     t_expansion_node exp_node;
 
     /* Stores state info during route */
@@ -482,15 +561,7 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
                     }
                 }
 
-                router_data->explore_id_index++;
-                if (router_data->explore_id_index > 2000000000) {
-                    /* overflow protection */
-                    for (unsigned int id = 0; id < lb_type_graph.size(); id++) {
-                        router_data->explored_node_tb[id].explored_id = OPEN;
-                        router_data->explored_node_tb[id].enqueue_id = OPEN;
-                        router_data->explore_id_index = 1;
-                    }
-                }
+                advance_explore_id(router_data);
             }
 
             if (!is_impossible) {
@@ -534,10 +605,116 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
             free_lb_net_rt(lb_nets[inet].rt_tree);
             lb_nets[inet].rt_tree = nullptr;
         }
+
+        /* Only pure routability failures are remembered: mode issues make the
+         * caller change the modes and retry, and record illegal modes on the way */
+        if (is_cacheable && !mode_status->is_mode_issue()) {
+            add_lb_route_to_cache(router_data->route_cache, std::move(route_signature));
+        }
     }
     return is_routed;
 }
 
+/* Route the current problem by keeping the routes of the last successful route
+ * (saved_lb_nets) for the nets whose terminals did not change, and by only routing
+ * the nets touched since then, i.e., new nets and nets whose terminals changed.
+ * A kept route is ripped up as well if it is no longer legal for the modes set on the
+ * lb_rr_nodes by the new atoms.
+ * Return true if the resulting route is legal. Otherwise, all the route trees are freed
+ * so that the caller can route the whole problem from scratch */
+static bool try_incremental_intra_lb_route(t_lb_router_data* router_data) {
+    std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
+    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+
+    std::unordered_map<AtomNetId, const t_intra_lb_net*> saved_nets;
+    for (const t_intra_lb_net& saved_net : *router_data->saved_lb_nets) {
+        saved_nets[saved_net.atom_net_id] = &saved_net;
+    }
+
+    reset_explored_node_tb(router_data);
+    for (unsigned int inode = 0; inode < lb_type_graph.size(); inode++) {
+        router_data->lb_rr_node_stats[inode].historical_usage = 0;
+        router_data->lb_rr_node_stats[inode].occ = 0;
+    }
+    router_data->pres_con_fac = router_data->params.pres_fac;
+
+    /* Modes are not checked when committing, as no mode is expanded */
+    std::unordered_map<const t_pb_graph_node*, const t_mode*> mode_map;
+    t_mode_selection_status mode_status;
+
+    /* Keep the routes of the untouched nets */
+    std::vector<int> touched_nets;
+    for (unsigned int inet = 0; inet < lb_nets.size(); inet++) {
+        free_lb_net_rt(lb_nets[inet].rt_tree);
+        lb_nets[inet].rt_tree = nullptr;
+
+        auto saved_net = saved_nets.find(lb_nets[inet].atom_net_id);
+        if (saved_net == saved_nets.end()
+            || saved_net->second->rt_tree == nullptr
+            || saved_net->second->terminals != lb_nets[inet].terminals
+            || !is_rt_legal_for_modes(saved_net->second->rt_tree, router_data)) {
+            touched_nets.push_back(inet);
+            continue;
+        }
+        lb_nets[inet].rt_tree = new t_lb_trace(*saved_net->second->rt_tree);
+        commit_remove_rt(lb_nets[inet].rt_tree, router_data, RT_COMMIT, &mode_map, &mode_status);
+    }
+
+    /* Route the touched nets around the kept routes */
+    t_expansion_node exp_node;
+    reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node> pq;
+    bool is_impossible = false;
+    for (size_t itouched = 0; itouched < touched_nets.size() && !is_impossible; itouched++) {
+        int inet = touched_nets[itouched];
+        add_source_to_rt(router_data, inet);
+
+        for (unsigned int itarget = 1; itarget < lb_nets[inet].terminals.size() && !is_impossible; itarget++) {
+            pq.clear();
+            expand_rt(router_data, inet, pq, inet);
+
+            is_impossible = try_expand_nodes(router_data, &lb_nets[inet], &exp_node, pq, itarget, false, 0);
+            if (!is_impossible && exp_node.node_index == lb_nets[inet].terminals[itarget]) {
+                is_impossible = add_to_rt(lb_nets[inet].rt_tree, exp_node.node_index, router_data, inet);
+            }
+
+            advance_explore_id(router_data);
+        }
+
+        if (!is_impossible) {
+            commit_remove_rt(lb_nets[inet].rt_tree, router_data, RT_COMMIT, &mode_map, &mode_status);
+        }
+    }
+
+    if (!is_impossible && is_route_success(router_data)) {
+        return true;
+    }
+
+    for (unsigned int inet = 0; inet < lb_nets.size(); inet++) {
+        free_lb_net_rt(lb_nets[inet].rt_tree);
+        lb_nets[inet].rt_tree = nullptr;
+    }
+    return false;
+}
+
+/* Check that every edge of a route tree belongs to the mode currently set on its driver node */
+static bool is_rt_legal_for_modes(const t_lb_trace* rt, t_lb_router_data* router_data) {
+    int mode = router_data->lb_rr_node_stats[rt->current_node].mode;
+    if (mode == -1) {
+        mode = 0;
+    }
+
+    for (const t_lb_trace& next_node : rt->next_nodes) {
+        if (mode != get_lb_type_rr_graph_edge_mode(*router_data->lb_type_graph, rt->current_node, next_node.current_node)) {
+            return false;
+        }
+        if (!is_rt_legal_for_modes(&next_node, router_data)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 /*****************************************************************************************
  * Accessor Functions
  ******************************************************************************************/
@@ -1023,6 +1200,89 @@ static void commit_remove_rt(t_lb_trace* rt, t_lb_router_data* router_data, e_co
     }
 }
 
+/* Build the signature of the routing problem currently loaded in the router data.
+ * Return false if the problem cannot be identified by its signature, i.e. some
+ * pb_graph_nodes carry illegal modes from a previous mode conflict */
+static bool build_lb_route_signature(const t_lb_router_data* router_data,
+                                     const t_mode_selection_status* mode_status,
+                                     t_lb_route_signature& signature) {
+    const std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
+    const std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+
+    signature.clear();
+    signature.push_back(router_data->lb_type->index);
+    signature.push_back(mode_status->expand_all_modes);
+
+    signature.push_back(lb_nets.size());
+    for (const t_intra_lb_net& lb_net : lb_nets) {
+        signature.push_back(lb_net.terminals.size());
+        signature.insert(signature.end(), lb_net.terminals.begin(), lb_net.terminals.end());
+    }
+
+    for (size_t inode = 0; inode < lb_type_graph.size(); inode++) {
+        const t_pb_graph_pin* pin = lb_type_graph[inode].pb_graph_pin;
+        if (pin != nullptr && !pin->parent_node->illegal_modes.empty()) {
+            return false;
+        }
+        if (-1 != router_data->lb_rr_node_stats[inode].mode) {
+            signature.push_back(inode);
+            signature.push_back(router_data->lb_rr_node_stats[inode].mode);
+        }
+    }
+
+    return true;
+}
+
+/* Estimate the memory used by a signature stored in the cache of unroutable problems,
+ * including the nodes of the hash map and of the recency list */
+static size_t lb_route_signature_bytes(const t_lb_route_signature& signature) {
+    return sizeof(t_lb_route_signature) + signature.capacity() * sizeof(int) + 6 * sizeof(void*);
+}
+
+/* Return true if a routing problem is known to be unroutable, and mark it as the most recently hit */
+static bool is_lb_route_cached(t_lb_route_cache* route_cache, const t_lb_route_signature& signature) {
+    if (route_cache == nullptr) {
+        return false;
+    }
+
+    auto result = route_cache->signatures.find(signature);
+    if (result == route_cache->signatures.end()) {
+        return false;
+    }
+    route_cache->recency.splice(route_cache->recency.begin(), route_cache->recency, result->second);
+    return true;
+}
+
+/* Remember an unroutable routing problem, evicting the least recently hit ones
+ * until the estimated memory footprint of the cache fits its budget */
+static void add_lb_route_to_cache(t_lb_route_cache* route_cache, t_lb_route_signature&& signature) {
+    if (route_cache == nullptr) {
+        return;
+    }
+
+    signature.shrink_to_fit();
+    size_t num_bytes = lb_route_signature_bytes(signature);
+    if (num_bytes > route_cache->max_bytes) {
+        return;
+    }
+
+    auto result = route_cache->signatures.emplace(std::move(signature), route_cache->recency.end());
+    if (!result.second) {
+        return;
+    }
+    route_cache->recency.push_front(&result.first->first);
+    result.first->second = route_cache->recency.begin();
+    route_cache->num_bytes += num_bytes;
+
+    while (route_cache->num_bytes > route_cache->max_bytes) {
+        auto victim = route_cache->signatures.find(*route_cache->recency.back());
+        VTR_ASSERT(victim != route_cache->signatures.end());
+        route_cache->num_bytes -= lb_route_signature_bytes(victim->first);
+        route_cache->recency.pop_back();
+        route_cache->signatures.erase(victim);
+    }
+}
+
 /* Should net be skipped?  If the net does not conflict with another net, then skip routing this net */
 static bool is_skip_route_net(t_lb_trace* rt, t_lb_router_data* router_data) {
     t_lb_rr_node_stats* lb_rr_node_stats;
@@ -1328,6 +1588,21 @@ static void reset_explored_node_tb(t_lb_router_data* router_data) {
     }
 }
 
+/* Use a new identifier for the next exploration, so that the explored node table does not need to be cleared */
+static void advance_explore_id(t_lb_router_data* router_data) {
+    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+
+    router_data->explore_id_index++;
+    if (router_data->explore_id_index > 2000000000) {
+        /* overflow protection */
+        for (unsigned int id = 0; id < lb_type_graph.size(); id++) {
+            router_data->explored_node_tb[id].explored_id = OPEN;
+            router_data->explored_node_tb[id].enqueue_id = OPEN;
+            router_data->explore_id_index = 1;
+        }
+    }
+}
+
 /* Save last successful intra-logic block route and reset current traceback */
 static void save_and_reset_lb_route(t_lb_router_data* router_data) {
     std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
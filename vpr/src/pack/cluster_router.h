@@ -11,8 +11,10 @@
 #include "pack_types.h"
 
 /* Constructors/Destructors */
-t_lb_router_data* alloc_and_load_router_data(std::vector<t_lb_type_rr_node>* lb_type_graph, t_logical_block_type_ptr type);
+t_lb_router_data* alloc_and_load_router_data(std::vector<t_lb_type_rr_node>* lb_type_graph, t_logical_block_type_ptr type, t_lb_route_cache* route_cache);
 void free_router_data(t_lb_router_data* router_data);
+t_lb_route_cache* alloc_lb_route_cache(const size_t& max_bytes);
+void free_lb_route_cache(t_lb_route_cache* route_cache);
 void free_intra_lb_nets(std::vector<t_intra_lb_net>* intra_lb_nets);
 
 /* Routing Functions */
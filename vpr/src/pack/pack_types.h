@@ -213,6 +213,11 @@ struct t_explored_node_tb {
 };
 
 /* Stores all data needed by intra-logic cluster_ctx.blocks router */
+/* Cache of the intra-logic block routing problems known to be unroutable.
+ * It is owned by the packer and shared by the router data of all the clusters,
+ * see cluster_router.cpp */
+struct t_lb_route_cache;
+
 struct t_lb_router_data {
     /* Physical Architecture Info */
     std::vector<t_lb_type_rr_node>* lb_type_graph; /* Pointer to physical intra-logic cluster_ctx.blocks type rr graph */
@@ -242,6 +247,9 @@ struct t_lb_router_data {
     /* current congestion factor */
     float pres_con_fac;
 
+    /* Cache of unroutable routing problems shared between clusters (not owned, may be nullptr) */
+    t_lb_route_cache* route_cache;
+
     t_lb_router_data() {
         lb_type_graph = nullptr;
         lb_rr_node_stats = nullptr;
@@ -259,6 +267,8 @@ struct t_lb_router_data {
         params.hist_fac = 0.3;
 
         pres_con_fac = 1;
+
+        route_cache = nullptr;
     }
 };
 
@@ -126,6 +126,7 @@ void alloc_and_load_all_pb_graphs(bool load_power_structures) {
     for (auto& type : device_ctx.logical_block_types) {
         if (type.pb_type) {
             type.pb_graph_head = (t_pb_graph_node*)vtr::calloc(1, sizeof(t_pb_graph_node));
+            type.pb_graph_head->logical_block_type_index = type.index;
             int pin_count_in_cluster = 0;
             alloc_and_load_pb_graph(type.pb_graph_head, nullptr,
                                     type.pb_type, 0, load_power_structures, pin_count_in_cluster);
@@ -202,6 +203,9 @@ static void alloc_and_load_pb_graph(t_pb_graph_node* pb_graph_node,
     pb_graph_node->placement_index = index;
     pb_graph_node->pb_type = pb_type;
     pb_graph_node->parent_pb_graph_node = parent_pb_graph_node;
+    if (parent_pb_graph_node) {
+        pb_graph_node->logical_block_type_index = parent_pb_graph_node->logical_block_type_index;
+    }
 
     pb_graph_node->num_input_ports = 0;
     pb_graph_node->num_output_ports = 0;
@@ -123,17 +123,38 @@ static vtr::vector<ClusterNetId, double> net_cost, temp_net_cost;
  * right, DO NOT update again.                                                   */
 static vtr::vector<ClusterNetId, char> bb_updated_before;
 
-/* [0..cluster_ctx.clb_nlist.nets().size()-1][1..num_pins-1]. What is the value of the timing   */
-/* driven portion of the cost function. These arrays will be set to  */
-/* (criticality * delay) for each point to point connection. */
-
-static vtr::vector<ClusterNetId, double*> point_to_point_timing_cost;
-static vtr::vector<ClusterNetId, double*> temp_point_to_point_timing_cost;
+/* Per-net and per-connection state of the placer, stored as a structure of     *
+ * arrays: each field is a single contiguous array, so that the incremental     *
+ * cost updates of the inner loop walk a few arrays instead of thousands of     *
+ * small heap blocks scattered across the address space.                        *
+ *                                                                              *
+ * The per-connection fields of all the nets are packed net by net. The value   *
+ * of the connection to net pin ipin [1..num_pins-1] is at index                *
+ * conn_base[net_id] + ipin, see conn_index(). The slot of the driver pin       *
+ * (ipin = 0) is left unused, so that no index falls before the slice of a net. */
+struct t_place_net_soa {
+    /* [0..cluster_ctx.clb_nlist.nets().size()-1]. Index of the driver pin of *
+     * each net in the per-connection fields. Only for timing driven placement */
+    vtr::vector<ClusterNetId, size_t> conn_base;
+
+    /* What is the value of the timing driven portion of the cost function. *
+     * These arrays will be set to (criticality * delay) for each point to   *
+     * point connection.                                                     */
+    std::vector<double> timing_cost;
+    std::vector<double> temp_timing_cost;
+
+    /* What is the value of the delay for each connection in the circuit */
+    std::vector<float> delay;
+    std::vector<float> temp_delay;
+
+    /* [0..cluster_ctx.clb_nlist.nets().size()-1].  Store the bounding box coordinates *
+     * and the number of blocks on each of a net's bounding box (to allow efficient    *
+     * updates), respectively.                                                         */
+    vtr::vector<ClusterNetId, t_bb> bb_coords;
+    vtr::vector<ClusterNetId, t_bb> bb_num_on_edges;
+};
 
-/* [0..cluster_ctx.clb_nlist.nets().size()-1][1..num_pins-1]. What is the value of the delay */
-/* for each connection in the circuit */
-static vtr::vector<ClusterNetId, float*> point_to_point_delay;
-static vtr::vector<ClusterNetId, float*> temp_point_to_point_delay;
+static t_place_net_soa place_nets;
 
 /* [0..cluster_ctx.clb_nlist.blocks().size()-1][0..pins_per_clb-1]. Indicates which pin on the net */
 /* this block corresponds to, this is only required during timing-driven */
@@ -141,12 +162,6 @@ static vtr::vector<ClusterNetId, float*> temp_point_to_point_delay;
 /* each net */
 static vtr::vector<ClusterBlockId, std::vector<int>> net_pin_indices;
 
-/* [0..cluster_ctx.clb_nlist.nets().size()-1].  Store the bounding box coordinates and the number of    *
- * blocks on each of a net's bounding box (to allow efficient updates),      *
- * respectively.                                                             */
-
-static vtr::vector<ClusterNetId, t_bb> bb_coords, bb_num_on_edges;
-
 /* The arrays below are used to precompute the inverse of the average   *
  * number of tracks per channel between [subhigh] and [sublow].  Access *
  * them as chan?_place_cost_fac[subhigh][sublow].  They are used to     *
@@ -270,6 +285,12 @@ static void alloc_and_load_placement_structs(float place_cost_exp,
 
 static void alloc_and_load_net_pin_indices();
 
+static size_t alloc_and_load_net_conn_base();
+
+static size_t conn_index(ClusterNetId net_id, int ipin);
+
+static vtr::vector<ClusterNetId, float*> get_net_conn_delay_ptrs();
+
 static void alloc_and_load_try_swap_structs();
 
 static void free_placement_structs(const t_placer_opts& placer_opts);
@@ -515,7 +536,8 @@ void try_place(const t_placer_opts& placer_opts,
          * Initialize timing analysis
          */
         auto& atom_ctx = g_vpr_ctx.atom();
-        placement_delay_calc = std::make_shared<PlacementDelayCalculator>(atom_ctx.nlist, atom_ctx.lookup, point_to_point_delay);
+        vtr::vector<ClusterNetId, float*> net_conn_delay_ptrs = get_net_conn_delay_ptrs();
+        placement_delay_calc = std::make_shared<PlacementDelayCalculator>(atom_ctx.nlist, atom_ctx.lookup, net_conn_delay_ptrs);
         placement_delay_calc->set_tsu_margin_relative(placer_opts.tsu_rel_margin);
         placement_delay_calc->set_tsu_margin_absolute(placer_opts.tsu_abs_margin);
         timing_info = make_setup_timing_info(placement_delay_calc);
@@ -1149,9 +1171,9 @@ static void update_move_nets(int num_nets_affected) {
     for (int inet_affected = 0; inet_affected < num_nets_affected; inet_affected++) {
         ClusterNetId net_id = ts_nets_to_update[inet_affected];
 
-        bb_coords[net_id] = ts_bb_coord_new[net_id];
+        place_nets.bb_coords[net_id] = ts_bb_coord_new[net_id];
         if (cluster_ctx.clb_nlist.net_sinks(net_id).size() >= SMALL_NET)
-            bb_num_on_edges[net_id] = ts_bb_edge_new[net_id];
+            place_nets.bb_num_on_edges[net_id] = ts_bb_edge_new[net_id];
 
         net_cost[net_id] = temp_net_cost[net_id];
 
@@ -1414,10 +1436,10 @@ static void update_td_delta_costs(const PlaceDelayModel* delay_model, const t_pl
         //Re-compute all point to point connections for this net.
         for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net).size(); ipin++) {
             float temp_delay = comp_td_point_to_point_delay(delay_model, net, ipin);
-            temp_point_to_point_delay[net][ipin] = temp_delay;
+            place_nets.temp_delay[conn_index(net, ipin)] = temp_delay;
 
-            temp_point_to_point_timing_cost[net][ipin] = get_timing_place_crit(net, ipin) * temp_delay;
-            delta_timing_cost += temp_point_to_point_timing_cost[net][ipin] - point_to_point_timing_cost[net][ipin];
+            place_nets.temp_timing_cost[conn_index(net, ipin)] = get_timing_place_crit(net, ipin) * temp_delay;
+            delta_timing_cost += place_nets.temp_timing_cost[conn_index(net, ipin)] - place_nets.timing_cost[conn_index(net, ipin)];
         }
     } else {
         //This pin is a net sink on a moved block
@@ -1433,10 +1455,10 @@ static void update_td_delta_costs(const PlaceDelayModel* delay_model, const t_pl
             int net_pin = cluster_ctx.clb_nlist.pin_net_index(pin);
 
             float temp_delay = comp_td_point_to_point_delay(delay_model, net, net_pin);
-            temp_point_to_point_delay[net][net_pin] = temp_delay;
+            place_nets.temp_delay[conn_index(net, net_pin)] = temp_delay;
 
-            temp_point_to_point_timing_cost[net][net_pin] = get_timing_place_crit(net, net_pin) * temp_delay;
-            delta_timing_cost += temp_point_to_point_timing_cost[net][net_pin] - point_to_point_timing_cost[net][net_pin];
+            place_nets.temp_timing_cost[conn_index(net, net_pin)] = get_timing_place_crit(net, net_pin) * temp_delay;
+            delta_timing_cost += place_nets.temp_timing_cost[conn_index(net, net_pin)] - place_nets.timing_cost[conn_index(net, net_pin)];
         }
     }
 }
@@ -1537,7 +1559,7 @@ static void comp_td_point_to_point_delays(const PlaceDelayModel* delay_model) {
 
     for (auto net_id : cluster_ctx.clb_nlist.nets()) {
         for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ++ipin) {
-            point_to_point_delay[net_id][ipin] = comp_td_point_to_point_delay(delay_model, net_id, ipin);
+            place_nets.delay[conn_index(net_id, ipin)] = comp_td_point_to_point_delay(delay_model, net_id, ipin);
         }
     }
 }
@@ -1560,10 +1582,10 @@ static void update_td_cost(const t_pl_blocks_to_be_moved& blocks_affected) {
                 //This net is being driven by a moved block, recompute
                 //all point to point connections on this net.
                 for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++) {
-                    point_to_point_delay[net_id][ipin] = temp_point_to_point_delay[net_id][ipin];
-                    temp_point_to_point_delay[net_id][ipin] = INVALID_DELAY;
-                    point_to_point_timing_cost[net_id][ipin] = temp_point_to_point_timing_cost[net_id][ipin];
-                    temp_point_to_point_timing_cost[net_id][ipin] = INVALID_DELAY;
+                    place_nets.delay[conn_index(net_id, ipin)] = place_nets.temp_delay[conn_index(net_id, ipin)];
+                    place_nets.temp_delay[conn_index(net_id, ipin)] = INVALID_DELAY;
+                    place_nets.timing_cost[conn_index(net_id, ipin)] = place_nets.temp_timing_cost[conn_index(net_id, ipin)];
+                    place_nets.temp_timing_cost[conn_index(net_id, ipin)] = INVALID_DELAY;
                 }
             } else {
                 //This pin is a net sink on a moved block
@@ -1573,10 +1595,10 @@ static void update_td_cost(const t_pl_blocks_to_be_moved& blocks_affected) {
                 if (!driven_by_moved_block(net_id, blocks_affected)) {
                     int net_pin = cluster_ctx.clb_nlist.pin_net_index(pin_id);
 
-                    point_to_point_delay[net_id][net_pin] = temp_point_to_point_delay[net_id][net_pin];
-                    temp_point_to_point_delay[net_id][net_pin] = INVALID_DELAY;
-                    point_to_point_timing_cost[net_id][net_pin] = temp_point_to_point_timing_cost[net_id][net_pin];
-                    temp_point_to_point_timing_cost[net_id][net_pin] = INVALID_DELAY;
+                    place_nets.delay[conn_index(net_id, net_pin)] = place_nets.temp_delay[conn_index(net_id, net_pin)];
+                    place_nets.temp_delay[conn_index(net_id, net_pin)] = INVALID_DELAY;
+                    place_nets.timing_cost[conn_index(net_id, net_pin)] = place_nets.temp_timing_cost[conn_index(net_id, net_pin)];
+                    place_nets.temp_timing_cost[conn_index(net_id, net_pin)] = INVALID_DELAY;
                 }
             }
         } /* Finished going through all the pins in the moved block */
@@ -1614,11 +1636,11 @@ static void comp_td_costs(const PlaceDelayModel* delay_model, double* timing_cos
             float conn_delay = comp_td_point_to_point_delay(delay_model, net_id, ipin);
             float conn_timing_cost = conn_delay * get_timing_place_crit(net_id, ipin);
 
-            point_to_point_delay[net_id][ipin] = conn_delay;
-            temp_point_to_point_delay[net_id][ipin] = INVALID_DELAY;
+            place_nets.delay[conn_index(net_id, ipin)] = conn_delay;
+            place_nets.temp_delay[conn_index(net_id, ipin)] = INVALID_DELAY;
 
-            point_to_point_timing_cost[net_id][ipin] = conn_timing_cost;
-            temp_point_to_point_timing_cost[net_id][ipin] = INVALID_DELAY;
+            place_nets.timing_cost[conn_index(net_id, ipin)] = conn_timing_cost;
+            place_nets.temp_timing_cost[conn_index(net_id, ipin)] = INVALID_DELAY;
             new_timing_cost += conn_timing_cost;
         }
     }
@@ -1645,16 +1667,16 @@ static double comp_bb_cost(e_cost_methods method) {
             /* Small nets don't use incremental updating on their bounding boxes, *
              * so they can use a fast bounding box calculator.                    */
             if (cluster_ctx.clb_nlist.net_sinks(net_id).size() >= SMALL_NET && method == NORMAL) {
-                get_bb_from_scratch(net_id, &bb_coords[net_id],
-                                    &bb_num_on_edges[net_id]);
+                get_bb_from_scratch(net_id, &place_nets.bb_coords[net_id],
+                                    &place_nets.bb_num_on_edges[net_id]);
             } else {
-                get_non_updateable_bb(net_id, &bb_coords[net_id]);
+                get_non_updateable_bb(net_id, &place_nets.bb_coords[net_id]);
             }
 
-            net_cost[net_id] = get_net_cost(net_id, &bb_coords[net_id]);
+            net_cost[net_id] = get_net_cost(net_id, &place_nets.bb_coords[net_id]);
             cost += net_cost[net_id];
             if (method == CHECK)
-                expected_wirelength += get_net_wirelength_estimate(net_id, &bb_coords[net_id]);
+                expected_wirelength += get_net_wirelength_estimate(net_id, &place_nets.bb_coords[net_id]);
         }
     }
 
@@ -1668,35 +1690,24 @@ static double comp_bb_cost(e_cost_methods method) {
 /* Frees the major structures needed by the placer (and not needed       *
  * elsewhere).   */
 static void free_placement_structs(const t_placer_opts& placer_opts) {
-    auto& cluster_ctx = g_vpr_ctx.clustering();
-
     free_fast_cost_update();
 
     if (placer_opts.place_algorithm == PATH_TIMING_DRIVEN_PLACE
         || placer_opts.enable_timing_computations) {
-        for (auto net_id : cluster_ctx.clb_nlist.nets()) {
-            /*add one to the address since it is indexed from 1 not 0 */
-            point_to_point_timing_cost[net_id]++;
-            free(point_to_point_timing_cost[net_id]);
-
-            temp_point_to_point_timing_cost[net_id]++;
-            free(temp_point_to_point_timing_cost[net_id]);
-
-            point_to_point_delay[net_id]++;
-            free(point_to_point_delay[net_id]);
-
-            temp_point_to_point_delay[net_id]++;
-            free(temp_point_to_point_delay[net_id]);
-        }
-
-        point_to_point_timing_cost.clear();
-        point_to_point_delay.clear();
-        temp_point_to_point_timing_cost.clear();
-        temp_point_to_point_delay.clear();
+        /* Release the flat storage rather than only resetting its size */
+        place_nets.conn_base.clear();
+        place_nets.conn_base.shrink_to_fit();
+        std::vector<double>().swap(place_nets.timing_cost);
+        std::vector<double>().swap(place_nets.temp_timing_cost);
+        std::vector<float>().swap(place_nets.delay);
+        std::vector<float>().swap(place_nets.temp_delay);
 
         net_pin_indices.clear();
     }
 
+    place_nets.bb_coords.clear();
+    place_nets.bb_num_on_edges.clear();
+
     free_placement_macros_structs();
 
     /* Frees up all the data structure used in vpr_utils. */
@@ -1710,7 +1721,6 @@ static void alloc_and_load_placement_structs(float place_cost_exp,
                                              t_direct_inf* directs,
                                              int num_directs) {
     int max_pins_per_clb;
-    unsigned int ipin;
 
     auto& device_ctx = g_vpr_ctx.device();
     auto& cluster_ctx = g_vpr_ctx.clustering();
@@ -1729,40 +1739,19 @@ static void alloc_and_load_placement_structs(float place_cost_exp,
         || placer_opts.enable_timing_computations) {
         /* Allocate structures associated with timing driven placement */
         /* [0..cluster_ctx.clb_nlist.nets().size()-1][1..num_pins-1]  */
-        point_to_point_delay.resize(num_nets);
-        temp_point_to_point_delay.resize(num_nets);
-
-        point_to_point_timing_cost.resize(num_nets);
-        temp_point_to_point_timing_cost.resize(num_nets);
-
-        for (auto net_id : cluster_ctx.clb_nlist.nets()) {
-            size_t num_sinks = cluster_ctx.clb_nlist.net_sinks(net_id).size();
-            /* In the following, subract one so index starts at *
-             * 1 instead of 0 */
-            point_to_point_delay[net_id] = (float*)vtr::malloc(num_sinks * sizeof(float));
-            point_to_point_delay[net_id]--;
-
-            temp_point_to_point_delay[net_id] = (float*)vtr::malloc(num_sinks * sizeof(float));
-            temp_point_to_point_delay[net_id]--;
+        size_t num_conn_slots = alloc_and_load_net_conn_base();
 
-            point_to_point_timing_cost[net_id] = (double*)vtr::malloc(num_sinks * sizeof(double));
-            point_to_point_timing_cost[net_id]--;
+        place_nets.delay.assign(num_conn_slots, 0.f);
+        place_nets.temp_delay.assign(num_conn_slots, 0.f);
 
-            temp_point_to_point_timing_cost[net_id] = (double*)vtr::malloc(num_sinks * sizeof(double));
-            temp_point_to_point_timing_cost[net_id]--;
-        }
-        for (auto net_id : cluster_ctx.clb_nlist.nets()) {
-            for (ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++) {
-                point_to_point_delay[net_id][ipin] = 0;
-                temp_point_to_point_delay[net_id][ipin] = 0;
-            }
-        }
+        place_nets.timing_cost.assign(num_conn_slots, 0.);
+        place_nets.temp_timing_cost.assign(num_conn_slots, 0.);
     }
 
     net_cost.resize(num_nets, -1.);
     temp_net_cost.resize(num_nets, -1.);
-    bb_coords.resize(num_nets, t_bb());
-    bb_num_on_edges.resize(num_nets, t_bb());
+    place_nets.bb_coords.resize(num_nets, t_bb());
+    place_nets.bb_num_on_edges.resize(num_nets, t_bb());
 
     /* Used to store costs for moves not yet made and to indicate when a net's   *
      * cost has been recomputed. temp_net_cost[inet] < 0 means net's cost hasn't *
@@ -1812,6 +1801,43 @@ static void alloc_and_load_net_pin_indices() {
     }
 }
 
+/* Loads the index of the driver pin of each net in the per-connection fields *
+ * of place_nets. Each net owns num_pins slots, including the unused slot of  *
+ * its driver pin. Returns the total number of slots.                         */
+static size_t alloc_and_load_net_conn_base() {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    place_nets.conn_base.resize(cluster_ctx.clb_nlist.nets().size());
+
+    size_t offset = 0;
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        place_nets.conn_base[net_id] = offset;
+        offset += cluster_ctx.clb_nlist.net_pins(net_id).size();
+    }
+    return offset;
+}
+
+/* Index of the connection to net pin ipin [1..num_pins-1] of a net in the *
+ * per-connection fields of place_nets.                                   */
+static inline size_t conn_index(ClusterNetId net_id, int ipin) {
+    return place_nets.conn_base[net_id] + ipin;
+}
+
+/* Builds the per-net pointers to the connection delays expected by the      *
+ * PlacementDelayCalculator, which indexes them by net pin [1..num_pins-1].  *
+ * Each pointer is at the (unused) driver slot of its net, so it never goes   *
+ * before the storage. The pointers stay valid until place_nets.delay is     *
+ * reallocated.                                                              */
+static vtr::vector<ClusterNetId, float*> get_net_conn_delay_ptrs() {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    vtr::vector<ClusterNetId, float*> net_conn_delay_ptrs(cluster_ctx.clb_nlist.nets().size(), nullptr);
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        net_conn_delay_ptrs[net_id] = place_nets.delay.data() + place_nets.conn_base[net_id];
+    }
+    return net_conn_delay_ptrs;
+}
+
 static void alloc_and_load_try_swap_structs() {
     /* Allocate the local bb_coordinate storage, etc. only once. */
     /* Allocate with size cluster_ctx.clb_nlist.nets().size() for any number of nets affected. */
@@ -2072,8 +2098,8 @@ static void update_bb(ClusterNetId net_id, t_bb* bb_coord_new, t_bb* bb_edge_new
         return;
     } else if (bb_updated_before[net_id] == NOT_UPDATED_YET) {
         /* The net had NOT been updated before, could use the old values */
-        curr_bb_coord = &bb_coords[net_id];
-        curr_bb_edge = &bb_num_on_edges[net_id];
+        curr_bb_coord = &place_nets.bb_coords[net_id];
+        curr_bb_edge = &place_nets.bb_num_on_edges[net_id];
         bb_updated_before[net_id] = UPDATED_ONCE;
     } else {
         /* The net had been updated before, must use the new values */